@@ -16,43 +16,91 @@ cannot calculate that result.
 If voltage source connect the inverse, the algorithm handle it.
 3. All transistor configuratiions are set as 'npn' type. 
 4. In ac analysis, algorithms use 're transistor' model.
+5. All names begin with 'bjt_' (or 'BJT_' for types), so this
+source file can be included together with JFET.h and MOSFET.h.
+Functions are 'static inline', so it can be included next to the
+library too (see TransCal.h).
 
 EXISTING CONFIGURATIONS:
 ------------------------
 
-+ dc_fixed_bias()
-+ ac_fixed_bias()
-+ dc_emitter_bias()
-+ ac_emitter_bias()
-+ dc_voltage_divider()
-+ ac_voltage_divider()
-+ dc_collector_feedback()
-+ ac_collector_feedback()
-+ ac_collector_dc_feedback()
-+ dc_emitter_follower()
-+ ac_emitter_follower()
-+ dc_common_base()
-+ ac_common_base()
-+ dc_miscellaneous_bias()
-+ two_port_system()
-+ cascaded_system()
++ bjt_dc_fixed_bias()
++ bjt_ac_fixed_bias()
++ bjt_dc_emitter_bias()
++ bjt_ac_emitter_bias()
++ bjt_dc_voltage_divider()
++ bjt_ac_voltage_divider()
++ bjt_dc_collector_feedback()
++ bjt_ac_collector_feedback()
++ bjt_ac_collector_dc_feedback()
++ bjt_dc_emitter_follower()
++ bjt_ac_emitter_follower()
++ bjt_dc_common_base()
++ bjt_ac_common_base()
++ bjt_dc_miscellaneous_bias()
++ bjt_two_port_system()
++ bjt_cascaded_system()
+
+FUSED (DC AND AC) ANALYSES:
+---------------------------
+
++ bjt_analyze_fixed_bias()
++ bjt_analyze_emitter_bias()
++ bjt_analyze_voltage_divider()
++ bjt_analyze_collector_feedback()
++ bjt_analyze_emitter_follower()
++ bjt_analyze_common_base()
+
+BATCH ENTRY POINTS:
+-------------------
+
++ bjt_dc_voltage_divider_batch()
++ bjt_ac_voltage_divider_batch()
++ bjt_analyze_fixed_bias_batch()
++ bjt_analyze_emitter_bias_batch()
++ bjt_analyze_voltage_divider_batch()
++ bjt_analyze_collector_feedback_batch()
++ bjt_analyze_emitter_follower_batch()
++ bjt_analyze_common_base_batch()
+
+TEXT FORMATTING:
+----------------
+
++ bjt_format_dc_results()
++ bjt_format_ac_results()
++ bjt_format_two_port_results()
++ bjt_format_cascaded_results()
++ bjt_stage_name()
+
+UNIFORM DESCRIPTIONS:
+---------------------
+
++ bjt_configurations[] (see Configuration.h)
 */
 
+#ifndef BJT_H
+#define BJT_H
+
 // Libraries:
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include "Batch.h"
+#include "Configuration.h"
+#include "Format.h"
 
 // General constants:
 #define Vbe 0.7
-#define MAX_TRANS 32
+#define VCE_SAT Vbe // highest Vce of saturated BJTs (Vbc >= 0)
+#define MAX_TRANS 32 // stages of 'bjt_cascaded_system()'
+#define STAGE_NAME 24 // enough bytes for any stage name ("Av" + digits)
 
 // User-defined string type:
 typedef char * string;
 
 // Result of DC analysis:
-struct DCResults {
+struct BJT_DCResults {
    double Ib; // base current
    double Ic; // collector current
    double Ie; // emitter current
@@ -65,7 +113,7 @@ struct DCResults {
 };
 
 // Results of AC analysis:
-struct ACResults {
+struct BJT_ACResults {
    double re; // re factor
    double Zi;  // input impedance
    double Zo; // output impedance
@@ -74,49 +122,133 @@ struct ACResults {
 };
 
 // Results of Two Port System:
-struct TwoPortResults {
+struct BJT_TwoPortResults {
    double Avl; // load-voltage gain
    double Avs; // source-voltage gain
    double Ail; // load-current gain
 };
 
 // Results of Cascaded System:
-struct CascadedResults {
-   char names[MAX_TRANS][MAX_TRANS]; // stage names
-   double voltages[MAX_TRANS]; // stage voltages
+struct BJT_CascadedResults {
+   double voltages[MAX_TRANS]; // stage voltages (see bjt_stage_name())
    double Avt; // total voltage gain
    double Avs; // source voltage gain
    double Ait; // total current gain
 };
 
+// Results of fused DC and AC analysis:
+struct BJT_FusedResults {
+   struct BJT_DCResults dc; // DC analysis
+   struct BJT_ACResults ac; // AC analysis
+};
+
+// Result columns of batch DC analysis:
+struct BJT_DCColumns {
+   double *restrict Ib; // base currents
+   double *restrict Ic; // collector currents
+   double *restrict Ie; // emitter currents
+   double *restrict Icsat; // collector saturation (max) currents
+   double *restrict Vce; // collector-emitter voltages
+   double *restrict Vc; // collector voltages
+   double *restrict Ve; // emitter voltages
+   double *restrict Vb; // base voltages
+   double *restrict Vbc; // base-collector voltages
+};
+
+// Result columns of batch AC analysis:
+struct BJT_ACColumns {
+   double *restrict re; // re factors
+   double *restrict Zi; // input impedances
+   double *restrict Zo; // output impedances
+   double *restrict Av; // voltage gains
+};
+
 // User-defined analysis types:
-typedef struct DCResults DCAnalysis;
-typedef struct ACResults ACAnalysis;
-typedef struct TwoPortResults TwoPortAnalysis;
-typedef struct CascadedResults CascadedAnalysis;
+typedef struct BJT_DCResults BJT_DCAnalysis;
+typedef struct BJT_ACResults BJT_ACAnalysis;
+typedef struct BJT_TwoPortResults BJT_TwoPortAnalysis;
+typedef struct BJT_CascadedResults BJT_CascadedAnalysis;
+typedef struct BJT_FusedResults BJT_FusedAnalysis;
+typedef struct BJT_DCColumns BJT_DCBatch;
+typedef struct BJT_ACColumns BJT_ACBatch;
 
 /* --------------------------------------------------------------- */
 /* ---------------------- Helper Definations --------------------- */
 /* --------------------------------------------------------------- */
 
 /* Get the Rth of both 'R1' and 'R2' resistors. */
-double _Rth_(double R1, double R2) {
+static inline double _Rth_(double R1, double R2) {
    // Rth is necesarry for voltage divider config.
    return 1 / (1 / R1 + 1 / R2); 
 }
 
 /* Get the Eth of both 'R1' and 'R2' resistors. */
-double _Eth_(double Vcc, double R1, double R2) {
+static inline double _Eth_(double Vcc, double R1, double R2) {
    // Eth is necesarry for voltage divider config.
    return Vcc * (R2 / (R1 + R2));
 }
 
+/* AC analysis of common-emitter configurations with bypassed (or
+without) emitter resistor at the operating point of 're'. 'Rb' is
+the total base resistance (Rth of voltage-divider). */
+static inline BJT_ACAnalysis _bjt_ac_bypassed_(double re, double Rb, 
+      double Rc, double beta, double ro) {
+   BJT_ACAnalysis analysis;
+   analysis.re = re; 
+   analysis.Zi = _Rth_(Rb, (beta * analysis.re)); 
+   analysis.Zo = _Rth_(Rc, ro); 
+   analysis.Av = -1 * _Rth_(Rc, ro) / analysis.re;
+   analysis.phase = "Out of phase";
+   return analysis;
+}
+
+/* AC analysis of common-emitter configurations with unbypassed 
+emitter resistor at the operating point of 're'. */
+static inline BJT_ACAnalysis _bjt_ac_unbypassed_(double re, double Rb, 
+      double Rc, double Re, double beta, double ro) {
+   BJT_ACAnalysis analysis;
+   analysis.re = re; 
+   double Zb1 = (beta + 1) + (Rc/ro);
+   double Zb2 = 1 + (Rc + Re) / ro;
+   double Zb = beta * analysis.re + (Zb1 / Zb2) * Re;
+   analysis.Zi = _Rth_(Rb, Zb);
+   double Zo1 = beta * (ro + analysis.re);
+   double Zo2 = 1 + (beta * analysis.re) / Re;
+   double Zo3 = ro + Zo1 / Zo2;
+   analysis.Zo = _Rth_(Rc, Zo3);
+   double Av1 = (-1 * (beta * Rc) / Zb) * 
+                (1 + (analysis.re / ro)) + (Rc/ro);
+   double Av2 = 1 + (Rc / ro);
+   analysis.Av = Av1 / Av2; 
+   analysis.phase = "Out of phase";
+   return analysis;
+}
+
+/* AC analysis of collector-feedback configuration at the operating
+point of 're'. */
+static inline BJT_ACAnalysis _bjt_ac_feedback_(double re, double Rf, 
+      double Rc, double beta, double ro) {
+   BJT_ACAnalysis analysis;
+   analysis.re = re; 
+   double Zi1 = 1 + (_Rth_(Rc, ro) / Rf);
+   double Zi2 = (1 / (beta * analysis.re)) + (1 / Rf);
+   double Zi3 = _Rth_(Rc, ro) / (beta * analysis.re * Rf);
+   double Zi4 = _Rth_(Rc, ro) / (Rf * analysis.re);
+   analysis.Zi = Zi1 / (Zi2 + Zi3 + Zi4); 
+   analysis.Zo = 1 / (1/ro + 1/Rc + 1/Rf); 
+   double Av1 = Rf / (_Rth_(Rc, ro) + Rf);
+   double Av2 = _Rth_(Rc, ro) / analysis.re;
+   analysis.Av = -1 * Av1 * Av2; 
+   analysis.phase = "Out of phase";
+   return analysis;
+}
+
 /* --------------------------------------------------------------- */
 /* ------------------------- Display Results --------------------- */
 /* --------------------------------------------------------------- */
 
 /* Display the DC results of any transistor. */
-void display_dc_results(DCAnalysis analysis) {
+static inline void bjt_display_dc_results(BJT_DCAnalysis analysis) {
    // Display the DC analysis results.
    printf("Ib: %e A\n", analysis.Ib);
    printf("Ic: %e A\n", analysis.Ic);
@@ -131,7 +263,7 @@ void display_dc_results(DCAnalysis analysis) {
 }
 
 /* Display the AC results of any transistor. */
-void display_ac_results(ACAnalysis analysis) {
+static inline void bjt_display_ac_results(BJT_ACAnalysis analysis) {
    // Display the DC analysis results.
    printf("re: %f ohm\n", analysis.re);
    printf("Zi: %f ohm\n", analysis.Zi);
@@ -141,13 +273,100 @@ void display_ac_results(ACAnalysis analysis) {
 } 
 
 /* Display the two port system results. */
-void display_two_port_results(TwoPortAnalysis analysis) {
+static inline void bjt_display_two_port_results(
+      BJT_TwoPortAnalysis analysis) {
    // Display the results of two port systems.
    printf("Avl: %f\n", analysis.Avl);
    printf("Avs: %f\n", analysis.Avs);
    printf("Ail: %f\n", analysis.Ail);
 }
 
+/* Format the DC results as fields of the current text row (see
+Format.h). Like the other formatters, it can be combined with them
+in one row and it writes field names after text_begin_header().
+
+struct TextBuffer *text = text_buffer();
+text_begin_header(text);
+bjt_format_dc_results(text, analysis);
+text_end_row(text);
+bjt_format_dc_results(text, analysis);
+text_end_row(text);
+text_flush(text);
+
+Ib,Ic,Ie,Icsat,Vce,Vc,Ve,Vb,Vbc
+4.708333333333334e-05,0.002354166666666667,0.00240125,...
+*/
+static inline void bjt_format_dc_results(struct TextBuffer *text,
+                                         BJT_DCAnalysis analysis) {
+   // Format the DC analysis results.
+   text_double(text, "Ib", analysis.Ib);
+   text_double(text, "Ic", analysis.Ic);
+   text_double(text, "Ie", analysis.Ie);
+   text_double(text, "Icsat", analysis.Icsat);
+   text_double(text, "Vce", analysis.Vce);
+   text_double(text, "Vc", analysis.Vc);
+   text_double(text, "Ve", analysis.Ve);
+   text_double(text, "Vb", analysis.Vb);
+   text_double(text, "Vbc", analysis.Vbc);
+}
+
+/* Format the AC results as fields of the current text row. */
+static inline void bjt_format_ac_results(struct TextBuffer *text,
+                                         BJT_ACAnalysis analysis) {
+   // Format the AC analysis results.
+   text_double(text, "re", analysis.re);
+   text_double(text, "Zi", analysis.Zi);
+   text_double(text, "Zo", analysis.Zo);
+   text_double(text, "Av", analysis.Av);
+   text_string(text, "phase", analysis.phase);
+}
+
+/* Format the two port system results as fields of the current text
+row. */
+static inline void bjt_format_two_port_results(struct TextBuffer *text,
+      BJT_TwoPortAnalysis analysis) {
+   // Format the results of two port systems.
+   text_double(text, "Avl", analysis.Avl);
+   text_double(text, "Avs", analysis.Avs);
+   text_double(text, "Ail", analysis.Ail);
+}
+
+/* Write the name of the i'th (from 0) stage gain of a cascaded system
+("Av1", "Av2", ...) and return its length. Names aren't stored in
+results, they are written only when they are needed.
+
+char name[STAGE_NAME];
+bjt_stage_name(name, 11); // "Av12"
+*/
+static inline int bjt_stage_name(char *name, size_t i) {
+   char digits[STAGE_NAME];
+   int count = 0, length = 0;
+   // Write the digits of the stage number in reverse.
+   for (size_t stage = i + 1; stage > 0; stage /= 10)
+      digits[count++] = '0' + stage % 10;
+   name[length++] = 'A'; name[length++] = 'v';
+   while (count > 0) name[length++] = digits[--count];
+   name[length] = '\0';
+   return length;
+}
+
+/* Format the 'num' stages cascaded system results as fields of the
+current text row. */
+static inline void bjt_format_cascaded_results(struct TextBuffer *text,
+      size_t num, BJT_CascadedAnalysis analysis) {
+   // Check if the count of stages is consistent.
+   assert (num > 0 && num <= MAX_TRANS);
+   char name[STAGE_NAME];
+   // Format the stage gains, then the total gains.
+   for (size_t i=0; i<num; i++) {
+      bjt_stage_name(name, i);
+      text_double(text, name, analysis.voltages[i]);
+   }
+   text_double(text, "Avt", analysis.Avt);
+   text_double(text, "Avs", analysis.Avs);
+   text_double(text, "Ait", analysis.Ait);
+}
+
 /* --------------------------------------------------------------- */
 /* ------------------------ Main Definations --------------------- */
 /* --------------------------------------------------------------- */
@@ -155,8 +374,8 @@ void display_two_port_results(TwoPortAnalysis analysis) {
 /* DC analysis of fixed-bias transistor configuration. 
 
 double Vcc=12, Rb=240000, Rc=2200, beta=50;
-DCAnaysis analysis = dc_fixed_bias(Vcc, Rb, Rc, beta);
-display_dc_results(analysis);
+BJT_DCAnalysis analysis = bjt_dc_fixed_bias(Vcc, Rb, Rc, beta);
+bjt_display_dc_results(analysis);
 
 Ib: 4.708333e-05 A 
 Ic: 2.354167e-03 A
@@ -169,12 +388,12 @@ Vb: 0.700000 V
 Vbc: -6.120833 V
 Vbe: 0.700000 V
 */
-DCAnalysis dc_fixed_bias(double Vcc, double Rb, double Rc, 
-                         double beta) {
+static inline BJT_DCAnalysis bjt_dc_fixed_bias(double Vcc, double Rb, 
+      double Rc, double beta) {
    // Check if parameters of transistor are consistent.
    assert (Rb > 0 && Rc > 0 && beta > 0);
    // Create DC analysis object.
-   DCAnalysis analysis;
+   BJT_DCAnalysis analysis;
    // Calculate the all analyzes of transistor.
    analysis.Ib = (Vcc - Vbe) / Rb; 
    analysis.Ie = (beta + 1) * analysis.Ib; 
@@ -192,8 +411,8 @@ DCAnalysis dc_fixed_bias(double Vcc, double Rb, double Rc,
 /* AC analysis of fixed-bias transistor configuration. 
 
 double Vcc=12, Rb=470000, Rc=3000, beta=100, ro=50000;
-ACAnalysis analysis = ac_fixed_bias(Vcc, Rb, Rc, beta, ro);
-display_ac_results(analysis);
+BJT_ACAnalysis analysis = bjt_ac_fixed_bias(Vcc, Rb, Rc, beta, ro);
+bjt_display_ac_results(analysis);
 
 re: 10.707088 ohm
 Zi: 1068.275199 ohm
@@ -201,12 +420,12 @@ Zo: 2830.188679 ohm
 Av: -264.328506
 phase: Out of phase
 */
-ACAnalysis ac_fixed_bias(double Vcc, double Rb, double Rc, 
-                         double beta, double ro) {
+static inline BJT_ACAnalysis bjt_ac_fixed_bias(double Vcc, double Rb, 
+      double Rc, double beta, double ro) {
    // Check if parameters of transistor are consistent.
    assert(Rb > 0 && Rc > 0 && beta > 0 && ro > 0);
    // Create AC analysis object.
-   ACAnalysis analysis;
+   BJT_ACAnalysis analysis;
    // Calculate the all analyzes of transistor.
    double Ib = (Vcc - Vbe) / Rb; 
    double Ie = (beta + 1) * Ib; 
@@ -222,8 +441,8 @@ ACAnalysis ac_fixed_bias(double Vcc, double Rb, double Rc,
 /* DC analysis of emitter-bias transistor configuration. 
 
 double Vcc=20, Rb=430000, Rc=2000, Re=1000, beta=50;
-DCAnalysis analysis = dc_emitter_bias(Vcc, Rb, Rc, Re, beta);
-display_dc_results(analysis);
+BJT_DCAnalysis analysis = bjt_dc_emitter_bias(Vcc, Rb, Rc, Re, beta);
+bjt_display_dc_results(analysis);
 
 Ib: 4.012474e-05 A
 Ic: 2.006237e-03 A
@@ -236,12 +455,12 @@ Vb: 2.746362 V
 Vbc: -13.281289 V
 Vbe: 0.700000 V
 */
-DCAnalysis dc_emitter_bias(double Vcc, double Rb, double Rc, 
-                           double Re, double beta) {
+static inline BJT_DCAnalysis bjt_dc_emitter_bias(double Vcc, double Rb, 
+      double Rc, double Re, double beta) {
    // Check if parameters of transistor are consistent.
    assert (Rb > 0 && Rc > 0 && Re > 0 && beta > 0);
    // Create DC analysis object.
-   DCAnalysis analysis;
+   BJT_DCAnalysis analysis;
    // Calculate the all analyzes of transistor.  
    analysis.Ib = (Vcc - Vbe) / (Rb + (beta + 1) * Re); 
    analysis.Ie = (beta + 1) * analysis.Ib;
@@ -259,8 +478,9 @@ DCAnalysis dc_emitter_bias(double Vcc, double Rb, double Rc,
 /* AC analysis of emitter-bias transistor configuration. 
 
 double Vcc=20, Rb=470000, Rc=2200, Re=560, beta=120, ro=40000;
-ACAnalysis analysis = ac_emitter_bias(Vcc, Rb, Rc, Re, beta, ro);
-display_ac_results(analysis);
+BJT_ACAnalysis analysis = bjt_ac_emitter_bias(Vcc, Rb, Rc, Re, beta, 
+      ro);
+bjt_display_ac_results(analysis);
 
 re: 5.987137 ohm
 Zi: 56433.065511 ohm
@@ -268,12 +488,12 @@ Zo: 2197.743643 ohm
 Av: -3.850258
 phase: Out of phase
 */
-ACAnalysis ac_emitter_bias(double Vcc, double Rb, double Rc, 
-                           double Re, double beta, double ro) {
+static inline BJT_ACAnalysis bjt_ac_emitter_bias(double Vcc, double Rb, 
+      double Rc, double Re, double beta, double ro) {
    // Check if parameters of transistor are consistent.
    assert (Rb > 0 && Rc > 0 && Re > 0 && beta > 0 && ro > 0);
    // Create AC analysis object.
-   ACAnalysis analysis;
+   BJT_ACAnalysis analysis;
    // Calculate the all analyzes of transistor.
    double Ib = (Vcc - Vbe) / (Rb + (beta + 1) * Re);
    double Ie = (beta + 1) * Ib; 
@@ -298,9 +518,9 @@ ACAnalysis ac_emitter_bias(double Vcc, double Rb, double Rc,
 /* DC analysis of voltage-divider transisfor configuration. 
 
 double Vcc=22, Rb1=39000, Rb2=3900, Rc=10000, Re=1500, beta=100;
-DCAnalysis analysis = dc_voltage_divider(Vcc, Rb1, Rb2, 
-                                         Rc, Re, beta);
-display_dc_results(analysis);
+BJT_DCAnalysis analysis = bjt_dc_voltage_divider(Vcc, Rb1, Rb2, Rc, Re, 
+      beta);
+bjt_display_dc_results(analysis);
 
 Ib: 8.384638e-06 A
 Ic: 8.384638e-04 A
@@ -313,12 +533,12 @@ Vb: 1.970273 V
 Vbc: -11.657666 V
 Vbe: 0.700000 V
 */
-DCAnalysis dc_voltage_divider(double Vcc, double Rb1, double Rb2, 
-                              double Rc, double Re, double beta) {
+static inline BJT_DCAnalysis bjt_dc_voltage_divider(double Vcc, 
+      double Rb1, double Rb2, double Rc, double Re, double beta) {
    // Check if parameters of transistor are consistent.
    assert (Rb1 > 0 && Rb2 > 0 && Rc > 0 && Re > 0 && beta > 0);
    // Create DC analysis object.
-   DCAnalysis analysis;
+   BJT_DCAnalysis analysis;
    // Calculate the all analyzes of transistor.
    double rth = _Rth_(Rb1, Rb2); 
    double eth = _Eth_(Vcc, Rb1, Rb2); 
@@ -340,9 +560,9 @@ DCAnalysis dc_voltage_divider(double Vcc, double Rb1, double Rb2,
 double Vcc=16, Rb1=90000, Rb2=10000, Rc=2200;
 double Re=680, beta=210, ro=50000; 
 string bypass = "bypassed";
-ACAnalysis analysis = ac_voltage_divider(Vcc, Rb1, Rb2, Rc, 
-                                         Re, beta, ro, bypass);
-display_ac_results(analysis);
+BJT_ACAnalysis analysis = bjt_ac_voltage_divider(Vcc, Rb1, Rb2, Rc, Re, 
+      beta, ro, bypass);
+bjt_display_ac_results(analysis);
 
 re: 20.876672 ohm
 Zi: 2948.043327 ohm
@@ -353,21 +573,23 @@ phase: Out of phase
 double Vcc=16, Rb1=90000, Rb2=10000, Rc=2200;
 double Re=680, beta=210, ro=50000; 
 string bypass = "unbypassed";
-ACAnalysis analysis = ac_voltage_divider(Vcc, Rb1, Rb2, Rc, 
-                                         Re, beta, ro, bypass);
-display_ac_results(analysis);
+BJT_ACAnalysis analysis = bjt_ac_voltage_divider(Vcc, Rb1, Rb2, Rc, Re, 
+      beta, ro, bypass);
+bjt_display_ac_results(analysis);
 
 re: 20.876672 ohm
-Zi: 8456.660156 ohm
-Zo: 2196.691162 ohm
+Zi: 8456.660453 ohm
+Zo: 2196.691081 ohm
 Av: -3.118332
 phase: Out of phase
 */
-ACAnalysis ac_voltage_divider(double Vcc, double Rb1, double Rb2, 
-   double Rc, double Re, double beta, double ro, string bypass) {
+static inline BJT_ACAnalysis bjt_ac_voltage_divider(double Vcc, 
+      double Rb1, double Rb2, double Rc, double Re, double beta, 
+      double ro, string bypass) {
    // Check if parameters of transistor are consistent.
    assert (Rb1 > 0 && Rb2 > 0 && Rc > 0 && Re > 0 && beta > 0);
-   assert (bypass == "bypassed" || bypass == "unbypassed");
+   assert (strcmp(bypass, "bypassed") == 0 || 
+           strcmp(bypass, "unbypassed") == 0);
 
    // Indicate the all variables.
    double Zb1, Zb2, Zb, Zi, Zo1, Zo2, Zo3, Zo, Av1, Av2, Av;
@@ -377,16 +599,16 @@ ACAnalysis ac_voltage_divider(double Vcc, double Rb1, double Rb2,
    double Ib = (eth - Vbe) / (rth +(beta + 1) * Re); 
    double Ie = (beta + 1) * Ib;
    // Create AC analysis object.
-   ACAnalysis analysis; 
+   BJT_ACAnalysis analysis; 
 
    analysis.re = 0.026 / Ie; 
    // According to 'bypass' parameter, there are two options.
-   if (bypass = "bypassed") {
+   if (strcmp(bypass, "bypassed") == 0) {
       analysis.Zi = _Rth_(rth, (beta * analysis.re));
       analysis.Zo = _Rth_(Rc, ro);
       analysis.Av = -1 * _Rth_(Rc, ro) / analysis.re; 
    } 
-   if (bypass == "unbypassed") {
+   if (strcmp(bypass, "unbypassed") == 0) {
       Zb1 = (beta + 1) + (Rc/ro);
       Zb2 = 1 + (Rc + Re) / ro;
       Zb = beta * analysis.re + (Zb1 / Zb2) * Re;
@@ -408,8 +630,9 @@ ACAnalysis ac_voltage_divider(double Vcc, double Rb1, double Rb2,
 /* DC analysis of collector-feedback transistor configuration. 
 
 double Vcc=10, Rf=250000, Rc=4700, Re=1200, beta=90;
-DCAnalysis analysis = dc_collector_feedback(Vcc, Rf, Rc, Re, beta);
-display_dc_results(analysis);
+BJT_DCAnalysis analysis = bjt_dc_collector_feedback(Vcc, Rf, Rc, Re, 
+      beta);
+bjt_display_dc_results(analysis);
 
 Ib: 1.190781e-05 A
 Ic: 1.071703e-03 A
@@ -422,12 +645,12 @@ Vb: 2.000333 V
 Vbc: -2.976953 V
 Vbe: 0.700000 V
 */
-DCAnalysis dc_collector_feedback(double Vcc, double Rf, double Rc, 
-                                 double Re, double beta) {  
+static inline BJT_DCAnalysis bjt_dc_collector_feedback(double Vcc, 
+      double Rf, double Rc, double Re, double beta) {
    // Check if parameters of transistor are consistent.
    assert (Rf > 0 && Rc > 0 && Re > 0 && beta > 0);
    // Create DC analysis object.
-   DCAnalysis analysis;
+   BJT_DCAnalysis analysis;
    // Calculate the all analyzes of transistor.
    analysis.Ib = (Vcc - Vbe) / (Rf + beta * (Rc+Re)); 
    analysis.Ie = (beta + 1) * analysis.Ib; 
@@ -445,21 +668,22 @@ DCAnalysis dc_collector_feedback(double Vcc, double Rf, double Rc,
 /* AC analysis of collector-feedback transistor configuration. 
 
 double Vcc=9, Rf=180000, Rc=2700, beta=200, ro=1e+6;
-ACAnalysis analysis = ac_collector_feedback(Vcc, Rf, Rc, beta, ro);
-display_ac_results(analysis);
+BJT_ACAnalysis analysis = bjt_ac_collector_feedback(Vcc, Rf, Rc, beta, 
+      ro);
+bjt_display_ac_results(analysis);
 
 re: 11.221003 ohm
-Zi: 565.582214 ohm
-Zo: 2660.097900 ohm
-Av: -237.064163
+Zi: 566.701954 ohm
+Zo: 2653.041171 ohm
+Av: -236.435288
 phase: Out of phase
 */
-ACAnalysis ac_collector_feedback(double Vcc, double Rf, double Rc, 
-                                 double beta, double ro) {
+static inline BJT_ACAnalysis bjt_ac_collector_feedback(double Vcc, 
+      double Rf, double Rc, double beta, double ro) {
    // Check if parameters of transistor are consistent.
    assert (Rf > 0 && Rc > 0 && beta > 0 && ro > 0);
    // Create AC analysis object.
-   ACAnalysis analysis; 
+   BJT_ACAnalysis analysis; 
    // Calculate the all analyzes of transistor.
    double Ib = (Vcc - Vbe) / (Rf + beta * Rc); 
    double Ie = (beta + 1) * Ib; 
@@ -481,22 +705,22 @@ ACAnalysis ac_collector_feedback(double Vcc, double Rf, double Rc,
 /* AC analysis of collector-dc-feedback transistor configuration. 
 
 double Vcc=12, Rf1=120000, Rf2=68000, Rc=3000, beta=140, ro=30000;
-ACAnalysis analysis = ac_collector_dc_feedback(Vcc, Rf1, Rf2, 
-                                               Rc, beta, ro);
-display_ac_results(analysis);
-
-re: 9.921547 ohm
-Zi: 1373.122437 ohm
-Zo: 2622.107910 ohm
-Av: -264.284210
+BJT_ACAnalysis analysis = bjt_ac_collector_dc_feedback(Vcc, Rf1, Rf2, 
+      Rc, beta, ro);
+bjt_display_ac_results(analysis);
+
+re: 9.921546 ohm
+Zi: 1373.122426 ohm
+Zo: 2622.107969 ohm
+Av: -264.284200
 phase: Out of phase
 */
-ACAnalysis ac_collector_dc_feedback(double Vcc, double Rf1, 
-               double Rf2, double Rc, double beta, double ro) {
+static inline BJT_ACAnalysis bjt_ac_collector_dc_feedback(double Vcc, 
+      double Rf1, double Rf2, double Rc, double beta, double ro) {
    // Check if the parameters of transistor are consistent.
    assert (Rf1 > 0 && Rf2 > 0 && Rc > 0 && beta > 0 && ro > 0);
    // Create AC analysis object.
-   ACAnalysis analysis; 
+   BJT_ACAnalysis analysis; 
    // Calculate the all analyzes of transistor.
    double Ib = (Vcc - Vbe) / (Rf1+Rf2 + (beta * Rc));
    double Ie = (beta + 1) * Ib; 
@@ -512,8 +736,8 @@ ACAnalysis ac_collector_dc_feedback(double Vcc, double Rf1,
 /* DC analysis of emitter-follower transisfor configuration. 
 
 double Vee=20, Rb=240000, Re=2000, beta=90;
-DCAnalysis analysis = dc_emitter_follower(Vee, Rb, Re, beta);
-display_dc_results(analysis);
+BJT_DCAnalysis analysis = bjt_dc_emitter_follower(Vee, Rb, Re, beta);
+bjt_display_dc_results(analysis);
 
 Ib: 4.573460e-05 A
 Ic: 4.116114e-03 A
@@ -526,12 +750,12 @@ Vb: 29.023697 V
 Vbc: -10.976303 V
 Vbe: 0.700000 V
 */
-DCAnalysis dc_emitter_follower(double Vee, double Rb, double Re, 
-                               double beta) {
+static inline BJT_DCAnalysis bjt_dc_emitter_follower(double Vee, 
+      double Rb, double Re, double beta) {
    // Check if the parameters of transistor are consistent.
    assert (Rb > 0 && Re > 0 && beta > 0);
    // Create DC analysis object.
-   DCAnalysis analysis; 
+   BJT_DCAnalysis analysis; 
    // Calculate the all analyzes of transistor.
    analysis.Ib = (Vee - Vbe) / (Rb + (beta + 1) * Re);
    analysis.Ie = (beta + 1) * analysis.Ib;
@@ -549,8 +773,9 @@ DCAnalysis dc_emitter_follower(double Vee, double Rb, double Re,
 /* AC analysis of emitter-follower transistor configuration. 
 
 double Vcc=12, Rb=220000, Re=3300, beta=100, ro=1e+6;
-ACAnalysis analysis = ac_emitter_follower(Vcc, Rb, Re, beta, ro);
-display_ac_results(analysis);
+BJT_ACAnalysis analysis = bjt_ac_emitter_follower(Vcc, Rb, Re, beta, 
+      ro);
+bjt_display_ac_results(analysis);
 
 re: 12.604749 ohm
 Zi: 132550.803154 ohm
@@ -558,12 +783,12 @@ Zo: 12.432776 ohm
 Av: 0.996220
 phase: In phase
 */
-ACAnalysis ac_emitter_follower(double Vcc, double Rb, double Re, 
-                               double beta, double ro) {
+static inline BJT_ACAnalysis bjt_ac_emitter_follower(double Vcc, 
+      double Rb, double Re, double beta, double ro) {
    // Check if the parameters of transistor are consistent.
    assert (Rb > 0 && Re > 0 && beta > 0 && ro > 0);
    // Create AC analysis object.
-   ACAnalysis analysis; 
+   BJT_ACAnalysis analysis; 
    // Calculate the all analyzes of transistor.
    double Ib = (Vcc - Vbe) / (Rb + (beta + 1) * Re);
    double Ie = (beta + 1) * Ib; 
@@ -584,8 +809,8 @@ ACAnalysis ac_emitter_follower(double Vcc, double Rb, double Re,
 /* DC analysis of common-base transisfor configuration. 
 
 double Vcc=10, Vee=4, Rc=2400, Re=1200, beta=60;
-DCAnalysis analysis = dc_common_base(Vcc, Vee, Rc, Re, beta);
-display_dc_results(analysis);
+BJT_DCAnalysis analysis = bjt_dc_common_base(Vcc, Vee, Rc, Re, beta);
+bjt_display_dc_results(analysis);
 
 Ib: 4.508197e-05 A
 Ic: 2.704918e-03 A
@@ -598,12 +823,12 @@ Vb: -1.000000 V (not calculated)
 Vbc: -3.508196 V
 Vbe: 0.700000 V
 */
-DCAnalysis dc_common_base(double Vcc, double Vee, double Rc, 
-                          double Re, double beta) {
+static inline BJT_DCAnalysis bjt_dc_common_base(double Vcc, double Vee, 
+      double Rc, double Re, double beta) {
    // Check if the parameters of transistor are consistent.
    assert (Rc > 0 && Re > 0 && beta > 0);
    // Create DC analysis object.
-   DCAnalysis analysis; 
+   BJT_DCAnalysis analysis; 
    // Calculate the all analyzes of transistor.
    analysis.Ie = (Vee - Vbe) / Re; 
    analysis.Ib = analysis.Ie / (beta + 1); 
@@ -622,8 +847,8 @@ DCAnalysis dc_common_base(double Vcc, double Vee, double Rc,
 /* AC analysis of common-base transistor configuration. 
 
 double Vcc=8, Vee=2, Rc=5000, Re=1000, alpha=0.98;
-ACAnalysis analysis = ac_common_base(Vcc, Vee, Rc, Re, alpha);
-display_ac_results(analysis);
+BJT_ACAnalysis analysis = bjt_ac_common_base(Vcc, Vee, Rc, Re, alpha);
+bjt_display_ac_results(analysis);
 
 re: 20.000000 ohm
 Zi: 19.607843 ohm
@@ -631,12 +856,12 @@ Zo: 5000.000000 ohm
 Av: 245.000000
 phase: In phase
 */
-ACAnalysis ac_common_base(double Vcc, double Vee, double Rc, 
-                          double Re, double alpha) {
+static inline BJT_ACAnalysis bjt_ac_common_base(double Vcc, double Vee, 
+      double Rc, double Re, double alpha) {
    // Check if the parameters of transistor are consistent.
    assert (Rc > 0 && Re > 0 && alpha > 0);
    // Create AC analysis object.
-   ACAnalysis analysis; 
+   BJT_ACAnalysis analysis; 
    // Calculate the all analyzes of transistor.
    double Ie = (Vee - Vbe) / Re; 
    analysis.re = 0.026 / Ie; 
@@ -651,8 +876,8 @@ ACAnalysis ac_common_base(double Vcc, double Vee, double Rc,
 /* DC analysis of miscellaneous-bias transisfor configuration. 
 
 double Vcc=20, Rb=680000, Rc=4700, beta=120;
-DCAnalysis analysis = dc_miscellaneous_bias(Vcc, Rb, Rc, beta);
-display_dc_results(analysis);
+BJT_DCAnalysis analysis = bjt_dc_miscellaneous_bias(Vcc, Rb, Rc, beta);
+bjt_display_dc_results(analysis);
 
 Ib: 1.551447e-05 A
 Ic: 1.861736e-03 A
@@ -665,12 +890,12 @@ Vb: 0.700000 V
 Vbc: -10.476921 V
 Vbe: 0.700000 V
 */
-DCAnalysis dc_miscellaneous_bias(double Vcc, double Rb, double Rc, 
-                                 double beta) {
+static inline BJT_DCAnalysis bjt_dc_miscellaneous_bias(double Vcc, 
+      double Rb, double Rc, double beta) {
    // Check if the parameters of transistor are consistent.
    assert (Rb > 0 && Rc > 0 && beta > 0);
    // Create DC analysis object.
-   DCAnalysis analysis; 
+   BJT_DCAnalysis analysis; 
    // Calculate the all analyzes of transistor.
    analysis.Ib = (Vcc - Vbe) / (Rb + beta * Rc); 
    analysis.Ic = beta * analysis.Ib; 
@@ -688,19 +913,20 @@ DCAnalysis dc_miscellaneous_bias(double Vcc, double Rb, double Rc,
 /* Two Port System Analysis 
 
 double Avnl=-480, Zi=4000, Zo=2000, Rs=200, Rl=5600;
-TwoPortAnalysis analysis = two_port_system(Avnl, Zi, Zo, Rs, Rl);
-display_two_port_results(analysis);
+BJT_TwoPortAnalysis analysis = bjt_two_port_system(Avnl, Zi, Zo, Rs, 
+      Rl);
+bjt_display_two_port_results(analysis);
 
-Avl: -353.684204    // load-voltage gain
-Avs: -336.842102    // source-voltage gain
-Ail: 252.631577     // load-current gain
+Avl: -353.684211    // load-voltage gain
+Avs: -336.842105    // source-voltage gain
+Ail: 252.631579     // load-current gain
 */
-TwoPortAnalysis two_port_system(double Avnl, double Zi, double Zo, 
-                                double Rs, double Rl) {
+static inline BJT_TwoPortAnalysis bjt_two_port_system(double Avnl, 
+      double Zi, double Zo, double Rs, double Rl) {
    // Check if the parameters of two port system are consistent.
    assert (Zi > 0 && Zo > 0 && Rs > 0 && Rl > 0);
    // Create two port system object.
-   TwoPortAnalysis analysis; 
+   BJT_TwoPortAnalysis analysis; 
    // Calculate the all analyzes of two port system.
    analysis.Avl = Rl / (Rl + Zo) * Avnl; 
    analysis.Avs = Zi / (Zi + Rs) * analysis.Avl; 
@@ -709,16 +935,25 @@ TwoPortAnalysis two_port_system(double Avnl, double Zi, double Zo,
    return analysis;
 }
 
+/* Get the loaded voltage gain of a cascaded stage. */
+static inline double _bjt_stage_gain_(double Avnl, double Zo,
+                                      double load) {
+   // The next stage (or the load) divides the output voltage.
+   return load / (load + Zo) * Avnl;
+}
+
 /* Cascaded System Analysis 
 
 double Avnls[3] = {1, 250, 100}; // not-load voltage gains
 double Zis[3] = {500, 26, 100}; // input impedances
 double Zos[3] = {1000, 5100, 100}; // output impedances
 double Rs = 10000, Rl = 820; // source and load resistances
-CascadedAnalysis analysis = cascaded_system(3, Avnls, Zis, 
-                                            Zos, Rs, Rl); 
+BJT_CascadedAnalysis analysis = bjt_cascaded_system(3, Avnls, Zis, Zos, 
+      Rs, Rl);
 
-(You can display the each result manually.)
+(You can display the each result manually, stage names are written
+by bjt_stage_name(). For longer chains and stage updates, see
+Cascade.h.)
 Av1: 0.025341
 Av2: 4.807692
 Av3: 89.130435
@@ -726,49 +961,630 @@ Avt: 10.858971
 Avs: 0.517094
 Ait: -6.621324
 */
-CascadedAnalysis cascaded_system(size_t num, double Avnls[num], 
-      double Zis[num], double Zos[num], double Rs, double Rl){
+static inline BJT_CascadedAnalysis bjt_cascaded_system(size_t num, 
+      double Avnls[num], double Zis[num], double Zos[num], double Rs, 
+      double Rl){
    // Check if the parameters of cascaded system are consistent.
-   for (int i=0; i<num; i++)
-      assert (Zis[i] > 0 && Zos[i] > 0 && Rs > 0 && Rl > 0);
+   assert (num > 0 && num <= MAX_TRANS && Rs > 0 && Rl > 0);
+   for (size_t i=0; i<num; i++)
+      assert (Zis[i] > 0 && Zos[i] > 0);
    // Create cascaded system object.
-   CascadedAnalysis analysis; 
+   BJT_CascadedAnalysis analysis; 
    // Declare the voltage variables.
-   double tvoltage = 1, Av;
-   // Declare the stage names.
-   char iname[MAX_TRANS], vname[MAX_TRANS] = "Av";
-
-   // Calculate the all analyzes of cascaded system.
-   for (int i=0; i<num; i++) {
-
-      if (i != num - 1) {
-         // Calculate the stage voltages and total voltage.
-         Av = Zis[i+1] / (Zis[i+1] + Zos[i]) * Avnls[i];
-         tvoltage *= Av;
-         // Right know, create the stage names.
-         sprintf(iname, "%d", (i + 1)); strcat(vname, iname);
-         // Append the stage voltage names and gain to struct.
-         strcpy(analysis.names[i], vname);
-         analysis.voltages[i] = Av;
+   double tvoltage = 1;
+
+   // Calculate the stage voltages and total voltage. Each stage is
+   // loaded by the next one, the last stage by 'Rl'.
+   for (size_t i=0; i<num; i++) {
+      double load = (i != num - 1) ? Zis[i+1] : Rl;
+      analysis.voltages[i] = _bjt_stage_gain_(Avnls[i], Zos[i], load);
+      tvoltage *= analysis.voltages[i];
+   }
+   // Calculate the other parameters to struct.
+   analysis.Avt = tvoltage;
+   analysis.Avs = Zis[0] / (Zis[0] + Rs) * tvoltage;
+   analysis.Ait = -1 * tvoltage * Zis[0] / Rl;
+
+   return analysis;
+}
+
+/* --------------------------------------------------------------- */
+/* ----------------------- Fused Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Fused DC and AC analysis of fixed-bias transistor configuration.
+
+The operating point is solved only once and the AC analysis uses
+its emitter current. So, it is cheaper than calling both of
+'bjt_dc_fixed_bias()' and 'bjt_ac_fixed_bias()'.
+
+double Vcc=12, Rb=470000, Rc=3000, beta=100, ro=50000;
+BJT_FusedAnalysis analysis = bjt_analyze_fixed_bias(Vcc, Rb, Rc, beta, 
+      ro);
+bjt_display_dc_results(analysis.dc);
+bjt_display_ac_results(analysis.ac);
+
+Ib: 2.404255e-05 A
+Ic: 2.404255e-03 A
+...
+re: 10.707088 ohm
+Zi: 1068.275199 ohm
+Zo: 2830.188679 ohm
+Av: -264.328506
+phase: Out of phase
+*/
+static inline BJT_FusedAnalysis bjt_analyze_fixed_bias(double Vcc, 
+      double Rb, double Rc, double beta, double ro) {
+   // Check if parameters of transistor are consistent.
+   assert (Rb > 0 && Rc > 0 && beta > 0 && ro > 0);
+   // Create fused analysis object.
+   BJT_FusedAnalysis analysis;
+   // Solve the operating point only once.
+   analysis.dc = bjt_dc_fixed_bias(Vcc, Rb, Rc, beta);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac = _bjt_ac_bypassed_(0.026 / analysis.dc.Ie, Rb, Rc, 
+                                   beta, ro);
+
+   return analysis;
+}
+
+/* Fused DC and AC analysis of emitter-bias transistor configuration.
+
+double Vcc=20, Rb=470000, Rc=2200, Re=560, beta=120, ro=40000;
+BJT_FusedAnalysis analysis = bjt_analyze_emitter_bias(Vcc, Rb, Rc, Re, 
+      beta, ro);
+bjt_display_dc_results(analysis.dc);
+bjt_display_ac_results(analysis.ac);
+
+Ib: 3.588962e-05 A
+Ic: 4.306754e-03 A
+...
+re: 5.987137 ohm
+Zi: 56433.065511 ohm
+Zo: 2197.743643 ohm
+Av: -3.850258
+phase: Out of phase
+*/
+static inline BJT_FusedAnalysis bjt_analyze_emitter_bias(double Vcc, 
+      double Rb, double Rc, double Re, double beta, double ro) {
+   // Check if parameters of transistor are consistent.
+   assert (Rb > 0 && Rc > 0 && Re > 0 && beta > 0 && ro > 0);
+   // Create fused analysis object.
+   BJT_FusedAnalysis analysis;
+   // Solve the operating point only once.
+   analysis.dc = bjt_dc_emitter_bias(Vcc, Rb, Rc, Re, beta);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac = _bjt_ac_unbypassed_(0.026 / analysis.dc.Ie, Rb, Rc, 
+                                     Re, beta, ro);
+
+   return analysis;
+}
+
+/* Fused DC and AC analysis of voltage-divider transistor configuration.
+
+double Vcc=16, Rb1=90000, Rb2=10000, Rc=2200;
+double Re=680, beta=210, ro=50000; 
+string bypass = "unbypassed";
+BJT_FusedAnalysis analysis = bjt_analyze_voltage_divider(Vcc, Rb1, Rb2, 
+      Rc, Re, beta, ro, bypass);
+bjt_display_dc_results(analysis.dc);
+bjt_display_ac_results(analysis.ac);
+
+Ib: 5.902413e-06 A
+Ic: 1.239507e-03 A
+...
+re: 20.876672 ohm
+Zi: 8456.660453 ohm
+Zo: 2196.691081 ohm
+Av: -3.118332
+phase: Out of phase
+*/
+static inline BJT_FusedAnalysis bjt_analyze_voltage_divider(double Vcc, 
+      double Rb1, double Rb2, double Rc, double Re, double beta, 
+      double ro, string bypass) {
+   // Check if parameters of transistor are consistent.
+   assert (Rb1 > 0 && Rb2 > 0 && Rc > 0 && Re > 0 && beta > 0 && 
+           ro > 0);
+   assert (strcmp(bypass, "bypassed") == 0 || 
+           strcmp(bypass, "unbypassed") == 0);
+   // Create fused analysis object.
+   BJT_FusedAnalysis analysis;
+   // Solve the operating point only once.
+   analysis.dc = bjt_dc_voltage_divider(Vcc, Rb1, Rb2, Rc, Re, beta);
+   // Calculate the AC analyzes at the same operating point.
+   double rth = _Rth_(Rb1, Rb2); 
+   double re = 0.026 / analysis.dc.Ie; 
+   // According to 'bypass' parameter, there are two options.
+   if (strcmp(bypass, "bypassed") == 0)
+      analysis.ac = _bjt_ac_bypassed_(re, rth, Rc, beta, ro);
+   else analysis.ac = _bjt_ac_unbypassed_(re, rth, Rc, Re, beta, ro);
+
+   return analysis;
+}
+
+/* Fused DC and AC analysis of collector-feedback transistor 
+configuration. In AC domain, 'Re' is assumed as bypassed.
+
+double Vcc=9, Rf=180000, Rc=2700, Re=1200, beta=200, ro=1e+6;
+BJT_FusedAnalysis analysis = bjt_analyze_collector_feedback(Vcc, Rf, 
+      Rc, Re, beta, ro);
+bjt_display_dc_results(analysis.dc);
+bjt_display_ac_results(analysis.ac);
+
+Ib: 8.645833e-06 A
+Ic: 1.729167e-03 A
+...
+re: 14.961338 ohm
+Zi: 754.822135 ohm
+Zo: 2653.041171 ohm
+Av: -177.326466
+phase: Out of phase
+*/
+static inline BJT_FusedAnalysis bjt_analyze_collector_feedback(double Vcc, 
+      double Rf, double Rc, double Re, double beta, double ro) {
+   // Check if parameters of transistor are consistent.
+   assert (Rf > 0 && Rc > 0 && Re > 0 && beta > 0 && ro > 0);
+   // Create fused analysis object.
+   BJT_FusedAnalysis analysis;
+   // Solve the operating point only once.
+   analysis.dc = bjt_dc_collector_feedback(Vcc, Rf, Rc, Re, beta);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac = _bjt_ac_feedback_(0.026 / analysis.dc.Ie, Rf, Rc, 
+                                   beta, ro);
+
+   return analysis;
+}
+
+/* Fused DC and AC analysis of emitter-follower transistor 
+configuration.
+
+double Vee=12, Rb=220000, Re=3300, beta=100, ro=1e+6;
+BJT_FusedAnalysis analysis = bjt_analyze_emitter_follower(Vee, Rb, Re, 
+      beta, ro);
+bjt_display_dc_results(analysis.dc);
+bjt_display_ac_results(analysis.ac);
+
+Ib: 2.042292e-05 A
+Ic: 2.042292e-03 A
+...
+re: 12.604749 ohm
+Zi: 132550.803154 ohm
+Zo: 12.432776 ohm
+Av: 0.996220
+phase: In phase
+*/
+static inline BJT_FusedAnalysis bjt_analyze_emitter_follower(double Vee, 
+      double Rb, double Re, double beta, double ro) {
+   // Check if parameters of transistor are consistent.
+   assert (Rb > 0 && Re > 0 && beta > 0 && ro > 0);
+   // Create fused analysis object.
+   BJT_FusedAnalysis analysis;
+   // Solve the operating point only once.
+   analysis.dc = bjt_dc_emitter_follower(Vee, Rb, Re, beta);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac.re = 0.026 / analysis.dc.Ie; 
+   double Zb1 = (beta + 1) * Re;
+   double Zb2 = 1 + (Re / ro);
+   double Zb = (beta * analysis.ac.re) + (Zb1 / Zb2);
+   analysis.ac.Zi = 1 / (1 /Rb + 1 /Zb); 
+   double Zo1 = (beta * analysis.ac.re) / (beta + 1);
+   analysis.ac.Zo = 1 / (1 /ro + 1 /Re + 1 /Zo1); 
+   double Av1 = (beta + 1) * Re / Zb;
+   analysis.ac.Av = Av1 / (1 + (Re/ro)); 
+   analysis.ac.phase = "In phase";
+
+   return analysis;
+}
+
+/* Fused DC and AC analysis of common-base transistor configuration.
+The 'alpha' factor of AC analysis is found from 'beta'.
+
+double Vcc=8, Vee=2, Rc=5000, Re=1000, beta=49;
+BJT_FusedAnalysis analysis = bjt_analyze_common_base(Vcc, Vee, Rc, Re, 
+      beta);
+bjt_display_dc_results(analysis.dc);
+bjt_display_ac_results(analysis.ac);
+
+Ib: 2.600000e-05 A
+Ic: 1.274000e-03 A
+...
+re: 20.000000 ohm
+Zi: 19.607843 ohm
+Zo: 5000.000000 ohm
+Av: 245.000000
+phase: In phase
+*/
+static inline BJT_FusedAnalysis bjt_analyze_common_base(double Vcc, 
+      double Vee, double Rc, double Re, double beta) {
+   // Check if the parameters of transistor are consistent.
+   assert (Rc > 0 && Re > 0 && beta > 0);
+   // Create fused analysis object.
+   BJT_FusedAnalysis analysis;
+   // Solve the operating point only once.
+   analysis.dc = bjt_dc_common_base(Vcc, Vee, Rc, Re, beta);
+   // Calculate the AC analyzes at the same operating point.
+   double alpha = beta / (beta + 1);
+   analysis.ac.re = 0.026 / analysis.dc.Ie; 
+   analysis.ac.Zi = _Rth_(Re, analysis.ac.re);
+   analysis.ac.Zo = Rc; 
+   analysis.ac.Av = alpha * Rc / analysis.ac.re;
+   analysis.ac.phase = "In phase"; 
+
+   return analysis;
+}
+
+/* --------------------------------------------------------------- */
+/* ----------------------- Batch Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Batch DC analysis of voltage-divider transistor configuration.
+
+Each parameter is an array of 'num' designs and each result field
+is written to its own column. The i'th column entries are equal to
+'bjt_dc_voltage_divider()' of the i'th parameters.
+
+size_t num = 2;
+double Vcc[2]={22, 22}, Rb1[2]={39000, 39000}, Rb2[2]={3900, 3900};
+double Rc[2]={10000, 10000}, Re[2]={1500, 1200}, beta[2]={100, 100};
+double Ib[2], Ic[2], Ie[2], Icsat[2], Vce[2], Vc[2], Ve[2];
+double Vb[2], Vbc[2];
+BJT_DCBatch results = {Ib, Ic, Ie, Icsat, Vce, Vc, Ve, Vb, Vbc};
+bjt_dc_voltage_divider_batch(num, Vcc, Rb1, Rb2, Rc, Re, beta, results);
+
+Ic: 8.384638e-04 A, 1.042122e-03 A
+Vce: 12.357666 V, 10.328232 V
+*/
+BATCH_DISPATCH
+static inline void bjt_dc_voltage_divider_batch(size_t num, 
+      const double *Vcc, const double *Rb1, const double *Rb2, 
+      const double *Rc, const double *Re, const double *beta, 
+      BJT_DCBatch results) {
+   // Check if parameters of transistors are consistent.
+   for (size_t i=0; i<num; i++)
+      assert (Rb1[i] > 0 && Rb2[i] > 0 && Rc[i] > 0 && 
+              Re[i] > 0 && beta[i] > 0);
+
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++) {
+      double rth = _Rth_(Rb1[i], Rb2[i]);
+      double eth = _Eth_(Vcc[i], Rb1[i], Rb2[i]);
+      double ib = (eth - Vbe) / (rth + (beta[i] + 1) * Re[i]);
+      double ic = beta[i] * ib;
+      double ve = (beta[i] + 1) * ib * Re[i];
+      double vce = Vcc[i] - ic * (Rc[i] + Re[i]);
+      results.Ib[i] = ib;
+      results.Ic[i] = ic;
+      results.Ie[i] = (beta[i] + 1) * ib;
+      results.Icsat[i] = Vcc[i] / (Rc[i] + Re[i]);
+      results.Vce[i] = vce;
+      results.Ve[i] = ve;
+      results.Vc[i] = vce + ve;
+      results.Vb[i] = Vbe + ve;
+      results.Vbc[i] = (Vbe + ve) - (vce + ve);
+   }
+}
+
+/* Batch AC analysis of voltage-divider transistor configuration.
+
+Each parameter is an array of 'num' designs and each result field
+is written to its own column. The 'bypass' option is common for 
+all designs. Phase relationship is always 'Out of phase', so it 
+isn't written to any column.
+
+size_t num = 2;
+double Vcc[2]={16, 16}, Rb1[2]={90000, 90000}, Rb2[2]={10000, 10000};
+double Rc[2]={2200, 2200}, Re[2]={680, 680}, beta[2]={210, 210};
+double ro[2]={50000, 40000}; 
+double re[2], Zi[2], Zo[2], Av[2];
+BJT_ACBatch results = {re, Zi, Zo, Av};
+bjt_ac_voltage_divider_batch(num, Vcc, Rb1, Rb2, Rc, Re, beta, ro, 
+                             "bypassed", results);
+
+re: 20.876672 ohm, 20.876672 ohm
+Av: -100.939446, -99.886997
+*/
+BATCH_DISPATCH
+static inline void bjt_ac_voltage_divider_batch(size_t num, 
+      const double *Vcc, const double *Rb1, const double *Rb2, 
+      const double *Rc, const double *Re, const double *beta, 
+      const double *ro, string bypass, BJT_ACBatch results) {
+   // Check if parameters of transistors are consistent.
+   assert (strcmp(bypass, "bypassed") == 0 || 
+           strcmp(bypass, "unbypassed") == 0);
+   for (size_t i=0; i<num; i++)
+      assert (Rb1[i] > 0 && Rb2[i] > 0 && Rc[i] > 0 && 
+              Re[i] > 0 && beta[i] > 0 && ro[i] > 0);
+
+   // According to 'bypass' parameter, there are two options.
+   if (strcmp(bypass, "bypassed") == 0) {
+      BATCH_LOOP
+      for (size_t i=0; i<num; i++) {
+         double rth = _Rth_(Rb1[i], Rb2[i]);
+         double eth = _Eth_(Vcc[i], Rb1[i], Rb2[i]);
+         double Ib = (eth - Vbe) / (rth + (beta[i] + 1) * Re[i]);
+         double r = 0.026 / ((beta[i] + 1) * Ib);
+         results.re[i] = r;
+         results.Zi[i] = _Rth_(rth, beta[i] * r);
+         results.Zo[i] = _Rth_(Rc[i], ro[i]);
+         results.Av[i] = -1 * _Rth_(Rc[i], ro[i]) / r;
       }
-      // Calculate the last stage of cascaded system.
-      else {
-         // Calculate the last stage voltage.
-         Av = Rl / (Rl + Zos[num - 1]) * Avnls[num - 1];
-         tvoltage *= Av;
-         // Right know, create the last stage names.
-         sprintf(iname, "%d", (i + 1)); strcat(vname, iname);
-         // Append the last stage voltage names and gain to it.
-         strcpy(analysis.names[num - 1], vname);
-         analysis.voltages[num - 1] = Av;
+   }
+   else {
+      BATCH_LOOP
+      for (size_t i=0; i<num; i++) {
+         double rth = _Rth_(Rb1[i], Rb2[i]);
+         double eth = _Eth_(Vcc[i], Rb1[i], Rb2[i]);
+         double Ib = (eth - Vbe) / (rth + (beta[i] + 1) * Re[i]);
+         double r = 0.026 / ((beta[i] + 1) * Ib);
+         double Zb1 = (beta[i] + 1) + (Rc[i] / ro[i]);
+         double Zb2 = 1 + (Rc[i] + Re[i]) / ro[i];
+         double Zb = beta[i] * r + (Zb1 / Zb2) * Re[i];
+         double Zo1 = beta[i] * (ro[i] + r);
+         double Zo2 = 1 + (beta[i] * r) / Re[i];
+         double Zo3 = ro[i] + Zo1 / Zo2;
+         double Av1 = (-1 * (beta[i] * Rc[i]) / Zb) * 
+                      (1 + (r / ro[i])) + (Rc[i] / ro[i]);
+         double Av2 = 1 + (Rc[i] / ro[i]);
+         results.re[i] = r;
+         results.Zi[i] = _Rth_(rth, Zb);
+         results.Zo[i] = _Rth_(Rc[i], Zo3);
+         results.Av[i] = Av1 / Av2;
       }
-      // Calculate the other parameters to struct.
-      analysis.Avt = tvoltage;
-      analysis.Avs = Zis[0] / (Zis[0] + Rs) * tvoltage;
-      analysis.Ait = -1 * tvoltage * Zis[0] / Rl;
+   }
+}
+
+/* Store the fused analysis of i'th design to the result columns. */
+static inline void _bjt_store_fused_(BJT_FusedAnalysis analysis, size_t i, 
+                                     BJT_DCBatch dc, BJT_ACBatch ac) {
+   // Write each result field to its own column.
+   dc.Ib[i] = analysis.dc.Ib;
+   dc.Ic[i] = analysis.dc.Ic;
+   dc.Ie[i] = analysis.dc.Ie;
+   dc.Icsat[i] = analysis.dc.Icsat;
+   dc.Vce[i] = analysis.dc.Vce;
+   dc.Vc[i] = analysis.dc.Vc;
+   dc.Ve[i] = analysis.dc.Ve;
+   dc.Vb[i] = analysis.dc.Vb;
+   dc.Vbc[i] = analysis.dc.Vbc;
+   ac.re[i] = analysis.ac.re;
+   ac.Zi[i] = analysis.ac.Zi;
+   ac.Zo[i] = analysis.ac.Zo;
+   ac.Av[i] = analysis.ac.Av;
+}
+
+/* Batch fused analysis of fixed-bias transistor configuration. 
+The i'th column entries are equal to 'bjt_analyze_fixed_bias()' of the
+i'th parameters. */
+BATCH_DISPATCH
+static inline void bjt_analyze_fixed_bias_batch(size_t num, 
+      const double *Vcc, const double *Rb, const double *Rc, 
+      const double *beta, const double *ro, BJT_DCBatch dc, 
+      BJT_ACBatch ac) {
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _bjt_store_fused_(bjt_analyze_fixed_bias(Vcc[i], Rb[i], Rc[i], 
+                        beta[i], ro[i]), i, dc, ac);
+}
 
-      // Clear the 'iname' and 'vname' variables.
-      strcpy(iname, ""); strcpy(vname, "Av");
+/* Batch fused analysis of emitter-bias transistor configuration. 
+The i'th column entries are equal to 'bjt_analyze_emitter_bias()' of the
+i'th parameters. */
+BATCH_DISPATCH
+static inline void bjt_analyze_emitter_bias_batch(size_t num, 
+      const double *Vcc, const double *Rb, const double *Rc, 
+      const double *Re, const double *beta, const double *ro, 
+      BJT_DCBatch dc, BJT_ACBatch ac) {
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _bjt_store_fused_(bjt_analyze_emitter_bias(Vcc[i], Rb[i], Rc[i], 
+                        Re[i], beta[i], ro[i]), i, dc, ac);
+}
+
+/* Batch fused analysis of voltage-divider transistor configuration. 
+The i'th column entries are equal to 'bjt_analyze_voltage_divider()' of
+the i'th parameters. The 'bypass' option is common for all designs. 
+*/
+BATCH_DISPATCH
+static inline void bjt_analyze_voltage_divider_batch(size_t num, 
+      const double *Vcc, const double *Rb1, const double *Rb2, 
+      const double *Rc, const double *Re, const double *beta, 
+      const double *ro, string bypass, BJT_DCBatch dc, BJT_ACBatch ac) {
+   // Check if 'bypass' parameter is consistent.
+   assert (strcmp(bypass, "bypassed") == 0 || 
+           strcmp(bypass, "unbypassed") == 0);
+   // According to 'bypass' parameter, there are two options.
+   if (strcmp(bypass, "bypassed") == 0) {
+      BATCH_LOOP
+      for (size_t i=0; i<num; i++)
+         _bjt_store_fused_(bjt_analyze_voltage_divider(Vcc[i], Rb1[i], 
+               Rb2[i], Rc[i], Re[i], beta[i], ro[i], "bypassed"), i, 
+               dc, ac);
    }
-   return analysis;
+   else {
+      BATCH_LOOP
+      for (size_t i=0; i<num; i++)
+         _bjt_store_fused_(bjt_analyze_voltage_divider(Vcc[i], Rb1[i], 
+               Rb2[i], Rc[i], Re[i], beta[i], ro[i], "unbypassed"), i, 
+               dc, ac);
+   }
+}
+
+/* Batch fused analysis of collector-feedback transistor configuration. 
+The i'th column entries are equal to 'bjt_analyze_collector_feedback()' 
+of the i'th parameters. */
+BATCH_DISPATCH
+static inline void bjt_analyze_collector_feedback_batch(size_t num, 
+      const double *Vcc, const double *Rf, const double *Rc, 
+      const double *Re, const double *beta, const double *ro, 
+      BJT_DCBatch dc, BJT_ACBatch ac) {
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _bjt_store_fused_(bjt_analyze_collector_feedback(Vcc[i], Rf[i], 
+                        Rc[i], Re[i], beta[i], ro[i]), i, dc, ac);
+}
+
+/* Batch fused analysis of emitter-follower transistor configuration. 
+The i'th column entries are equal to 'bjt_analyze_emitter_follower()' of
+the i'th parameters. */
+BATCH_DISPATCH
+static inline void bjt_analyze_emitter_follower_batch(size_t num, 
+      const double *Vee, const double *Rb, const double *Re, 
+      const double *beta, const double *ro, BJT_DCBatch dc, 
+      BJT_ACBatch ac) {
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _bjt_store_fused_(bjt_analyze_emitter_follower(Vee[i], Rb[i], 
+                        Re[i], beta[i], ro[i]), i, dc, ac);
+}
+
+/* Batch fused analysis of common-base transistor configuration. 
+The i'th column entries are equal to 'bjt_analyze_common_base()' of the
+i'th parameters. */
+BATCH_DISPATCH
+static inline void bjt_analyze_common_base_batch(size_t num, 
+      const double *Vcc, const double *Vee, const double *Rc, 
+      const double *Re, const double *beta, BJT_DCBatch dc, 
+      BJT_ACBatch ac) {
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _bjt_store_fused_(bjt_analyze_common_base(Vcc[i], Vee[i], Rc[i], 
+                        Re[i], beta[i]), i, dc, ac);
+}
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Uniform Definations -------------------- */
+/* --------------------------------------------------------------- */
+
+/* Get the batch result columns from uniform result columns. */
+static inline BJT_DCBatch _bjt_dc_columns_(double *const *results) {
+   // DC fields are the first fields of results.
+   BJT_DCBatch dc = {results[0], results[1], results[2], results[3], 
+                 results[4], results[5], results[6], results[7], 
+                 results[8]};
+   return dc;
+}
+
+/* Get the batch result columns from uniform result columns. */
+static inline BJT_ACBatch _bjt_ac_columns_(double *const *results) {
+   // AC fields are following the DC fields.
+   BJT_ACBatch ac = {results[9], results[10], results[11], results[12]};
+   return ac;
+}
+
+/* Uniform evaluations of fused analyses for the engines. */
+static inline void _bjt_uniform_fixed_bias_(size_t num, 
+                                            const double *const *params, 
+                                            double *const *results) {
+   bjt_analyze_fixed_bias_batch(num, params[0], params[1], params[2], 
+         params[3], params[4], _bjt_dc_columns_(results), 
+         _bjt_ac_columns_(results));
+}
+
+static inline void _bjt_uniform_emitter_bias_(size_t num, 
+      const double *const *params, double *const *results) {
+   bjt_analyze_emitter_bias_batch(num, params[0], params[1], params[2], 
+         params[3], params[4], params[5], _bjt_dc_columns_(results), 
+         _bjt_ac_columns_(results));
+}
+
+static inline void _bjt_uniform_voltage_divider_(size_t num, 
+      const double *const *params, double *const *results) {
+   bjt_analyze_voltage_divider_batch(num, params[0], params[1], 
+         params[2], params[3], params[4], params[5], params[6], 
+         "bypassed", _bjt_dc_columns_(results), 
+         _bjt_ac_columns_(results));
+}
+
+static inline void _bjt_uniform_voltage_divider_unbypassed_(size_t num, 
+      const double *const *params, double *const *results) {
+   bjt_analyze_voltage_divider_batch(num, params[0], params[1], 
+         params[2], params[3], params[4], params[5], params[6], 
+         "unbypassed", _bjt_dc_columns_(results), 
+         _bjt_ac_columns_(results));
 }
+
+static inline void _bjt_uniform_collector_feedback_(size_t num, 
+      const double *const *params, double *const *results) {
+   bjt_analyze_collector_feedback_batch(num, params[0], params[1], 
+         params[2], params[3], params[4], params[5], 
+         _bjt_dc_columns_(results), _bjt_ac_columns_(results));
+}
+
+static inline void _bjt_uniform_emitter_follower_(size_t num, 
+      const double *const *params, double *const *results) {
+   bjt_analyze_emitter_follower_batch(num, params[0], params[1], 
+         params[2], params[3], params[4], _bjt_dc_columns_(results), 
+         _bjt_ac_columns_(results));
+}
+
+static inline void _bjt_uniform_common_base_(size_t num, 
+      const double *const *params, double *const *results) {
+   bjt_analyze_common_base_batch(num, params[0], params[1], params[2], 
+         params[3], params[4], _bjt_dc_columns_(results), 
+         _bjt_ac_columns_(results));
+}
+
+/* Uniform regions of BJT designs (see 'classify_regions()'). A design
+is saturated if its Vce is at most VCE_SAT (its base-collector 
+junction isn't reverse biased). Vce is found by every configuration,
+unlike Icsat (-1 for emitter-follower and common-base designs). */
+BATCH_DISPATCH
+static inline void _bjt_uniform_regions_(size_t num, 
+                                         const double *const *params, 
+                                         const double *const *results, 
+                                         unsigned char *regions) {
+   (void) params;
+   const double *Ic = results[1], *Vce = results[4];
+   // Comparisons with NaN are false, so NaN designs get no region.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++) {
+      int saturation = (Ic[i] > 0) & (Vce[i] <= VCE_SAT);
+      int active = (Ic[i] > 0) & (Vce[i] > VCE_SAT);
+      regions[i] = (Ic[i] <= 0) * REGION_CUTOFF + 
+                   active * REGION_ACTIVE + 
+                   saturation * REGION_SATURATION;
+   }
+}
+
+// Result fields of all BJT configurations:
+#define BJT_RESULTS 13, {"Ib", "Ic", "Ie", "Icsat", "Vce", "Vc", "Ve", \
+   "Vb", "Vbc", "re", "Zi", "Zo", "Av"}, {1, 4, 12, 10, 11}
+
+/* Uniform descriptions of BJT configurations. The parameters are 
+in the same order as the 'analyze_*()' functions. */
+static const struct Configuration bjt_configurations[] = {
+   {"fixed_bias", 5, {"Vcc", "Rb", "Rc", "beta", "ro"}, 
+    BJT_RESULTS, _bjt_uniform_fixed_bias_, _bjt_uniform_regions_, 
+    0x1E},
+   {"emitter_bias", 6, {"Vcc", "Rb", "Rc", "Re", "beta", "ro"}, 
+    BJT_RESULTS, _bjt_uniform_emitter_bias_, _bjt_uniform_regions_, 
+    0x3E},
+   {"voltage_divider", 7, {"Vcc", "Rb1", "Rb2", "Rc", "Re", "beta", 
+    "ro"}, BJT_RESULTS, _bjt_uniform_voltage_divider_, 
+    _bjt_uniform_regions_, 0x7E},
+   {"voltage_divider_unbypassed", 7, {"Vcc", "Rb1", "Rb2", "Rc", 
+    "Re", "beta", "ro"}, BJT_RESULTS, 
+    _bjt_uniform_voltage_divider_unbypassed_, _bjt_uniform_regions_, 
+    0x7E},
+   {"collector_feedback", 6, {"Vcc", "Rf", "Rc", "Re", "beta", "ro"},
+    BJT_RESULTS, _bjt_uniform_collector_feedback_, 
+    _bjt_uniform_regions_, 0x3E},
+   {"emitter_follower", 5, {"Vee", "Rb", "Re", "beta", "ro"}, 
+    BJT_RESULTS, _bjt_uniform_emitter_follower_, 
+    _bjt_uniform_regions_, 0x1E},
+   {"common_base", 5, {"Vcc", "Vee", "Rc", "Re", "beta"}, 
+    BJT_RESULTS, _bjt_uniform_common_base_, _bjt_uniform_regions_, 
+    0x1C},
+};
+
+// Number of uniform BJT configurations:
+static const size_t num_bjt_configurations = 
+   sizeof(bjt_configurations) / sizeof(bjt_configurations[0]);
+
+#endif
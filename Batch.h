@@ -0,0 +1,57 @@
+/* Batch (Structure-of-Arrays) Analysis Support
+
+The scalar configurations are called once per design and return
+their results by value. For large tolerance runs and sweeps, that
+is too slow. So, batch entry points take one contiguous array per
+parameter and write one contiguous array (column) per result.
+
+IMPORTANT NOTES:
+----------------
+
+1. Compile with optimizations (for example '-O3 -DNDEBUG
+-fno-math-errno') because batch loops are vectorized by compiler.
+Assertions of scalar configurations and 'errno' setting of 'sqrt()'
+prevent vectorization.
+2. On x86-64 Linux with GCC or Clang, every batch entry point is
+cloned for AVX-512, AVX2 and the baseline (SSE2) instruction sets.
+The right clone is chosen at load time by the CPU features. Define
+'BATCH_NO_DISPATCH' to build only the baseline.
+3. Batch loops inline the scalar configurations, so the results 
+are the same as the scalar ones.
+4. Result columns must not overlap with each other or with the
+parameter arrays. Parameter arrays may overlap with each other.
+*/
+
+#ifndef BATCH_H
+#define BATCH_H
+
+// Libraries:
+#include <stddef.h>
+
+// Batch loops inline their scalar configurations:
+#if defined(__GNUC__) || defined(__clang__)
+#define BATCH_FLATTEN __attribute__((flatten))
+#else
+#define BATCH_FLATTEN
+#endif
+
+// Iterations of batch loops are independent of each other:
+#if defined(__clang__)
+#define BATCH_LOOP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define BATCH_LOOP _Pragma("GCC ivdep")
+#else
+#define BATCH_LOOP
+#endif
+
+// Runtime CPU dispatch for batch entry points:
+#if defined(__x86_64__) && defined(__linux__) && \
+    (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(BATCH_NO_DISPATCH)
+#define BATCH_DISPATCH BATCH_FLATTEN \
+   __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define BATCH_DISPATCH BATCH_FLATTEN
+#endif
+
+#endif
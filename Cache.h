@@ -0,0 +1,441 @@
+/* Memoizing Result Cache of Transistor Configurations
+
+An interactive design service gets the same queries again and again
+(like the same 'emitter_follower' design from many users). So, this
+source file keeps the results of analyzed designs in a cache in
+front of the uniform configurations (see Configuration.h), and a
+repeated query is answered without any analysis (FET queries skip
+the quadratic solve of drain current).
+
+struct ResultCache *cache = create_result_cache(65536, 0);
+cached_evaluate(cache, config, params, results);
+display_cache_stats(cache_stats(cache));
+destroy_result_cache(cache);
+
+IMPORTANT NOTES:
+----------------
+
+1. Keys are the configuration and the exact bits of its parameters.
+So, 0.0 and -0.0 (or NANs with different payloads) are different
+keys and a hit gives the same bits as an analysis.
+2. The cache is split into shards by the hash of keys. Each shard
+has its own lock, hash buckets and LRU (least recently used) order,
+so threads querying different designs rarely wait for each other.
+3. The memory is bounded: all entries are allocated when the cache
+is created. A full shard evicts its least recently used entry.
+4. Designs are analyzed out of the locks. If two threads miss the
+same key together, both analyze it and the later one only refreshes
+the entry.
+5. The cached batch ('cached_configuration()') analyzes the misses
+of each block of CACHE_BLOCK designs together, so they still use the
+vectorized batch functions.
+6. Link with '-pthread'.
+
+EXISTING OPERATIONS:
+--------------------
+
++ Cache Lifetime (create_result_cache, destroy_result_cache)
++ Queries (cache_lookup, cache_store, cached_evaluate,
+cached_configuration)
++ Statistics (cache_stats, display_cache_stats)
+*/
+
+#ifndef CACHE_H
+#define CACHE_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include "Configuration.h"
+
+// General constants:
+#define CACHE_SHARDS 16 // default count of shards
+#define CACHE_BLOCK 64 // designs looked up before analyzing misses
+#define CACHE_LINE 64 // alignment of shards (no false sharing)
+#define CACHE_NONE UINT32_MAX // index of missing entries
+
+// Prefetching of memory (only a hint):
+#if defined(__GNUC__) || defined(__clang__)
+#define CACHE_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define CACHE_PREFETCH(address) ((void) (address))
+#endif
+
+// Links of an entry (kept apart from entries, so walking buckets and
+// LRU order touches only this compact array):
+struct CacheLink {
+   uint64_t hash; // hash of key
+   uint32_t next; // next entry of the same hash bucket
+   uint32_t newer; // next entry in LRU order
+   uint32_t older; // previous entry in LRU order
+};
+
+// Cached results of a design:
+struct CacheEntry {
+   const struct Configuration *config; // configuration of key
+   double params[MAX_PARAMS]; // parameters of key
+   double results[MAX_RESULTS]; // results of design
+};
+
+// Part of the cache with its own lock:
+struct CacheShard {
+   _Alignas(CACHE_LINE) pthread_mutex_t lock; // guards the shard
+   struct CacheLink *links; // links of all entries
+   struct CacheEntry *entries; // all entries of shard
+   uint32_t *buckets; // first entries of hash buckets
+   size_t capacity; // count of entries
+   size_t used; // count of filled entries
+   size_t mask; // count of buckets - 1
+   uint32_t newest; // most recently used entry
+   uint32_t oldest; // least recently used entry
+   size_t hits; // found queries
+   size_t misses; // analyzed queries
+   size_t evictions; // replaced entries
+};
+
+// Sharded cache:
+struct ResultCache {
+   size_t num_shards; // count of shards
+   struct CacheShard *shards; // all shards
+};
+
+// Counters of all shards:
+struct CacheStats {
+   size_t hits; // found queries
+   size_t misses; // analyzed queries
+   size_t evictions; // replaced entries
+   size_t entries; // filled entries
+   size_t capacity; // maximum entries
+   size_t bytes; // allocated memory
+};
+
+// User-defined statistics type:
+typedef struct CacheStats CacheStats;
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Hash the configuration and the bits of its parameters. Each
+parameter costs one multiplication and the sum is mixed once at the
+end (splitmix64 finalizer). */
+uint64_t _cache_hash_(const struct Configuration *config,
+                      const double *params) {
+   uint64_t z = (uintptr_t) config;
+   for (size_t p=0; p<config->nparams; p++) {
+      uint64_t bits;
+      memcpy(&bits, &params[p], sizeof(bits));
+      z = (z + bits) * 0x9E3779B97F4A7C15;
+   }
+   z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+   z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+   return z ^ (z >> 31);
+}
+
+/* Get the shard of a hash (its high bits, the buckets use the low
+ones). */
+struct CacheShard *_cache_shard_(struct ResultCache *cache,
+                                 uint64_t hash) {
+   return &cache->shards[(hash >> 32) % cache->num_shards];
+}
+
+/* Find the entry of a key in the shard. If it doesn't exist,
+CACHE_NONE is returned. */
+uint32_t _cache_find_(const struct CacheShard *shard,
+                      const struct Configuration *config,
+                      uint64_t hash, const double *params) {
+   uint32_t index = shard->buckets[hash & shard->mask];
+   while (index != CACHE_NONE) {
+      // Compare the keys only if their hashes are equal.
+      const struct CacheEntry *entry = &shard->entries[index];
+      if (shard->links[index].hash == hash && entry->config == config &&
+          memcmp(entry->params, params,
+                 config->nparams * sizeof(double)) == 0)
+         return index;
+      index = shard->links[index].next;
+   }
+   return CACHE_NONE;
+}
+
+/* Remove an entry from the LRU order. */
+void _cache_unlink_(struct CacheShard *shard, uint32_t index) {
+   struct CacheLink *link = &shard->links[index];
+   if (link->newer != CACHE_NONE)
+      shard->links[link->newer].older = link->older;
+   else shard->newest = link->older;
+   if (link->older != CACHE_NONE)
+      shard->links[link->older].newer = link->newer;
+   else shard->oldest = link->newer;
+}
+
+/* Put an entry to the front of LRU order (as the newest). */
+void _cache_push_(struct CacheShard *shard, uint32_t index) {
+   struct CacheLink *link = &shard->links[index];
+   link->newer = CACHE_NONE;
+   link->older = shard->newest;
+   if (shard->newest != CACHE_NONE)
+      shard->links[shard->newest].newer = index;
+   else shard->oldest = index;
+   shard->newest = index;
+}
+
+/* Remove an entry from its hash bucket. */
+void _cache_unbucket_(struct CacheShard *shard, uint32_t index) {
+   uint32_t *link = &shard->buckets[shard->links[index].hash &
+                                    shard->mask];
+   while (*link != index) link = &shard->links[*link].next;
+   *link = shard->links[index].next;
+}
+
+/* Get an entry for a new key. A free one is used first, otherwise
+the least recently used one is evicted. */
+uint32_t _cache_claim_(struct CacheShard *shard) {
+   if (shard->used < shard->capacity) return shard->used++;
+   uint32_t index = shard->oldest;
+   _cache_unlink_(shard, index);
+   _cache_unbucket_(shard, index);
+   shard->evictions++;
+   return index;
+}
+
+/* Store the results of a key whose hash is known. */
+void _cache_insert_(struct ResultCache *cache,
+                    const struct Configuration *config, uint64_t hash,
+                    const double *params, const double *results) {
+   struct CacheShard *shard = _cache_shard_(cache, hash);
+   pthread_mutex_lock(&shard->lock);
+   uint32_t index = _cache_find_(shard, config, hash, params);
+   if (index != CACHE_NONE) _cache_unlink_(shard, index);
+   else {
+      // Fill a new entry and link it to its bucket.
+      index = _cache_claim_(shard);
+      struct CacheEntry *entry = &shard->entries[index];
+      entry->config = config;
+      memcpy(entry->params, params, config->nparams * sizeof(double));
+      shard->links[index].hash = hash;
+      shard->links[index].next = shard->buckets[hash & shard->mask];
+      shard->buckets[hash & shard->mask] = index;
+   }
+   memcpy(shard->entries[index].results, results,
+          config->nresults * sizeof(double));
+   _cache_push_(shard, index);
+   pthread_mutex_unlock(&shard->lock);
+}
+
+/* Find the results of a key whose hash is known. If they are found,
+1 is returned. */
+int _cache_search_(struct ResultCache *cache,
+                   const struct Configuration *config, uint64_t hash,
+                   const double *params, double *results) {
+   struct CacheShard *shard = _cache_shard_(cache, hash);
+   pthread_mutex_lock(&shard->lock);
+   uint32_t index = _cache_find_(shard, config, hash, params);
+   if (index != CACHE_NONE) {
+      memcpy(results, shard->entries[index].results,
+             config->nresults * sizeof(double));
+      _cache_unlink_(shard, index);
+      _cache_push_(shard, index);
+      shard->hits++;
+   }
+   else shard->misses++;
+   pthread_mutex_unlock(&shard->lock);
+   return index != CACHE_NONE;
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Create a cache of at most 'capacity' designs in 'shards' shards.
+If 'shards' is 0, CACHE_SHARDS shards are used. Each shard holds an
+equal part of the capacity (rounded up), but keys aren't spread over
+shards exactly equally. So, give some headroom (like 2x) over the
+count of designs which should stay cached. */
+struct ResultCache *create_result_cache(size_t capacity,
+                                        size_t shards) {
+   // Check if the parameters are consistent.
+   assert (capacity > 0);
+   if (shards == 0) shards = CACHE_SHARDS;
+   if (shards > capacity) shards = capacity;
+   size_t per_shard = (capacity + shards - 1) / shards;
+   assert (per_shard < CACHE_NONE);
+   // Use at least two buckets per entry, so chains are short.
+   size_t buckets = 1;
+   while (buckets < 2 * per_shard) buckets *= 2;
+
+   struct ResultCache *cache = malloc(sizeof(struct ResultCache));
+   assert (cache != NULL);
+   cache->num_shards = shards;
+   cache->shards = aligned_alloc(CACHE_LINE,
+                                 shards * sizeof(struct CacheShard));
+   assert (cache->shards != NULL);
+   for (size_t s=0; s<shards; s++) {
+      struct CacheShard *shard = &cache->shards[s];
+      memset(shard, 0, sizeof(struct CacheShard));
+      pthread_mutex_init(&shard->lock, NULL);
+      shard->links = malloc(per_shard * sizeof(struct CacheLink));
+      shard->entries = malloc(per_shard * sizeof(struct CacheEntry));
+      shard->buckets = malloc(buckets * sizeof(uint32_t));
+      assert (shard->links != NULL && shard->entries != NULL &&
+              shard->buckets != NULL);
+      memset(shard->buckets, 0xFF, buckets * sizeof(uint32_t));
+      shard->capacity = per_shard;
+      shard->mask = buckets - 1;
+      shard->newest = shard->oldest = CACHE_NONE;
+   }
+   return cache;
+}
+
+/* Destroy a cache created by 'create_result_cache()'. */
+void destroy_result_cache(struct ResultCache *cache) {
+   for (size_t s=0; s<cache->num_shards; s++) {
+      pthread_mutex_destroy(&cache->shards[s].lock);
+      free(cache->shards[s].links);
+      free(cache->shards[s].entries);
+      free(cache->shards[s].buckets);
+   }
+   free(cache->shards);
+   free(cache);
+}
+
+/* Find the cached results of a design ('nparams' parameters of the
+configuration). If they are found, they are copied to 'results' and
+1 is returned. */
+int cache_lookup(struct ResultCache *cache,
+                 const struct Configuration *config,
+                 const double *params, double *results) {
+   return _cache_search_(cache, config, _cache_hash_(config, params),
+                         params, results);
+}
+
+/* Store the results of a design. The least recently used design of
+its shard may be evicted. */
+void cache_store(struct ResultCache *cache,
+                 const struct Configuration *config,
+                 const double *params, const double *results) {
+   _cache_insert_(cache, config, _cache_hash_(config, params), params,
+                  results);
+}
+
+/* Analyze a design through the cache. Parameters and results are
+given as rows (in the order of configuration names).
+
+double params[5] = {12, 220000, 3300, 100, 1e+6}, results[13];
+cached_evaluate(cache, config, params, results); // analyzed
+cached_evaluate(cache, config, params, results); // found
+*/
+void cached_evaluate(struct ResultCache *cache,
+                     const struct Configuration *config,
+                     const double *params, double *results) {
+   uint64_t hash = _cache_hash_(config, params);
+   if (_cache_search_(cache, config, hash, params, results)) return;
+   // Analyze the design as a batch of one.
+   const double *param_columns[MAX_PARAMS];
+   double *result_columns[MAX_RESULTS];
+   for (size_t p=0; p<config->nparams; p++)
+      param_columns[p] = &params[p];
+   for (size_t r=0; r<config->nresults; r++)
+      result_columns[r] = &results[r];
+   config->evaluate(1, param_columns, result_columns);
+   _cache_insert_(cache, config, hash, params, results);
+}
+
+/* Analyze 'num' designs through the cache. Parameters and results
+are columns like the 'evaluate()' of configuration. */
+void cached_configuration(struct ResultCache *cache,
+                          const struct Configuration *config,
+                          size_t num, const double *const *params,
+                          double *const *results) {
+   double rows[CACHE_BLOCK][MAX_PARAMS], found[MAX_RESULTS];
+   double miss_params[MAX_PARAMS][CACHE_BLOCK];
+   double miss_results[MAX_RESULTS][CACHE_BLOCK];
+   const double *miss_param_columns[MAX_PARAMS];
+   double *miss_result_columns[MAX_RESULTS];
+   uint64_t hashes[CACHE_BLOCK];
+   size_t misses[CACHE_BLOCK];
+   for (size_t p=0; p<config->nparams; p++)
+      miss_param_columns[p] = miss_params[p];
+   for (size_t r=0; r<config->nresults; r++)
+      miss_result_columns[r] = miss_results[r];
+
+   for (size_t start=0; start<num; start+=CACHE_BLOCK) {
+      size_t n = (num - start < CACHE_BLOCK) ? num - start :
+                 CACHE_BLOCK;
+      // Hash the designs of block first and prefetch their buckets,
+      // so the lookups don't wait for memory one by one.
+      for (size_t i=0; i<n; i++) {
+         for (size_t p=0; p<config->nparams; p++)
+            rows[i][p] = params[p][start + i];
+         hashes[i] = _cache_hash_(config, rows[i]);
+         const struct CacheShard *shard = _cache_shard_(cache, hashes[i]);
+         CACHE_PREFETCH(&shard->buckets[hashes[i] & shard->mask]);
+      }
+      // Look up the designs of block and gather the misses.
+      size_t num_misses = 0;
+      for (size_t i=0; i<n; i++) {
+         if (_cache_search_(cache, config, hashes[i], rows[i], found)) {
+            for (size_t r=0; r<config->nresults; r++)
+               results[r][start + i] = found[r];
+            continue;
+         }
+         for (size_t p=0; p<config->nparams; p++)
+            miss_params[p][num_misses] = rows[i][p];
+         misses[num_misses++] = i;
+      }
+      if (num_misses == 0) continue;
+      // Analyze the misses together, then scatter and store them.
+      config->evaluate(num_misses, miss_param_columns,
+                       miss_result_columns);
+      for (size_t m=0; m<num_misses; m++) {
+         size_t i = misses[m];
+         for (size_t r=0; r<config->nresults; r++)
+            found[r] = results[r][start + i] = miss_results[r][m];
+         _cache_insert_(cache, config, hashes[i], rows[i], found);
+      }
+   }
+}
+
+/* Sum the counters of all shards. */
+CacheStats cache_stats(struct ResultCache *cache) {
+   CacheStats stats = {0};
+   stats.bytes = sizeof(struct ResultCache) +
+                 cache->num_shards * sizeof(struct CacheShard);
+   for (size_t s=0; s<cache->num_shards; s++) {
+      struct CacheShard *shard = &cache->shards[s];
+      pthread_mutex_lock(&shard->lock);
+      stats.hits += shard->hits;
+      stats.misses += shard->misses;
+      stats.evictions += shard->evictions;
+      stats.entries += shard->used;
+      stats.capacity += shard->capacity;
+      stats.bytes += shard->capacity * (sizeof(struct CacheLink) +
+                                        sizeof(struct CacheEntry)) +
+                     (shard->mask + 1) * sizeof(uint32_t);
+      pthread_mutex_unlock(&shard->lock);
+   }
+   return stats;
+}
+
+/* Display the counters of a cache.
+
+hits: 900 (90.00%)
+misses: 100
+evictions: 0
+entries: 100 of 65536
+memory: 17827840 bytes
+*/
+void display_cache_stats(CacheStats stats) {
+   size_t queries = stats.hits + stats.misses;
+   printf("hits: %zu (%.2f%%)\n", stats.hits,
+          queries ? 100.0 * stats.hits / queries : 0.0);
+   printf("misses: %zu\n", stats.misses);
+   printf("evictions: %zu\n", stats.evictions);
+   printf("entries: %zu of %zu\n", stats.entries, stats.capacity);
+   printf("memory: %zu bytes\n", stats.bytes);
+}
+
+#endif
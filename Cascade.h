@@ -0,0 +1,236 @@
+/* Cascaded Systems of Any Length with Stage Updates
+
+'bjt_cascaded_system()' (see BJT.h) analyzes at most MAX_TRANS
+stages and it is computed from scratch for every change. But while
+a chain is tuned, only one stage changes at a time. So, this source
+file keeps the stage gains of a chain in a product tree (a segment
+tree): updating a stage recomputes its gain, the gain of the stage
+before it (which it loads) and their ancestors, in O(log n). Many
+chains with the same count of stages are analyzed together by a
+batch entry point.
+
+double tree[BJT_CASCADE_TREE(3)];
+struct BJT_Cascade cascade = bjt_cascade(3, Avnls, Zis, Zos, Rs, Rl,
+                                         tree);
+bjt_cascade_update_stage(&cascade, 1, 300, 26, 5100);
+BJT_CascadeTotals totals = bjt_cascade_totals(&cascade);
+
+IMPORTANT NOTES:
+----------------
+
+1. Nothing is allocated. The stage arrays and the tree (of
+BJT_CASCADE_TREE(num) doubles) belong to the caller, and updates
+write the stage arrays in place.
+2. Stage gains have the same bits as 'bjt_cascaded_system()'. The
+tree multiplies them in pairs (not from left to right), so 'Avt' may
+differ from it in the last bits. The batch entry point multiplies
+from left to right, so all of its results have the same bits. After
+any updates, the tree has the same bits as a new one.
+3. A long chain may overflow (or underflow) the range of 'Avt', even
+if its stage gains are fine.
+4. Stage names aren't stored, see 'bjt_stage_name()'.
+
+EXISTING OPERATIONS:
+--------------------
+
++ Trees (bjt_cascade, bjt_cascade_update_stage,
+bjt_cascade_update_load)
++ Results (bjt_cascade_gain, bjt_cascade_totals)
++ Batches (bjt_cascade_batch)
+*/
+
+#ifndef CASCADE_H
+#define CASCADE_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "BJT.h"
+
+// General constants:
+#define CASCADE_BLOCK 256 // chains of a batch block
+
+// Doubles of the tree of a 'num' stages chain:
+#define BJT_CASCADE_TREE(num) (2 * (num))
+
+// Cascaded system with its product tree:
+struct BJT_Cascade {
+   size_t num; // count of stages
+   double *Avnls; // not-load voltage gains
+   double *Zis; // input impedances
+   double *Zos; // output impedances
+   double Rs; // source resistance
+   double Rl; // load resistance
+   double *tree; // stage gains from 'num', products of children below
+};
+
+// Total gains of a cascaded system:
+struct BJT_CascadeTotals {
+   double Avt; // total voltage gain
+   double Avs; // source voltage gain
+   double Ait; // total current gain
+};
+
+// Total gain columns of batch cascaded systems:
+struct BJT_CascadeColumns {
+   double *restrict Avt; // total voltage gains
+   double *restrict Avs; // source voltage gains
+   double *restrict Ait; // total current gains
+};
+
+// User-defined analysis types:
+typedef struct BJT_CascadeTotals BJT_CascadeTotals;
+typedef struct BJT_CascadeColumns BJT_CascadeBatch;
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Recompute the gain of the i'th stage (a leaf of tree). */
+void _bjt_cascade_leaf_(struct BJT_Cascade *cascade, size_t i) {
+   double load = (i != cascade->num - 1) ? cascade->Zis[i+1] :
+                 cascade->Rl;
+   cascade->tree[cascade->num + i] = _bjt_stage_gain_(
+         cascade->Avnls[i], cascade->Zos[i], load);
+}
+
+/* Recompute the products above the i'th stage up to the root. */
+void _bjt_cascade_climb_(struct BJT_Cascade *cascade, size_t i) {
+   double *tree = cascade->tree;
+   for (size_t k=(cascade->num + i) / 2; k>0; k/=2)
+      tree[k] = tree[2*k] * tree[2*k + 1];
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Build the product tree of a cascaded system. The arrays are kept
+(not copied), so they must live as long as the cascade.
+
+double Avnls[3] = {1, 250, 100}, Zis[3] = {500, 26, 100};
+double Zos[3] = {1000, 5100, 100}, tree[BJT_CASCADE_TREE(3)];
+struct BJT_Cascade cascade = bjt_cascade(3, Avnls, Zis, Zos, 10000,
+                                         820, tree);
+*/
+struct BJT_Cascade bjt_cascade(size_t num, double *Avnls, double *Zis,
+                               double *Zos, double Rs, double Rl,
+                               double *tree) {
+   // Check if the parameters of cascaded system are consistent.
+   assert (num > 0 && Rs > 0 && Rl > 0);
+   for (size_t i=0; i<num; i++)
+      assert (Zis[i] > 0 && Zos[i] > 0);
+   struct BJT_Cascade cascade = {num, Avnls, Zis, Zos, Rs, Rl, tree};
+   // Fill the leaves, then the products from the bottom.
+   for (size_t i=0; i<num; i++) _bjt_cascade_leaf_(&cascade, i);
+   for (size_t k=num-1; k>0; k--)
+      tree[k] = tree[2*k] * tree[2*k + 1];
+   return cascade;
+}
+
+/* Update the i'th stage. Its gain and the gain of the stage before it
+(its input impedance loads that stage) are recomputed. */
+void bjt_cascade_update_stage(struct BJT_Cascade *cascade, size_t i,
+                              double Avnl, double Zi, double Zo) {
+   // Check if the parameters of stage are consistent.
+   assert (i < cascade->num && Zi > 0 && Zo > 0);
+   cascade->Avnls[i] = Avnl;
+   cascade->Zis[i] = Zi;
+   cascade->Zos[i] = Zo;
+   _bjt_cascade_leaf_(cascade, i);
+   _bjt_cascade_climb_(cascade, i);
+   if (i > 0) {
+      _bjt_cascade_leaf_(cascade, i - 1);
+      _bjt_cascade_climb_(cascade, i - 1);
+   }
+}
+
+/* Update the source and load resistances. Only the last stage is
+recomputed ('Rs' changes only 'Avs'). */
+void bjt_cascade_update_load(struct BJT_Cascade *cascade, double Rs,
+                             double Rl) {
+   // Check if the resistances are consistent.
+   assert (Rs > 0 && Rl > 0);
+   cascade->Rs = Rs;
+   if (Rl == cascade->Rl) return;
+   cascade->Rl = Rl;
+   _bjt_cascade_leaf_(cascade, cascade->num - 1);
+   _bjt_cascade_climb_(cascade, cascade->num - 1);
+}
+
+/* Get the loaded voltage gain of the i'th stage (see
+'bjt_stage_name()' for its name). */
+double bjt_cascade_gain(const struct BJT_Cascade *cascade, size_t i) {
+   assert (i < cascade->num);
+   return cascade->tree[cascade->num + i];
+}
+
+/* Get the total gains of a cascaded system (from the root of tree).
+
+Avt: 10.858971
+Avs: 0.517094
+Ait: -6.621324
+*/
+BJT_CascadeTotals bjt_cascade_totals(const struct BJT_Cascade *cascade) {
+   BJT_CascadeTotals totals;
+   double Zi = cascade->Zis[0];
+   totals.Avt = cascade->tree[1]; // the leaf itself for one stage
+   totals.Avs = Zi / (Zi + cascade->Rs) * totals.Avt;
+   totals.Ait = -1 * totals.Avt * Zi / cascade->Rl;
+   return totals;
+}
+
+/* Analyze 'chains' cascaded systems of 'stages' stages together.
+Parameters are columns of stages ('Avnls[s][c]' is the not-load gain
+of the s'th stage of the c'th chain) and 'Rs' and 'Rl' are columns of
+chains. Stage gains are written to 'voltages' columns (if it isn't
+NULL) and the total gains to 'totals'. */
+BATCH_DISPATCH
+void bjt_cascade_batch(size_t chains, size_t stages,
+                       const double *const *Avnls,
+                       const double *const *Zis,
+                       const double *const *Zos, const double *Rs,
+                       const double *Rl, double *const *voltages,
+                       BJT_CascadeBatch totals) {
+   assert (stages > 0);
+   // Chains are analyzed in blocks, so 'Avt' of a block stays in the
+   // cache while all of its stages are multiplied.
+   for (size_t first=0; first<chains; first+=CASCADE_BLOCK) {
+      size_t n = (chains - first < CASCADE_BLOCK) ? chains - first :
+                 CASCADE_BLOCK;
+      double *restrict Avt = totals.Avt + first;
+      BATCH_LOOP
+      for (size_t c=0; c<n; c++) Avt[c] = 1;
+      // Multiply the stages from left to right (like the scalar one).
+      for (size_t s=0; s<stages; s++) {
+         const double *load = ((s != stages - 1) ? Zis[s+1] : Rl) +
+                              first;
+         const double *Avnl = Avnls[s] + first, *Zo = Zos[s] + first;
+         if (voltages != NULL) {
+            double *restrict Av = voltages[s] + first;
+            BATCH_LOOP
+            for (size_t c=0; c<n; c++) {
+               Av[c] = _bjt_stage_gain_(Avnl[c], Zo[c], load[c]);
+               Avt[c] *= Av[c];
+            }
+         }
+         else {
+            BATCH_LOOP
+            for (size_t c=0; c<n; c++)
+               Avt[c] *= _bjt_stage_gain_(Avnl[c], Zo[c], load[c]);
+         }
+      }
+      double *restrict Avs = totals.Avs + first;
+      double *restrict Ait = totals.Ait + first;
+      const double *Zi = Zis[0] + first, *Rsb = Rs + first;
+      const double *Rlb = Rl + first;
+      BATCH_LOOP
+      for (size_t c=0; c<n; c++) {
+         Avs[c] = Zi[c] / (Zi[c] + Rsb[c]) * Avt[c];
+         Ait[c] = -1 * Avt[c] * Zi[c] / Rlb[c];
+      }
+   }
+}
+
+#endif
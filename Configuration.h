@@ -0,0 +1,262 @@
+/* Uniform Description of Transistor Configurations
+
+Every configuration has its own function signature and result
+structure. The engines (like Monte Carlo) must handle any of them.
+So, each transistor family describes its configurations with this
+uniform structure: parameter names, result field names and one
+batch function which takes parameter columns and writes result
+columns in the same order as the names.
+
+IMPORTANT NOTES:
+----------------
+
+1. Results are the fields of fused (DC and AC) analysis. String
+fields like 'phase' aren't included.
+2. Common metrics (like collector/drain current) are found by
+'metrics' indices. So, engines can report the same quantities for
+BJT, JFET and MOSFET configurations.
+3. This source file is included by both the library (TransCal.c)
+and the programs which link it. So, its definitions are static.
+4. The closed-form analyses assume one region (active BJTs and
+saturated FETs) and don't check it. 'classify' finds the region of
+each analyzed design from its result columns, so the engines can
+skip the designs out of the accepted regions (see
+'classify_regions()').
+5. Batch evaluations inline the scalar analyses, so a bad design
+fails their assertions and aborts a whole batch. The engines find a
+status mask of each design instead: 'validate_params()' before the
+evaluation (non-positive resistances and gains) and
+'validate_results()' after it (infinite and NAN results). They sum
+the columns of each design times 0 in vectorized loops (non-finite
+entries make it NAN) and classify only the flagged designs. Faulty
+designs are evaluated with harmless parameters (see
+'replace_faulty_params()'), counted and skipped.
+
+EXISTING TABLES:
+----------------
+
++ bjt_configurations[] (in BJT.h)
++ jfet_configurations[] (in JFET.h)
++ mosfet_configurations[] (in MOSFET.h)
+*/
+
+#ifndef CONFIGURATION_H
+#define CONFIGURATION_H
+
+// Libraries:
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include "Batch.h"
+
+// General constants:
+#define MAX_PARAMS 12
+#define MAX_RESULTS 16
+
+// User-defined string type:
+typedef char * string;
+
+// Common metrics of all configurations:
+enum Metric {
+   METRIC_I, // collector (BJT) or drain (FET) current
+   METRIC_V, // collector-emitter (BJT) or drain-source (FET) voltage
+   METRIC_AV, // voltage gain
+   METRIC_ZI, // input impedance
+   METRIC_ZO, // output impedance
+   NUM_METRICS
+};
+
+// Names of common metrics:
+static const string metric_names[NUM_METRICS] = {
+   "I", "V", "Av", "Zi", "Zo"
+};
+
+// Operating regions of analyzed designs (bits of region masks):
+enum Region {
+   REGION_CUTOFF = 1, // no collector (BJT) or drain (FET) current
+   REGION_ACTIVE = 2, // active BJT or saturated FET (the modeled one)
+   REGION_SATURATION = 4, // saturated BJT (Vce at most VCE_SAT)
+   REGION_OHMIC = 8, // ohmic (triode) FET
+   NUM_REGIONS = 4
+};
+
+// Names of operating regions (in the order of bits):
+static const string region_names[NUM_REGIONS] = {
+   "cutoff", "active", "saturation", "ohmic"
+};
+
+// Faults of analyzed designs (bits of status masks, in the order
+// of their causes):
+enum Fault {
+   FAULT_PARAMETER = 1, // non-positive resistance or gain (or NAN)
+   FAULT_DIVISION = 2, // division by zero (infinite results)
+   FAULT_DISCRIMINANT = 4, // no operating point (NAN current)
+   FAULT_NONFINITE = 8, // any other NAN result
+   NUM_FAULTS = 4
+};
+
+// Names of faults (in the order of bits):
+static const string fault_names[NUM_FAULTS] = {
+   "parameter", "division", "discriminant", "nonfinite"
+};
+
+// Description of any configuration:
+struct Configuration {
+   string name; // configuration name
+   size_t nparams; // number of parameters
+   string params[MAX_PARAMS]; // parameter names in call order
+   size_t nresults; // number of result fields
+   string results[MAX_RESULTS]; // result field names
+   size_t metrics[NUM_METRICS]; // result indices of common metrics
+   // Analysis of 'num' designs from parameter columns.
+   void (*evaluate)(size_t num, const double *const *params,
+                    double *const *results);
+   // Regions of 'num' analyzed designs (NULL if it isn't known). A
+   // design with non-finite results gets no region (0).
+   void (*classify)(size_t num, const double *const *params,
+                    const double *const *results,
+                    unsigned char *regions);
+   // Bits of parameters which must be positive (the asserted ones of
+   // scalar analyses, see 'validate_params()').
+   unsigned positive;
+};
+
+/* Find the configuration named 'name' in a family table. If it
+doesn't exist, NULL is returned.
+
+const struct Configuration *config = find_configuration(
+      bjt_configurations, num_bjt_configurations, "emitter_bias");
+*/
+static inline const struct Configuration *find_configuration(
+      const struct Configuration *table, size_t num, const char *name) {
+   // Search the table linearly, it is small.
+   for (size_t i=0; i<num; i++)
+      if (strcmp(table[i].name, name) == 0) return &table[i];
+   return NULL;
+}
+
+/* Find the regions of 'num' analyzed designs (the parameter and
+result columns of 'evaluate'). Configurations without any classifier
+are active unless their current isn't finite.
+
+unsigned char regions[256];
+config->evaluate(num, params, results);
+classify_regions(config, num, params, results, regions);
+if (regions[0] & (REGION_SATURATION | REGION_OHMIC)) ...
+*/
+static inline void classify_regions(const struct Configuration *config,
+      size_t num, const double *const *params,
+      const double *const *results, unsigned char *regions) {
+   if (config->classify != NULL) {
+      config->classify(num, params, results, regions);
+      return;
+   }
+   const double *I = results[config->metrics[METRIC_I]];
+   for (size_t i=0; i<num; i++)
+      regions[i] = isfinite(I[i]) ? REGION_ACTIVE : 0;
+}
+
+// Designs validated together (their sums fit the L1 cache):
+#define VALIDATE_BLOCK 512
+
+/* Add 0 to the 'sum' of designs whose 'column' entries are finite
+(and positive, if 'positive') and NAN or 1 otherwise. */
+BATCH_DISPATCH
+static inline void _validate_column_(size_t num, const double *column,
+                                     int positive,
+                                     double *restrict sum) {
+   if (positive) {
+      BATCH_LOOP
+      for (size_t i=0; i<num; i++)
+         sum[i] += 0.0 * column[i] + (column[i] > 0 ? 0.0 : 1.0);
+   } else {
+      BATCH_LOOP
+      for (size_t i=0; i<num; i++) sum[i] += 0.0 * column[i];
+   }
+}
+
+/* Find the first fault of the design 'i' from its results (only for
+designs with non-finite results). */
+static inline unsigned char _result_fault_(
+      const struct Configuration *config, size_t i,
+      const double *const *results) {
+   for (size_t r=0; r<config->nresults; r++)
+      if (fabs(results[r][i]) == INFINITY) return FAULT_DIVISION;
+   if (isnan(results[config->metrics[METRIC_I]][i]))
+      return FAULT_DISCRIMINANT;
+   return FAULT_NONFINITE;
+}
+
+/* Find the status masks of 'num' designs from their parameter
+columns (FAULT_PARAMETER or 0) and count the faulty ones. Parameters
+in 'positive' must be positive and the others finite. */
+static inline size_t validate_params(const struct Configuration *config,
+      size_t num, const double *const *params,
+      unsigned char *restrict status) {
+   double sum[VALIDATE_BLOCK];
+   size_t faults = 0;
+   for (size_t start=0; start<num; start+=VALIDATE_BLOCK) {
+      size_t block = (num - start < VALIDATE_BLOCK) ?
+                     num - start : VALIDATE_BLOCK;
+      memset(sum, 0, block * sizeof(double));
+      for (size_t p=0; p<config->nparams; p++)
+         _validate_column_(block, params[p] + start,
+                           (config->positive >> p) & 1, sum);
+      for (size_t i=0; i<block; i++) {
+         status[start + i] = (sum[i] != 0) * FAULT_PARAMETER;
+         faults += (sum[i] != 0);
+      }
+   }
+   return faults;
+}
+
+/* Replace the parameters of faulty designs with 1, so they can be
+evaluated without failing any assertion (their results are
+meaningless, they must be skipped). */
+static inline void replace_faulty_params(
+      const struct Configuration *config, size_t num,
+      double *const *params, const unsigned char *restrict status) {
+   for (size_t p=0; p<config->nparams; p++) {
+      double *restrict column = params[p];
+      BATCH_LOOP
+      for (size_t i=0; i<num; i++)
+         column[i] += (status[i] != 0) * (1.0 - column[i]);
+   }
+}
+
+/* Add the faults of 'num' evaluated designs to their status masks
+(of 'validate_params()') and count the faulty ones. A NAN current
+means no operating point (like the negative discriminant of FET
+quadratics). Only the first fault of a design is kept (the lowest
+bit), the later ones are its consequences.
+
+unsigned char status[256];
+if (validate_params(config, num, params, status) > 0)
+   replace_faulty_params(config, num, params, status);
+config->evaluate(num, params, results);
+size_t faults = validate_results(config, num, results, status);
+if (status[0] & FAULT_DISCRIMINANT) ...
+*/
+static inline size_t validate_results(const struct Configuration *config,
+      size_t num, const double *const *results,
+      unsigned char *restrict status) {
+   double sum[VALIDATE_BLOCK];
+   size_t faults = 0;
+   for (size_t start=0; start<num; start+=VALIDATE_BLOCK) {
+      size_t block = (num - start < VALIDATE_BLOCK) ?
+                     num - start : VALIDATE_BLOCK;
+      memset(sum, 0, block * sizeof(double));
+      for (size_t r=0; r<config->nresults; r++)
+         _validate_column_(block, results[r] + start, 0, sum);
+      // Only the flagged designs (rare) are classified.
+      for (size_t i=0; i<block; i++) {
+         if (sum[i] != 0 && status[start + i] == 0)
+            status[start + i] = _result_fault_(config, start + i,
+                                               results);
+         faults += (status[start + i] != 0);
+      }
+   }
+   return faults;
+}
+
+#endif
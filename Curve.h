@@ -0,0 +1,386 @@
+/* Streaming Transfer Characteristics and Load Lines
+
+Plots of many parts need their curves: the Shockley transfer curve
+of JFETs (Id = Idss(1 - Vgs/Vp)^2), the k(Vgs - Vgsth)^2 transfer
+curve of E-MOSFETs and the DC load line of BJTs (from Icsat to the
+cut-off Vce). This source file evaluates these curves at 'points'
+equally spaced points of each part, writes them to a CSV or binary
+stream and finds the Q-point of each part (the intersection of its
+curve with its bias line) alongside.
+
+struct CurveStream stream = {text_buffer(), CURVE_BINARY};
+jfet_transfer_curves(parts, columns, 1000, stream, qpoints);
+
+IMPORTANT NOTES:
+----------------
+
+1. Points of a part are evaluated in chunks of CURVE_CHUNK points
+(vectorized over the points) and written to the buffer of stream
+(see Format.h), which is written to its file when it's full. So,
+memory doesn't depend on the count of parts or points.
+2. Text streams have a header row (part and the names of axes) and a
+row per point, in the mode of their buffer (CSV by default). Binary
+streams have a CurveHeader, then a CurveRecord (with the Q-point)
+and 'points' (x, y) pairs for each part. Values are native
+doubles, like result files (see ResultFile.h). Formatting numbers
+dominates text streams, so binary ones are about 100 times faster.
+3. FET bias lines are Vgs = VG - Id * Rs. So, VG is -Vgg and Rs is 0
+for fixed-bias designs, VG is 0 for self-bias designs, VG is Vg for
+voltage-divider designs and VG is Vdd and Rs is Rd for
+drain-feedback designs. Q-points solve the same quadratics as the
+'dc_*' functions (in a single form), so they may differ in the last
+bits.
+4. E-MOSFET curves end at VG (the bias line meets the Vgs axis
+there). BJT Q-points are on the load line at the Ic of the parts,
+limited to cut-off (0) and saturation (Icsat).
+5. Parameters aren't checked for each part. A negative discriminant
+gives a NAN Q-point, like the 'dc_*' functions.
+6. Functions return 0 on success and -1 on failure (with 'errno'
+set) after flushing the stream.
+
+EXISTING OPERATIONS:
+--------------------
+
++ Transfer curves (jfet_transfer_curves, mosfet_transfer_curves)
++ Load lines (bjt_load_lines)
+*/
+
+#ifndef CURVE_H
+#define CURVE_H
+
+// Libraries:
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "FET.h"
+#include "Format.h"
+
+// General constants:
+#define CURVE_MAGIC "TCCURVES" // first bytes of binary streams
+#define CURVE_VERSION 1 // version of binary layout
+#define CURVE_ENDIAN 0x01020304 // byte order marker
+#define CURVE_CHUNK 512 // points evaluated together
+#define CURVE_BLOCK 256 // parts whose Q-points are found together
+
+// Formats of curve streams:
+enum CurveFormat {
+   CURVE_CSV, // rows of part, x and y
+   CURVE_BINARY // records of parts (see CurveRecord)
+};
+
+// Stream of curves:
+struct CurveStream {
+   struct TextBuffer *text; // buffer and file (see Format.h)
+   enum CurveFormat format; // layout of curves
+};
+
+// Header of binary streams:
+struct CurveHeader {
+   char magic[8]; // CURVE_MAGIC
+   uint32_t version; // CURVE_VERSION
+   uint32_t endian; // CURVE_ENDIAN in native byte order
+   uint64_t parts; // count of parts
+   uint64_t points; // points of each part
+   char x[8]; // name of x axis ("Vgs" or "Vce")
+   char y[8]; // name of y axis ("Id" or "Ic")
+};
+
+// Record of a part in binary streams (followed by its points):
+struct CurveRecord {
+   uint64_t part; // index of part
+   double Vq; // voltage of Q-point
+   double Iq; // current of Q-point
+};
+
+// Columns of JFET parts and their bias lines:
+struct JFET_CurveParts {
+   const double *Idss; // drain-source saturation currents
+   const double *Vp; // pinch-off voltages
+   const double *VG; // gate voltages of bias lines
+   const double *Rs; // source resistances of bias lines
+};
+
+// Columns of E-MOSFET parts and their bias lines:
+struct MOSFET_CurveParts {
+   const double *k; // k constants (see 'mosfet_dc_*')
+   const double *Vgsth; // threshold voltages
+   const double *VG; // gate voltages of bias lines
+   const double *Rs; // source resistances of bias lines
+};
+
+// Columns of BJT parts (like their DC results):
+struct BJT_CurveParts {
+   const double *Vcc; // cut-off collector-emitter voltages
+   const double *Icsat; // collector saturation currents
+   const double *Ic; // collector currents
+};
+
+// Q-point columns of parts:
+struct CurveQPoints {
+   double *restrict V; // gate-source or collector-emitter voltages
+   double *restrict I; // drain or collector currents
+};
+
+// Curves of a block of parts, x = x0 + dx * t and
+// y = y0 + (y1 + y2 * t) * t for t in [0, 1]:
+struct CurveBlock {
+   double x0[CURVE_BLOCK], dx[CURVE_BLOCK];
+   double y0[CURVE_BLOCK], y1[CURVE_BLOCK], y2[CURVE_BLOCK];
+};
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Append raw bytes to the buffer of stream. */
+void _curve_bytes_(struct TextBuffer *text, const void *data,
+                   size_t bytes) {
+   _text_reserve_(text, bytes);
+   memcpy(text->data + text->length, data, bytes);
+   text->length += bytes;
+}
+
+/* Write the header of a stream. */
+void _curve_begin_(struct CurveStream stream, size_t parts,
+                   size_t points, const char *x, const char *y) {
+   if (stream.format == CURVE_CSV) {
+      text_begin_header(stream.text);
+      text_double(stream.text, "part", 0);
+      text_double(stream.text, x, 0);
+      text_double(stream.text, y, 0);
+      text_end_row(stream.text);
+      return;
+   }
+   struct CurveHeader header = {CURVE_MAGIC, CURVE_VERSION,
+                                CURVE_ENDIAN, parts, points};
+   strncpy(header.x, x, sizeof(header.x) - 1);
+   strncpy(header.y, y, sizeof(header.y) - 1);
+   _curve_bytes_(stream.text, &header, sizeof(header));
+}
+
+/* Evaluate 'num' points of a curve from the 'first' one as (x, y)
+pairs. */
+BATCH_DISPATCH
+void _curve_points_(size_t first, size_t num, size_t points,
+                    double x0, double dx, double y0, double y1,
+                    double y2, double *restrict xy) {
+   // One point is the beginning of curve.
+   double last = (points > 1) ? points - 1 : 1;
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++) {
+      double t = (double) (first + i) / last;
+      xy[2*i] = x0 + dx * t;
+      xy[2*i + 1] = y0 + (y1 + y2 * t) * t;
+   }
+}
+
+/* Write the curves of a block of parts (from the 'first' part). */
+void _curve_emit_(struct CurveStream stream, size_t first, size_t num,
+                  size_t points, const struct CurveBlock *block,
+                  struct CurveQPoints q, const char *x,
+                  const char *y) {
+   double xy[2 * CURVE_CHUNK];
+   for (size_t c=0; c<num; c++) {
+      size_t part = first + c;
+      if (stream.format == CURVE_BINARY) {
+         struct CurveRecord record = {part, q.V[part], q.I[part]};
+         _curve_bytes_(stream.text, &record, sizeof(record));
+      }
+      for (size_t p=0; p<points; p+=CURVE_CHUNK) {
+         size_t n = (points - p < CURVE_CHUNK) ? points - p : CURVE_CHUNK;
+         _curve_points_(p, n, points, block->x0[c], block->dx[c],
+                        block->y0[c], block->y1[c], block->y2[c], xy);
+         if (stream.format == CURVE_BINARY) {
+            _curve_bytes_(stream.text, xy, 2 * n * sizeof(double));
+            continue;
+         }
+         for (size_t i=0; i<n; i++) {
+            text_double(stream.text, "part", part);
+            text_double(stream.text, x, xy[2*i]);
+            text_double(stream.text, y, xy[2*i + 1]);
+            text_end_row(stream.text);
+         }
+      }
+   }
+}
+
+/* Find the Q-points and curves of a block of JFET parts. With
+u = 1 - VG/Vp and w = Rs/Vp, the Shockley equation on the bias line
+is Idss w^2 Id^2 + (2 Idss u w - 1) Id + Idss u^2 = 0. */
+BATCH_DISPATCH
+void _jfet_curve_block_(size_t num, struct JFET_CurveParts parts,
+                        struct CurveBlock *restrict block,
+                        struct CurveQPoints q) {
+   BATCH_LOOP
+   for (size_t c=0; c<num; c++) {
+      double Idss = parts.Idss[c], Vp = parts.Vp[c], Rs = parts.Rs[c];
+      double u = 1.0 - parts.VG[c] / Vp, w = Rs / Vp;
+      double Id = _drain_current_(Idss * w * w, 2 * Idss * u * w - 1,
+                                  Idss * u * u);
+      q.I[c] = Id;
+      q.V[c] = parts.VG[c] - Id * Rs;
+      // From pinch-off (t = 0) to Vgs = 0 (t = 1), Id = Idss t^2.
+      block->x0[c] = Vp;
+      block->dx[c] = -1 * Vp;
+      block->y0[c] = 0;
+      block->y1[c] = 0;
+      block->y2[c] = Idss;
+   }
+}
+
+/* Find the Q-points and curves of a block of E-MOSFET parts (the
+same quadratic as 'mosfet_dc_voltage_divider()'). */
+BATCH_DISPATCH
+void _mosfet_curve_block_(size_t num, struct MOSFET_CurveParts parts,
+                          struct CurveBlock *restrict block,
+                          struct CurveQPoints q) {
+   BATCH_LOOP
+   for (size_t c=0; c<num; c++) {
+      double k = parts.k[c], Rs = parts.Rs[c];
+      double d = parts.VG[c] - parts.Vgsth[c];
+      double Id = _drain_current_(k * Rs * Rs, -2 * k * Rs * d - 1,
+                                  k * d * d);
+      q.I[c] = Id;
+      q.V[c] = parts.VG[c] - Id * Rs;
+      // From threshold (t = 0) to VG (t = 1), Id = k d^2 t^2.
+      block->x0[c] = parts.Vgsth[c];
+      block->dx[c] = d;
+      block->y0[c] = 0;
+      block->y1[c] = 0;
+      block->y2[c] = k * d * d;
+   }
+}
+
+/* Find the Q-points and load lines of a block of BJT parts. */
+BATCH_DISPATCH
+void _bjt_curve_block_(size_t num, struct BJT_CurveParts parts,
+                       struct CurveBlock *restrict block,
+                       struct CurveQPoints q) {
+   BATCH_LOOP
+   for (size_t c=0; c<num; c++) {
+      double Icsat = parts.Icsat[c], Ic = parts.Ic[c];
+      // Limit Ic between cut-off and saturation (with blends, so the
+      // loop is vectorized).
+      Ic = Ic + (Ic > Icsat) * (Icsat - Ic);
+      Ic = Ic - (Ic < 0) * Ic;
+      q.I[c] = Ic;
+      q.V[c] = parts.Vcc[c] * (1.0 - Ic / Icsat);
+      // From Vce = 0 (t = 0) to cut-off (t = 1), Ic = Icsat (1 - t).
+      block->x0[c] = 0;
+      block->dx[c] = parts.Vcc[c];
+      block->y0[c] = Icsat;
+      block->y1[c] = -1 * Icsat;
+      block->y2[c] = 0;
+   }
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Write the transfer curves of 'parts' JFETs (from Vp to 0) with
+'points' points each and find their Q-points (see note 3).
+
+double Idss[2] = {0.008, 0.01}, Vp[2] = {-6, -8};
+double VG[2] = {0, -2}, Rs[2] = {1000, 0}, Vq[2], Iq[2];
+struct JFET_CurveParts columns = {Idss, Vp, VG, Rs};
+struct CurveQPoints qpoints = {Vq, Iq};
+struct CurveStream stream = {text_buffer(), CURVE_CSV};
+jfet_transfer_curves(2, columns, 3, stream, qpoints);
+
+part,Vgs,Id
+0,-6,0
+0,-3,0.002
+0,0,0.008
+1,-8,0
+1,-4,0.0025
+1,0,0.01
+
+Vq: -2.587624, -2.000000
+Iq: 2.587624e-03, 5.625000e-03
+*/
+int jfet_transfer_curves(size_t parts, struct JFET_CurveParts columns,
+                         size_t points, struct CurveStream stream,
+                         struct CurveQPoints q) {
+   // Check if the parameters of curves are consistent.
+   assert (points > 0 && stream.text != NULL);
+   static _Thread_local struct CurveBlock block;
+   _curve_begin_(stream, parts, points, "Vgs", "Id");
+   for (size_t first=0; first<parts; first+=CURVE_BLOCK) {
+      size_t n = (parts - first < CURVE_BLOCK) ? parts - first :
+                 CURVE_BLOCK;
+      struct JFET_CurveParts block_parts = {columns.Idss + first,
+         columns.Vp + first, columns.VG + first, columns.Rs + first};
+      struct CurveQPoints block_q = {q.V + first, q.I + first};
+      _jfet_curve_block_(n, block_parts, &block, block_q);
+      _curve_emit_(stream, first, n, points, &block, q, "Vgs", "Id");
+   }
+   return text_flush(stream.text);
+}
+
+/* Write the transfer curves of 'parts' E-MOSFETs (from Vgsth to VG)
+with 'points' points each and find their Q-points (see note 3).
+
+double k[1] = {2.4e-4}, Vgsth[1] = {3}, VG[1] = {12}, Rs[1] = {2000};
+struct MOSFET_CurveParts columns = {k, Vgsth, VG, Rs};
+mosfet_transfer_curves(1, columns, 1000, stream, qpoints);
+
+Vq: 6.411991
+Iq: 2.794004e-03
+*/
+int mosfet_transfer_curves(size_t parts,
+                           struct MOSFET_CurveParts columns,
+                           size_t points, struct CurveStream stream,
+                           struct CurveQPoints q) {
+   // Check if the parameters of curves are consistent.
+   assert (points > 0 && stream.text != NULL);
+   static _Thread_local struct CurveBlock block;
+   _curve_begin_(stream, parts, points, "Vgs", "Id");
+   for (size_t first=0; first<parts; first+=CURVE_BLOCK) {
+      size_t n = (parts - first < CURVE_BLOCK) ? parts - first :
+                 CURVE_BLOCK;
+      struct MOSFET_CurveParts block_parts = {columns.k + first,
+         columns.Vgsth + first, columns.VG + first, columns.Rs + first};
+      struct CurveQPoints block_q = {q.V + first, q.I + first};
+      _mosfet_curve_block_(n, block_parts, &block, block_q);
+      _curve_emit_(stream, first, n, points, &block, q, "Vgs", "Id");
+   }
+   return text_flush(stream.text);
+}
+
+/* Write the DC load lines of 'parts' BJTs (from Vce = 0 to Vcc) with
+'points' points each and find their Q-points (see note 4). The
+columns may be the DC results of a batch analysis.
+
+double Vcc[1] = {12}, Icsat[1] = {4e-3}, Ic[1] = {2.354167e-03};
+struct BJT_CurveParts columns = {Vcc, Icsat, Ic};
+bjt_load_lines(1, columns, 3, stream, qpoints);
+
+part,Vce,Ic
+0,0,0.004
+0,6,0.002
+0,12,0
+
+Vq: 4.937499
+Iq: 2.354167e-03
+*/
+int bjt_load_lines(size_t parts, struct BJT_CurveParts columns,
+                   size_t points, struct CurveStream stream,
+                   struct CurveQPoints q) {
+   // Check if the parameters of curves are consistent.
+   assert (points > 0 && stream.text != NULL);
+   static _Thread_local struct CurveBlock block;
+   _curve_begin_(stream, parts, points, "Vce", "Ic");
+   for (size_t first=0; first<parts; first+=CURVE_BLOCK) {
+      size_t n = (parts - first < CURVE_BLOCK) ? parts - first :
+                 CURVE_BLOCK;
+      struct BJT_CurveParts block_parts = {columns.Vcc + first,
+         columns.Icsat + first, columns.Ic + first};
+      struct CurveQPoints block_q = {q.V + first, q.I + first};
+      _bjt_curve_block_(n, block_parts, &block, block_q);
+      _curve_emit_(stream, first, n, points, &block, q, "Vce", "Ic");
+   }
+   return text_flush(stream.text);
+}
+
+#endif
@@ -0,0 +1,347 @@
+/* Standard-Value Design Search of BJT Bias Networks
+
+Analysis finds the operating point of given resistors. Design is
+the inverse: it finds the resistors for a wanted operating point.
+Real resistors have standard values (E12, E24, E96 series). So,
+this source file searches the standard values of voltage-divider
+configuration (Rb1, Rb2, Rc, Re) whose Ic and Vce are in the
+tolerance band of targets and returns the best ones.
+
+IMPORTANT NOTES:
+----------------
+
+1. Include this file instead of BJT.h, it includes BJT.h itself.
+2. Brute force over E96 with four resistors is about 10^11
+designs. Instead, the search is bounded (branch and bound):
+   + Ic decreases as Rb1 increases (Eth falls and Rth rises), so
+   Rb1 values stop when even the smallest Re can't reach Ic.
+   + For each base divider, only Re values which give Ic in the
+   band are searched.
+   + For each Re, only Rc values which give Vce in the band (so
+   Icsat above Ic) are searched.
+   + Re values whose Ic error alone is worse than the current
+   worst of best designs are skipped.
+3. Base dividers are shared by threads with work stealing. The
+best designs don't depend on the count of threads, but the count of
+evaluated designs does (each thread bounds with its own designs).
+4. Error of a design is sqrt(eIc^2 + eVce^2), where eIc and eVce
+are the relative errors of Ic and Vce.
+5. Only the first MAX_VALUES standard values of a range are searched
+(like E96 from 0.1 to 1e+10), the others are counted in 'clamped'.
+An empty range gives no designs.
+6. Link with '-pthread'.
+*/
+
+#ifndef DESIGN_H
+#define DESIGN_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include "BJT.h"
+#include "Parallel.h"
+
+// General constants:
+#define MAX_DESIGNS 10
+#define MAX_VALUES 1024
+
+// Standard resistor series:
+enum ResistorSeries {E12 = 12, E24 = 24, E96 = 96};
+
+// Values of each series in a decade:
+const double e12_values[12] = {
+   10, 12, 15, 18, 22, 27, 33, 39, 47, 56, 68, 82
+};
+const double e24_values[24] = {
+   10, 11, 12, 13, 15, 16, 18, 20, 22, 24, 27, 30,
+   33, 36, 39, 43, 47, 51, 56, 62, 68, 75, 82, 91
+};
+const double e96_values[96] = {
+   100, 102, 105, 107, 110, 113, 115, 118, 121, 124, 127, 130,
+   133, 137, 140, 143, 147, 150, 154, 158, 162, 165, 169, 174,
+   178, 182, 187, 191, 196, 200, 205, 210, 215, 221, 226, 232,
+   237, 243, 249, 255, 261, 267, 274, 280, 287, 294, 301, 309,
+   316, 324, 332, 340, 348, 357, 365, 374, 383, 392, 402, 412,
+   422, 432, 442, 453, 464, 475, 487, 499, 511, 523, 536, 549,
+   562, 576, 590, 604, 619, 634, 649, 665, 681, 698, 715, 732,
+   750, 768, 787, 806, 825, 845, 866, 887, 909, 931, 953, 976
+};
+
+// A voltage-divider design:
+struct Design {
+   double Rb1; // upper base resistor
+   double Rb2; // lower base resistor
+   double Rc; // collector resistor
+   double Re; // emitter resistor
+   double Ic; // collector current
+   double Vce; // collector-emitter voltage
+   double error; // relative error to targets
+};
+
+// Results of design search:
+struct DesignResults {
+   size_t count; // count of found designs
+   size_t evaluated; // count of analyzed designs
+   size_t clamped; // standard values beyond MAX_VALUES (not searched)
+   struct Design designs[MAX_DESIGNS]; // best designs first
+};
+
+// User-defined analysis types:
+typedef struct DesignResults DesignAnalysis;
+
+// Best designs found by a thread:
+struct DesignPart {
+   size_t count; // count of found designs
+   size_t evaluated; // count of analyzed designs
+   struct Design designs[MAX_DESIGNS]; // best designs first
+};
+
+// Common state of a design search:
+struct DesignRun {
+   double Vcc, beta; // supply and transistor
+   double Ic, Vce, tolerance; // targets and band
+   const double *values; // standard values (ascending)
+   size_t num; // count of standard values
+   struct DesignPart *parts; // best designs of threads
+   struct WorkQueue *queues; // base dividers of threads
+   size_t threads; // count of threads
+};
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Find the first index of ascending 'values' not less than 'x'. */
+size_t _lower_index_(const double *values, size_t num, double x) {
+   // Search binary, the values are sorted.
+   size_t low = 0, high = num;
+   while (low < high) {
+      size_t middle = low + (high - low) / 2;
+      if (values[middle] < x) low = middle + 1;
+      else high = middle;
+   }
+   return low;
+}
+
+/* Check if design 'a' is better than 'b'. Equal errors are ordered
+by the resistors, so the order doesn't depend on the threads. */
+int _better_design_(const struct Design *a, const struct Design *b) {
+   // Compare the errors, then each resistor.
+   if (a->error != b->error) return a->error < b->error;
+   if (a->Rb1 != b->Rb1) return a->Rb1 < b->Rb1;
+   if (a->Rb2 != b->Rb2) return a->Rb2 < b->Rb2;
+   if (a->Re != b->Re) return a->Re < b->Re;
+   return a->Rc < b->Rc;
+}
+
+/* Insert the design to the sorted best designs if it's good enough. */
+void _insert_design_(struct Design *designs, size_t *count,
+                     struct Design design) {
+   // Find the place of design and shift the worse ones.
+   size_t place = *count;
+   while (place > 0 && _better_design_(&design, &designs[place - 1]))
+      place--;
+   if (place >= MAX_DESIGNS) return;
+   if (*count < MAX_DESIGNS) (*count)++;
+   for (size_t i=*count-1; i>place; i--) designs[i] = designs[i - 1];
+   designs[place] = design;
+}
+
+/* Search all designs whose lower base resistor is 'Rb2'. */
+void _search_divider_(const struct DesignRun *run, double Rb2,
+                      struct DesignPart *part) {
+   const double *values = run->values;
+   size_t num = run->num;
+   double beta = run->beta, Vcc = run->Vcc;
+   double IcLow = run->Ic * (1 - run->tolerance);
+   double IcHigh = run->Ic * (1 + run->tolerance);
+   double VceLow = run->Vce * (1 - run->tolerance);
+   double VceHigh = run->Vce * (1 + run->tolerance);
+
+   for (size_t i=0; i<num; i++) {
+      double Rb1 = values[i];
+      double rth = _Rth_(Rb1, Rb2);
+      double eth = _Eth_(Vcc, Rb1, Rb2);
+      // Bound on Eth: larger Rb1 gives even less current.
+      double IcMax = beta * (eth - Vbe) /
+                     (rth + (beta + 1) * values[0]);
+      if (IcMax < IcLow) break;
+      double IcMin = beta * (eth - Vbe) /
+                     (rth + (beta + 1) * values[num - 1]);
+      if (IcMin > IcHigh) continue;
+      // Find the Re values which give Ic in the band.
+      double ReLow = (beta * (eth - Vbe) / IcHigh - rth) / (beta + 1);
+      double ReHigh = (beta * (eth - Vbe) / IcLow - rth) / (beta + 1);
+      size_t first = _lower_index_(values, num, ReLow);
+      size_t last = _lower_index_(values, num, ReHigh);
+      first = (first > 0) ? first - 1 : 0;
+      last = (last < num) ? last + 1 : num;
+
+      for (size_t j=first; j<last; j++) {
+         double Re = values[j];
+         // Calculate Ic in the same way as bjt_dc_voltage_divider().
+         double Ic = beta * ((eth - Vbe) / (rth + (beta + 1) * Re));
+         if (Ic < IcLow || Ic > IcHigh) continue;
+         // Bound on the error: Ic error alone may be too large.
+         double eIc = (Ic - run->Ic) / run->Ic;
+         if (part->count == MAX_DESIGNS &&
+             fabs(eIc) > part->designs[MAX_DESIGNS - 1].error)
+            continue;
+         // Find the Rc values which give Vce in the band.
+         double RcLow = (Vcc - VceHigh) / Ic - Re;
+         double RcHigh = (Vcc - VceLow) / Ic - Re;
+         size_t start = _lower_index_(values, num, RcLow);
+         size_t stop = _lower_index_(values, num, RcHigh);
+         start = (start > 0) ? start - 1 : 0;
+         stop = (stop < num) ? stop + 1 : num;
+
+         for (size_t k=start; k<stop; k++) {
+            double Rc = values[k];
+            BJT_DCAnalysis dc = bjt_dc_voltage_divider(Vcc, Rb1, Rb2,
+                                                       Rc, Re, beta);
+            part->evaluated++;
+            if (dc.Ic < IcLow || dc.Ic > IcHigh) continue;
+            if (dc.Vce < VceLow || dc.Vce > VceHigh) continue;
+            double eVce = (dc.Vce - run->Vce) / run->Vce;
+            eIc = (dc.Ic - run->Ic) / run->Ic;
+            struct Design design = {Rb1, Rb2, Rc, Re, dc.Ic, dc.Vce,
+                                    sqrt(eIc * eIc + eVce * eVce)};
+            _insert_design_(part->designs, &part->count, design);
+         }
+      }
+   }
+}
+
+/* Search the base dividers of a thread and steal others when idle. */
+void _design_worker_(void *args, size_t index) {
+   struct DesignRun *run = args;
+   size_t item;
+   // Prefer own base dividers, then the ones of other threads.
+   while (1) {
+      if (take_work(&run->queues[index], &item))
+         _search_divider_(run, run->values[item], &run->parts[index]);
+      else if (!steal_work(run->queues, run->threads, index)) break;
+   }
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------- Display Results --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Display the results of design search. */
+void display_design_results(DesignAnalysis analysis) {
+   // Display the best designs.
+   printf("designs: %zu (evaluated: %zu)\n", analysis.count,
+          analysis.evaluated);
+   if (analysis.clamped > 0)
+      printf("clamped: %zu standard values\n", analysis.clamped);
+   for (size_t i=0; i<analysis.count; i++) {
+      struct Design design = analysis.designs[i];
+      printf("Rb1=%g Rb2=%g Rc=%g Re=%g: Ic=%e A Vce=%f V "
+             "error=%.4f%%\n", design.Rb1, design.Rb2, design.Rc,
+             design.Re, design.Ic, design.Vce, 100 * design.error);
+   }
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Write the standard values of 'series' between 'Rmin' and 'Rmax' to
+'values' and return their count. Only the first MAX_VALUES of them
+are written, so a count above MAX_VALUES means a clamped range.
+
+double values[MAX_VALUES];
+size_t num = standard_resistors(E12, 1000, 10000, values);
+
+values: 1000, 1200, 1500, 1800, 2200, 2700, 3300, 3900, 4700, 5600,
+        6800, 8200, 10000
+*/
+size_t standard_resistors(enum ResistorSeries series, double Rmin,
+                          double Rmax, double *values) {
+   // Check if the parameters are consistent.
+   assert (series == E12 || series == E24 || series == E96);
+   assert (Rmin > 0 && Rmax >= Rmin && values != NULL);
+   const double *decade = (series == E12) ? e12_values :
+                          (series == E24) ? e24_values : e96_values;
+   double digits = (series == E96) ? 100 : 10;
+   // Scale the values of a decade to each decade in the range.
+   size_t num = 0;
+   for (int exponent=-3; exponent<=12; exponent++) {
+      for (int i=0; i<series; i++) {
+         // Divide by exact powers, so 10.2 isn't 10.200000000000001.
+         double value = (exponent >= 0) ?
+            decade[i] * pow(10, exponent) / digits :
+            decade[i] / (digits * pow(10, -exponent));
+         if (value < Rmin || value > Rmax) continue;
+         if (num < MAX_VALUES) values[num] = value;
+         num++;
+      }
+   }
+   return num;
+}
+
+/* Search the standard resistors of voltage-divider configuration.
+
+The resistors (Rb1, Rb2, Rc, Re) are taken from 'series' between
+'Rmin' and 'Rmax'. The designs whose Ic and Vce are in the relative
+'tolerance' band of targets are searched on 'threads' threads (0
+means all processors) and the best ones are returned.
+
+double Vcc=22, beta=100, Ic=0.002, Vce=10, tolerance=0.01;
+DesignAnalysis analysis = design_voltage_divider(Vcc, beta, Ic, Vce,
+                                 tolerance, E96, 100, 1000000, 0);
+display_design_results(analysis);
+
+designs: 10 (evaluated: 2881)
+Rb1=34000 Rb2=28000 Rc=1580 Re=4420: Ic=1.999997e-03 A ...
+Rb1=4220 Rb2=2550 Rc=2260 Re=3740: Ic=1.999992e-03 A ...
+Rb1=221000 Rb2=562000 Rc=100 Re=5900: Ic=2.000011e-03 A ...
+...
+*/
+DesignAnalysis design_voltage_divider(double Vcc, double beta,
+               double Ic, double Vce, double tolerance,
+               enum ResistorSeries series, double Rmin, double Rmax,
+               size_t threads) {
+   // Check if the parameters of design are consistent.
+   assert (Vcc > 0 && beta > 0 && Ic > 0 && Vce > 0 && Vce < Vcc);
+   assert (tolerance > 0 && tolerance < 1);
+   // Create design analysis object.
+   DesignAnalysis analysis = {0};
+   double values[MAX_VALUES];
+   struct DesignRun run = {Vcc, beta, Ic, Vce, tolerance, values};
+   run.num = standard_resistors(series, Rmin, Rmax, values);
+   if (run.num > MAX_VALUES) {
+      analysis.clamped = run.num - MAX_VALUES;
+      run.num = MAX_VALUES;
+   }
+   // An empty range hasn't any base divider to share.
+   if (run.num == 0) return analysis;
+   run.threads = _num_threads_(threads);
+   if (run.threads > run.num) run.threads = run.num;
+   run.parts = calloc(run.threads, sizeof(struct DesignPart));
+   assert (run.parts != NULL);
+   // Share the lower base resistors (Rb2) between the threads.
+   run.queues = create_work_queues(run.threads);
+   for (size_t t=0; t<run.threads; t++)
+      fill_work_queue(&run.queues[t], run.num * t / run.threads,
+                      run.num * (t + 1) / run.threads);
+   parallel_run(run.threads, _design_worker_, &run);
+
+   // Merge the best designs of threads.
+   for (size_t t=0; t<run.threads; t++) {
+      struct DesignPart *part = &run.parts[t];
+      analysis.evaluated += part->evaluated;
+      for (size_t i=0; i<part->count; i++)
+         _insert_design_(analysis.designs, &analysis.count,
+                         part->designs[i]);
+   }
+
+   destroy_work_queues(run.queues, run.threads);
+   free(run.parts);
+   return analysis;
+}
+
+#endif
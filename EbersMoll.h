@@ -0,0 +1,699 @@
+/* Exact (Ebers-Moll) Operating Points of BJT Configurations
+
+Every 'bjt_dc_*()' function of BJT.h assumes the active region with a
+fixed Vbe of 0.7 V. So, an overdriven design gets a negative Vce
+instead of saturating. This source file solves the bias networks with
+the Ebers-Moll equations of both junctions by Newton-Raphson, starting
+from the closed-form result, and reports the operating region. The
+batch evaluations iterate SIMD lanes of designs together with a
+convergence mask per lane. This design is saturated, but
+'bjt_dc_fixed_bias()' gives a Vce of -10.129167 V:
+
+double Vcc=12, Rb=240000, Rc=4700, beta=100, ro=50000;
+BJT_ExactAnalysis analysis = bjt_exact_fixed_bias(Vcc, Rb, Rc, beta,
+      ro, bjt_junctions);
+bjt_display_exact_results(analysis);
+
+Ic: 2.526676e-03 A
+Vce: 0.124625 V
+Vbe: 0.724919 V
+region: saturation
+iterations: 7
+
+IMPORTANT NOTES:
+----------------
+
+1. Include this file instead of BJT.h, it includes it.
+2. The forward current gain is 'beta' of the configuration and the
+reverse one, the saturation current and the thermal voltage are given
+by 'struct BJT_EbersMoll' (typical silicon is 'bjt_junctions', its
+Vbe is 0.7 V at about 1 mA).
+3. The unknowns are Vbe and Vbc. Newton steps which forward bias a
+junction more are limited to BJT_EM_STEP, so the exponentials don't
+overflow, and the iteration stops when a step moves both of them less
+than BJT_EM_TOLERANCE in total. Newton steps converge quadratically,
+so that last step leaves only rounding errors.
+4. A junction conducts above BJT_EM_ON. The region is cutoff (none),
+active (base-emitter), reverse (base-collector) or saturation (both).
+A design which doesn't converge in BJT_EM_ITERATIONS has the region
+BJT_UNCONVERGED.
+5. AC results are the 're' model of BJT.h at the exact operating
+point (re is VT / Ie). They are meaningful only in the active region.
+6. Only the bias configurations whose base network is a Thevenin
+source (and collector-feedback) are supported: fixed-bias,
+emitter-bias, voltage-divider and collector-feedback.
+7. Batch lanes are stepped until all lanes of their block converge,
+so a slow design costs its block more iterations (see EXACT_BLOCK).
+Their results may differ from the scalar ones in the last bits when
+the clone contracts to FMA.
+8. Link with '-lm'.
+
+EXISTING CONFIGURATIONS:
+------------------------
+
++ Fixed-Bias Configuration (bjt_exact_fixed_bias)
++ Emitter-Bias Configuration (bjt_exact_emitter_bias)
++ Voltage-Divider Configuration (bjt_exact_voltage_divider)
++ Collector-Feedback Configuration (bjt_exact_collector_feedback)
+
+UNIFORM DESCRIPTIONS:
+---------------------
+
++ bjt_exact_configurations[] (results end with "Vbe", "region" and
+"iterations")
+*/
+
+#ifndef EBERSMOLL_H
+#define EBERSMOLL_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include "BJT.h"
+
+// General constants:
+#define BJT_EM_STEP 0.1 // maximum forward step of a junction voltage
+#define BJT_EM_TOLERANCE 1e-9 // total step of converged voltages
+#define BJT_EM_ITERATIONS 100 // maximum Newton-Raphson iterations
+#define BJT_EM_ON 0.5 // junction voltage of conduction
+#define EXACT_BLOCK 64 // designs of one batch block
+
+// Junction model of a transistor:
+struct BJT_EbersMoll {
+   double Is; // saturation current of junctions
+   double betaR; // reverse current gain
+   double VT; // thermal voltage
+};
+
+// Typical silicon transistor (Vbe is 0.7 V at about 1 mA):
+const struct BJT_EbersMoll bjt_junctions = {2e-15, 1, 0.026};
+
+// Operating regions of a transistor:
+enum BJT_Region {
+   BJT_CUTOFF, // no junction conducts
+   BJT_ACTIVE, // base-emitter junction conducts
+   BJT_REVERSE, // base-collector junction conducts
+   BJT_SATURATION, // both junctions conduct
+   BJT_UNCONVERGED // not solved in BJT_EM_ITERATIONS
+};
+
+// Names of operating regions:
+const string bjt_region_names[] = {
+   "cutoff", "active", "reverse", "saturation", "unconverged"
+};
+
+// Bias network of a configuration:
+struct BJT_BiasNetwork {
+   double Vcc; // supply voltage
+   double V; // Thevenin voltage of base (unused with feedback)
+   double Rb; // base resistance (Rb, Rth or Rf)
+   double Rc; // collector resistance
+   double Re; // emitter resistance
+   double feedback; // 1 if the base resistance is fed by collector
+};
+
+// Junction voltages of a transistor:
+struct BJT_Junctions {
+   double be; // base-emitter voltage
+   double bc; // base-collector voltage
+};
+
+// Results of exact analysis:
+struct BJT_ExactResults {
+   struct BJT_DCResults dc; // DC analysis
+   struct BJT_ACResults ac; // AC analysis
+   double VbeEM; // base-emitter voltage
+   enum BJT_Region region; // operating region
+   int iterations; // Newton-Raphson iterations
+};
+
+// Block of bias network columns (of batch designs):
+struct BJT_NetworkColumns {
+   const double *Vcc; // supply voltages
+   const double *V; // Thevenin voltages of base
+   const double *Rb; // base resistances
+   const double *Rc; // collector resistances
+   const double *Re; // emitter resistances
+   const double *beta; // forward current gains
+   double feedback; // 1 if the base resistances are fed by collector
+};
+
+// User-defined analysis types:
+typedef struct BJT_ExactResults BJT_ExactAnalysis;
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Limit 'x' to at most (or at least) 'limit' without any branch. GCC
+doesn't if-convert a select of a constant which is used by later
+arithmetic (it may trap), so the comparison is multiplied instead. A
+limited result may differ from 'limit' in the last bit. */
+double _bjt_em_min_(double x, double limit) {
+   return x + (x > limit) * (limit - x);
+}
+double _bjt_em_max_(double x, double limit) {
+   return x + (x < limit) * (limit - x);
+}
+
+/* Get exp(x) without any branch or call, so batch loops are
+vectorized. 'x' is rounded to 'k' ln(2) plus a remainder which is
+at most ln(2) / 2, and 2^k is put into the exponent bits. The
+relative error is about one ULP and 'x' is clamped to +-700. */
+double _bjt_em_exp_(double x) {
+   x = _bjt_em_min_(_bjt_em_max_(x, -700), 700);
+   // Adding 1.5 * 2^52 rounds 'k' into the low bits of mantissa.
+   double k = x * 1.4426950408889634 + 0x1.8p52;
+   uint64_t bits;
+   memcpy(&bits, &k, sizeof(bits));
+   k -= 0x1.8p52;
+   // ln(2) is split, so 'k' times its high part is exact.
+   double r = (x - k * 6.93147180369123816490e-01) -
+              k * 1.90821492927058770002e-10;
+   // Taylor series of remainder (its 14th term is below 1e-17).
+   double p = 1.0 / 6227020800;
+   p = p * r + 1.0 / 479001600;
+   p = p * r + 1.0 / 39916800;
+   p = p * r + 1.0 / 3628800;
+   p = p * r + 1.0 / 362880;
+   p = p * r + 1.0 / 40320;
+   p = p * r + 1.0 / 5040;
+   p = p * r + 1.0 / 720;
+   p = p * r + 1.0 / 120;
+   p = p * r + 1.0 / 24;
+   p = p * r + 1.0 / 6;
+   p = p * r + 0.5;
+   p = p * r + 1;
+   p = p * r + 1;
+   // Add 'k' to the exponent of 'p'.
+   uint64_t scaled;
+   memcpy(&scaled, &p, sizeof(scaled));
+   scaled += bits << 52;
+   memcpy(&p, &scaled, sizeof(p));
+   return p;
+}
+
+/* Get the bias network of c'th design of a block. */
+struct BJT_BiasNetwork _bjt_network_(struct BJT_NetworkColumns columns,
+                                     size_t c) {
+   struct BJT_BiasNetwork network = {columns.Vcc[c], columns.V[c],
+         columns.Rb[c], columns.Rc[c], columns.Re[c],
+         columns.feedback};
+   return network;
+}
+
+/* Get the initial junction voltages from the closed-form analysis
+(Vbe is 0.7 V and Ic is beta * Ib). The base-collector junction is
+limited below Vbe (saturated designs) and above the open base
+voltage minus Vcc (cut off designs). */
+struct BJT_Junctions _bjt_exact_guess_(struct BJT_BiasNetwork network,
+                                       double beta) {
+   double open = (1 - network.feedback) * network.V +
+                 network.feedback * network.Vcc;
+   double Ib = (open - Vbe) / (network.Rb + (beta + 1 -
+               network.feedback) * network.Re + network.feedback *
+               beta * network.Rc);
+   double Vbc = Vbe - network.Vcc + beta * Ib * (network.Rc +
+                network.Re);
+   struct BJT_Junctions x;
+   x.be = _bjt_em_min_(open, Vbe);
+   x.bc = _bjt_em_max_(_bjt_em_min_(Vbc, x.be - 0.2),
+                       x.be - network.Vcc);
+   return x;
+}
+
+/* Do one Newton-Raphson step of the junction voltages. The residuals
+are the base loop 'V - Vb - Rb * Ib' (or 'Vc - Vb - Rf * Ib' with
+feedback) and the collector loop 'Vcc - Vc - Rc * (Ic + Ib)' (Ib only
+with feedback), and the 2x2 system is solved by Cramer's rule. */
+struct BJT_Junctions _bjt_exact_newton_(struct BJT_BiasNetwork network,
+      double beta, struct BJT_EbersMoll model, struct BJT_Junctions x) {
+   // Ebers-Moll currents and their conductances (the reciprocals of
+   // model are constants, so a step has only two divisions).
+   double uT = 1 / model.VT, uR = 1 / model.betaR, uF = 1 / beta;
+   double Ef = _bjt_em_exp_(x.be * uT), Er = _bjt_em_exp_(x.bc * uT);
+   double If = model.Is * (Ef - 1), Ir = model.Is * (Er - 1);
+   double gf = model.Is * uT * Ef, gr = model.Is * uT * Er;
+   double kR = 1 + uR, g = network.feedback, open = 1 - g;
+   double Ib = If * uF + Ir * uR, Ic = If - kR * Ir;
+   double Vb = (Ic + Ib) * network.Re + x.be;
+   double F1 = open * (network.V - Vb) - g * x.bc - network.Rb * Ib;
+   double F2 = network.Vcc - (Vb - x.bc) - network.Rc * (Ic + g * Ib);
+   // Jacobian of the residuals by Vbe (a) and Vbc (c).
+   double dIb_a = gf * uF, dIb_c = gr * uR;
+   double dIc_a = gf, dIc_c = -kR * gr;
+   double dVb_a = 1 + network.Re * (dIc_a + dIb_a);
+   double dVb_c = network.Re * (dIc_c + dIb_c);
+   double J11 = -open * dVb_a - network.Rb * dIb_a;
+   double J12 = -open * dVb_c - g - network.Rb * dIb_c;
+   double J21 = -dVb_a - network.Rc * (dIc_a + g * dIb_a);
+   double J22 = 1 - dVb_c - network.Rc * (dIc_c + g * dIb_c);
+   double inverse = 1 / (J11 * J22 - J12 * J21);
+   double da = (F2 * J12 - F1 * J22) * inverse;
+   double dc = (F1 * J21 - F2 * J11) * inverse;
+   // Limit the forward steps.
+   struct BJT_Junctions y;
+   y.be = x.be + _bjt_em_min_(da, BJT_EM_STEP);
+   y.bc = x.bc + _bjt_em_min_(dc, BJT_EM_STEP);
+   return y;
+}
+
+/* Get the total step between two junction voltages. */
+double _bjt_exact_step_(struct BJT_Junctions x,
+                        struct BJT_Junctions y) {
+   return fabs(y.be - x.be) + fabs(y.bc - x.bc);
+}
+
+/* Find the DC results and the region at the solved junction
+voltages. */
+BJT_ExactAnalysis _bjt_exact_point_(struct BJT_BiasNetwork network,
+      double beta, struct BJT_EbersMoll model, struct BJT_Junctions x,
+      int iterations, double converged) {
+   BJT_ExactAnalysis analysis;
+   double uT = 1 / model.VT, uR = 1 / model.betaR;
+   double If = model.Is * (_bjt_em_exp_(x.be * uT) - 1);
+   double Ir = model.Is * (_bjt_em_exp_(x.bc * uT) - 1);
+   analysis.dc.Ib = If * (1 / beta) + Ir * uR;
+   analysis.dc.Ic = If - (1 + uR) * Ir;
+   analysis.dc.Ie = analysis.dc.Ic + analysis.dc.Ib;
+   analysis.dc.Icsat = network.Vcc / (network.Rc + network.Re);
+   analysis.dc.Ve = analysis.dc.Ie * network.Re;
+   analysis.dc.Vb = analysis.dc.Ve + x.be;
+   analysis.dc.Vc = analysis.dc.Vb - x.bc;
+   analysis.dc.Vce = analysis.dc.Vc - analysis.dc.Ve;
+   analysis.dc.Vbc = x.bc;
+   analysis.VbeEM = x.be;
+   analysis.iterations = iterations;
+   // Find the region by the conducting junctions (see the order of
+   // 'BJT_Region'), without any branch.
+   double region = (x.be >= BJT_EM_ON) + 2.0 * (x.bc >= BJT_EM_ON);
+   region += (1 - converged) * (BJT_UNCONVERGED - region);
+   analysis.region = (enum BJT_Region) region;
+   return analysis;
+}
+
+/* Solve the operating point of a bias network. */
+BJT_ExactAnalysis _bjt_exact_bias_(struct BJT_BiasNetwork network,
+      double beta, struct BJT_EbersMoll model) {
+   // Check if the junction model is consistent.
+   assert (model.Is > 0 && model.betaR > 0 && model.VT > 0);
+   struct BJT_Junctions x = _bjt_exact_guess_(network, beta);
+   int iterations = 0, converged = 0;
+   while (!converged && iterations < BJT_EM_ITERATIONS) {
+      struct BJT_Junctions y = _bjt_exact_newton_(network, beta, model,
+                                                  x);
+      converged = _bjt_exact_step_(x, y) <= BJT_EM_TOLERANCE;
+      x = y;
+      iterations++;
+   }
+   return _bjt_exact_point_(network, beta, model, x, iterations,
+                            converged);
+}
+
+/* Solve the junction voltages of 'n' designs of a block (at most
+EXACT_BLOCK) together. Each iteration steps every lane, but a lane
+whose mask is set keeps its voltages and count, so the loops are
+vectorized across designs and the results are the scalar ones. */
+void _bjt_exact_lanes_(size_t n, struct BJT_NetworkColumns columns,
+      struct BJT_EbersMoll model, double *restrict bes,
+      double *restrict bcs, double *restrict iterations,
+      double *restrict done) {
+   BATCH_LOOP
+   for (size_t c=0; c<n; c++) {
+      struct BJT_Junctions x = _bjt_exact_guess_(_bjt_network_(columns,
+            c), columns.beta[c]);
+      bes[c] = x.be; bcs[c] = x.bc;
+      iterations[c] = 0; done[c] = 0;
+   }
+   for (int k=0; k<BJT_EM_ITERATIONS; k++) {
+      BATCH_LOOP
+      for (size_t c=0; c<n; c++) {
+         struct BJT_Junctions x = {bes[c], bcs[c]};
+         struct BJT_Junctions y = _bjt_exact_newton_(_bjt_network_(
+               columns, c), columns.beta[c], model, x);
+         double masked = done[c];
+         double converged = _bjt_exact_step_(x, y) <= BJT_EM_TOLERANCE;
+         // Converged lanes are masked (no branch, see note 1 of
+         // Batch.h).
+         bes[c] = (masked != 0) ? x.be : y.be;
+         bcs[c] = (masked != 0) ? x.bc : y.bc;
+         iterations[c] += 1 - masked;
+         done[c] = masked + converged * (1 - masked);
+      }
+      // Stop once every lane has converged (masks are 0 or 1).
+      size_t c = 0;
+      while (c < n && done[c] != 0) c++;
+      if (c == n) break;
+   }
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------- Display Results --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Display the operating point of any configuration (all DC results
+are displayed by 'bjt_display_dc_results()'). */
+void bjt_display_exact_results(BJT_ExactAnalysis analysis) {
+   // Display the solved point and how it was found.
+   printf("Ic: %e A\n", analysis.dc.Ic);
+   printf("Vce: %f V\n", analysis.dc.Vce);
+   printf("Vbe: %f V\n", analysis.VbeEM);
+   printf("region: %s\n", bjt_region_names[analysis.region]);
+   printf("iterations: %d\n", analysis.iterations);
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Exact analysis of fixed-bias transistor configuration.
+
+double Vcc=12, Rb=240000, Rc=2200, beta=50, ro=50000;
+BJT_ExactAnalysis analysis = bjt_exact_fixed_bias(Vcc, Rb, Rc, beta,
+      ro, bjt_junctions);
+bjt_display_exact_results(analysis);
+
+Ic: 2.349460e-03 A
+Vce: 6.831189 V
+Vbe: 0.722594 V
+region: active
+iterations: 6
+*/
+BJT_ExactAnalysis bjt_exact_fixed_bias(double Vcc, double Rb,
+      double Rc, double beta, double ro, struct BJT_EbersMoll model) {
+   // Check if parameters of transistor are consistent.
+   assert (Rb > 0 && Rc > 0 && beta > 0 && ro > 0);
+   struct BJT_BiasNetwork network = {Vcc, Vcc, Rb, Rc, 0, 0};
+   BJT_ExactAnalysis analysis = _bjt_exact_bias_(network, beta, model);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac = _bjt_ac_bypassed_(model.VT / analysis.dc.Ie, Rb, Rc,
+                                   beta, ro);
+
+   return analysis;
+}
+
+/* Exact analysis of emitter-bias transistor configuration.
+
+double Vcc=20, Rb=430000, Rc=2000, Re=1000, beta=50, ro=40000;
+BJT_ExactAnalysis analysis = bjt_exact_emitter_bias(Vcc, Rb, Rc, Re,
+      beta, ro, bjt_junctions);
+bjt_display_exact_results(analysis);
+
+Ic: 2.004318e-03 A
+Vce: 13.946960 V
+Vbe: 0.718463 V
+region: active
+iterations: 6
+*/
+BJT_ExactAnalysis bjt_exact_emitter_bias(double Vcc, double Rb,
+      double Rc, double Re, double beta, double ro,
+      struct BJT_EbersMoll model) {
+   // Check if parameters of transistor are consistent.
+   assert (Rb > 0 && Rc > 0 && Re > 0 && beta > 0 && ro > 0);
+   struct BJT_BiasNetwork network = {Vcc, Vcc, Rb, Rc, Re, 0};
+   BJT_ExactAnalysis analysis = _bjt_exact_bias_(network, beta, model);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac = _bjt_ac_unbypassed_(model.VT / analysis.dc.Ie, Rb,
+                                     Rc, Re, beta, ro);
+
+   return analysis;
+}
+
+/* Exact analysis of voltage-divider transistor configuration.
+
+double Vcc=22, Rb1=39000, Rb2=3900, Rc=10000, Re=1500, beta=100;
+double ro=50000;
+string bypass = "bypassed";
+BJT_ExactAnalysis analysis = bjt_exact_voltage_divider(Vcc, Rb1, Rb2,
+      Rc, Re, beta, ro, bypass, bjt_junctions);
+bjt_display_exact_results(analysis);
+
+Ic: 8.411172e-04 A
+Vce: 12.314536 V
+Vbe: 0.695886 V
+region: active
+iterations: 4
+*/
+BJT_ExactAnalysis bjt_exact_voltage_divider(double Vcc, double Rb1,
+      double Rb2, double Rc, double Re, double beta, double ro,
+      string bypass, struct BJT_EbersMoll model) {
+   // Check if parameters of transistor are consistent.
+   assert (Rb1 > 0 && Rb2 > 0 && Rc > 0 && Re > 0 && beta > 0 &&
+           ro > 0);
+   assert (strcmp(bypass, "bypassed") == 0 ||
+           strcmp(bypass, "unbypassed") == 0);
+   double rth = _Rth_(Rb1, Rb2);
+   struct BJT_BiasNetwork network = {Vcc, _Eth_(Vcc, Rb1, Rb2), rth, Rc,
+                                     Re, 0};
+   BJT_ExactAnalysis analysis = _bjt_exact_bias_(network, beta, model);
+   // According to 'bypass' parameter, there are two options.
+   double re = model.VT / analysis.dc.Ie;
+   if (strcmp(bypass, "bypassed") == 0)
+      analysis.ac = _bjt_ac_bypassed_(re, rth, Rc, beta, ro);
+   else analysis.ac = _bjt_ac_unbypassed_(re, rth, Rc, Re, beta, ro);
+
+   return analysis;
+}
+
+/* Exact analysis of collector-feedback transistor configuration. In
+AC domain, 'Re' is assumed as bypassed.
+
+double Vcc=10, Rf=250000, Rc=4700, Re=1200, beta=90, ro=1e+6;
+BJT_ExactAnalysis analysis = bjt_exact_collector_feedback(Vcc, Rf, Rc,
+      Re, beta, ro, bjt_junctions);
+bjt_display_exact_results(analysis);
+
+Ic: 1.063441e-03 A
+Vce: 3.655986 V
+Vbe: 0.701984 V
+region: active
+iterations: 4
+*/
+BJT_ExactAnalysis bjt_exact_collector_feedback(double Vcc, double Rf,
+      double Rc, double Re, double beta, double ro,
+      struct BJT_EbersMoll model) {
+   // Check if parameters of transistor are consistent.
+   assert (Rf > 0 && Rc > 0 && Re > 0 && beta > 0 && ro > 0);
+   struct BJT_BiasNetwork network = {Vcc, Vcc, Rf, Rc, Re, 1};
+   BJT_ExactAnalysis analysis = _bjt_exact_bias_(network, beta, model);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac = _bjt_ac_feedback_(model.VT / analysis.dc.Ie, Rf, Rc,
+                                   beta, ro);
+
+   return analysis;
+}
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Uniform Definations -------------------- */
+/* --------------------------------------------------------------- */
+
+/* Store the exact analysis of i'th design to the uniform result
+columns. */
+void _bjt_store_exact_(BJT_ExactAnalysis analysis, size_t i,
+                       double *const *results) {
+   BJT_FusedAnalysis fused = {analysis.dc, analysis.ac};
+   _bjt_store_fused_(fused, i, _bjt_dc_columns_(results),
+                     _bjt_ac_columns_(results));
+   results[13][i] = analysis.VbeEM;
+   results[14][i] = analysis.region;
+   results[15][i] = analysis.iterations;
+}
+
+/* Junction voltages of a batch block and their masks. */
+struct BJT_ExactLanes {
+   double be[EXACT_BLOCK]; // base-emitter voltages
+   double bc[EXACT_BLOCK]; // base-collector voltages
+   double iterations[EXACT_BLOCK]; // Newton-Raphson iterations
+   double done[EXACT_BLOCK]; // convergence masks
+};
+
+/* Solve a block and get the exact analysis of its c'th design. */
+#define EXACT_SOLVE(lanes, n, columns) \
+   _bjt_exact_lanes_(n, columns, bjt_junctions, (lanes).be, \
+                     (lanes).bc, (lanes).iterations, (lanes).done)
+#define EXACT_POINT(lanes, columns, c) \
+   _bjt_exact_point_(_bjt_network_(columns, c), (columns).beta[c], \
+         bjt_junctions, (struct BJT_Junctions) {(lanes).be[c], \
+         (lanes).bc[c]}, (lanes).iterations[c], (lanes).done[c])
+
+/* Uniform evaluations of exact analyses for the engines. The
+transistors have the typical silicon junctions ('bjt_junctions'). */
+BATCH_DISPATCH
+void _bjt_exact_fixed_bias_(size_t num, const double *const *params,
+                            double *const *results) {
+   struct BJT_ExactLanes lanes;
+   double zeros[EXACT_BLOCK] = {0};
+   for (size_t first=0; first<num; first+=EXACT_BLOCK) {
+      size_t n = (num - first < EXACT_BLOCK) ? num - first :
+                 EXACT_BLOCK;
+      const double *Vcc = params[0] + first, *Rb = params[1] + first;
+      const double *Rc = params[2] + first, *beta = params[3] + first;
+      const double *ro = params[4] + first;
+      struct BJT_NetworkColumns columns = {Vcc, Vcc, Rb, Rc, zeros,
+                                           beta, 0};
+      EXACT_SOLVE(lanes, n, columns);
+      BATCH_LOOP
+      for (size_t c=0; c<n; c++) {
+         BJT_ExactAnalysis a = EXACT_POINT(lanes, columns, c);
+         a.ac = _bjt_ac_bypassed_(bjt_junctions.VT / a.dc.Ie, Rb[c],
+                                  Rc[c], beta[c], ro[c]);
+         _bjt_store_exact_(a, first + c, results);
+      }
+   }
+}
+
+BATCH_DISPATCH
+void _bjt_exact_emitter_bias_(size_t num, const double *const *params,
+                              double *const *results) {
+   struct BJT_ExactLanes lanes;
+   for (size_t first=0; first<num; first+=EXACT_BLOCK) {
+      size_t n = (num - first < EXACT_BLOCK) ? num - first :
+                 EXACT_BLOCK;
+      const double *Vcc = params[0] + first, *Rb = params[1] + first;
+      const double *Rc = params[2] + first, *Re = params[3] + first;
+      const double *beta = params[4] + first, *ro = params[5] + first;
+      struct BJT_NetworkColumns columns = {Vcc, Vcc, Rb, Rc, Re, beta,
+                                           0};
+      EXACT_SOLVE(lanes, n, columns);
+      BATCH_LOOP
+      for (size_t c=0; c<n; c++) {
+         BJT_ExactAnalysis a = EXACT_POINT(lanes, columns, c);
+         a.ac = _bjt_ac_unbypassed_(bjt_junctions.VT / a.dc.Ie, Rb[c],
+                                    Rc[c], Re[c], beta[c], ro[c]);
+         _bjt_store_exact_(a, first + c, results);
+      }
+   }
+}
+
+/* Voltage-divider evaluations find the Thevenin base network of a
+block first. */
+BATCH_FLATTEN
+void _bjt_exact_divider_(size_t num, const double *const *params,
+                         double *const *results, int bypassed) {
+   struct BJT_ExactLanes lanes;
+   double Eth[EXACT_BLOCK], Rth[EXACT_BLOCK];
+   for (size_t first=0; first<num; first+=EXACT_BLOCK) {
+      size_t n = (num - first < EXACT_BLOCK) ? num - first :
+                 EXACT_BLOCK;
+      const double *Vcc = params[0] + first, *Rb1 = params[1] + first;
+      const double *Rb2 = params[2] + first, *Rc = params[3] + first;
+      const double *Re = params[4] + first, *beta = params[5] + first;
+      const double *ro = params[6] + first;
+      BATCH_LOOP
+      for (size_t c=0; c<n; c++) {
+         Eth[c] = _Eth_(Vcc[c], Rb1[c], Rb2[c]);
+         Rth[c] = _Rth_(Rb1[c], Rb2[c]);
+      }
+      struct BJT_NetworkColumns columns = {Vcc, Eth, Rth, Rc, Re, beta,
+                                           0};
+      EXACT_SOLVE(lanes, n, columns);
+      // According to 'bypassed' parameter, there are two loops.
+      if (bypassed) {
+         BATCH_LOOP
+         for (size_t c=0; c<n; c++) {
+            BJT_ExactAnalysis a = EXACT_POINT(lanes, columns, c);
+            a.ac = _bjt_ac_bypassed_(bjt_junctions.VT / a.dc.Ie, Rth[c],
+                                     Rc[c], beta[c], ro[c]);
+            _bjt_store_exact_(a, first + c, results);
+         }
+      }
+      else {
+         BATCH_LOOP
+         for (size_t c=0; c<n; c++) {
+            BJT_ExactAnalysis a = EXACT_POINT(lanes, columns, c);
+            a.ac = _bjt_ac_unbypassed_(bjt_junctions.VT / a.dc.Ie,
+                                       Rth[c], Rc[c], Re[c], beta[c],
+                                       ro[c]);
+            _bjt_store_exact_(a, first + c, results);
+         }
+      }
+   }
+}
+
+BATCH_DISPATCH
+void _bjt_exact_voltage_divider_(size_t num,
+      const double *const *params, double *const *results) {
+   _bjt_exact_divider_(num, params, results, 1);
+}
+
+BATCH_DISPATCH
+void _bjt_exact_voltage_divider_unbypassed_(size_t num,
+      const double *const *params, double *const *results) {
+   _bjt_exact_divider_(num, params, results, 0);
+}
+
+BATCH_DISPATCH
+void _bjt_exact_collector_feedback_(size_t num,
+      const double *const *params, double *const *results) {
+   struct BJT_ExactLanes lanes;
+   for (size_t first=0; first<num; first+=EXACT_BLOCK) {
+      size_t n = (num - first < EXACT_BLOCK) ? num - first :
+                 EXACT_BLOCK;
+      const double *Vcc = params[0] + first, *Rf = params[1] + first;
+      const double *Rc = params[2] + first, *Re = params[3] + first;
+      const double *beta = params[4] + first, *ro = params[5] + first;
+      struct BJT_NetworkColumns columns = {Vcc, Vcc, Rf, Rc, Re, beta,
+                                           1};
+      EXACT_SOLVE(lanes, n, columns);
+      BATCH_LOOP
+      for (size_t c=0; c<n; c++) {
+         BJT_ExactAnalysis a = EXACT_POINT(lanes, columns, c);
+         a.ac = _bjt_ac_feedback_(bjt_junctions.VT / a.dc.Ie, Rf[c],
+                                  Rc[c], beta[c], ro[c]);
+         _bjt_store_exact_(a, first + c, results);
+      }
+   }
+}
+
+/* Uniform regions of exact BJT designs (see 'classify_regions()'),
+from their solved regions. Reverse and unconverged designs get no
+region. */
+BATCH_DISPATCH
+void _bjt_exact_regions_(size_t num, const double *const *params,
+      const double *const *results, unsigned char *regions) {
+   (void) params;
+   const double *region = results[14];
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      regions[i] = (region[i] == BJT_CUTOFF) * REGION_CUTOFF +
+                   (region[i] == BJT_ACTIVE) * REGION_ACTIVE +
+                   (region[i] == BJT_SATURATION) * REGION_SATURATION;
+}
+
+// Result fields of all exact BJT configurations:
+#define BJT_EXACT_RESULTS 16, {"Ib", "Ic", "Ie", "Icsat", "Vce", "Vc", \
+   "Ve", "Vb", "Vbc", "re", "Zi", "Zo", "Av", "Vbe", "region", \
+   "iterations"}, {1, 4, 12, 10, 11}
+
+/* Uniform descriptions of exact BJT configurations. The parameters
+are the same as 'bjt_configurations[]', so an engine can switch a
+design to the exact model. */
+const struct Configuration bjt_exact_configurations[] = {
+   {"fixed_bias", 5, {"Vcc", "Rb", "Rc", "beta", "ro"},
+    BJT_EXACT_RESULTS, _bjt_exact_fixed_bias_, _bjt_exact_regions_,
+    0x1E},
+   {"emitter_bias", 6, {"Vcc", "Rb", "Rc", "Re", "beta", "ro"},
+    BJT_EXACT_RESULTS, _bjt_exact_emitter_bias_, _bjt_exact_regions_,
+    0x3E},
+   {"voltage_divider", 7, {"Vcc", "Rb1", "Rb2", "Rc", "Re", "beta",
+    "ro"}, BJT_EXACT_RESULTS, _bjt_exact_voltage_divider_,
+    _bjt_exact_regions_, 0x7E},
+   {"voltage_divider_unbypassed", 7, {"Vcc", "Rb1", "Rb2", "Rc", "Re",
+    "beta", "ro"}, BJT_EXACT_RESULTS,
+    _bjt_exact_voltage_divider_unbypassed_, _bjt_exact_regions_,
+    0x7E},
+   {"collector_feedback", 6, {"Vcc", "Rf", "Rc", "Re", "beta", "ro"},
+    BJT_EXACT_RESULTS, _bjt_exact_collector_feedback_,
+    _bjt_exact_regions_, 0x3E},
+};
+
+// Number of uniform exact BJT configurations:
+const size_t num_bjt_exact_configurations =
+   sizeof(bjt_exact_configurations) /
+   sizeof(bjt_exact_configurations[0]);
+
+#endif
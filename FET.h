@@ -0,0 +1,88 @@
+/* Shared Helpers of FET Transistor Configurations
+
+JFET and E-MOSFET analyses use the same helpers: parallel resultant,
+transconductance factor and drain current of the Shockley (or
+k(Vgs - Vgsth)^2) quadratic. So, both JFET.h and MOSFET.h include
+this source file and can be included together.
+*/
+
+#ifndef FET_H
+#define FET_H
+
+// Libraries:
+#include <stdlib.h>
+#include <math.h>
+#include "Batch.h"
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Get the parallel resultant of 'R1' and 'R2'. */
+static inline double _parallel_(double R1, double R2) {
+   // Find the resultant resistance for parallel resistors.
+   return 1.0 / (1.0 / R1 + 1.0 / R2);
+}
+
+/* Find the transconductance factor (gm). */
+static inline double _gm_factor_(double Idss, double Vp, double Vgs) {
+   // Find the transconductance factor (gm).
+   return (2.0 * Idss / fabs(Vp)) * (1.0 - Vgs / Vp);
+}
+
+/* Select the right drain current using discriminant. 
+
+The roots are found by the cancellation-free form of quadratic 
+formula and the right root is selected without any branch. The 
+smaller non-negative root is selected. If both roots are negative,
+the absolute value of the root closer to zero is selected. If the 
+discriminant is negative, there isn't any real root and NAN is 
+returned. */
+static inline double _drain_current_(double a, double b, double c) {
+   // Find the discriminant. A negative one gives NAN roots.
+   double dicriminant = (b * b) - (4 * a * c);
+   // Calculate two different roots without subtracting the nearly
+   // equal numbers (-b and the square root of discriminant).
+   double q = -0.5 * (b + copysign(sqrt(dicriminant), b));
+   double root1 = q / a;
+   double root2 = c / q;
+   // Specially, in some configurations, can be found two 
+   // roots and requries to select one of them.
+   double low = (root1 < root2) ? root1 : root2;
+   double high = (root1 < root2) ? root2 : root1;
+   return (low >= 0) ? low : fabs(high);
+}
+
+/* Select the right drain currents of 'num' quadratics at once.
+
+Each 'Id' entry is equal to '_drain_current_()' of the same 'a', 'b'
+and 'c' entries. The 'status' entry is set to 1 if the discriminant 
+is negative (and 'Id' is NAN), otherwise to 0. The count of negative
+discriminants is returned.
+
+double a[2]={0.222222, 0.1}, b[2]={-3.666667, 1}, c[2]={0.008, 5};
+double Id[2]; unsigned char status[2];
+size_t failures = _drain_current_batch_(2, a, b, c, Id, status);
+
+Id: 2.182107e-03, nan
+status: 0, 1
+failures: 1
+*/
+BATCH_DISPATCH
+static inline size_t _drain_current_batch_(size_t num, const double *a, 
+      const double *b, const double *c, double *restrict Id, 
+      unsigned char *restrict status) {
+   // Count the quadratics which haven't any real root.
+   size_t failures = 0;
+   // Select the roots of all quadratics using masks.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++) {
+      double dicriminant = (b[i] * b[i]) - (4 * a[i] * c[i]);
+      Id[i] = _drain_current_(a[i], b[i], c[i]);
+      status[i] = (dicriminant < 0);
+      failures += (dicriminant < 0);
+   }
+   return failures;
+}
+
+#endif
@@ -0,0 +1,503 @@
+/* Fast Text Formatting of Analysis Results
+
+The display functions print each field with its own printf call. It
+is fine for a few analyses, but for large sweeps the formatting and
+the locking of stdout take much more time than the analyses. So,
+this source file formats numbers with the Grisu3 algorithm (without
+any printf, except its rare exact fallback) into a large buffer of
+each thread, and writes the buffer to its file with a single write
+call when it's full.
+
+IMPORTANT NOTES:
+----------------
+
+1. Numbers are written with the fewest digits (at most 17) which read
+back as the same number by strtod(), like 'to_chars()'. Grisu3 finds
+them for about 99.5% of values and checks them, the others are found
+by snprintf() and strtod(). The layout is like "%g": 0.001,
+6.820833333333333, 4.708333333333334e-05, nan, -inf.
+2. Rows are written in CSV, TSV or key=value mode. In key=value mode,
+fields are separated by spaces and header rows aren't written. Text
+fields are quoted if they contain a separator, quote or newline.
+3. Each thread has its own buffer (see text_buffer()). Call
+text_flush() before the thread ends, otherwise the rest of its
+buffer is lost. Don't mix it with printf() on the same file without
+flushing both.
+4. All definitions are 'static inline', so this source file can be
+included by all families and by their users together.
+*/
+
+#ifndef FORMAT_H
+#define FORMAT_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+
+// General constants:
+#define TEXT_BUFFER (1 << 20) // bytes of the buffer of a thread
+#define TEXT_NUMBER 32 // enough bytes for any formatted number
+
+// Modes of text rows:
+enum TextMode {
+   TEXT_CSV, // comma-separated values
+   TEXT_TSV, // tab-separated values
+   TEXT_KEYVALUE // name=value pairs separated by spaces
+};
+
+// Output buffer of a thread:
+struct TextBuffer {
+   char *data; // buffered text
+   size_t length; // bytes of buffered text
+   size_t size; // capacity of buffer
+   int fd; // file descriptor (stdout by default)
+   enum TextMode mode; // layout of rows
+   size_t fields; // fields of the current row
+   int header; // the current row contains field names
+   int failed; // a write failed (errno is kept)
+};
+
+// Normalized powers of ten: 10^(8i - 348) = f * 2^e.
+static const struct {uint64_t f; int e;} _powers_of_ten_[87] = {
+   {0xFA8FD5A0081C0288, -1220}, {0xBAAEE17FA23EBF76, -1193},
+   {0x8B16FB203055AC76, -1166}, {0xCF42894A5DCE35EA, -1140},
+   {0x9A6BB0AA55653B2D, -1113}, {0xE61ACF033D1A45DF, -1087},
+   {0xAB70FE17C79AC6CA, -1060}, {0xFF77B1FCBEBCDC4F, -1034},
+   {0xBE5691EF416BD60C, -1007}, {0x8DD01FAD907FFC3C, -980},
+   {0xD3515C2831559A83, -954}, {0x9D71AC8FADA6C9B5, -927},
+   {0xEA9C227723EE8BCB, -901}, {0xAECC49914078536D, -874},
+   {0x823C12795DB6CE57, -847}, {0xC21094364DFB5637, -821},
+   {0x9096EA6F3848984F, -794}, {0xD77485CB25823AC7, -768},
+   {0xA086CFCD97BF97F4, -741}, {0xEF340A98172AACE5, -715},
+   {0xB23867FB2A35B28E, -688}, {0x84C8D4DFD2C63F3B, -661},
+   {0xC5DD44271AD3CDBA, -635}, {0x936B9FCEBB25C996, -608},
+   {0xDBAC6C247D62A584, -582}, {0xA3AB66580D5FDAF6, -555},
+   {0xF3E2F893DEC3F126, -529}, {0xB5B5ADA8AAFF80B8, -502},
+   {0x87625F056C7C4A8B, -475}, {0xC9BCFF6034C13053, -449},
+   {0x964E858C91BA2655, -422}, {0xDFF9772470297EBD, -396},
+   {0xA6DFBD9FB8E5B88F, -369}, {0xF8A95FCF88747D94, -343},
+   {0xB94470938FA89BCF, -316}, {0x8A08F0F8BF0F156B, -289},
+   {0xCDB02555653131B6, -263}, {0x993FE2C6D07B7FAC, -236},
+   {0xE45C10C42A2B3B06, -210}, {0xAA242499697392D3, -183},
+   {0xFD87B5F28300CA0E, -157}, {0xBCE5086492111AEB, -130},
+   {0x8CBCCC096F5088CC, -103}, {0xD1B71758E219652C, -77},
+   {0x9C40000000000000, -50}, {0xE8D4A51000000000, -24},
+   {0xAD78EBC5AC620000, 3}, {0x813F3978F8940984, 30},
+   {0xC097CE7BC90715B3, 56}, {0x8F7E32CE7BEA5C70, 83},
+   {0xD5D238A4ABE98068, 109}, {0x9F4F2726179A2245, 136},
+   {0xED63A231D4C4FB27, 162}, {0xB0DE65388CC8ADA8, 189},
+   {0x83C7088E1AAB65DB, 216}, {0xC45D1DF942711D9A, 242},
+   {0x924D692CA61BE758, 269}, {0xDA01EE641A708DEA, 295},
+   {0xA26DA3999AEF774A, 322}, {0xF209787BB47D6B85, 348},
+   {0xB454E4A179DD1877, 375}, {0x865B86925B9BC5C2, 402},
+   {0xC83553C5C8965D3D, 428}, {0x952AB45CFA97A0B3, 455},
+   {0xDE469FBD99A05FE3, 481}, {0xA59BC234DB398C25, 508},
+   {0xF6C69A72A3989F5C, 534}, {0xB7DCBF5354E9BECE, 561},
+   {0x88FCF317F22241E2, 588}, {0xCC20CE9BD35C78A5, 614},
+   {0x98165AF37B2153DF, 641}, {0xE2A0B5DC971F303A, 667},
+   {0xA8D9D1535CE3B396, 694}, {0xFB9B7CD9A4A7443C, 720},
+   {0xBB764C4CA7A44410, 747}, {0x8BAB8EEFB6409C1A, 774},
+   {0xD01FEF10A657842C, 800}, {0x9B10A4E5E9913129, 827},
+   {0xE7109BFBA19C0C9D, 853}, {0xAC2820D9623BF429, 880},
+   {0x80444B5E7AA7CF85, 907}, {0xBF21E44003ACDD2D, 933},
+   {0x8E679C2F5E44FF8F, 960}, {0xD433179D9C8CB841, 986},
+   {0x9E19DB92B4E31BA9, 1013}, {0xEB96BF6EBADF77D9, 1039},
+   {0xAF87023B9BF0EE6B, 1066},
+};
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Product of 'x * 2^ex' and 'y * 2^ey' rounded to 64 bits. */
+static inline uint64_t _multiply_(uint64_t x, uint64_t y) {
+   unsigned __int128 product = (unsigned __int128) x * y;
+   return (uint64_t) (product >> 64) + ((uint64_t) product >> 63);
+}
+
+/* Get the leading digit of a 'kappa' digits number. Constant divisors
+are much faster than a table of them. */
+static inline uint32_t _leading_digit_(uint32_t p1, int kappa) {
+   switch (kappa) {
+      case 10: return p1 / 1000000000;
+      case 9: return p1 / 100000000;
+      case 8: return p1 / 10000000;
+      case 7: return p1 / 1000000;
+      case 6: return p1 / 100000;
+      case 5: return p1 / 10000;
+      case 4: return p1 / 1000;
+      case 3: return p1 / 100;
+      case 2: return p1 / 10;
+      default: return p1;
+   }
+}
+
+/* Round the last digit toward the exact value (Grisu3) and check if
+the digits are surely the shortest and closest ones. If it isn't
+sure, 0 is returned. */
+static inline int _round_weed_(char *digits, int length,
+                               uint64_t distance, uint64_t delta,
+                               uint64_t rest, uint64_t ten_kappa,
+                               uint64_t unit) {
+   // The exact value is in (distance - unit, distance + unit).
+   uint64_t up = distance - unit, down = distance + unit;
+   while (rest < up && delta - rest >= ten_kappa &&
+          (rest + ten_kappa < up ||
+           up - rest >= rest + ten_kappa - up)) {
+      digits[length - 1]--;
+      rest += ten_kappa;
+   }
+   // A lower digit may be closer for another value in the range.
+   if (rest < down && delta - rest >= ten_kappa &&
+       (rest + ten_kappa < down ||
+        down - rest > rest + ten_kappa - down)) return 0;
+   // The digits must be in the safe interval.
+   return 2 * unit <= rest && rest <= delta - 4 * unit;
+}
+
+/* Find the shortest digits of 'f * 2^e' (Grisu3), so the value is
+'digits * 10^K'. 'closer' is set if the lower neighbor is closer
+(the significand is a power of two). If the digits aren't surely the
+shortest ones (about 0.5% of values), 0 is returned. */
+static inline int _grisu_(uint64_t f, int e, int closer, char *digits,
+                          int *K) {
+   static const uint64_t tens[20] = {1, 10, 100, 1000, 10000, 100000,
+      1000000, 10000000, 100000000, 1000000000, 10000000000,
+      100000000000, 1000000000000, 10000000000000, 100000000000000,
+      1000000000000000, 10000000000000000, 100000000000000000,
+      1000000000000000000, 10000000000000000000u};
+   // Find the neighbor boundaries of the value and normalize them.
+   uint64_t high = (f << 1) + 1, low = closer ? (f << 2) - 1 :
+                                               (f << 1) - 1;
+   int shift = __builtin_clzll(high), eh = e - 1 - shift;
+   high <<= shift;
+   low <<= (closer ? e - 2 : e - 1) - eh;
+   shift = __builtin_clzll(f);
+   f <<= shift;
+   e -= shift;
+   // Scale all by a cached power of ten to have the exponent in
+   // [-60, -32], so the integer part fits 32 bits. Each product is
+   // off by at most one unit, so the boundaries are widened by it.
+   double dk = (-61 - eh) * 0.30102999566398114 + 347;
+   int k = (int) dk;
+   if (dk - k > 0) k++;
+   int index = (k >> 3) + 1;
+   *K = 348 - index * 8;
+   uint64_t power = _powers_of_ten_[index].f;
+   int ep = _powers_of_ten_[index].e;
+   uint64_t w = _multiply_(f, power);
+   uint64_t wp = _multiply_(high, power) + 1;
+   uint64_t wm = _multiply_(low, power) - 1;
+   uint64_t delta = wp - wm, distance = wp - w, unit = 1;
+   int one = -(eh + ep + 64);
+   uint64_t mask = ((uint64_t) 1 << one) - 1;
+   // Generate the digits of the integer part.
+   uint32_t p1 = wp >> one;
+   uint64_t p2 = wp & mask;
+   int kappa = 1, length = 0;
+   while (kappa < 10 && p1 >= tens[kappa]) kappa++;
+   while (kappa > 0) {
+      uint32_t d = _leading_digit_(p1, kappa);
+      p1 -= d * tens[kappa - 1];
+      if (d || length) digits[length++] = '0' + d;
+      kappa--;
+      uint64_t rest = ((uint64_t) p1 << one) + p2;
+      if (rest < delta) {
+         *K += kappa;
+         return _round_weed_(digits, length, distance, delta, rest,
+                             tens[kappa] << one, unit) ? length : 0;
+      }
+   }
+   // Generate the digits of the fractional part.
+   while (1) {
+      p2 *= 10;
+      delta *= 10;
+      unit *= 10;
+      char d = p2 >> one;
+      if (d || length) digits[length++] = '0' + d;
+      p2 &= mask;
+      kappa--;
+      if (p2 < delta) {
+         *K += kappa;
+         return _round_weed_(digits, length, distance * unit, delta,
+                             p2, mask + 1, unit) ? length : 0;
+      }
+   }
+}
+
+/* Find the shortest digits of a value exactly, where Grisu3 isn't
+sure: the fewest correctly rounded digits which read back as the
+same number (of float type, if 'single'). It's much slower, but
+it's rarely needed. */
+static inline int _exact_digits_(double value, int single, char *digits,
+                                 int *K) {
+   char text[TEXT_NUMBER], fewer[TEXT_NUMBER];
+   // More digits always read back if fewer ones do, and Grisu3 only
+   // fails on long ones, so drop the digits from the most ones.
+   int count = single ? 9 : 17;
+   snprintf(text, sizeof(text), "%.*e", count - 1, fabs(value));
+   while (count > 1) {
+      snprintf(fewer, sizeof(fewer), "%.*e", count - 2, fabs(value));
+      int same = single ? strtof(fewer, NULL) == fabsf((float) value) :
+                          strtod(fewer, NULL) == fabs(value);
+      if (!same) break;
+      memcpy(text, fewer, sizeof(text));
+      count--;
+   }
+   // Get the digits and the exponent of "d.ddde-XX".
+   int length = 0;
+   const char *at = text;
+   for (; *at != 'e'; at++)
+      if (*at != '.') digits[length++] = *at;
+   *K = atoi(at + 1) - (length - 1);
+   return length;
+}
+
+/* Lay out 'digits * 10^K' like "%g" and get its length. */
+static inline int _layout_(char *out, int negative, const char *digits,
+                           int length, int K) {
+   char *begin = out;
+   int X = length + K - 1;
+   if (negative) *out++ = '-';
+   if (X >= -4 && X < 17) {
+      if (X < 0) {
+         // Write 0.000ddd.
+         *out++ = '0';
+         *out++ = '.';
+         memset(out, '0', -X - 1);
+         out += -X - 1;
+         memcpy(out, digits, length);
+         out += length;
+      }
+      else if (length <= X + 1) {
+         // Write ddd000.
+         memcpy(out, digits, length);
+         memset(out + length, '0', X + 1 - length);
+         out += X + 1;
+      }
+      else {
+         // Write ddd.ddd.
+         memcpy(out, digits, X + 1);
+         out[X + 1] = '.';
+         memcpy(out + X + 2, digits + X + 1, length - X - 1);
+         out += length + 1;
+      }
+   }
+   else {
+      // Write d.ddde-XX.
+      *out++ = digits[0];
+      if (length > 1) {
+         *out++ = '.';
+         memcpy(out, digits + 1, length - 1);
+         out += length - 1;
+      }
+      *out++ = 'e';
+      *out++ = X < 0 ? '-' : '+';
+      if (X < 0) X = -X;
+      if (X >= 100) *out++ = '0' + X / 100;
+      *out++ = '0' + X / 10 % 10;
+      *out++ = '0' + X % 10;
+   }
+   return out - begin;
+}
+
+/* Write special values (zero, NAN and infinity) or get 0. */
+static inline int _special_(char *out, int negative, int zero,
+                            int nan, int infinite) {
+   char *begin = out;
+   if (negative && !nan) *out++ = '-';
+   if (zero) *out++ = '0';
+   else if (nan) memcpy(out, "nan", 3), out += 3;
+   else if (infinite) memcpy(out, "inf", 3), out += 3;
+   else return 0;
+   return out - begin;
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Write the shortest round-trip digits of a double and get the count
+of written bytes (at most TEXT_NUMBER - 1, without NUL).
+
+char out[TEXT_NUMBER];
+out[format_double(out, 2.354166666666667e-03)] = '\0';
+
+out: 0.002354166666666667
+*/
+static inline int format_double(char *out, double value) {
+   uint64_t bits;
+   memcpy(&bits, &value, sizeof(bits));
+   int negative = bits >> 63, biased = (bits >> 52) & 0x7FF;
+   uint64_t f = bits & (((uint64_t) 1 << 52) - 1);
+   int special = _special_(out, negative, biased == 0 && f == 0,
+                           biased == 0x7FF && f != 0,
+                           biased == 0x7FF && f == 0);
+   if (special > 0) return special;
+   // Find the significand and exponent of the value.
+   int e = biased ? biased - 1075 : -1074;
+   if (biased) f |= (uint64_t) 1 << 52;
+   char digits[20];
+   int K, length = _grisu_(f, e, f == (uint64_t) 1 << 52, digits, &K);
+   if (length == 0) length = _exact_digits_(value, 0, digits, &K);
+   return _layout_(out, negative, digits, length, K);
+}
+
+/* Write the shortest round-trip digits of a float (for MOSFET
+results) and get the count of written bytes.
+
+char out[TEXT_NUMBER];
+out[format_float(out, 0.1f)] = '\0';
+
+out: 0.1
+*/
+static inline int format_float(char *out, float value) {
+   uint32_t bits;
+   memcpy(&bits, &value, sizeof(bits));
+   int negative = bits >> 31, biased = (bits >> 23) & 0xFF;
+   uint64_t f = bits & ((1 << 23) - 1);
+   int special = _special_(out, negative, biased == 0 && f == 0,
+                           biased == 0xFF && f != 0,
+                           biased == 0xFF && f == 0);
+   if (special > 0) return special;
+   // Find the significand and exponent of the value.
+   int e = biased ? biased - 150 : -149;
+   if (biased) f |= 1 << 23;
+   char digits[20];
+   int K, length = _grisu_(f, e, f == 1 << 23, digits, &K);
+   if (length == 0) length = _exact_digits_(value, 1, digits, &K);
+   return _layout_(out, negative, digits, length, K);
+}
+
+/* Get the output buffer of the calling thread. It writes CSV rows to
+stdout until its 'fd' and 'mode' are changed.
+
+struct TextBuffer *text = text_buffer();
+text->mode = TEXT_KEYVALUE;
+text_double(text, "Ic", 2.354167e-03);
+text_double(text, "Vce", 6.820833);
+text_end_row(text);
+text_flush(text);
+
+Ic=0.002354167 Vce=6.820833
+*/
+static inline struct TextBuffer *text_buffer(void) {
+   static _Thread_local struct TextBuffer buffer = {.fd = 1};
+   if (buffer.data == NULL) {
+      buffer.data = malloc(TEXT_BUFFER);
+      assert (buffer.data != NULL);
+      buffer.size = TEXT_BUFFER;
+   }
+   return &buffer;
+}
+
+/* Write all buffered text to the file with a single write (unless
+the file takes less). If it fails, -1 is returned and the text is
+dropped. */
+static inline int text_flush(struct TextBuffer *text) {
+   const char *data = text->data;
+   size_t length = text->length;
+   text->length = 0;
+   while (length > 0 && !text->failed) {
+      ssize_t written = write(text->fd, data, length);
+      if (written < 0 && errno == EINTR) continue;
+      if (written <= 0) text->failed = 1;
+      else data += written, length -= written;
+   }
+   return text->failed ? -1 : 0;
+}
+
+/* Make room for 'bytes' more bytes in the buffer. */
+static inline void _text_reserve_(struct TextBuffer *text,
+                                  size_t bytes) {
+   if (text->size - text->length >= bytes) return;
+   text_flush(text);
+   // Only very long text fields need a larger buffer.
+   if (text->size < bytes) {
+      text->data = realloc(text->data, bytes);
+      assert (text->data != NULL);
+      text->size = bytes;
+   }
+}
+
+/* Begin a field of the current row and write its name if needed. */
+static inline void _text_begin_(struct TextBuffer *text,
+                                const char *name) {
+   if (text->header && text->mode == TEXT_KEYVALUE) return;
+   int named = text->header || text->mode == TEXT_KEYVALUE;
+   size_t length = named ? strlen(name) : 0;
+   _text_reserve_(text, length + TEXT_NUMBER + 2);
+   char *out = text->data + text->length;
+   if (text->fields++ > 0)
+      *out++ = text->mode == TEXT_CSV ? ',' :
+               text->mode == TEXT_TSV ? '\t' : ' ';
+   if (named) {
+      memcpy(out, name, length);
+      out += length;
+      if (!text->header) *out++ = '=';
+   }
+   text->length = out - text->data;
+}
+
+/* Begin a header row: the next fields write their names instead of
+their values (nothing in key=value mode). */
+static inline void text_begin_header(struct TextBuffer *text) {
+   text->header = 1;
+}
+
+/* Append a double field to the current row. */
+static inline void text_double(struct TextBuffer *text,
+                               const char *name, double value) {
+   _text_begin_(text, name);
+   if (!text->header)
+      text->length += format_double(text->data + text->length, value);
+}
+
+/* Append a float field to the current row. */
+static inline void text_float(struct TextBuffer *text,
+                              const char *name, float value) {
+   _text_begin_(text, name);
+   if (!text->header)
+      text->length += format_float(text->data + text->length, value);
+}
+
+/* Append a text field to the current row (quoted if needed). */
+static inline void text_string(struct TextBuffer *text,
+                               const char *name, const char *value) {
+   _text_begin_(text, name);
+   if (text->header) return;
+   size_t length = strlen(value);
+   char separator = text->mode == TEXT_CSV ? ',' :
+                    text->mode == TEXT_TSV ? '\t' : ' ';
+   int quoted = strpbrk(value, "\"\n") != NULL ||
+                memchr(value, separator, length) != NULL;
+   _text_reserve_(text, 2 * length + 2);
+   char *out = text->data + text->length;
+   if (quoted) *out++ = '"';
+   for (size_t i=0; i<length; i++) {
+      // Quotes are doubled in quoted fields.
+      if (quoted && value[i] == '"') *out++ = '"';
+      *out++ = value[i];
+   }
+   if (quoted) *out++ = '"';
+   text->length = out - text->data;
+}
+
+/* End the current row. */
+static inline void text_end_row(struct TextBuffer *text) {
+   // Header rows aren't written in key=value mode.
+   if (!text->header || text->mode != TEXT_KEYVALUE) {
+      _text_reserve_(text, 1);
+      text->data[text->length++] = '\n';
+   }
+   text->fields = 0;
+   text->header = 0;
+}
+
+#endif
@@ -0,0 +1,433 @@
+/* Frequency Response of Transistor Amplifiers
+
+The AC analyses give only the mid-band results. Real amplifiers
+have coupling and bypass capacitors, whose gain falls at low
+frequencies, and device (and wiring) capacitances, whose gain falls
+at high frequencies. The Miller effect multiplies the feedback
+capacitance (Cbc or Cgd) by the gain. So, this source file finds the
+poles (cutoff frequencies of each RC network) of a configuration,
+computes its complex gain over any frequencies and finds the lower
+and upper -3 dB frequencies and the bandwidth.
+
+IMPORTANT NOTES:
+----------------
+
+1. Include this file instead of BJT.h and JFET.h, it includes them.
+2. Gains are source-voltage gains: Vo / Vs with the source
+resistance 'Rs' (or 'Rsig') and the load 'Rl'.
+3. Each RC network is a single pole (Boylestad's model), so the gain
+is 'Av * prod(1 / (1 - j fL/f)) * prod(1 / (1 + j f/fH))'.
+4. fL and fH are found from the whole response (not only from the
+dominant poles), so close poles are handled.
+5. Give INFINITY for an ideal (short) capacitor and 0 for a missing
+capacitance. Frequencies are in Hz, capacitances in F.
+6. Frequency loops are vectorized like batch entry points (see
+Batch.h). Link with '-lm' and '-pthread'.
+*/
+
+#ifndef FREQUENCY_H
+#define FREQUENCY_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include "BJT.h"
+#include "JFET.h"
+#include "Parallel.h"
+
+// General constants:
+#define MAX_POLES 4
+#define TWO_PI 6.283185307179586
+#define CUTOFF_STEPS 100 // bisection steps of cutoff frequencies
+
+// Capacitances of BJT amplifiers:
+struct BJT_Capacitors {
+   double Cs; // input coupling capacitor
+   double Cc; // output coupling capacitor
+   double Ce; // emitter bypass capacitor
+   double Cbe; // base-emitter capacitance
+   double Cbc; // base-collector (Miller) capacitance
+   double Cce; // collector-emitter capacitance
+   double Cwi; // input wiring capacitance
+   double Cwo; // output wiring capacitance
+};
+
+// Capacitances of JFET amplifiers:
+struct JFET_Capacitors {
+   double Cg; // input coupling capacitor
+   double Cc; // output coupling capacitor
+   double Cs; // source bypass capacitor
+   double Cgs; // gate-source capacitance
+   double Cgd; // gate-drain (Miller) capacitance
+   double Cds; // drain-source capacitance
+   double Cwi; // input wiring capacitance
+   double Cwo; // output wiring capacitance
+};
+
+// Mid-band gain and poles of an amplifier:
+struct FrequencyModel {
+   double Av; // mid-band source-voltage gain
+   size_t nlow; // count of low-frequency poles
+   double low[MAX_POLES]; // low cutoff frequencies of networks
+   size_t nhigh; // count of high-frequency poles
+   double high[MAX_POLES]; // high cutoff frequencies of networks
+};
+
+// Results of frequency analysis:
+struct FrequencyResults {
+   double Av; // mid-band source-voltage gain
+   double fL; // lower -3 dB frequency
+   double fH; // upper -3 dB frequency
+   double bandwidth; // fH - fL
+};
+
+// Columns of a batch frequency run:
+struct FrequencyRun {
+   const struct FrequencyModel *models; // models of designs
+   size_t num; // count of designs
+   size_t nfrequencies; // count of frequencies
+   const double *frequencies; // common frequencies
+   double *gain; // gains (dB) of designs (or NULL)
+   double *phase; // phases (degrees) of designs (or NULL)
+   struct FrequencyResults *analyses; // cutoffs of designs
+   size_t threads; // count of threads
+};
+
+// User-defined analysis types:
+typedef struct FrequencyResults FrequencyAnalysis;
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Get the cutoff frequency of an RC network. */
+double _cutoff_(double R, double C) {
+   return 1 / (TWO_PI * R * C);
+}
+
+/* Get the squared gain of 'model' relative to its mid-band gain. */
+double _relative_gain_(const struct FrequencyModel *model, double f) {
+   double gain = 1;
+   for (size_t p=0; p<model->nlow; p++) {
+      double x = model->low[p] / f;
+      gain /= 1 + x * x;
+   }
+   for (size_t p=0; p<model->nhigh; p++) {
+      double y = f / model->high[p];
+      gain /= 1 + y * y;
+   }
+   return gain;
+}
+
+/* Find the frequency between 'f1' and 'f2' where the relative gain
+crosses 1/2 (-3 dB). It is bisected logarithmically. */
+double _crossing_(const struct FrequencyModel *model, double f1,
+                  double f2) {
+   int rising = _relative_gain_(model, f1) < 0.5;
+   for (int step=0; step<CUTOFF_STEPS; step++) {
+      double middle = sqrt(f1 * f2);
+      if ((_relative_gain_(model, middle) < 0.5) == rising) f1 = middle;
+      else f2 = middle;
+      if (f2 - f1 <= 1e-12 * f2) break;
+   }
+   return sqrt(f1 * f2);
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------- Display Results --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Display the results of frequency analysis. */
+void display_frequency_results(FrequencyAnalysis analysis) {
+   // Display the mid-band gain and cutoff frequencies.
+   printf("Av: %f\n", analysis.Av);
+   printf("fL: %f Hz\n", analysis.fL);
+   printf("fH: %f Hz\n", analysis.fH);
+   printf("bandwidth: %f Hz\n", analysis.bandwidth);
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Frequency model of bypassed voltage-divider BJT configuration.
+
+double Vcc=10, Rb1=40000, Rb2=10000, Rc=4000, Re=2000;
+double beta=100, ro=INFINITY, Rs=1000, Rl=2200;
+struct BJT_Capacitors caps = {10e-6, 1e-6, 20e-6, 36e-12, 4e-12,
+                              1e-12, 6e-12, 8e-12};
+struct FrequencyModel model = bjt_voltage_divider_frequency(Vcc, Rb1,
+      Rb2, Rc, Re, beta, ro, Rs, Rl, caps);
+
+model.Av: -24.996485
+model.low: 4.259858, 25.670152, 161.642173 Hz
+model.high: 1190621.646676, 8548467.852303 Hz
+*/
+struct FrequencyModel bjt_voltage_divider_frequency(double Vcc,
+      double Rb1, double Rb2, double Rc, double Re, double beta,
+      double ro, double Rs, double Rl, struct BJT_Capacitors caps) {
+   // Check if the parameters of amplifier are consistent.
+   assert (Rs > 0 && Rl > 0);
+   BJT_ACAnalysis ac = bjt_ac_voltage_divider(Vcc, Rb1, Rb2, Rc, Re,
+                                              beta, ro, "bypassed");
+   struct FrequencyModel model = {0};
+   // Mid-band gain with the source and load.
+   double Rth = _parallel_(Rb1, Rb2), Rl1 = _parallel_(ac.Zo, Rl);
+   double Av = -Rl1 / ac.re;
+   model.Av = ac.Zi / (ac.Zi + Rs) * Av;
+   // Coupling and bypass capacitors give the low poles.
+   double Re1 = _parallel_(Re, _parallel_(Rs, Rth) / beta + ac.re);
+   model.low[model.nlow++] = _cutoff_(Rs + ac.Zi, caps.Cs);
+   model.low[model.nlow++] = _cutoff_(ac.Zo + Rl, caps.Cc);
+   model.low[model.nlow++] = _cutoff_(Re1, caps.Ce);
+   // Input (with Miller) and output capacitances give the high poles.
+   double Ci = caps.Cwi + caps.Cbe + (1 - Av) * caps.Cbc;
+   double Co = caps.Cwo + caps.Cce + (1 - 1 / Av) * caps.Cbc;
+   model.high[model.nhigh++] = _cutoff_(_parallel_(Rs, ac.Zi), Ci);
+   model.high[model.nhigh++] = _cutoff_(Rl1, Co);
+
+   return model;
+}
+
+/* Frequency model of bypassed voltage-divider JFET configuration.
+
+double Vdd=20, Rg1=82*1e+6, Rg2=11*1e+6, Rd=2000, Rs=610;
+double Idss=0.012, Vp=-3, rd=5*1e+5, Rsig=10000, Rl=4700;
+struct JFET_Capacitors caps = {0.01e-6, 0.5e-6, 2e-6, 4e-12,
+                               2e-12, 0.5e-12, 5e-12, 6e-12};
+struct FrequencyModel model = jfet_voltage_divider_frequency(Vdd,
+      Rg1, Rg2, Rd, Rs, Idss, Vp, rd, Rsig, Rl, caps);
+
+model.Av: -7.551839
+model.low: 1.639264, 47.565507, 559.396386 Hz
+model.high: 609967.872346, 12979372.780684 Hz
+*/
+struct FrequencyModel jfet_voltage_divider_frequency(double Vdd,
+      double Rg1, double Rg2, double Rd, double Rs, double Idss,
+      double Vp, double rd, double Rsig, double Rl,
+      struct JFET_Capacitors caps) {
+   // Check if the parameters of amplifier are consistent.
+   assert (Rsig > 0 && Rl > 0);
+   JFET_ACAnalysis ac = jfet_ac_voltage_divider(Vdd, Rg1, Rg2, Rd, Rs,
+                                                Idss, Vp, rd);
+   struct FrequencyModel model = {0};
+   // Mid-band gain with the source and load.
+   double Rl1 = _parallel_(ac.Zo, Rl);
+   double Av = -ac.gm * Rl1;
+   model.Av = ac.Zi / (ac.Zi + Rsig) * Av;
+   // Coupling and bypass capacitors give the low poles.
+   double Req = Rs / (1 + Rs * (1 + ac.gm * rd) / (rd + _parallel_(Rd,
+                                                               Rl)));
+   model.low[model.nlow++] = _cutoff_(Rsig + ac.Zi, caps.Cg);
+   model.low[model.nlow++] = _cutoff_(ac.Zo + Rl, caps.Cc);
+   model.low[model.nlow++] = _cutoff_(Req, caps.Cs);
+   // Input (with Miller) and output capacitances give the high poles.
+   double Ci = caps.Cwi + caps.Cgs + (1 - Av) * caps.Cgd;
+   double Co = caps.Cwo + caps.Cds + (1 - 1 / Av) * caps.Cgd;
+   model.high[model.nhigh++] = _cutoff_(_parallel_(Rsig, ac.Zi), Ci);
+   model.high[model.nhigh++] = _cutoff_(Rl1, Co);
+
+   return model;
+}
+
+/* Frequency model of common-gate JFET configuration. 'Cg' couples
+the source to the input and 'Cs' isn't used. There is no Miller
+effect, because the gate is grounded.
+
+double Vdd=15, Vss=0, Rd=3300, Rs=1500, Idss=0.008, Vp=-2.8;
+double rd=4*1e+4, Rsig=50, Rl=10000;
+struct JFET_Capacitors caps = {10e-6, 1e-6, 0, 4e-12, 2e-12,
+                               0.5e-12, 5e-12, 6e-12};
+struct FrequencyModel model = jfet_common_gate_frequency(Vdd, Vss,
+      Rd, Rs, Idss, Vp, rd, Rsig, Rl, caps);
+
+model.Av: 4.524859
+model.low: 37.825021, 12.197184 Hz
+model.high: 401373146.833855, 8014486.884752 Hz
+*/
+struct FrequencyModel jfet_common_gate_frequency(double Vdd,
+      double Vss, double Rd, double Rs, double Idss, double Vp,
+      double rd, double Rsig, double Rl,
+      struct JFET_Capacitors caps) {
+   // Check if the parameters of amplifier are consistent.
+   assert (Rsig > 0 && Rl > 0);
+   JFET_ACAnalysis ac = jfet_ac_common_gate(Vdd, Vss, Rd, Rs, Idss, Vp,
+                                            rd);
+   struct FrequencyModel model = {0};
+   // Mid-band gain with the source and load.
+   double Rl1 = _parallel_(Rd, Rl);
+   double Av = (ac.gm * Rl1 + Rl1 / rd) / (1 + Rl1 / rd);
+   model.Av = ac.Zi / (ac.Zi + Rsig) * Av;
+   // Coupling capacitors give the low poles.
+   model.low[model.nlow++] = _cutoff_(Rsig + ac.Zi, caps.Cg);
+   model.low[model.nlow++] = _cutoff_(ac.Zo + Rl, caps.Cc);
+   // Input and output capacitances give the high poles.
+   double Ci = caps.Cwi + caps.Cgs;
+   double Co = caps.Cwo + caps.Cgd + caps.Cds;
+   model.high[model.nhigh++] = _cutoff_(_parallel_(Rsig, ac.Zi), Ci);
+   model.high[model.nhigh++] = _cutoff_(_parallel_(ac.Zo, Rl), Co);
+
+   return model;
+}
+
+/* Write 'num' logarithmically spaced frequencies from 'start' to
+'stop' to 'frequencies'.
+
+double frequencies[5];
+log_frequencies(10, 100000, 5, frequencies);
+
+frequencies: 10, 100, 1000, 10000, 100000
+*/
+void log_frequencies(double start, double stop, size_t num,
+                     double *frequencies) {
+   // Check if the range is consistent.
+   assert (start > 0 && stop >= start && num > 0);
+   double step = (num > 1) ? log(stop / start) / (num - 1) : 0;
+   for (size_t i=0; i<num; i++)
+      frequencies[i] = start * exp(step * i);
+   frequencies[num - 1] = stop;
+}
+
+/* Compute the complex gain of 'model' at 'num' frequencies. The
+real and imaginary parts are written to 're' and 'im'. Each pole
+multiplies the gains of all frequencies, so the loops are vectorized
+across frequencies. */
+BATCH_DISPATCH
+void frequency_response(const struct FrequencyModel *model,
+                        size_t num, const double *frequencies,
+                        double *restrict re, double *restrict im) {
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++) {
+      re[i] = model->Av;
+      im[i] = 0;
+   }
+   // Low poles: multiply by 1 / (1 - jx) = (1 + jx) / (1 + x^2).
+   for (size_t p=0; p<model->nlow; p++) {
+      double pole = model->low[p];
+      BATCH_LOOP
+      for (size_t i=0; i<num; i++) {
+         double x = pole / frequencies[i], scale = 1 / (1 + x * x);
+         double a = re[i], b = im[i];
+         re[i] = (a - b * x) * scale;
+         im[i] = (b + a * x) * scale;
+      }
+   }
+   // High poles: multiply by 1 / (1 + jy) = (1 - jy) / (1 + y^2).
+   for (size_t p=0; p<model->nhigh; p++) {
+      double inverse = 1 / model->high[p];
+      BATCH_LOOP
+      for (size_t i=0; i<num; i++) {
+         double y = frequencies[i] * inverse, scale = 1 / (1 + y * y);
+         double a = re[i], b = im[i];
+         re[i] = (a + b * y) * scale;
+         im[i] = (b - a * y) * scale;
+      }
+   }
+}
+
+/* Compute the Bode plot of 'model' at 'num' frequencies: gains in
+dB and phases in degrees (-180, 180].
+
+double frequencies[3] = {10, 10000, 1e+7};
+double gain[3], phase[3];
+bode_response(&model, 3, frequencies, gain, phase);
+
+(bjt_voltage_divider_frequency() example)
+gain: -5.756479, 27.956102, 5.667311 dB
+phase: -1.751102, -179.450692, 47.316265 degrees
+*/
+void bode_response(const struct FrequencyModel *model, size_t num,
+                   const double *frequencies, double *restrict gain,
+                   double *restrict phase) {
+   // The complex gain is kept in the output columns.
+   frequency_response(model, num, frequencies, gain, phase);
+   for (size_t i=0; i<num; i++) {
+      double a = gain[i], b = phase[i];
+      gain[i] = 10 * log10(a * a + b * b);
+      phase[i] = atan2(b, a) * (360 / TWO_PI);
+   }
+}
+
+/* Find the mid-band gain, the lower and upper -3 dB frequencies and
+the bandwidth of 'model'. Without low poles, fL is 0; without high
+poles, fH is INFINITY.
+
+FrequencyAnalysis analysis = frequency_analysis(&model);
+display_frequency_results(analysis);
+
+(bjt_voltage_divider_frequency() example)
+Av: -24.996485
+fL: 165.682316 Hz
+fH: 1168576.619014 Hz
+bandwidth: 1168410.936698 Hz
+*/
+FrequencyAnalysis frequency_analysis(
+      const struct FrequencyModel *model) {
+   // Check if the model is consistent.
+   assert (model->nlow <= MAX_POLES && model->nhigh <= MAX_POLES);
+   FrequencyAnalysis analysis = {model->Av, 0, INFINITY, INFINITY};
+   // The mid-band is between the largest low and smallest high pole.
+   double low = 0, high = INFINITY;
+   for (size_t p=0; p<model->nlow; p++)
+      if (model->low[p] > low) low = model->low[p];
+   for (size_t p=0; p<model->nhigh; p++)
+      if (model->high[p] < high) high = model->high[p];
+   double middle = (low > 0 && isfinite(high)) ? sqrt(low * high) :
+                   (low > 0) ? 1e+3 * low : isfinite(high) ?
+                   1e-3 * high : 1;
+   // Search each cutoff between the mid-band and far beyond poles.
+   if (low > 0)
+      analysis.fL = (_relative_gain_(model, middle) < 0.5) ? NAN :
+                    _crossing_(model, 1e-3 * low, middle);
+   if (isfinite(high))
+      analysis.fH = (_relative_gain_(model, middle) < 0.5) ? NAN :
+                    _crossing_(model, middle, 1e+3 * high);
+   analysis.bandwidth = analysis.fH - analysis.fL;
+
+   return analysis;
+}
+
+/* Compute the frequencies of some designs of a batch run. */
+void _frequency_worker_(void *args, size_t index) {
+   struct FrequencyRun *run = args;
+   size_t first = run->num * index / run->threads;
+   size_t last = run->num * (index + 1) / run->threads;
+   for (size_t d=first; d<last; d++) {
+      run->analyses[d] = frequency_analysis(&run->models[d]);
+      if (run->gain == NULL) continue;
+      size_t offset = d * run->nfrequencies;
+      bode_response(&run->models[d], run->nfrequencies,
+                    run->frequencies, run->gain + offset,
+                    run->phase + offset);
+   }
+}
+
+/* Analyze 'num' designs on 'threads' threads (0 means all
+processors). The cutoffs of design 'd' are written to 'analyses[d]'.
+If 'gain' and 'phase' aren't NULL, the Bode plot of design 'd' at
+'nfrequencies' common frequencies is written to their row 'd'
+('num * nfrequencies' entries each).
+
+FrequencyAnalysis *analyses = malloc(num * sizeof(FrequencyAnalysis));
+frequency_batch(num, models, 1000, frequencies, gain, phase,
+                analyses, 0);
+*/
+void frequency_batch(size_t num, const struct FrequencyModel *models,
+                     size_t nfrequencies, const double *frequencies,
+                     double *gain, double *phase,
+                     FrequencyAnalysis *analyses, size_t threads) {
+   // Check if the columns are consistent.
+   assert (models != NULL && analyses != NULL);
+   assert ((gain == NULL) == (phase == NULL));
+   assert (gain == NULL || frequencies != NULL);
+   struct FrequencyRun run = {models, num, nfrequencies, frequencies,
+                              gain, phase, analyses};
+   run.threads = _num_threads_(threads);
+   if (run.threads > num) run.threads = num;
+   if (run.threads > 0) parallel_run(run.threads, _frequency_worker_,
+                                     &run);
+}
+
+#endif
@@ -0,0 +1,328 @@
+/* Incremental AC Analysis of Transistor Configurations
+
+In a sweep over the load side of a design (like 'ro', 'Rc' or 'rd'),
+the operating point doesn't change, but every call of an 'ac_*'
+function solves it again. So, this source file splits an analysis
+into nodes of intermediate quantities (like the bias currents, 'Zb'
+or 'gm') and records which parameters and nodes each one uses. An
+incremental analysis keeps the values of nodes and, when a parameter
+is updated, recomputes only the nodes which depend on it.
+
+struct IncrementalAnalysis analysis = incremental_analysis(
+      &bjt_incremental_emitter_bias, params);
+incremental_update(&analysis, 5, 80000); // 'ro', bias isn't solved
+BJT_ACAnalysis ac = bjt_incremental_results(&analysis);
+
+IMPORTANT NOTES:
+----------------
+
+1. Nodes compute the same expressions in the same order as the
+'ac_*' functions, so the results have the same bits.
+2. Parameters are in the order of the 'ac_*' functions. Updating a
+parameter with the same bits doesn't invalidate anything.
+3. Nodes are computed lazily: the invalidated nodes are recomputed
+when a value is read. So, updating several parameters before
+reading costs one recomputation.
+4. An analysis is a plain value (no allocation), but it isn't shared
+between threads. Give each thread its own copy.
+5. The first values of a graph are the AC results (in the order of
+the uniform columns of AC fields).
+
+EXISTING GRAPHS:
+----------------
+
++ BJT Emitter-Bias Configuration (bjt_incremental_emitter_bias)
++ JFET Voltage-Divider Configuration (jfet_incremental_voltage_divider)
+
+EXISTING OPERATIONS:
+--------------------
+
++ Lifetime (incremental_analysis, incremental_param)
++ Updates (incremental_update, incremental_refresh)
++ Results (incremental_value, bjt_incremental_results,
+jfet_incremental_results)
++ Sweeps (incremental_sweep)
+*/
+
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "BJT.h"
+#include "JFET.h"
+
+// General constants:
+#define INCREMENTAL_NODES 32 // maximum nodes of a graph (mask bits)
+#define INCREMENTAL_VALUES 16 // maximum values of a graph
+#define INCREMENTAL_RESULTS 4 // AC results at the front of values
+#define INCREMENTAL_NONE SIZE_MAX // index of missing parameters
+
+// Intermediate quantities computed together:
+struct IncrementalNode {
+   string name; // node name
+   uint32_t params; // mask of parameters used
+   uint32_t nodes; // mask of (earlier) nodes used
+   // Computation of node values from parameters and earlier values.
+   void (*compute)(const double *params, double *values);
+};
+
+// Dependency graph of a configuration:
+struct IncrementalGraph {
+   string name; // analyzed function
+   size_t nparams; // number of parameters
+   string params[MAX_PARAMS]; // parameter names in call order
+   size_t nvalues; // number of values
+   string values[INCREMENTAL_VALUES]; // value names (results first)
+   string phase; // phase relationship of results
+   size_t nnodes; // number of nodes
+   struct IncrementalNode nodes[INCREMENTAL_NODES]; // in dependency
+                                                    // order
+};
+
+// State of an incremental analysis:
+struct IncrementalAnalysis {
+   const struct IncrementalGraph *graph; // analyzed graph
+   double params[MAX_PARAMS]; // current parameters
+   double values[INCREMENTAL_VALUES]; // values of valid nodes
+   uint32_t stale; // mask of nodes to recompute
+   uint32_t dependents[MAX_PARAMS]; // nodes invalidated by parameters
+   size_t computed; // count of node computations
+};
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+// Mask of the k'th parameter (or node):
+#define INC(k) (UINT32_C(1) << (k))
+
+// Index of the lowest set bit of a (non-zero) mask:
+#if defined(__GNUC__) || defined(__clang__)
+#define INC_LOWEST(mask) ((size_t) __builtin_ctz(mask))
+#else
+#define INC_LOWEST(mask) _incremental_lowest_(mask)
+size_t _incremental_lowest_(uint32_t mask) {
+   size_t k = 0;
+   while (!(mask & INC(k))) k++;
+   return k;
+}
+#endif
+
+/* BJT emitter-bias nodes. Parameters are (Vcc, Rb, Rc, Re, beta, ro)
+and values are (re, Zi, Zo, Av, Ib, Ie, Zb, beta * re, Zo2). The
+terms of 'Zb' and 'Zo' which don't depend on 'ro' are found with the
+bias, so a sweep of 'ro' doesn't compute them again. */
+void _bjt_inc_eb_bias_(const double *p, double *v) {
+   double Vcc = p[0], Rb = p[1], Re = p[3], beta = p[4];
+   v[4] = (Vcc - Vbe) / (Rb + (beta + 1) * Re);
+   v[5] = (beta + 1) * v[4];
+   v[0] = 0.026 / v[5];
+   v[7] = beta * v[0];
+   v[8] = 1 + (beta * v[0]) / Re;
+}
+void _bjt_inc_eb_zb_(const double *p, double *v) {
+   double Rc = p[2], Re = p[3], beta = p[4], ro = p[5];
+   double Zb1 = (beta + 1) + (Rc/ro);
+   double Zb2 = 1 + (Rc + Re) / ro;
+   v[6] = v[7] + (Zb1 / Zb2) * Re;
+}
+void _bjt_inc_eb_zi_(const double *p, double *v) {
+   v[1] = _Rth_(p[1], v[6]);
+}
+void _bjt_inc_eb_zo_(const double *p, double *v) {
+   double Rc = p[2], beta = p[4], ro = p[5];
+   double Zo1 = beta * (ro + v[0]);
+   double Zo3 = ro + Zo1 / v[8];
+   v[2] = _Rth_(Rc, Zo3);
+}
+void _bjt_inc_eb_av_(const double *p, double *v) {
+   double Rc = p[2], beta = p[4], ro = p[5];
+   double Av1 = (-1 * (beta * Rc) / v[6]) *
+                (1 + (v[0] / ro)) + (Rc/ro);
+   double Av2 = 1 + (Rc / ro);
+   v[3] = Av1 / Av2;
+}
+
+/* JFET voltage-divider nodes. Parameters are (Vdd, Rg1, Rg2, Rd, Rs,
+Idss, Vp, rd) and values are (gm, Zi, Zo, Av, Vg, Id, Vgs). */
+void _jfet_inc_vd_bias_(const double *p, double *v) {
+   double Vdd = p[0], Rg1 = p[1], Rg2 = p[2], Rs = p[4];
+   double Idss = p[5], Vp = p[6];
+   double Vg = (Rg2 * Vdd) / (Rg1 + Rg2);
+   // For quadritic equations, find discriminant.
+   double a = Rs * Rs * Idss / Vp / Vp;
+   double b1 = (2.0 * Rs * Idss / Vp);
+   double b2 = (2.0 * Vg * Rs * Idss / Vp / Vp);
+   double b = b1 - b2 - 1;
+   double c = Idss * (1.0-(2.0 * Vg/Vp) + (Vg * Vg/Vp/Vp));
+   v[4] = Vg;
+   v[5] = _drain_current_(a, b, c);
+   v[6] = Vg - v[5] * Rs;
+}
+void _jfet_inc_vd_gm_(const double *p, double *v) {
+   v[0] = _gm_factor_(p[5], p[6], v[6]);
+}
+void _jfet_inc_vd_zi_(const double *p, double *v) {
+   v[1] = _parallel_(p[1], p[2]);
+}
+void _jfet_inc_vd_zo_(const double *p, double *v) {
+   v[2] = _parallel_(p[3], p[7]);
+}
+void _jfet_inc_vd_av_(const double *p, double *v) {
+   (void) p;
+   v[3] = -1 * v[0] * v[2];
+}
+
+/* Find the nodes which depend on a parameter (directly or through
+earlier nodes). */
+uint32_t _incremental_dependents_(const struct IncrementalGraph *graph,
+                                  size_t param) {
+   uint32_t dependents = 0;
+   // Earlier nodes are decided first, so one pass is enough.
+   for (size_t n=0; n<graph->nnodes; n++)
+      if ((graph->nodes[n].params & INC(param)) ||
+          (graph->nodes[n].nodes & dependents))
+         dependents |= INC(n);
+   return dependents;
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+// BJT emitter-bias graph (see bjt_ac_emitter_bias()):
+const struct IncrementalGraph bjt_incremental_emitter_bias = {
+   "bjt_ac_emitter_bias", 6, {"Vcc", "Rb", "Rc", "Re", "beta", "ro"},
+   9, {"re", "Zi", "Zo", "Av", "Ib", "Ie", "Zb", "beta*re", "Zo2"},
+   "Out of phase", 5, {
+   {"bias", INC(0) | INC(1) | INC(3) | INC(4), 0, _bjt_inc_eb_bias_},
+   {"Zb", INC(2) | INC(3) | INC(4) | INC(5), INC(0), _bjt_inc_eb_zb_},
+   {"Zi", INC(1), INC(1), _bjt_inc_eb_zi_},
+   {"Zo", INC(2) | INC(4) | INC(5), INC(0), _bjt_inc_eb_zo_},
+   {"Av", INC(2) | INC(4) | INC(5), INC(0) | INC(1),
+    _bjt_inc_eb_av_}}
+};
+
+// JFET voltage-divider graph (see jfet_ac_voltage_divider()):
+const struct IncrementalGraph jfet_incremental_voltage_divider = {
+   "jfet_ac_voltage_divider", 8, {"Vdd", "Rg1", "Rg2", "Rd", "Rs",
+   "Idss", "Vp", "rd"}, 7, {"gm", "Zi", "Zo", "Av", "Vg", "Id", "Vgs"},
+   "Out of phase", 5, {
+   {"bias", INC(0) | INC(1) | INC(2) | INC(4) | INC(5) | INC(6), 0,
+    _jfet_inc_vd_bias_},
+   {"gm", INC(5) | INC(6), INC(0), _jfet_inc_vd_gm_},
+   {"Zi", INC(1) | INC(2), 0, _jfet_inc_vd_zi_},
+   {"Zo", INC(3) | INC(7), 0, _jfet_inc_vd_zo_},
+   {"Av", 0, INC(1) | INC(3), _jfet_inc_vd_av_}}
+};
+
+/* Create an incremental analysis of a graph with its first parameters
+(in call order). Nothing is computed until a value is read.
+
+double params[6] = {20, 470000, 2200, 560, 120, 40000};
+struct IncrementalAnalysis analysis = incremental_analysis(
+      &bjt_incremental_emitter_bias, params);
+*/
+struct IncrementalAnalysis incremental_analysis(
+      const struct IncrementalGraph *graph, const double *params) {
+   // Check if the graph fits in the masks.
+   assert (graph->nnodes <= INCREMENTAL_NODES &&
+           graph->nparams <= MAX_PARAMS);
+   struct IncrementalAnalysis analysis;
+   memset(&analysis, 0, sizeof(analysis));
+   analysis.graph = graph;
+   memcpy(analysis.params, params, graph->nparams * sizeof(double));
+   analysis.stale = (graph->nnodes == INCREMENTAL_NODES) ? UINT32_MAX :
+                    INC(graph->nnodes) - 1;
+   for (size_t p=0; p<graph->nparams; p++)
+      analysis.dependents[p] = _incremental_dependents_(graph, p);
+   return analysis;
+}
+
+/* Find the index of the parameter named 'name' in a graph. If it
+doesn't exist, INCREMENTAL_NONE is returned. */
+size_t incremental_param(const struct IncrementalGraph *graph,
+                         const char *name) {
+   for (size_t p=0; p<graph->nparams; p++)
+      if (strcmp(graph->params[p], name) == 0) return p;
+   return INCREMENTAL_NONE;
+}
+
+/* Update the parameter at 'index'. Only the nodes which depend on it
+are invalidated. */
+void incremental_update(struct IncrementalAnalysis *analysis,
+                        size_t index, double value) {
+   assert (index < analysis->graph->nparams);
+   // Same bits don't change any node.
+   if (memcmp(&analysis->params[index], &value, sizeof(double)) == 0)
+      return;
+   analysis->params[index] = value;
+   analysis->stale |= analysis->dependents[index];
+}
+
+/* Recompute the invalidated nodes (in dependency order). */
+void incremental_refresh(struct IncrementalAnalysis *analysis) {
+   const struct IncrementalNode *nodes = analysis->graph->nodes;
+   // Lower bits are earlier nodes, so take the lowest one each time.
+   for (uint32_t stale = analysis->stale; stale != 0;
+        stale &= stale - 1) {
+      nodes[INC_LOWEST(stale)].compute(analysis->params,
+                                       analysis->values);
+      analysis->computed++;
+   }
+   analysis->stale = 0;
+}
+
+/* Get the value at 'index' (see the value names of graph). */
+double incremental_value(struct IncrementalAnalysis *analysis,
+                         size_t index) {
+   assert (index < analysis->graph->nvalues);
+   incremental_refresh(analysis);
+   return analysis->values[index];
+}
+
+/* Get the AC results of a BJT graph. */
+BJT_ACAnalysis bjt_incremental_results(
+      struct IncrementalAnalysis *analysis) {
+   incremental_refresh(analysis);
+   const double *v = analysis->values;
+   BJT_ACAnalysis results = {v[0], v[1], v[2], v[3],
+                             analysis->graph->phase};
+   return results;
+}
+
+/* Get the AC results of a JFET graph. */
+JFET_ACAnalysis jfet_incremental_results(
+      struct IncrementalAnalysis *analysis) {
+   incremental_refresh(analysis);
+   const double *v = analysis->values;
+   JFET_ACAnalysis results = {v[0], v[1], v[2], v[3],
+                              analysis->graph->phase};
+   return results;
+}
+
+/* Sweep the parameter at 'index' over 'num' values and write the AC
+results of each value to 'results' columns (INCREMENTAL_RESULTS of
+them). The analysis is left at the last value.
+
+double ro[3] = {20000, 40000, 80000}, re[3], Zi[3], Zo[3], Av[3];
+double *columns[4] = {re, Zi, Zo, Av};
+incremental_sweep(&analysis, 5, 3, ro, columns); // bias solved once
+*/
+void incremental_sweep(struct IncrementalAnalysis *analysis,
+                       size_t index, size_t num, const double *values,
+                       double *const *results) {
+   for (size_t i=0; i<num; i++) {
+      incremental_update(analysis, index, values[i]);
+      incremental_refresh(analysis);
+      for (size_t r=0; r<INCREMENTAL_RESULTS; r++)
+         results[r][i] = analysis->values[r];
+   }
+}
+
+#endif
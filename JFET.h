@@ -14,32 +14,71 @@ IMPORTANT NOTES:
 If voltage source connect the inverse, the algorithm handle it.
 2. All transistor configuratiions are set as 'npn' type. 
 3. In ac analysis, algorithms use 'JFET small signal' model.
+4. All names begin with 'jfet_' (or 'JFET_' for types), so this
+source file can be included together with BJT.h and MOSFET.h.
+Functions are 'static inline', so it can be included next to the
+library too (see TransCal.h).
 
 EXISTING CONFIGURATIONS:
 ------------------------
 
-+ dc_fixed_bias()
-+ ac_fixed_bias()
-+ dc_self_bias()
-+ ac_self_bias()
-+ dc_voltage_divider()
-+ ac_voltage_divider()
-+ dc_common_gate()
-+ ac_common_gate()
-+ ac_source_follower()
++ jfet_dc_fixed_bias()
++ jfet_ac_fixed_bias()
++ jfet_dc_self_bias()
++ jfet_ac_self_bias()
++ jfet_dc_voltage_divider()
++ jfet_ac_voltage_divider()
++ jfet_dc_common_gate()
++ jfet_ac_common_gate()
++ jfet_ac_source_follower()
+
+FUSED (DC AND AC) ANALYSES:
+---------------------------
+
++ jfet_analyze_fixed_bias()
++ jfet_analyze_self_bias()
++ jfet_analyze_voltage_divider()
++ jfet_analyze_common_gate()
+
+BATCH ENTRY POINTS:
+-------------------
+
++ _drain_current_batch_() (see FET.h)
++ jfet_analyze_fixed_bias_batch()
++ jfet_analyze_self_bias_batch()
++ jfet_analyze_voltage_divider_batch()
++ jfet_analyze_common_gate_batch()
+
+TEXT FORMATTING:
+----------------
+
++ jfet_format_dc_results()
++ jfet_format_ac_results()
+
+UNIFORM DESCRIPTIONS:
+---------------------
+
++ jfet_configurations[] (see Configuration.h)
 */
 
+#ifndef JFET_H
+#define JFET_H
+
 // Libraries:
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <math.h>
+#include "Batch.h"
+#include "Configuration.h"
+#include "FET.h"
+#include "Format.h"
 
 // User-defined string type:
 typedef char * string;
 
 // Results of DC analysis:
-struct DCResults {
+struct JFET_DCResults {
    double Id; // drain current
    double Vgs; // gate-source voltage
    double Vds; // drain-source voltage
@@ -49,7 +88,7 @@ struct DCResults {
 };
 
 // Results of AC analysis:
-struct ACResults {
+struct JFET_ACResults {
    double gm; // transconductance factor
    double Zi; // input impedance
    double Zo; // output impedance
@@ -57,50 +96,43 @@ struct ACResults {
    string phase; // phase relationship
 };
 
-// User-defined analysis types:
-typedef struct DCResults DCAnalysis;
-typedef struct ACResults ACAnalysis;
-
-/* --------------------------------------------------------------- */
-/* ---------------------- Helper Definations --------------------- */
-/* --------------------------------------------------------------- */
+// Results of fused DC and AC analysis:
+struct JFET_FusedResults {
+   struct JFET_DCResults dc; // DC analysis
+   struct JFET_ACResults ac; // AC analysis
+};
 
-/* Get the parallel resultant of 'R1' and 'R2'. */
-double _parallel_(double R1, double R2) {
-   // Find the resultant resistance for parallel resistors.
-   return 1.0 / (1.0 / R1 + 1.0 / R2);
-}
+// Result columns of batch DC analysis:
+struct JFET_DCColumns {
+   double *restrict Id; // drain currents
+   double *restrict Vgs; // gate-source voltages
+   double *restrict Vds; // drain-source voltages
+   double *restrict Vs; // source voltages
+   double *restrict Vd; // drain voltages
+   double *restrict Vg; // gate voltages
+};
 
-/* Find the transconductance factor (gm). */
-double _gm_factor_(double Idss, double Vp, double Vgs) {
-   // Find the transconductance factor (gm).
-   return (2.0 * Idss / abs(Vp)) * (1.0 - Vgs / Vp);
-}
+// Result columns of batch AC analysis:
+struct JFET_ACColumns {
+   double *restrict gm; // transconductance factors
+   double *restrict Zi; // input impedances
+   double *restrict Zo; // output impedances
+   double *restrict Av; // voltage gains
+};
 
-/* Select the right drain current using discriminant. */
-double _drain_current_(double a, double b, double c) {
-   // Find the discriminant and calculate two different roots.
-   double dicriminant = (b * b) - (4 * a * c);
-   double root1 = (-1.0 * b + sqrt(dicriminant)) / (2 * a);
-   double root2 = (-1.0 * b - sqrt(dicriminant)) / (2 * a);
-   // Specially, in some configurations, can be found two 
-   // roots and requries to select one of them.
-   if (root1 >= 0 && root2 < 0) return root1;
-   if (root2 >= 0 && root1 < 0) return root2;
-   if (root1 >= 0 && root2 >= 0) {
-      if (root1 >= root2) return root2;
-      else return root1;} 
-   if (root1 < 0 && root2 < 0) {
-      if (abs(root1) >= abs(root2)) return abs(root2);
-      else return abs(root1);}
-}
+// User-defined analysis types:
+typedef struct JFET_DCResults JFET_DCAnalysis;
+typedef struct JFET_ACResults JFET_ACAnalysis;
+typedef struct JFET_FusedResults JFET_FusedAnalysis;
+typedef struct JFET_DCColumns JFET_DCBatch;
+typedef struct JFET_ACColumns JFET_ACBatch;
 
 /* --------------------------------------------------------------- */
 /* ------------------------- Display Results --------------------- */
 /* --------------------------------------------------------------- */
 
 /* Display the DC results of any kind of transistor. */
-void display_dc_results(DCAnalysis analysis) {
+static inline void jfet_display_dc_results(JFET_DCAnalysis analysis) {
    // Display the DC results.
    printf("Id: %e A\n", analysis.Id);
    printf("Vgs: %f V\n", analysis.Vgs);
@@ -111,7 +143,7 @@ void display_dc_results(DCAnalysis analysis) {
 }
 
 /* Display the AC results of any kind of transistor. */
-void display_ac_results(ACAnalysis analysis) {
+static inline void jfet_display_ac_results(JFET_ACAnalysis analysis) {
    // Display the AC results.
    printf("gm: %e S\n", analysis.gm);
    printf("Zi: %f ohm\n", analysis.Zi);
@@ -120,6 +152,30 @@ void display_ac_results(ACAnalysis analysis) {
    printf("Phase: %s\n", analysis.phase);
 }
 
+/* Format the DC results as fields of the current text row (see
+Format.h and bjt_format_dc_results()). */
+static inline void jfet_format_dc_results(struct TextBuffer *text,
+                                          JFET_DCAnalysis analysis) {
+   // Format the DC results.
+   text_double(text, "Id", analysis.Id);
+   text_double(text, "Vgs", analysis.Vgs);
+   text_double(text, "Vds", analysis.Vds);
+   text_double(text, "Vs", analysis.Vs);
+   text_double(text, "Vd", analysis.Vd);
+   text_double(text, "Vg", analysis.Vg);
+}
+
+/* Format the AC results as fields of the current text row. */
+static inline void jfet_format_ac_results(struct TextBuffer *text,
+                                          JFET_ACAnalysis analysis) {
+   // Format the AC results.
+   text_double(text, "gm", analysis.gm);
+   text_double(text, "Zi", analysis.Zi);
+   text_double(text, "Zo", analysis.Zo);
+   text_double(text, "Av", analysis.Av);
+   text_string(text, "phase", analysis.phase);
+}
+
 /* --------------------------------------------------------------- */
 /* ------------------------ Main Definations --------------------- */
 /* --------------------------------------------------------------- */
@@ -127,8 +183,8 @@ void display_ac_results(ACAnalysis analysis) {
 /* DC analysis of fixed-bias transistor configuration. 
 
 double Vdd=16, Vgg=2, Rd=2000, Idss=0.01, Vp=-8;
-DCAnalysis analysis = dc_fixed_bias(Vdd, Vgg, Rd, Idss, Vp);
-display_dc_results(analysis);
+JFET_DCAnalysis analysis = jfet_dc_fixed_bias(Vdd, Vgg, Rd, Idss, Vp);
+jfet_display_dc_results(analysis);
 
 Id: 5.625000e-03 A
 Vgs: -2.000000 V
@@ -137,12 +193,12 @@ Vg: -2.000000 V
 Vd: 4.750000 V
 Vs: 0.000000 V
 */
-DCAnalysis dc_fixed_bias(double Vdd, double Vgg, double Rd, 
-                         double Idss, double Vp) {
+static inline JFET_DCAnalysis jfet_dc_fixed_bias(double Vdd, double Vgg, 
+      double Rd, double Idss, double Vp) {
    // Check if the parameters of transistor are consistent.
    assert (Rd > 0);
    // Create DC analysis object.
-   DCAnalysis analysis;
+   JFET_DCAnalysis analysis;
    // Calculate the all analyzes of transistor.
    analysis.Vgs = -1 * Vgg; 
    analysis.Id = Idss * (1.0 - analysis.Vgs / Vp) * 
@@ -159,9 +215,9 @@ DCAnalysis dc_fixed_bias(double Vdd, double Vgg, double Rd,
 
 double Vdd=16, Vgg=2, Rd=2000, Rg=1e+6;
 double Idss=0.01, Vp=-8, rd=25000;
-ACAnalysis analysis = ac_fixed_bias(Vdd, Vgg, Rg, Rd, 
-                                    Idss, Vp, rd);
-display_ac_results(analysis);
+JFET_ACAnalysis analysis = jfet_ac_fixed_bias(Vdd, Vgg, Rg, Rd, Idss, 
+      Vp, rd);
+jfet_display_ac_results(analysis);
 
 gm: 1.875000e-03 S
 Zi: 1000000.000000 ohm
@@ -169,12 +225,12 @@ Zo: 1851.851852 ohm
 Av: -3.472222
 Phase: Out of phase
 */
-ACAnalysis ac_fixed_bias(double Vdd, double Vgg, double Rg, 
-               double Rd, double Idss, double Vp, double rd) {
+static inline JFET_ACAnalysis jfet_ac_fixed_bias(double Vdd, double Vgg, 
+      double Rg, double Rd, double Idss, double Vp, double rd) {
    // Check if the parameters of transistor are consistent.
    assert (Rd > 0 && Rg > 0 && rd > 0);
    // Create AC analysis object.
-   ACAnalysis analysis;
+   JFET_ACAnalysis analysis;
    // Calculate the all analyzes of transistor.
    double Vgs = -1 * Vgg; 
    analysis.gm = _gm_factor_(Idss, Vp, Vgs);
@@ -189,8 +245,8 @@ ACAnalysis ac_fixed_bias(double Vdd, double Vgg, double Rg,
 /* DC analysis of self-bias transistor configuration. 
 
 double Vdd=20, Rd=3300, Rs=1000, Idss=0.008, Vp=-6;
-DCAnalysis analysis = dc_self_bias(Vdd, Rd, Rs, Idss, Vp);
-display_dc_results(analysis);
+JFET_DCAnalysis analysis = jfet_dc_self_bias(Vdd, Rd, Rs, Idss, Vp);
+jfet_display_dc_results(analysis);
 
 Id: 2.587624e-03 A
 Vgs: -2.587624 V
@@ -199,12 +255,12 @@ Vg: 0.000000 V
 Vd: 11.460840 V
 Vs: 2.587624 V
 */
-DCAnalysis dc_self_bias(double Vdd, double Rd, double Rs, 
-                        double Idss, double Vp) {
+static inline JFET_DCAnalysis jfet_dc_self_bias(double Vdd, double Rd, 
+      double Rs, double Idss, double Vp) {
    // Check if the parameters of transistor are consistent.
    assert (Rd > 0 && Rs > 0);
    // Create DC analysis object.
-   DCAnalysis analysis;
+   JFET_DCAnalysis analysis;
    // Calculate the all analyzes of transistor. For that, 
    // previously select the right Id using dicriminant.
    double a = Rs * Rs * Idss / Vp / Vp;
@@ -224,9 +280,9 @@ DCAnalysis dc_self_bias(double Vdd, double Rd, double Rs,
 
 double Vdd=20, Rd=3300, Rs=1000, Vp=-6;
 double Idss=0.008, Rg=1e+6, rd=50000;
-ACAnalysis analysis = ac_self_bias(Vdd, Rg, Rd, Rs, 
-                                   Idss, Vp, rd);
-display_ac_results(analysis);
+JFET_ACAnalysis analysis = jfet_ac_self_bias(Vdd, Rg, Rd, Rs, Idss, Vp, 
+      rd);
+jfet_display_ac_results(analysis);
 
 gm: 1.516611e-03 S
 Zi: 1000000.000000 ohm
@@ -234,12 +290,12 @@ Zo: 3216.314824 ohm
 Av: -1.922998
 Phase: Out of phase
 */
-ACAnalysis ac_self_bias(double Vdd, double Rg, double Rd, double Rs, 
-                        double Idss, double Vp, double rd) {
+static inline JFET_ACAnalysis jfet_ac_self_bias(double Vdd, double Rg, 
+      double Rd, double Rs, double Idss, double Vp, double rd) {
    // Check if the parameters of transistor are consistent.
    assert (Rd > 0 && Rg > 0 && Rs > 0 && rd > 0);
    // Create AC analysis object.
-   ACAnalysis analysis;
+   JFET_ACAnalysis analysis;
    // Calculate the all analyzes of transistor. For that, 
    // previously select the right Id using discriminant.
    double a = Rs * Rs * Idss / Vp / Vp;
@@ -264,9 +320,9 @@ ACAnalysis ac_self_bias(double Vdd, double Rg, double Rd, double Rs,
 
 double Vdd=16, Rg1=21*1e+5, Rg2=27*1e+4;
 double Rd=2400, Rs=1500, Idss=0.008, Vp=-4;
-DCAnalysis analysis = dc_voltage_divider(Vdd, Rg1, Rg2, Rd, 
-                                        Rs, Idss, Vp);
-display_dc_results(analysis);
+JFET_DCAnalysis analysis = jfet_dc_voltage_divider(Vdd, Rg1, Rg2, Rd, 
+      Rs, Idss, Vp);
+jfet_display_dc_results(analysis);
 
 Id: 2.416309e-03 A
 Vgs: -1.801678 V
@@ -275,12 +331,13 @@ Vg: 1.822785 V
 Vd: 10.200859 V
 Vs: 3.624463 V
 */
-DCAnalysis dc_voltage_divider(double Vdd, double Rg1, double Rg2,
-                  double Rd, double Rs, double Idss, double Vp){
+static inline JFET_DCAnalysis jfet_dc_voltage_divider(double Vdd, 
+      double Rg1, double Rg2, double Rd, double Rs, double Idss, 
+      double Vp){
    // Check if the parameters of transistor are consistent.
    assert (Rg1 > 0 && Rg2 > 0 && Rd > 0 && Rs > 0);
    // Create DC analysis object.
-   DCAnalysis analysis;
+   JFET_DCAnalysis analysis;
    // Calculate the all analyzes of transistor.
    analysis.Vg = (Rg2 * Vdd) / (Rg1 + Rg2);
    // For quadritic equations, find discriminant.
@@ -303,9 +360,9 @@ DCAnalysis dc_voltage_divider(double Vdd, double Rg1, double Rg2,
 
 double Vdd=20, Rg1=82*1e+6, Rg2=11*1e+6, Rd=2000;
 double Rs=610, Idss=0.012, Vp=-3, rd=5*1e+5;
-ACAnalysis analysis = ac_voltage_divider(Vdd, Rg1, Rg2, Rd, 
-                                         Rs, Idss, Vp, rd);
-display_ac_results(analysis);
+JFET_ACAnalysis analysis = jfet_ac_voltage_divider(Vdd, Rg1, Rg2, Rd, 
+      Rs, Idss, Vp, rd);
+jfet_display_ac_results(analysis);
 
 gm: 5.403363e-03 S
 Zi: 9698924.731183 ohm
@@ -313,12 +370,13 @@ Zo: 1992.031873 ohm
 Av: -10.763671
 Phase: Out of phase
 */
-ACAnalysis ac_voltage_divider(double Vdd, double Rg1, double Rg2,
-         double Rd, double Rs, double Idss, double Vp, double rd){
+static inline JFET_ACAnalysis jfet_ac_voltage_divider(double Vdd, 
+      double Rg1, double Rg2, double Rd, double Rs, double Idss, 
+      double Vp, double rd){
    // Check if the parameters of transistor are consistent.
    assert (Rg1 > 0 && Rg2 > 0 && Rd > 0 && Rs > 0);
    // Create AC analysis object.
-   ACAnalysis analysis;
+   JFET_ACAnalysis analysis;
    // Calculate the all analyzes of transistor.
    double Vg = (Rg2 * Vdd) / (Rg1 + Rg2);
    // For quadritic equations, find discriminant.
@@ -341,8 +399,9 @@ ACAnalysis ac_voltage_divider(double Vdd, double Rg1, double Rg2,
 /* DC analysis of common-gate transistor configuration. 
 
 double Vdd=12, Vss=0, Rd=1500, Rs=680, Idss=0.012, Vp=-6;
-DCAnalysis analysis = dc_common_gate(Vdd, Vss, Rd, Rs, Idss, Vp);
-display_dc_results(analysis);
+JFET_DCAnalysis analysis = jfet_dc_common_gate(Vdd, Vss, Rd, Rs, Idss, 
+      Vp);
+jfet_display_dc_results(analysis);
 
 Id: 3.835265e-03 A
 Vgs: -2.607980 V
@@ -351,12 +410,12 @@ Vg: 0.000000 V
 Vd: 6.247102 V
 Vs: 2.607980 V
 */
-DCAnalysis dc_common_gate(double Vdd, double Vss, double Rd, 
-                           double Rs, double Idss, double Vp) {
+static inline JFET_DCAnalysis jfet_dc_common_gate(double Vdd, double Vss, 
+      double Rd, double Rs, double Idss, double Vp) {
    // Check if the parameters of transistor are consistent.
    assert (Rd > 0 && Rs > 0);
    // Create DC analysis object.
-   DCAnalysis analysis;
+   JFET_DCAnalysis analysis;
    // For quadritic equations, find discriminant.
    double a = (Rs * Rs) * Idss / (Vp * Vp);
    double b1 = 2.0 * Rs * Idss / Vp;
@@ -380,22 +439,22 @@ DCAnalysis dc_common_gate(double Vdd, double Vss, double Rd,
 
 double Vdd=15, Vss=0, Rd=3300, Rs=1500, Idss=0.008;
 double Vp=-2.8, rd=4*1e+4;
-ACAnalysis analysis = ac_common_gate(Vdd, Vss, Rd, Rs, 
-                                     Idss, Vp, rd);
-display_ac_results(analysis);
+JFET_ACAnalysis analysis = jfet_ac_common_gate(Vdd, Vss, Rd, Rs, Idss, 
+      Vp, rd);
+jfet_display_ac_results(analysis);
 
-gm: 3.042147e-03 S
-Zi: 285.709479 ohm
+gm: 2.172962e-03 S
+Zi: 370.766303 ohm
 Zo: 3048.498845 ohm
-Av: 9.350194
+Av: 6.700485
 Phase: In phase
 */
-ACAnalysis ac_common_gate(double Vdd, double Vss, double Rd, 
-                  double Rs, double Idss, double Vp, double rd) {
+static inline JFET_ACAnalysis jfet_ac_common_gate(double Vdd, double Vss, 
+      double Rd, double Rs, double Idss, double Vp, double rd) {
    // Check if the parameters of transistor are consistent.
    assert (Rd > 0 && Rs > 0 && rd > 0);
    // Create AC analysis object.
-   ACAnalysis analysis;
+   JFET_ACAnalysis analysis;
    // For quadritic equations, find discriminant.
    double a = (Rs * Rs) * Idss / (Vp * Vp);
    double b1 = 2.0 * Rs * Idss / Vp;
@@ -423,9 +482,9 @@ ACAnalysis ac_common_gate(double Vdd, double Vss, double Rd,
 
 double Vdd=9, Vgs=-2.86, Rg=1e+6, Rs=2200;
 double Idss=0.016, Vp=-4, rd=4*1e+4; 
-ACAnalysis analysis = ac_source_follower(Vdd, Vgs, Rg, Rs, 
-                                         Idss, Vp, rd);
-display_ac_results(analysis);
+JFET_ACAnalysis analysis = jfet_ac_source_follower(Vdd, Vgs, Rg, Rs, 
+      Idss, Vp, rd);
+jfet_display_ac_results(analysis);
 
 gm: 2.280000e-03 S
 Zi: 1000000.000000 ohm
@@ -433,12 +492,13 @@ Zo: 362.378521 ohm
 Av: 0.826223
 Phase: In phase
 */
-ACAnalysis ac_source_follower(double Vdd, double Vgs, double Rg,
-                  double Rs, double Idss, double Vp, double rd) {
+static inline JFET_ACAnalysis jfet_ac_source_follower(double Vdd, 
+      double Vgs, double Rg, double Rs, double Idss, double Vp, 
+      double rd) {
    // Check if the parameters of transistor are consistent.
    assert (Rg > 0 && Rs > 0 && rd > 0);
    // Create AC analysis object.
-   ACAnalysis analysis;
+   JFET_ACAnalysis analysis;
    // Calculate the all analyzes of transistor.
    analysis.gm = _gm_factor_(Idss, Vp, Vgs); 
    analysis.Zi = Rg; 
@@ -450,3 +510,363 @@ ACAnalysis ac_source_follower(double Vdd, double Vgs, double Rg,
 
    return analysis;
 }
+
+/* --------------------------------------------------------------- */
+/* ----------------------- Fused Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Fused DC and AC analysis of fixed-bias transistor configuration.
+
+The operating point is solved only once and the AC analysis uses
+its gate-source voltage. So, it is cheaper than calling both of
+'jfet_dc_fixed_bias()' and 'jfet_ac_fixed_bias()'.
+
+double Vdd=16, Vgg=2, Rd=2000, Rg=1e+6;
+double Idss=0.01, Vp=-8, rd=25000;
+JFET_FusedAnalysis analysis = jfet_analyze_fixed_bias(Vdd, Vgg, Rg, Rd, 
+      Idss, Vp, rd);
+jfet_display_dc_results(analysis.dc);
+jfet_display_ac_results(analysis.ac);
+
+Id: 5.625000e-03 A
+Vgs: -2.000000 V
+...
+gm: 1.875000e-03 S
+Zi: 1000000.000000 ohm
+Zo: 1851.851852 ohm
+Av: -3.472222
+Phase: Out of phase
+*/
+static inline JFET_FusedAnalysis jfet_analyze_fixed_bias(double Vdd, 
+      double Vgg, double Rg, double Rd, double Idss, double Vp, 
+      double rd) {
+   // Check if the parameters of transistor are consistent.
+   assert (Rd > 0 && Rg > 0 && rd > 0);
+   // Create fused analysis object.
+   JFET_FusedAnalysis analysis;
+   // Solve the operating point only once.
+   analysis.dc = jfet_dc_fixed_bias(Vdd, Vgg, Rd, Idss, Vp);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac.gm = _gm_factor_(Idss, Vp, analysis.dc.Vgs);
+   analysis.ac.Zi = Rg; 
+   analysis.ac.Zo = _parallel_(Rd, rd); 
+   analysis.ac.Av = -1.0 * analysis.ac.gm * analysis.ac.Zo; 
+   analysis.ac.phase = "Out of phase";
+
+   return analysis;
+}
+
+/* Fused DC and AC analysis of self-bias transistor configuration.
+
+double Vdd=20, Rd=3300, Rs=1000, Vp=-6;
+double Idss=0.008, Rg=1e+6, rd=50000;
+JFET_FusedAnalysis analysis = jfet_analyze_self_bias(Vdd, Rg, Rd, Rs, 
+      Idss, Vp, rd);
+jfet_display_dc_results(analysis.dc);
+jfet_display_ac_results(analysis.ac);
+
+Id: 2.587624e-03 A
+Vgs: -2.587624 V
+...
+gm: 1.516611e-03 S
+Zi: 1000000.000000 ohm
+Zo: 3216.314824 ohm
+Av: -1.922998
+Phase: Out of phase
+*/
+static inline JFET_FusedAnalysis jfet_analyze_self_bias(double Vdd, 
+      double Rg, double Rd, double Rs, double Idss, double Vp, 
+      double rd) {
+   // Check if the parameters of transistor are consistent.
+   assert (Rd > 0 && Rg > 0 && Rs > 0 && rd > 0);
+   // Create fused analysis object.
+   JFET_FusedAnalysis analysis;
+   // Solve the operating point (the quadratic) only once.
+   analysis.dc = jfet_dc_self_bias(Vdd, Rd, Rs, Idss, Vp);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac.gm = _gm_factor_(Idss, Vp, analysis.dc.Vgs);
+   analysis.ac.Zi = Rg; 
+   double Zo1 = 1 + analysis.ac.gm * Rs + Rs / rd;
+   double Zo2 = 1 + analysis.ac.gm * Rs + Rs / rd + Rd / rd;
+   analysis.ac.Zo = Zo1 * Rd / Zo2; 
+   double Av1 = analysis.ac.gm * Rd;
+   double Av2 = 1.0 + analysis.ac.gm * Rs + (Rd + Rs) / rd;
+   analysis.ac.Av = -1.0 * Av1 / Av2; 
+   analysis.ac.phase = "Out of phase";
+
+   return analysis;
+}
+
+/* Fused DC and AC analysis of voltage-divider transistor 
+configuration.
+
+double Vdd=20, Rg1=82*1e+6, Rg2=11*1e+6, Rd=2000;
+double Rs=610, Idss=0.012, Vp=-3, rd=5*1e+5;
+JFET_FusedAnalysis analysis = jfet_analyze_voltage_divider(Vdd, Rg1, 
+      Rg2, Rd, Rs, Idss, Vp, rd);
+jfet_display_dc_results(analysis.dc);
+jfet_display_ac_results(analysis.ac);
+
+Id: 5.474312e-03 A
+Vgs: -0.973739 V
+...
+gm: 5.403363e-03 S
+Zi: 9698924.731183 ohm
+Zo: 1992.031873 ohm
+Av: -10.763671
+Phase: Out of phase
+*/
+static inline JFET_FusedAnalysis jfet_analyze_voltage_divider(double Vdd, 
+      double Rg1, double Rg2, double Rd, double Rs, double Idss, 
+      double Vp, double rd) {
+   // Check if the parameters of transistor are consistent.
+   assert (Rg1 > 0 && Rg2 > 0 && Rd > 0 && Rs > 0 && rd > 0);
+   // Create fused analysis object.
+   JFET_FusedAnalysis analysis;
+   // Solve the operating point (the quadratic) only once.
+   analysis.dc = jfet_dc_voltage_divider(Vdd, Rg1, Rg2, Rd, Rs, Idss, 
+         Vp);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac.gm = _gm_factor_(Idss, Vp, analysis.dc.Vgs); 
+   analysis.ac.Zi = _parallel_(Rg1, Rg2); 
+   analysis.ac.Zo = _parallel_(Rd, rd); 
+   analysis.ac.Av = -1 * analysis.ac.gm * analysis.ac.Zo; 
+   analysis.ac.phase = "Out of phase";
+
+   return analysis;
+}
+
+/* Fused DC and AC analysis of common-gate transistor configuration.
+
+double Vdd=15, Vss=0, Rd=3300, Rs=1500, Idss=0.008;
+double Vp=-2.8, rd=4*1e+4;
+JFET_FusedAnalysis analysis = jfet_analyze_common_gate(Vdd, Vss, Rd, 
+      Rs, Idss, Vp, rd);
+jfet_display_dc_results(analysis.dc);
+jfet_display_ac_results(analysis.ac);
+
+Id: 1.156832e-03 A
+Vgs: -1.735249 V
+...
+gm: 2.172962e-03 S
+Zi: 370.766303 ohm
+Zo: 3048.498845 ohm
+Av: 6.700485
+Phase: In phase
+*/
+static inline JFET_FusedAnalysis jfet_analyze_common_gate(double Vdd, 
+      double Vss, double Rd, double Rs, double Idss, double Vp, 
+      double rd) {
+   // Check if the parameters of transistor are consistent.
+   assert (Rd > 0 && Rs > 0 && rd > 0);
+   // Create fused analysis object.
+   JFET_FusedAnalysis analysis;
+   // Solve the operating point (the quadratic) only once.
+   analysis.dc = jfet_dc_common_gate(Vdd, Vss, Rd, Rs, Idss, Vp);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac.gm = _gm_factor_(Idss, Vp, analysis.dc.Vgs); 
+   double Zi1 = (rd + Rd) / (1 + analysis.ac.gm * rd);
+   analysis.ac.Zi = _parallel_(Rs, Zi1); 
+   analysis.ac.Zo = _parallel_(Rd, rd); 
+   double Av1 = analysis.ac.gm * Rd + Rd / rd;
+   double Av2 = 1 + Rd / rd;
+   analysis.ac.Av = Av1 / Av2; 
+   analysis.ac.phase = "In phase";
+
+   return analysis;
+}
+
+/* --------------------------------------------------------------- */
+/* ----------------------- Batch Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Store the fused analysis of i'th design to the result columns. */
+static inline void _jfet_store_fused_(JFET_FusedAnalysis analysis, 
+                                      size_t i, JFET_DCBatch dc, 
+                                      JFET_ACBatch ac) {
+   // Write each result field to its own column.
+   dc.Id[i] = analysis.dc.Id;
+   dc.Vgs[i] = analysis.dc.Vgs;
+   dc.Vds[i] = analysis.dc.Vds;
+   dc.Vs[i] = analysis.dc.Vs;
+   dc.Vd[i] = analysis.dc.Vd;
+   dc.Vg[i] = analysis.dc.Vg;
+   ac.gm[i] = analysis.ac.gm;
+   ac.Zi[i] = analysis.ac.Zi;
+   ac.Zo[i] = analysis.ac.Zo;
+   ac.Av[i] = analysis.ac.Av;
+}
+
+/* Batch fused analysis of fixed-bias transistor configuration. 
+The i'th column entries are equal to 'jfet_analyze_fixed_bias()' of the
+i'th parameters. */
+BATCH_DISPATCH
+static inline void jfet_analyze_fixed_bias_batch(size_t num, 
+      const double *Vdd, const double *Vgg, const double *Rg, 
+      const double *Rd, const double *Idss, const double *Vp, 
+      const double *rd, JFET_DCBatch dc, JFET_ACBatch ac) {
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _jfet_store_fused_(jfet_analyze_fixed_bias(Vdd[i], Vgg[i], Rg[i], 
+                         Rd[i], Idss[i], Vp[i], rd[i]), i, dc, ac);
+}
+
+/* Batch fused analysis of self-bias transistor configuration. 
+The i'th column entries are equal to 'jfet_analyze_self_bias()' of the
+i'th parameters. */
+BATCH_DISPATCH
+static inline void jfet_analyze_self_bias_batch(size_t num, 
+      const double *Vdd, const double *Rg, const double *Rd, 
+      const double *Rs, const double *Idss, const double *Vp, 
+      const double *rd, JFET_DCBatch dc, JFET_ACBatch ac) {
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _jfet_store_fused_(jfet_analyze_self_bias(Vdd[i], Rg[i], Rd[i], 
+                         Rs[i], Idss[i], Vp[i], rd[i]), i, dc, ac);
+}
+
+/* Batch fused analysis of voltage-divider transistor configuration. 
+The i'th column entries are equal to 'jfet_analyze_voltage_divider()' of
+the i'th parameters. */
+BATCH_DISPATCH
+static inline void jfet_analyze_voltage_divider_batch(size_t num, 
+      const double *Vdd, const double *Rg1, const double *Rg2, 
+      const double *Rd, const double *Rs, const double *Idss, 
+      const double *Vp, const double *rd, JFET_DCBatch dc, 
+      JFET_ACBatch ac) {
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _jfet_store_fused_(jfet_analyze_voltage_divider(Vdd[i], Rg1[i], 
+                         Rg2[i], Rd[i], Rs[i], Idss[i], Vp[i], rd[i]), 
+                         i, dc, ac);
+}
+
+/* Batch fused analysis of common-gate transistor configuration. 
+The i'th column entries are equal to 'jfet_analyze_common_gate()' of the
+i'th parameters. */
+BATCH_DISPATCH
+static inline void jfet_analyze_common_gate_batch(size_t num, 
+      const double *Vdd, const double *Vss, const double *Rd, 
+      const double *Rs, const double *Idss, const double *Vp, 
+      const double *rd, JFET_DCBatch dc, JFET_ACBatch ac) {
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _jfet_store_fused_(jfet_analyze_common_gate(Vdd[i], Vss[i], 
+                         Rd[i], Rs[i], Idss[i], Vp[i], rd[i]), i, dc, 
+                         ac);
+}
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Uniform Definations -------------------- */
+/* --------------------------------------------------------------- */
+
+/* Get the batch result columns from uniform result columns. */
+static inline JFET_DCBatch _jfet_dc_columns_(double *const *results) {
+   // DC fields are the first fields of results.
+   JFET_DCBatch dc = {results[0], results[1], results[2], results[3], 
+                 results[4], results[5]};
+   return dc;
+}
+
+/* Get the batch result columns from uniform result columns. */
+static inline JFET_ACBatch _jfet_ac_columns_(double *const *results) {
+   // AC fields are following the DC fields.
+   JFET_ACBatch ac = {results[6], results[7], results[8], results[9]};
+   return ac;
+}
+
+/* Uniform evaluations of fused analyses for the engines. */
+static inline void _jfet_uniform_fixed_bias_(size_t num, 
+      const double *const *params, double *const *results) {
+   jfet_analyze_fixed_bias_batch(num, params[0], params[1], params[2], 
+         params[3], params[4], params[5], params[6], 
+         _jfet_dc_columns_(results), _jfet_ac_columns_(results));
+}
+
+static inline void _jfet_uniform_self_bias_(size_t num, 
+                                            const double *const *params, 
+                                            double *const *results) {
+   jfet_analyze_self_bias_batch(num, params[0], params[1], params[2], 
+         params[3], params[4], params[5], params[6], 
+         _jfet_dc_columns_(results), _jfet_ac_columns_(results));
+}
+
+static inline void _jfet_uniform_voltage_divider_(size_t num, 
+      const double *const *params, double *const *results) {
+   jfet_analyze_voltage_divider_batch(num, params[0], params[1], 
+         params[2], params[3], params[4], params[5], params[6], 
+         params[7], _jfet_dc_columns_(results), 
+         _jfet_ac_columns_(results));
+}
+
+static inline void _jfet_uniform_common_gate_(size_t num, 
+      const double *const *params, double *const *results) {
+   jfet_analyze_common_gate_batch(num, params[0], params[1], params[2], 
+         params[3], params[4], params[5], params[6], 
+         _jfet_dc_columns_(results), _jfet_ac_columns_(results));
+}
+
+/* Regions of JFET designs from their pinch-off voltages 'Vp'. A
+design is cut off if Vgs is beyond Vp and it is ohmic if Vds is below
+the saturation voltage (Vgs - Vp). */
+BATCH_DISPATCH
+static inline void _jfet_regions_(size_t num, const double *Vp, 
+                                  const double *const *results, 
+                                  unsigned char *regions) {
+   const double *Vgs = results[1], *Vds = results[2];
+   // Comparisons with NaN are false, so NaN designs get no region.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++) {
+      double Vdsat = Vgs[i] - Vp[i];
+      int on = Vdsat > 0;
+      regions[i] = (Vdsat <= 0) * REGION_CUTOFF + 
+                   (on & (Vds[i] >= Vdsat)) * REGION_ACTIVE + 
+                   (on & (Vds[i] < Vdsat)) * REGION_OHMIC;
+   }
+}
+
+/* Uniform regions of JFET designs (see 'classify_regions()'). */
+static inline void _jfet_uniform_regions_(size_t num, 
+                                          const double *const *params, 
+                                          const double *const *results, 
+                                          unsigned char *regions) {
+   // Vp is the 6th parameter except in voltage-divider designs.
+   _jfet_regions_(num, params[5], results, regions);
+}
+
+static inline void _jfet_uniform_divider_regions_(size_t num, 
+      const double *const *params, const double *const *results, 
+      unsigned char *regions) {
+   _jfet_regions_(num, params[6], results, regions);
+}
+
+// Result fields of all JFET configurations:
+#define JFET_RESULTS 10, {"Id", "Vgs", "Vds", "Vs", "Vd", "Vg", "gm", \
+   "Zi", "Zo", "Av"}, {0, 2, 9, 7, 8}
+
+/* Uniform descriptions of JFET configurations. The parameters are 
+in the same order as the 'analyze_*()' functions. */
+static const struct Configuration jfet_configurations[] = {
+   {"fixed_bias", 7, {"Vdd", "Vgg", "Rg", "Rd", "Idss", "Vp", "rd"},
+    JFET_RESULTS, _jfet_uniform_fixed_bias_, _jfet_uniform_regions_, 
+    0x4C},
+   {"self_bias", 7, {"Vdd", "Rg", "Rd", "Rs", "Idss", "Vp", "rd"},
+    JFET_RESULTS, _jfet_uniform_self_bias_, _jfet_uniform_regions_, 
+    0x4E},
+   {"voltage_divider", 8, {"Vdd", "Rg1", "Rg2", "Rd", "Rs", "Idss", 
+    "Vp", "rd"}, JFET_RESULTS, _jfet_uniform_voltage_divider_, 
+    _jfet_uniform_divider_regions_, 0x9E},
+   {"common_gate", 7, {"Vdd", "Vss", "Rd", "Rs", "Idss", "Vp", "rd"},
+    JFET_RESULTS, _jfet_uniform_common_gate_, _jfet_uniform_regions_, 
+    0x4C},
+};
+
+// Number of uniform JFET configurations:
+static const size_t num_jfet_configurations = 
+   sizeof(jfet_configurations) / sizeof(jfet_configurations[0]);
+
+#endif
@@ -15,27 +15,62 @@ IMPORTANT NOTES:
 1. Don't give any voltage parameter as negative to algorithms.
 If voltage source connect the inverse, the algorithm handle it.
 2. All transistor configuratiions are set as 'npn' type. 
+3. All names begin with 'mosfet_' (or 'MOSFET_' for types), so
+this source file can be included together with BJT.h and JFET.h.
+Functions are 'static inline', so it can be included next to the
+library too (see TransCal.h).
 
 EXISTING CONFIGURATIONS:
 ------------------------
 
-+ dc_drain_feedback()
-+ ac_drain_feedback()
-+ dc_voltage_divider()
-+ ac_voltage_divider()
++ mosfet_dc_drain_feedback()
++ mosfet_ac_drain_feedback()
++ mosfet_dc_voltage_divider()
++ mosfet_ac_voltage_divider()
+
+FUSED (DC AND AC) ANALYSES:
+---------------------------
+
++ mosfet_analyze_drain_feedback()
++ mosfet_analyze_voltage_divider()
+
+BATCH ENTRY POINTS:
+-------------------
+
++ _drain_current_batch_() (see FET.h)
++ mosfet_analyze_drain_feedback_batch()
++ mosfet_analyze_voltage_divider_batch()
+
+TEXT FORMATTING:
+----------------
+
++ mosfet_format_dc_results()
++ mosfet_format_ac_results()
+
+UNIFORM DESCRIPTIONS:
+---------------------
+
++ mosfet_configurations[] (see Configuration.h)
 */
 
+#ifndef MOSFET_H
+#define MOSFET_H
+
 // Libraries:
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <math.h>
+#include "Batch.h"
+#include "Configuration.h"
+#include "FET.h"
+#include "Format.h"
 
 // User-defined string type:
 typedef char * string;
 
 // Results of DC analysis:
-struct DCResults {
+struct MOSFET_DCResults {
    float k; // k constant
    float Id; // drain current
    float Vgs; // gate-source voltage
@@ -43,7 +78,7 @@ struct DCResults {
 };
 
 // Results of AC analysis:
-struct ACResults {
+struct MOSFET_ACResults {
    float gm; // transconductance factor
    float Zi; // input impedance
    float Zo; // output impedance
@@ -51,50 +86,41 @@ struct ACResults {
    string phase; // phase relationship
 };
 
-// User-defined analysis types:
-typedef struct DCResults DCAnalysis;
-typedef struct ACResults ACAnalysis;
-
-/* --------------------------------------------------------------- */
-/* ---------------------- Helper Definations --------------------- */
-/* --------------------------------------------------------------- */
+// Results of fused DC and AC analysis:
+struct MOSFET_FusedResults {
+   struct MOSFET_DCResults dc; // DC analysis
+   struct MOSFET_ACResults ac; // AC analysis
+};
 
-/* Get the parallel resultant of 'R1' and 'R2'. */
-double _parallel_(double R1, double R2) {
-   // Find the resultant resistance for parallel resistors.
-   return 1.0 / (1.0 / R1 + 1.0 / R2);
-}
+// Result columns of batch DC analysis:
+struct MOSFET_DCColumns {
+   float *restrict k; // k constants
+   float *restrict Id; // drain currents
+   float *restrict Vgs; // gate-source voltages
+   float *restrict Vds; // drain-source voltages
+};
 
-/* Find the transconductance factor (gm). */
-double _gm_factor_(double Idss, double Vp, double Vgs) {
-   // Find the transconductance factor (gm).
-   return (2.0 * Idss / abs(Vp)) * (1.0 - Vgs / Vp);
-}
+// Result columns of batch AC analysis:
+struct MOSFET_ACColumns {
+   float *restrict gm; // transconductance factors
+   float *restrict Zi; // input impedances
+   float *restrict Zo; // output impedances
+   float *restrict Av; // voltage gains
+};
 
-/* Select the right drain current using discriminant. */
-double _drain_current_(double a, double b, double c) {
-   // Find the discriminant and calculate two different roots.
-   double dicriminant = (b * b) - (4 * a * c);
-   double root1 = (-1.0 * b + sqrt(dicriminant)) / (2 * a);
-   double root2 = (-1.0 * b - sqrt(dicriminant)) / (2 * a);
-   // Specially, in some configurations, can be found two 
-   // roots and requries to select one of them.
-   if (root1 >= 0 && root2 < 0) return root1;
-   if (root2 >= 0 && root1 < 0) return root2;
-   if (root1 >= 0 && root2 >= 0) {
-      if (root1 >= root2) return root2;
-      else return root1;} 
-   if (root1 < 0 && root2 < 0) {
-      if (abs(root1) >= abs(root2)) return abs(root2);
-      else return abs(root1);}
-}
+// User-defined analysis types:
+typedef struct MOSFET_DCResults MOSFET_DCAnalysis;
+typedef struct MOSFET_ACResults MOSFET_ACAnalysis;
+typedef struct MOSFET_FusedResults MOSFET_FusedAnalysis;
+typedef struct MOSFET_DCColumns MOSFET_DCBatch;
+typedef struct MOSFET_ACColumns MOSFET_ACBatch;
 
 /* --------------------------------------------------------------- */
 /* ------------------------- Display Results --------------------- */
 /* --------------------------------------------------------------- */
 
 /* Display the DC results of any kind of transistor. */
-void display_dc_results(DCAnalysis analysis) {
+static inline void mosfet_display_dc_results(MOSFET_DCAnalysis analysis) {
    // Display the DC results.
    printf("k: %e A/V^2\n", analysis.k);
    printf("Id: %e A\n", analysis.Id);
@@ -103,7 +129,7 @@ void display_dc_results(DCAnalysis analysis) {
 }
 
 /* Display the AC results of any kind of transistor. */
-void display_ac_results(ACAnalysis analysis) {
+static inline void mosfet_display_ac_results(MOSFET_ACAnalysis analysis) {
    // Display the AC results.
    printf("gm: %e S\n", analysis.gm);
    printf("Zi: %f ohm\n", analysis.Zi);
@@ -112,6 +138,29 @@ void display_ac_results(ACAnalysis analysis) {
    printf("Phase: %s\n", analysis.phase);
 }
 
+/* Format the DC results as fields of the current text row (see
+Format.h and bjt_format_dc_results()). The float fields are
+written with the fewest digits of floats. */
+static inline void mosfet_format_dc_results(struct TextBuffer *text,
+                                            MOSFET_DCAnalysis analysis) {
+   // Format the DC results.
+   text_float(text, "k", analysis.k);
+   text_float(text, "Id", analysis.Id);
+   text_float(text, "Vgs", analysis.Vgs);
+   text_float(text, "Vds", analysis.Vds);
+}
+
+/* Format the AC results as fields of the current text row. */
+static inline void mosfet_format_ac_results(struct TextBuffer *text,
+                                            MOSFET_ACAnalysis analysis) {
+   // Format the AC results.
+   text_float(text, "gm", analysis.gm);
+   text_float(text, "Zi", analysis.Zi);
+   text_float(text, "Zo", analysis.Zo);
+   text_float(text, "Av", analysis.Av);
+   text_string(text, "phase", analysis.phase);
+}
+
 /* --------------------------------------------------------------- */
 /* ------------------------ Main Definations --------------------- */
 /* --------------------------------------------------------------- */
@@ -119,21 +168,21 @@ void display_ac_results(ACAnalysis analysis) {
 /* DC analysis of drain-feedback transistor configuration. 
 
 double Vdd=12, Rg=1e+7, Rd=2000, Idon=0.006, Vgson=8, Vgsth=3;
-DCAnalysis analysis = dc_drain_feedback(Vdd, Rg, Rd, Idon, 
-                                        Vgson, Vgsth);
-display_dc_results(analysis);
+MOSFET_DCAnalysis analysis = mosfet_dc_drain_feedback(Vdd, Rg, Rd, 
+      Idon, Vgson, Vgsth);
+mosfet_display_dc_results(analysis);
 
 k: 2.400000e-04 A/V^2
 Id: 2.794004e-03 A
 Vgs: 6.411991 V
 Vds: 6.411991 V
 */
-DCAnalysis dc_drain_feedback(double Vdd, double Rg, double Rd, 
-                        double Idon, double Vgson, double Vgsth) {
+static inline MOSFET_DCAnalysis mosfet_dc_drain_feedback(double Vdd, 
+      double Rg, double Rd, double Idon, double Vgson, double Vgsth) {
    // Check if the parameters of transistor are consistent.
    assert (Rg > 0 && Rd > 0);
    // Create DC analysis object.
-   DCAnalysis analysis;
+   MOSFET_DCAnalysis analysis;
    // Calculate the all analyzes of transistor.
    analysis.k = Idon / ((Vgson - Vgsth) * (Vgson - Vgsth)); 
    double a = Rd * Rd * analysis.k;
@@ -150,9 +199,9 @@ DCAnalysis dc_drain_feedback(double Vdd, double Rg, double Rd,
 
 double Vdd=12, Rg=1e+7, Rd=2000, Idon=0.006;
 double Vgson=8, Vgsth=3, rd=5*1e+4;
-ACAnaysis analysis = ac_drain_feedback(Vdd, Rg, Rd, Idon, 
-                                       Vgson, Vgsth, rd);
-display_ac_results(analysis);
+MOSFET_ACAnalysis analysis = mosfet_ac_drain_feedback(Vdd, Rg, Rd, 
+      Idon, Vgson, Vgsth, rd);
+mosfet_display_ac_results(analysis);
 
 gm: 1.637756e-03 S
 Zi: 2410374.750000 ohm
@@ -160,12 +209,13 @@ Zo: 1922.707153 ohm
 Av: -3.148925
 Phase: Out of phase
 */
-ACAnalysis ac_drain_feedback(double Vdd, double Rg, double Rd, 
-            double Idon, double Vgson, double Vgsth, double rd) {
+static inline MOSFET_ACAnalysis mosfet_ac_drain_feedback(double Vdd, 
+      double Rg, double Rd, double Idon, double Vgson, double Vgsth, 
+      double rd) {
    // Check if the parameters of transistor are consistent.
    assert (Rg > 0 && Rd > 0 && rd > 0);
    // Create AC analysis object.
-   ACAnalysis analysis;
+   MOSFET_ACAnalysis analysis;
    // Calculate the all analyzes of transistor.
    double k = Idon / ((Vgson - Vgsth) * (Vgson - Vgsth)); 
    double a = Rd * Rd * k;
@@ -189,21 +239,22 @@ ACAnalysis ac_drain_feedback(double Vdd, double Rg, double Rd,
 
 double Vdd=40, Rg1=22*1e+6, Rg2=18*1e+6, Rd=3000;
 double Rs=820, Idon=0.003, Vgson=10, Vgsth=5;
-DCAnalysis analysis = dc_voltage_divider(Vdd, Rg1, Rg2, Rd, 
-                                    Rs, Idon, Vgson, Vgsth);
-display_dc_results(analysis);
+MOSFET_DCAnalysis analysis = mosfet_dc_voltage_divider(Vdd, Rg1, Rg2, 
+      Rd, Rs, Idon, Vgson, Vgsth);
+mosfet_display_dc_results(analysis);
 
 k: 1.200000e-04 A/V^2
 Id: 6.724565e-03 A
 Vgs: 12.485856 V
 Vds: 14.312160 V
 */
-DCAnalysis dc_voltage_divider(double Vdd, double Rg1, double Rg2,
-   double Rd, double Rs, double Idon, double Vgson, double Vgsth){
+static inline MOSFET_DCAnalysis mosfet_dc_voltage_divider(double Vdd, 
+      double Rg1, double Rg2, double Rd, double Rs, double Idon, 
+      double Vgson, double Vgsth){
    // Check if the parameters of transistor are consistent.
    assert (Rg1 > 0 && Rg2 > 0 && Rd > 0 && Rs > 0);
    // Create DC analysis object.
-   DCAnalysis analysis;
+   MOSFET_DCAnalysis analysis;
    // Calculate the all analyzes of transistor.
    analysis.k = Idon / ((Vgson - Vgsth) * (Vgson - Vgsth));
    double Vg = Rg2 * Vdd / (Rg1 + Rg2);
@@ -221,9 +272,9 @@ DCAnalysis dc_voltage_divider(double Vdd, double Rg1, double Rg2,
 
 double Vdd=24, Rg1=1e+7, Rg2=6.8*1e+6, Rd=2200;
 double Rs=750, Idon=0.005, Vgson=6, Vgsth=3, rd=1e+6;
-ACAnalysis analysis = ac_voltage_divider(Vdd, Rg1, Rg2, Rd, 
-                                 Rs, Idon, Vgson, Vgsth, rd);
-display_ac_results(analysis);
+MOSFET_ACAnalysis analysis = mosfet_ac_voltage_divider(Vdd, Rg1, Rg2, 
+      Rd, Rs, Idon, Vgson, Vgsth, rd);
+mosfet_display_ac_results(analysis);
 
 gm: 3.321982e-03 S
 Zi: 4047619.000000 ohm
@@ -231,13 +282,13 @@ Zo: 2195.170654 ohm
 Av: -7.292316
 Phase: Out of phase
 */
-ACAnalysis ac_voltage_divider(double Vdd, double Rg1, double Rg2,
-   double Rd, double Rs, double Idon, double Vgson, double Vgsth,
-   double rd){
+static inline MOSFET_ACAnalysis mosfet_ac_voltage_divider(double Vdd, 
+      double Rg1, double Rg2, double Rd, double Rs, double Idon, 
+      double Vgson, double Vgsth, double rd){
    // Check if the parameters of transistor are consistent.
    assert (Rg1 > 0 && Rg2 > 0 && Rd > 0 && Rs > 0 && rd > 0);
    // Create AC analysis object.
-   ACAnalysis analysis;
+   MOSFET_ACAnalysis analysis;
    // Calculate the all analyzes of transistor.
    double k = Idon / ((Vgson - Vgsth) * (Vgson - Vgsth));
    double Vg = Rg2 * Vdd / (Rg1 + Rg2);
@@ -254,3 +305,260 @@ ACAnalysis ac_voltage_divider(double Vdd, double Rg1, double Rg2,
 
    return analysis;
 }
+
+/* --------------------------------------------------------------- */
+/* ----------------------- Fused Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Fused DC and AC analysis of drain-feedback transistor 
+configuration.
+
+The operating point is solved only once and the AC analysis uses
+its gate-source voltage. So, it is cheaper than calling both of
+'mosfet_dc_drain_feedback()' and 'mosfet_ac_drain_feedback()'.
+
+double Vdd=12, Rg=1e+7, Rd=2000, Idon=0.006;
+double Vgson=8, Vgsth=3, rd=5*1e+4;
+MOSFET_FusedAnalysis analysis = mosfet_analyze_drain_feedback(Vdd, Rg, 
+      Rd, Idon, Vgson, Vgsth, rd);
+mosfet_display_dc_results(analysis.dc);
+mosfet_display_ac_results(analysis.ac);
+
+k: 2.400000e-04 A/V^2
+Id: 2.794004e-03 A
+...
+gm: 1.637756e-03 S
+Zi: 2410374.500000 ohm
+Zo: 1922.707153 ohm
+Av: -3.148925
+Phase: Out of phase
+*/
+static inline MOSFET_FusedAnalysis mosfet_analyze_drain_feedback( 
+      double Vdd, double Rg, double Rd, double Idon, double Vgson, 
+      double Vgsth, double rd) {
+   // Check if the parameters of transistor are consistent.
+   assert (Rg > 0 && Rd > 0 && rd > 0);
+   // Create fused analysis object.
+   MOSFET_FusedAnalysis analysis;
+   // Solve the operating point (the quadratic) only once.
+   analysis.dc = mosfet_dc_drain_feedback(Vdd, Rg, Rd, Idon, Vgson, 
+         Vgsth);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac.gm = 2 * analysis.dc.k * (analysis.dc.Vgs - Vgsth); 
+   double Zi1 = Rg + _parallel_(rd, Rd);
+   double Zi2 = 1 + analysis.ac.gm * _parallel_(rd, Rd); 
+   analysis.ac.Zi = Zi1 / Zi2; 
+   double Zo1 = _parallel_(rd, Rd);
+   analysis.ac.Zo = _parallel_(Rg, Zo1); 
+   analysis.ac.Av = -1 * analysis.ac.gm * analysis.ac.Zo; 
+   analysis.ac.phase = "Out of phase";
+
+   return analysis;
+}
+
+/* Fused DC and AC analysis of voltage-divider transistor 
+configuration.
+
+double Vdd=24, Rg1=1e+7, Rg2=6.8*1e+6, Rd=2200;
+double Rs=750, Idon=0.005, Vgson=6, Vgsth=3, rd=1e+6;
+MOSFET_FusedAnalysis analysis = mosfet_analyze_voltage_divider(Vdd, 
+      Rg1, Rg2, Rd, Rs, Idon, Vgson, Vgsth, rd);
+mosfet_display_dc_results(analysis.dc);
+mosfet_display_ac_results(analysis.ac);
+
+k: 5.555556e-04 A/V^2
+Id: 4.966003e-03 A
+...
+gm: 3.321982e-03 S
+Zi: 4047619.000000 ohm
+Zo: 2195.170654 ohm
+Av: -7.292317
+Phase: Out of phase
+*/
+static inline MOSFET_FusedAnalysis mosfet_analyze_voltage_divider( 
+      double Vdd, double Rg1, double Rg2, double Rd, double Rs, 
+      double Idon, double Vgson, double Vgsth, double rd) {
+   // Check if the parameters of transistor are consistent.
+   assert (Rg1 > 0 && Rg2 > 0 && Rd > 0 && Rs > 0 && rd > 0);
+   // Create fused analysis object.
+   MOSFET_FusedAnalysis analysis;
+   // Solve the operating point (the quadratic) only once.
+   analysis.dc = mosfet_dc_voltage_divider(Vdd, Rg1, Rg2, Rd, Rs, Idon, 
+         Vgson, Vgsth);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac.gm = 2 * analysis.dc.k * (analysis.dc.Vgs - Vgsth); 
+   analysis.ac.Zi = _parallel_(Rg1, Rg2); 
+   analysis.ac.Zo = _parallel_(rd, Rd); 
+   analysis.ac.Av = -1 * analysis.ac.gm * analysis.ac.Zo;
+   analysis.ac.phase = "Out of phase"; 
+
+   return analysis;
+}
+
+/* --------------------------------------------------------------- */
+/* ----------------------- Batch Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Store the fused analysis of i'th design to the result columns. */
+static inline void _mosfet_store_fused_(MOSFET_FusedAnalysis analysis, 
+                                        size_t i, MOSFET_DCBatch dc, 
+                                        MOSFET_ACBatch ac) {
+   // Write each result field to its own column.
+   dc.k[i] = analysis.dc.k;
+   dc.Id[i] = analysis.dc.Id;
+   dc.Vgs[i] = analysis.dc.Vgs;
+   dc.Vds[i] = analysis.dc.Vds;
+   ac.gm[i] = analysis.ac.gm;
+   ac.Zi[i] = analysis.ac.Zi;
+   ac.Zo[i] = analysis.ac.Zo;
+   ac.Av[i] = analysis.ac.Av;
+}
+
+/* Batch fused analysis of drain-feedback transistor configuration. 
+The i'th column entries are equal to 
+'mosfet_analyze_drain_feedback()' of the i'th parameters. */
+BATCH_DISPATCH
+static inline void mosfet_analyze_drain_feedback_batch(size_t num, 
+      const double *Vdd, const double *Rg, const double *Rd, 
+      const double *Idon, const double *Vgson, const double *Vgsth, 
+      const double *rd, MOSFET_DCBatch dc, MOSFET_ACBatch ac) {
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _mosfet_store_fused_(mosfet_analyze_drain_feedback(Vdd[i], Rg[i], 
+            Rd[i], Idon[i], Vgson[i], Vgsth[i], rd[i]), i, dc, ac);
+}
+
+/* Batch fused analysis of voltage-divider transistor configuration. 
+The i'th column entries are equal to 
+'mosfet_analyze_voltage_divider()' of the i'th parameters. */
+BATCH_DISPATCH
+static inline void mosfet_analyze_voltage_divider_batch(size_t num, 
+      const double *Vdd, const double *Rg1, const double *Rg2, 
+      const double *Rd, const double *Rs, const double *Idon, 
+      const double *Vgson, const double *Vgsth, const double *rd, 
+      MOSFET_DCBatch dc, MOSFET_ACBatch ac) {
+   // Calculate the all analyzes of transistors.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _mosfet_store_fused_(mosfet_analyze_voltage_divider(Vdd[i], 
+            Rg1[i], Rg2[i], Rd[i], Rs[i], Idon[i], Vgson[i], Vgsth[i], 
+            rd[i]), i, dc, ac);
+}
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Uniform Definations -------------------- */
+/* --------------------------------------------------------------- */
+
+/* Uniform evaluations of fused analyses for the engines. They are
+computed and stored in double, so the results aren't rounded to the
+float fields of MOSFET_FusedAnalysis (and its operating point isn't
+rounded before the AC analysis). */
+BATCH_DISPATCH
+static inline void _mosfet_uniform_drain_feedback_(size_t num, 
+      const double *const *params, double *const *results) {
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++) {
+      double Vdd = params[0][i], Rg = params[1][i], Rd = params[2][i];
+      double Idon = params[3][i], Vgson = params[4][i]; 
+      double Vgsth = params[5][i], rd = params[6][i];
+      double k = Idon / ((Vgson - Vgsth) * (Vgson - Vgsth)); 
+      double a = Rd * Rd * k;
+      double b = 2 * k * Rd * (Vgsth - Vdd) - 1;
+      double c = k * (Vgsth - Vdd) * (Vgsth - Vdd);
+      double Id = _drain_current_(a, b, c); 
+      double Vgs = Vdd - Id * Rd; 
+      double gm = 2 * k * (Vgs - Vgsth); 
+      double Zo1 = _parallel_(rd, Rd);
+      results[0][i] = k;
+      results[1][i] = Id;
+      results[2][i] = Vgs;
+      results[3][i] = Vgs;
+      results[4][i] = gm;
+      results[5][i] = (Rg + Zo1) / (1 + gm * Zo1);
+      results[6][i] = _parallel_(Rg, Zo1);
+      results[7][i] = -1 * gm * _parallel_(Rg, Zo1);
+   }
+}
+
+BATCH_DISPATCH
+static inline void _mosfet_uniform_voltage_divider_(size_t num, 
+      const double *const *params, double *const *results) {
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++) {
+      double Vdd = params[0][i], Rg1 = params[1][i]; 
+      double Rg2 = params[2][i], Rd = params[3][i], Rs = params[4][i];
+      double Idon = params[5][i], Vgson = params[6][i];
+      double Vgsth = params[7][i], rd = params[8][i];
+      double k = Idon / ((Vgson - Vgsth) * (Vgson - Vgsth));
+      double Vg = Rg2 * Vdd / (Rg1 + Rg2);
+      double a = Rs * Rs * k;
+      double b = -2 * k * Rs * (Vg - Vgsth) - 1;
+      double c = k * (Vgsth - Vg) * (Vgsth - Vg);
+      double Id = _drain_current_(a, b, c); 
+      double Vgs = Vg - Id * Rs; 
+      double gm = 2 * k * (Vgs - Vgsth); 
+      results[0][i] = k;
+      results[1][i] = Id;
+      results[2][i] = Vgs;
+      results[3][i] = Vdd - Id * (Rs + Rd);
+      results[4][i] = gm;
+      results[5][i] = _parallel_(Rg1, Rg2);
+      results[6][i] = _parallel_(rd, Rd);
+      results[7][i] = -1 * gm * _parallel_(rd, Rd);
+   }
+}
+
+/* Regions of E-MOSFET designs from their threshold voltages 'Vgsth'.
+A design is cut off if Vgs is below Vgsth and it is ohmic if Vds is
+below the saturation voltage (Vgs - Vgsth). */
+BATCH_DISPATCH
+static inline void _mosfet_regions_(size_t num, const double *Vgsth, 
+                                    const double *const *results, 
+                                    unsigned char *regions) {
+   const double *Vgs = results[2], *Vds = results[3];
+   // Comparisons with NaN are false, so NaN designs get no region.
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++) {
+      double Vdsat = Vgs[i] - Vgsth[i];
+      int on = Vdsat > 0;
+      regions[i] = (Vdsat <= 0) * REGION_CUTOFF + 
+                   (on & (Vds[i] >= Vdsat)) * REGION_ACTIVE + 
+                   (on & (Vds[i] < Vdsat)) * REGION_OHMIC;
+   }
+}
+
+/* Uniform regions of MOSFET designs (see 'classify_regions()'). */
+static inline void _mosfet_uniform_feedback_regions_(size_t num, 
+      const double *const *params, const double *const *results, 
+      unsigned char *regions) {
+   _mosfet_regions_(num, params[5], results, regions);
+}
+
+static inline void _mosfet_uniform_divider_regions_(size_t num, 
+      const double *const *params, const double *const *results, 
+      unsigned char *regions) {
+   _mosfet_regions_(num, params[7], results, regions);
+}
+
+// Result fields of all MOSFET configurations:
+#define MOSFET_RESULTS 8, {"k", "Id", "Vgs", "Vds", "gm", "Zi", "Zo", \
+   "Av"}, {1, 3, 7, 5, 6}
+
+/* Uniform descriptions of MOSFET configurations. The parameters are 
+in the same order as the 'analyze_*()' functions. */
+static const struct Configuration mosfet_configurations[] = {
+   {"drain_feedback", 7, {"Vdd", "Rg", "Rd", "Idon", "Vgson", "Vgsth",
+    "rd"}, MOSFET_RESULTS, _mosfet_uniform_drain_feedback_, 
+    _mosfet_uniform_feedback_regions_, 0x46},
+   {"voltage_divider", 9, {"Vdd", "Rg1", "Rg2", "Rd", "Rs", "Idon", 
+    "Vgson", "Vgsth", "rd"}, MOSFET_RESULTS, 
+    _mosfet_uniform_voltage_divider_, _mosfet_uniform_divider_regions_,
+    0x11E},
+};
+
+// Number of uniform MOSFET configurations:
+static const size_t num_mosfet_configurations = 
+   sizeof(mosfet_configurations) / sizeof(mosfet_configurations[0]);
+
+#endif
@@ -0,0 +1,476 @@
+/* Monte Carlo Tolerance Analysis of Transistor Configurations
+
+Real resistors, betas and FET parameters spread around their
+nominal values. So, this source file samples the parameters of
+any configuration (see Configuration.h) from the given
+distributions, analyzes all samples on all processors and reports
+the statistics of common metrics (current, voltage, Av, Zi, Zo).
+
+IMPORTANT NOTES:
+----------------
+
+1. Random numbers are produced by the counter-based Philox4x32-10
+generator. Each sample has its own counter, so every thread has an
+independent stream.
+2. 'spread' of distributions is relative to the nominal value. For
+example, a 5% resistor is {DIST_UNIFORM, 1000, 0.05}.
+3. Percentiles are found from histograms whose ranges are found by
+a pilot run. So, they are approximate but mean, stddev, min and max
+are exact.
+4. Faulty samples (see 'validate_results()'), like non-positive
+resistances of wide distributions or negative discriminants of FET
+quadratics, are counted as failures and aren't included to the
+statistics. 'faults' counts them by kind too (see 'enum Fault').
+5. 'monte_carlo_regions()' classifies the samples too (see
+'classify_regions()'). The samples out of the accepted regions (like
+saturated BJTs) are counted as rejected and aren't included to the
+statistics, so the spread of an amplifier isn't widened by samples
+which don't amplify.
+6. Sums are accumulated in chunks of MC_CHUNK samples and the chunks
+are merged in their order, so the results are the same bits for any
+count of threads (threads only take whole chunks).
+7. Link with '-pthread' and '-lm'.
+*/
+
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <math.h>
+#include "Configuration.h"
+#include "Parallel.h"
+
+// General constants:
+#define MC_BLOCK 256 // samples analyzed together
+#define MC_CHUNK 16384 // samples summed together (MC_BLOCK multiple)
+#define MC_PILOT 4096 // samples to find histogram ranges
+#define MC_BINS 4096 // histogram bins of each metric
+#define NUM_PERCENTILES 5
+
+// Reported percentiles:
+const double mc_percentiles[NUM_PERCENTILES] = {1, 5, 50, 95, 99};
+
+// Kinds of parameter distributions:
+enum DistributionKind {
+   DIST_FIXED, // always nominal value
+   DIST_UNIFORM, // nominal * (1 +- spread)
+   DIST_GAUSSIAN // nominal * (1 + spread * N(0, 1))
+};
+
+// Distribution of a parameter:
+struct Distribution {
+   enum DistributionKind kind; // kind of distribution
+   double nominal; // nominal value
+   double spread; // relative tolerance or standard deviation
+};
+
+// Statistics of a metric:
+struct Statistics {
+   double mean; // mean value
+   double stddev; // standard deviation
+   double min; // minimum value
+   double max; // maximum value
+   double percentiles[NUM_PERCENTILES]; // see 'mc_percentiles'
+};
+
+// Results of Monte Carlo analysis:
+struct MonteCarloResults {
+   size_t samples; // count of all samples
+   size_t failures; // count of faulty samples
+   size_t faults[NUM_FAULTS]; // faulty samples of each kind
+   size_t rejected; // count of samples out of the accepted regions
+   struct Statistics metrics[NUM_METRICS]; // see 'enum Metric'
+};
+
+// User-defined analysis types:
+typedef struct MonteCarloResults MonteCarloAnalysis;
+
+// Accumulators of a thread:
+struct MonteCarloPart {
+   size_t count; // count of finite samples
+   size_t failures; // count of faulty samples
+   size_t faults[NUM_FAULTS]; // faulty samples of each kind
+   size_t rejected; // count of samples out of the accepted regions
+   double min[NUM_METRICS]; // minimum metrics
+   double max[NUM_METRICS]; // maximum metrics
+   size_t *histogram; // underflow, MC_BINS bins and overflow
+};
+
+// Common state of a Monte Carlo run:
+struct MonteCarloRun {
+   const struct Configuration *config; // analyzed configuration
+   const struct Distribution *distributions; // of each parameter
+   size_t samples; // count of samples
+   uint64_t seed; // key of random streams
+   size_t threads; // count of threads
+   size_t chunks; // count of chunks of samples
+   unsigned accept; // accepted regions (0 accepts all samples)
+   double shift[NUM_METRICS]; // pilot means for stable sums
+   double low[NUM_METRICS]; // histogram lower bounds
+   double width[NUM_METRICS]; // histogram bin widths
+   struct MonteCarloPart *parts; // accumulators of threads
+   double *sums; // sums and squared sums of shifted metrics (chunks)
+};
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Produce 4 random words from 'counter' and 'key' (Philox4x32-10). */
+void _philox_(uint32_t counter[4], uint32_t key0, uint32_t key1) {
+   // Apply ten rounds of multiply-xor mixing.
+   for (int round=0; round<10; round++) {
+      uint64_t product0 = (uint64_t) 0xD2511F53 * counter[0];
+      uint64_t product1 = (uint64_t) 0xCD9E8D57 * counter[2];
+      uint32_t next0 = (uint32_t) (product1 >> 32) ^ counter[1] ^ key0;
+      uint32_t next2 = (uint32_t) (product0 >> 32) ^ counter[3] ^ key1;
+      counter[0] = next0;
+      counter[1] = (uint32_t) product1;
+      counter[2] = next2;
+      counter[3] = (uint32_t) product0;
+      key0 += 0x9E3779B9; key1 += 0xBB67AE85;
+   }
+}
+
+/* Sample the 'param'th parameter of 'sample'th sample. */
+double _sample_(struct Distribution distribution, uint64_t seed,
+                uint64_t sample, uint32_t param) {
+   // Fixed parameters don't need any random number.
+   if (distribution.kind == DIST_FIXED) return distribution.nominal;
+   // Find two uniform numbers in [0, 1) from the sample counter.
+   uint32_t words[4] = {(uint32_t) sample, (uint32_t) (sample >> 32),
+                        param, 0};
+   _philox_(words, (uint32_t) seed, (uint32_t) (seed >> 32));
+   double u1 = (((uint64_t) words[0] << 21) ^ words[1]) * 0x1p-53;
+   double u2 = (((uint64_t) words[2] << 21) ^ words[3]) * 0x1p-53;
+   // Transform them according to the distribution.
+   double deviation = 2.0 * u1 - 1.0;
+   if (distribution.kind == DIST_GAUSSIAN)
+      deviation = sqrt(-2.0 * log(1.0 - u1)) *
+                  cos(6.283185307179586 * u2);
+   return distribution.nominal * (1.0 + distribution.spread * deviation);
+}
+
+/* Analyze and validate the samples between 'first' and 'first +
+num'. Their regions are found only if the run accepts some regions. */
+void _analyze_samples_(const struct MonteCarloRun *run, size_t first,
+                       size_t num, double *params, double *results,
+                       unsigned char *status, unsigned char *regions) {
+   const struct Configuration *config = run->config;
+   double *pcolumns[MAX_PARAMS], *rcolumns[MAX_RESULTS];
+   // Sample the parameter columns of all samples.
+   for (size_t p=0; p<config->nparams; p++) {
+      pcolumns[p] = params + p * MC_BLOCK;
+      for (size_t i=0; i<num; i++)
+         pcolumns[p][i] = _sample_(run->distributions[p], run->seed,
+                                   first + i, (uint32_t) p);
+   }
+   for (size_t r=0; r<config->nresults; r++)
+      rcolumns[r] = results + r * MC_BLOCK;
+   // Analyze all samples together (faulty ones with harmless
+   // parameters, they are skipped).
+   if (validate_params(config, num, (const double *const *) pcolumns,
+                       status) > 0)
+      replace_faulty_params(config, num, pcolumns, status);
+   config->evaluate(num, (const double *const *) pcolumns, rcolumns);
+   validate_results(config, num, (const double *const *) rcolumns,
+                    status);
+   if (run->accept != 0)
+      classify_regions(config, num, (const double *const *) pcolumns,
+                       (const double *const *) rcolumns, regions);
+}
+
+/* Check if the i'th sample is in the accepted regions of run. */
+int _accepted_(const struct MonteCarloRun *run,
+               const unsigned char *regions, size_t i) {
+   return run->accept == 0 || (regions[i] & run->accept) != 0;
+}
+
+/* Get the 'metric' of i'th sample from the result block. */
+double _metric_(const struct Configuration *config,
+                const double *results, enum Metric metric, size_t i) {
+   return results[config->metrics[metric] * MC_BLOCK + i];
+}
+
+/* Accumulate the samples of a thread. */
+void _monte_carlo_worker_(void *args, size_t index) {
+   struct MonteCarloRun *run = args;
+   struct MonteCarloPart *part = &run->parts[index];
+   const struct Configuration *config = run->config;
+   // Allocate the parameter and result blocks of this thread.
+   double *params = malloc(config->nparams * MC_BLOCK * sizeof(double));
+   double *results = malloc(config->nresults * MC_BLOCK *
+                            sizeof(double));
+   assert (params != NULL && results != NULL);
+   unsigned char status[MC_BLOCK], regions[MC_BLOCK];
+   // Find the samples of this thread (whole chunks).
+   size_t first = run->chunks * index / run->threads * MC_CHUNK;
+   size_t last = run->chunks * (index + 1) / run->threads * MC_CHUNK;
+   if (last > run->samples) last = run->samples;
+
+   for (size_t block=first; block<last; block+=MC_BLOCK) {
+      size_t num = (last - block < MC_BLOCK) ? last - block : MC_BLOCK;
+      _analyze_samples_(run, block, num, params, results, status,
+                        regions);
+      // A block never straddles two chunks.
+      double *sum = run->sums + block / MC_CHUNK * 2 * NUM_METRICS;
+      double *sum2 = sum + NUM_METRICS;
+      for (size_t i=0; i<num; i++) {
+         // Count the faulty samples by kind and skip them.
+         for (int f=0; f<NUM_FAULTS; f++)
+            part->faults[f] += (status[i] >> f) & 1;
+         if (status[i] != 0) { part->failures++; continue; }
+         if (!_accepted_(run, regions, i)) { part->rejected++; continue; }
+         part->count++;
+         for (int m=0; m<NUM_METRICS; m++) {
+            double value = _metric_(config, results, m, i);
+            double shifted = value - run->shift[m];
+            sum[m] += shifted;
+            sum2[m] += shifted * shifted;
+            if (value < part->min[m]) part->min[m] = value;
+            if (value > part->max[m]) part->max[m] = value;
+            // Underflow is the first bin, overflow is the last one.
+            double bin = floor((value - run->low[m]) / run->width[m]);
+            size_t slot = (bin < 0) ? 0 : (bin >= MC_BINS) ?
+                          MC_BINS + 1 : (size_t) bin + 1;
+            part->histogram[m * (MC_BINS + 2) + slot]++;
+         }
+      }
+   }
+   free(params); free(results);
+}
+
+/* Find the 'percent' percentile of a merged histogram. */
+double _percentile_(const size_t *histogram, size_t count,
+                    double percent, double low, double width,
+                    double min, double max) {
+   // Find the bin which contains the rank of percentile.
+   double rank = percent / 100.0 * (count - 1);
+   double before = 0;
+   size_t slot = 0;
+   while (slot < MC_BINS + 1 && before + histogram[slot] <= rank)
+      before += histogram[slot++];
+   // Interpolate linearly in the bin (or out-of-range region).
+   double start = (slot == 0) ? min : low + (slot - 1) * width;
+   double stop = (slot == 0) ? low : (slot == MC_BINS + 1) ?
+                 max : start + width;
+   if (slot == MC_BINS + 1) start = low + MC_BINS * width;
+   double fraction = (histogram[slot] > 0) ?
+                     (rank - before + 0.5) / histogram[slot] : 0.5;
+   double value = start + fraction * (stop - start);
+   // Percentile can't be out of the sample range.
+   return (value < min) ? min : (value > max) ? max : value;
+}
+
+/* Find the histogram ranges and shifts from the pilot samples. */
+void _pilot_run_(struct MonteCarloRun *run) {
+   const struct Configuration *config = run->config;
+   size_t pilot = (run->samples < MC_PILOT) ? run->samples : MC_PILOT;
+   double *params = malloc(config->nparams * MC_BLOCK * sizeof(double));
+   double *results = malloc(config->nresults * MC_BLOCK *
+                            sizeof(double));
+   assert (params != NULL && results != NULL);
+   unsigned char status[MC_BLOCK], regions[MC_BLOCK];
+   double min[NUM_METRICS], max[NUM_METRICS], sum[NUM_METRICS];
+   size_t count = 0;
+   for (int m=0; m<NUM_METRICS; m++) {
+      min[m] = INFINITY; max[m] = -INFINITY; sum[m] = 0;
+   }
+   // Analyze the first samples and find their ranges.
+   for (size_t block=0; block<pilot; block+=MC_BLOCK) {
+      size_t num = (pilot - block < MC_BLOCK) ? pilot - block : MC_BLOCK;
+      _analyze_samples_(run, block, num, params, results, status,
+                        regions);
+      for (size_t i=0; i<num; i++) {
+         if (status[i] != 0 || !_accepted_(run, regions, i)) continue;
+         count++;
+         for (int m=0; m<NUM_METRICS; m++) {
+            double value = _metric_(config, results, m, i);
+            sum[m] += value;
+            if (value < min[m]) min[m] = value;
+            if (value > max[m]) max[m] = value;
+         }
+      }
+   }
+   // Widen the ranges a bit, because pilot doesn't see all samples.
+   for (int m=0; m<NUM_METRICS; m++) {
+      double range = (count > 0) ? max[m] - min[m] : 0;
+      double scale = (count > 0) ? fabs(max[m]) + fabs(min[m]) : 1;
+      if (range <= 0) range = (scale > 0) ? scale * 1e-9 : 1e-300;
+      run->shift[m] = (count > 0) ? sum[m] / count : 0;
+      run->low[m] = (count > 0) ? min[m] - 0.05 * range : -range;
+      run->width[m] = 1.1 * range / MC_BINS;
+   }
+   free(params); free(results);
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------- Display Results --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Display the Monte Carlo results of any configuration. */
+void display_monte_carlo_results(MonteCarloAnalysis analysis) {
+   // Display the statistics of all metrics.
+   printf("samples: %zu (failures: %zu, rejected: %zu)\n",
+          analysis.samples, analysis.failures, analysis.rejected);
+   if (analysis.failures > 0) {
+      printf("faults:");
+      for (int f=0; f<NUM_FAULTS; f++)
+         printf(" %s=%zu", fault_names[f], analysis.faults[f]);
+      printf("\n");
+   }
+   for (int m=0; m<NUM_METRICS; m++) {
+      struct Statistics stats = analysis.metrics[m];
+      printf("%s: mean=%e stddev=%e min=%e max=%e", metric_names[m],
+             stats.mean, stats.stddev, stats.min, stats.max);
+      for (int p=0; p<NUM_PERCENTILES; p++)
+         printf(" p%g=%e", mc_percentiles[p], stats.percentiles[p]);
+      printf("\n");
+   }
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Monte Carlo analysis like 'monte_carlo()', but only the samples
+whose regions are in 'accept' (a mask of 'enum Region' bits) are
+included to the statistics. For example, a fixed-bias design near
+saturation without its saturated samples:
+
+const struct Configuration *config = find_configuration(
+      bjt_configurations, num_bjt_configurations, "fixed_bias");
+struct Distribution distributions[5] = {
+   {DIST_FIXED, 12, 0}, // Vcc
+   {DIST_UNIFORM, 270000, 0.05}, // Rb (5%)
+   {DIST_UNIFORM, 2400, 0.05}, // Rc (5%)
+   {DIST_GAUSSIAN, 100, 0.2}, // beta (20% sigma)
+   {DIST_FIXED, 50000, 0}, // ro
+};
+MonteCarloAnalysis analysis = monte_carlo_regions(config,
+      distributions, 1000000, 2024, REGION_ACTIVE, 0);
+display_monte_carlo_results(analysis);
+
+samples: 1000000 (failures: 0, rejected: 268953)
+I: mean=3.809350e-03 stddev=6.130540e-04 min=1.930287e-04 ...
+V: mean=2.880688e+00 stddev=1.461296e+00 min=7.000154e-01 ...
+Av: mean=-3.383792e+02 stddev=5.362047e+01 min=-4.192740e+02 ...
+Zi: mean=6.141680e+02 stddev=1.777440e+01 min=4.989630e+02 ...
+Zo: mean=2.285520e+03 stddev=6.288150e+01 min=2.180566e+03 ...
+*/
+MonteCarloAnalysis monte_carlo_regions(const struct Configuration *config,
+         const struct Distribution *distributions, size_t samples,
+         uint64_t seed, unsigned accept, size_t threads) {
+   // Check if the parameters of analysis are consistent.
+   assert (config != NULL && distributions != NULL && samples > 0);
+   // Create Monte Carlo analysis object.
+   MonteCarloAnalysis analysis = {samples, 0};
+   struct MonteCarloRun run = {config, distributions, samples, seed,
+                               _num_threads_(threads), accept};
+   run.chunks = (samples + MC_CHUNK - 1) / MC_CHUNK;
+   if (run.threads > run.chunks) run.threads = run.chunks;
+   // Find histogram ranges, then analyze all samples in parallel.
+   _pilot_run_(&run);
+   run.sums = calloc(run.chunks * 2 * NUM_METRICS, sizeof(double));
+   assert (run.sums != NULL);
+   run.parts = calloc(run.threads, sizeof(struct MonteCarloPart));
+   assert (run.parts != NULL);
+   for (size_t t=0; t<run.threads; t++) {
+      run.parts[t].histogram = calloc(NUM_METRICS * (MC_BINS + 2),
+                                      sizeof(size_t));
+      assert (run.parts[t].histogram != NULL);
+      for (int m=0; m<NUM_METRICS; m++) {
+         run.parts[t].min[m] = INFINITY;
+         run.parts[t].max[m] = -INFINITY;
+      }
+   }
+   parallel_run(run.threads, _monte_carlo_worker_, &run);
+
+   // Merge the accumulators of threads and the sums of chunks in the
+   // same order.
+   size_t count = 0;
+   double sum[NUM_METRICS] = {0}, sum2[NUM_METRICS] = {0};
+   size_t *histogram = run.parts[0].histogram;
+   for (int m=0; m<NUM_METRICS; m++) {
+      analysis.metrics[m].min = INFINITY;
+      analysis.metrics[m].max = -INFINITY;
+   }
+   for (size_t t=0; t<run.threads; t++) {
+      struct MonteCarloPart *part = &run.parts[t];
+      count += part->count;
+      analysis.failures += part->failures;
+      for (int f=0; f<NUM_FAULTS; f++)
+         analysis.faults[f] += part->faults[f];
+      analysis.rejected += part->rejected;
+      for (int m=0; m<NUM_METRICS; m++) {
+         if (part->min[m] < analysis.metrics[m].min)
+            analysis.metrics[m].min = part->min[m];
+         if (part->max[m] > analysis.metrics[m].max)
+            analysis.metrics[m].max = part->max[m];
+      }
+      if (t == 0) continue;
+      for (size_t b=0; b<NUM_METRICS * (MC_BINS + 2); b++)
+         histogram[b] += part->histogram[b];
+   }
+   for (size_t c=0; c<run.chunks; c++)
+      for (int m=0; m<NUM_METRICS; m++) {
+         sum[m] += run.sums[c * 2 * NUM_METRICS + m];
+         sum2[m] += run.sums[c * 2 * NUM_METRICS + NUM_METRICS + m];
+      }
+   // Calculate the statistics of each metric.
+   for (int m=0; m<NUM_METRICS; m++) {
+      struct Statistics *stats = &analysis.metrics[m];
+      stats->mean = (count > 0) ? run.shift[m] + sum[m] / count : NAN;
+      double variance = (count > 1) ?
+         (sum2[m] - sum[m] * sum[m] / count) / (count - 1) : 0;
+      stats->stddev = (variance > 0) ? sqrt(variance) : 0;
+      for (int p=0; p<NUM_PERCENTILES; p++)
+         stats->percentiles[p] = (count > 0) ? _percentile_(
+            histogram + m * (MC_BINS + 2), count, mc_percentiles[p],
+            run.low[m], run.width[m], stats->min, stats->max) : NAN;
+   }
+
+   for (size_t t=0; t<run.threads; t++) free(run.parts[t].histogram);
+   free(run.parts); free(run.sums);
+   return analysis;
+}
+
+/* Monte Carlo analysis of any configuration.
+
+Each parameter of 'config' is sampled from its own distribution in
+'distributions' (in the same order as 'config->params'). The samples
+are analyzed on 'threads' threads (0 means all processors).
+
+const struct Configuration *config = find_configuration(
+      bjt_configurations, num_bjt_configurations, "emitter_bias");
+struct Distribution distributions[6] = {
+   {DIST_FIXED, 20, 0}, // Vcc
+   {DIST_UNIFORM, 470000, 0.05}, // Rb (5%)
+   {DIST_UNIFORM, 2200, 0.05}, // Rc (5%)
+   {DIST_UNIFORM, 560, 0.05}, // Re (5%)
+   {DIST_GAUSSIAN, 120, 0.1}, // beta (10% sigma)
+   {DIST_FIXED, 40000, 0}, // ro
+};
+MonteCarloAnalysis analysis = monte_carlo(config, distributions,
+                                          1000000, 2024, 0);
+display_monte_carlo_results(analysis);
+
+samples: 1000000 (failures: 0, rejected: 0)
+I: mean=4.304309e-03 stddev=3.927623e-04 min=2.272191e-03 ...
+V: mean=8.120233e+00 stddev=1.117880e+00 min=2.703629e+00 ...
+Av: mean=-3.852734e+00 stddev=1.567016e-01 min=-4.269231e+00 ...
+Zi: mean=5.635822e+04 stddev=5.078342e+03 min=3.009554e+04 ...
+Zo: mean=2.197747e+03 stddev=6.335782e+01 min=2.087143e+03 ...
+*/
+MonteCarloAnalysis monte_carlo(const struct Configuration *config,
+         const struct Distribution *distributions, size_t samples,
+         uint64_t seed, size_t threads) {
+   return monte_carlo_regions(config, distributions, samples, seed, 0,
+                              threads);
+}
+
+#endif
@@ -0,0 +1,813 @@
+/* Modified Nodal Analysis of Netlists with Transistor Models
+
+The configuration functions of BJT.h, JFET.h and MOSFET.h solve
+fixed bias networks. But a board may use a network which none of
+them covers (like two transistors sharing one divider). So, this
+source file solves any netlist of resistors, sources and transistors
+by modified nodal analysis: the unknowns are the node voltages and
+the currents of voltage sources, and the transistors are linearized
+by Newton-Raphson. The matrix is sparse. Its symbolic factorization
+(the pivot order and the pattern of LU factors) is found once, so
+each Newton iteration (and each sweep point) only stamps and
+refactors the numbers.
+
+struct Netlist *netlist = create_netlist(7, 9);
+netlist_voltage_source(netlist, "Vcc", 1, 0, 22);
+netlist_resistor(netlist, "R1", 1, 2, 39000);
+netlist_resistor(netlist, "R2", 2, 0, 3900);
+netlist_resistor(netlist, "Rc1", 1, 3, 10000);
+netlist_resistor(netlist, "Re1", 4, 0, 1500);
+netlist_bjt(netlist, "Q1", 3, 2, 4, 100);
+netlist_resistor(netlist, "Rc2", 1, 5, 4700);
+netlist_resistor(netlist, "Re2", 6, 0, 1200);
+netlist_bjt(netlist, "Q2", 5, 2, 6, 100);
+netlist_solve(netlist);
+display_netlist_results(netlist);
+destroy_netlist(netlist);
+
+V(1): 22.000000 V
+V(2): 1.934889 V
+V(3): 13.817045 V
+V(4): 1.239718 V
+V(5): 17.214549 V
+V(6): 1.234035 V
+I(Vcc): -2.350967e-03 A
+I(R1): 5.144900e-04 A
+I(R2): 4.961253e-04 A
+I(Rc1): 8.182955e-04 A
+I(Re1): 8.264784e-04 A
+I(Q1): 8.182955e-04 A
+I(Rc2): 1.018181e-03 A
+I(Re2): 1.028363e-03 A
+I(Q2): 1.018181e-03 A
+iterations: 5
+
+IMPORTANT NOTES:
+----------------
+
+1. Node 0 is the ground. Every node needs a DC path to the ground
+(through resistors or sources), otherwise the matrix is singular and
+'netlist_solve()' fails (also if it is structurally singular, then
+the solution stays all zero).
+2. BJTs are NPN Ebers-Moll transistors with typical silicon junctions
+(see EbersMoll.h). JFETs are n-channel Shockley ones (no current
+below Vp) and E-MOSFETs are n-channel k(Vgs - Vgsth)^2 ones. Like
+JFET.h and MOSFET.h, FET currents don't depend on Vds (there isn't
+any ohmic region) and gates don't draw any current.
+3. The symbolic factorization is found by the first solve: equations
+are matched to unknowns so the diagonal hasn't any structural zero
+(the row of a voltage source swaps with the row of its node), the
+unknowns are ordered by minimum degree and the pattern of fill-in is
+kept. Changing values ('netlist_set_value()') keeps it, adding an
+element discards it.
+4. Pivots aren't searched numerically (the pattern is fixed). A zero
+or non-finite pivot fails the solve.
+5. Newton iterations start from the last solution (all zero and the
+Vbe of BJT.h for the first one). Forward junction steps above
+BJT_EM_ON are limited to BJT_EM_STEP and the iteration stops when no node voltage moves
+more than NETLIST_TOLERANCE. A netlist without transistors is solved
+once.
+6. Solves and sweeps don't allocate any memory.
+7. Link with '-lm'.
+
+EXISTING OPERATIONS:
+--------------------
+
++ Netlist Lifetime (create_netlist, destroy_netlist)
++ Elements (netlist_resistor, netlist_voltage_source,
+netlist_current_source, netlist_bjt, netlist_jfet, netlist_mosfet,
+netlist_set_value)
++ Solutions (netlist_solve, netlist_sweep, netlist_voltage,
+netlist_current, display_netlist_results)
+*/
+
+#ifndef NETLIST_H
+#define NETLIST_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include "EbersMoll.h"
+#include "JFET.h"
+#include "MOSFET.h"
+
+// General constants:
+#define NETLIST_TOLERANCE 1e-9 // node voltage step of converged solves
+#define NETLIST_ITERATIONS 100 // maximum Newton-Raphson iterations
+#define NETLIST_NONE SIZE_MAX // unknown of the ground (and no entry)
+
+// Kinds of elements:
+enum NetlistKind {
+   NETLIST_RESISTOR, // nodes (a, b), value is resistance
+   NETLIST_VOLTAGE, // nodes (+, -), value is voltage
+   NETLIST_CURRENT, // nodes (from, to), value is current
+   NETLIST_BJT, // nodes (collector, base, emitter), value is beta
+   NETLIST_JFET, // nodes (drain, gate, source), value is Idss
+   NETLIST_MOSFET // nodes (drain, gate, source), value is k
+};
+
+// Element of a netlist:
+struct NetlistElement {
+   enum NetlistKind kind; // kind of element
+   string name; // name of element (kept, not copied)
+   size_t nodes[3]; // terminal nodes (see 'NetlistKind')
+   double value; // main value (see 'NetlistKind')
+   double shape; // Vp of JFETs and Vgsth of MOSFETs
+   size_t branch; // unknown of current of voltage sources
+   size_t stamps[9]; // LU entries of matrix stamps
+   struct BJT_Junctions junctions; // limited junction voltages of BJTs
+};
+
+// Netlist with its factorization:
+struct Netlist {
+   size_t num_nodes; // count of nodes (with the ground)
+   size_t capacity; // maximum count of elements
+   size_t num_elements; // count of elements
+   size_t num_branches; // count of voltage sources
+   int nonlinear; // 1 if there is any transistor
+   struct NetlistElement *elements; // all elements
+   // Symbolic factorization (NULL until the first solve):
+   size_t n; // count of unknowns
+   size_t *start; // first LU entry of each pivot row (and the end)
+   size_t *diagonal; // diagonal LU entry of each pivot row
+   size_t *columns; // pivot column of each LU entry
+   size_t *unknowns; // unknown of each pivot
+   size_t *equations; // equation of each pivot row
+   // Numeric factorization and solution:
+   double *values; // LU entries (stamped matrix, then factors)
+   double *rhs; // right-hand side of equations
+   double *work; // dense pivot row (and solution in pivot order)
+   double *x; // unknowns of the last solution
+   int iterations; // Newton-Raphson iterations of the last solve
+   int converged; // 1 if the last solve converged
+};
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Get the unknown (and the equation) of a node voltage. */
+size_t _netlist_unknown_(size_t node) {
+   return (node == 0) ? NETLIST_NONE : node - 1;
+}
+
+/* Get the voltage of a node at the last solution. */
+double _netlist_node_(const struct Netlist *netlist, size_t node) {
+   return (node == 0 || netlist->x == NULL) ? 0 : netlist->x[node - 1];
+}
+
+/* Get the square-law drain current of a FET at 'Vgs' (none below Vp
+or Vgsth) and its transconductance. */
+double _netlist_square_law_(const struct NetlistElement *element,
+                            double Vgs, double *gm) {
+   int jfet = element->kind == NETLIST_JFET;
+   double Vov = jfet ? 1 - Vgs / element->shape : Vgs - element->shape;
+   double scale = jfet ? -2 / element->shape : 2;
+   *gm = (Vov > 0) ? element->value * scale * Vov : 0;
+   return (Vov > 0) ? element->value * Vov * Vov : 0;
+}
+
+/* Free the factorization of a netlist (its pattern changes). */
+void _netlist_discard_(struct Netlist *netlist) {
+   free(netlist->start); free(netlist->diagonal);
+   free(netlist->columns); free(netlist->unknowns);
+   free(netlist->equations); free(netlist->values);
+   free(netlist->rhs); free(netlist->work); free(netlist->x);
+   netlist->start = netlist->diagonal = netlist->columns = NULL;
+   netlist->unknowns = netlist->equations = NULL;
+   netlist->values = netlist->rhs = netlist->work = netlist->x = NULL;
+}
+
+/* Find the index of the lowest set bit of a non-zero word. */
+int _netlist_lowest_(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_ctzll(word);
+#else
+   int bit = 0;
+   while (!(word >> bit & 1)) bit++;
+   return bit;
+#endif
+}
+
+/* Count the set bits of a bit set of 'words' words. */
+size_t _netlist_count_(const uint64_t *set, size_t words) {
+   size_t count = 0;
+   for (size_t w=0; w<words; w++) {
+#if defined(__GNUC__) || defined(__clang__)
+      count += __builtin_popcountll(set[w]);
+#else
+      for (uint64_t word=set[w]; word!=0; word&=word-1) count++;
+#endif
+   }
+   return count;
+}
+
+// Visit each member 'i' of a bit set (the set may change):
+#define NETLIST_EACH(i, set, words) \
+   for (size_t _w_=0; _w_<(words); _w_++) \
+      for (uint64_t _b_=(set)[_w_]; _b_!=0 && \
+           ((i) = _w_ * 64 + _netlist_lowest_(_b_), 1); _b_&=_b_-1)
+
+/* Get the matrix entries (equations and unknowns) of an element in
+the order of its stamps. The count of entries is returned. */
+size_t _netlist_entries_(const struct Netlist *netlist,
+                         const struct NetlistElement *element,
+                         size_t *equations, size_t *unknowns) {
+   size_t t[3];
+   for (size_t k=0; k<3; k++)
+      t[k] = _netlist_unknown_(element->nodes[k]);
+   size_t branch = netlist->num_nodes - 1 + element->branch;
+   switch (element->kind) {
+   case NETLIST_RESISTOR: {
+      size_t e[4] = {t[0], t[0], t[1], t[1]}, u[4] = {t[0], t[1], t[0],
+                                                     t[1]};
+      memcpy(equations, e, sizeof(e)); memcpy(unknowns, u, sizeof(u));
+      return 4;
+   }
+   case NETLIST_VOLTAGE: {
+      size_t e[4] = {t[0], t[1], branch, branch};
+      size_t u[4] = {branch, branch, t[0], t[1]};
+      memcpy(equations, e, sizeof(e)); memcpy(unknowns, u, sizeof(u));
+      return 4;
+   }
+   case NETLIST_CURRENT:
+      return 0;
+   case NETLIST_BJT:
+      // Currents of all terminals depend on all terminal voltages.
+      for (size_t k=0; k<9; k++) {
+         equations[k] = t[k / 3];
+         unknowns[k] = t[k % 3];
+      }
+      return 9;
+   default: {
+      // Drain and source currents depend only on Vgs.
+      size_t e[4] = {t[0], t[0], t[2], t[2]}, u[4] = {t[1], t[2], t[1],
+                                                     t[2]};
+      memcpy(equations, e, sizeof(e)); memcpy(unknowns, u, sizeof(u));
+      return 4;
+   }
+   }
+}
+
+/* Add an element to the netlist (the symbolic factorization is
+discarded). */
+size_t _netlist_add_(struct Netlist *netlist, enum NetlistKind kind,
+                     string name, size_t n1, size_t n2, size_t n3,
+                     double value, double shape) {
+   // Check if the element fits the netlist.
+   assert (netlist->num_elements < netlist->capacity);
+   assert (n1 < netlist->num_nodes && n2 < netlist->num_nodes &&
+           n3 < netlist->num_nodes);
+   struct NetlistElement *element =
+         &netlist->elements[netlist->num_elements];
+   memset(element, 0, sizeof(struct NetlistElement));
+   element->kind = kind;
+   element->name = name;
+   element->nodes[0] = n1; element->nodes[1] = n2;
+   element->nodes[2] = n3;
+   element->value = value;
+   element->shape = shape;
+   element->branch = (kind == NETLIST_VOLTAGE) ?
+                     netlist->num_branches++ : NETLIST_NONE;
+   // Start BJTs in the active region of BJT.h.
+   element->junctions.be = Vbe;
+   element->junctions.bc = 0;
+   netlist->nonlinear |= (kind == NETLIST_BJT || kind == NETLIST_JFET ||
+                          kind == NETLIST_MOSFET);
+   _netlist_discard_(netlist);
+   return netlist->num_elements++;
+}
+
+/* Match each unknown to an equation with a structural entry in its
+column, by an augmenting path from 'u' (see MC21). */
+int _netlist_augment_(size_t u, const uint64_t *columns, size_t words,
+                      size_t *match, size_t *owner,
+                      unsigned char *visited) {
+   size_t e;
+   NETLIST_EACH(e, columns + u * words, words) {
+      if (visited[e]) continue;
+      visited[e] = 1;
+      if (owner[e] == NETLIST_NONE ||
+          _netlist_augment_(owner[e], columns, words, match, owner,
+                            visited)) {
+         match[u] = e;
+         owner[e] = u;
+         return 1;
+      }
+   }
+   return 0;
+}
+
+/* Compare two pivot columns for sorting. */
+int _netlist_compare_(const void *a, const void *b) {
+   size_t x = *(const size_t *) a, y = *(const size_t *) b;
+   return (x > y) - (x < y);
+}
+
+/* Find the symbolic factorization of a netlist and allocate its
+numeric factorization. If the netlist is structurally singular (an
+unknown can't be matched to any equation), nothing is kept and 0 is
+returned. */
+int _netlist_analyze_(struct Netlist *netlist) {
+   size_t n = netlist->num_nodes - 1 + netlist->num_branches;
+   size_t words = (n + 63) / 64;
+   assert (n > 0);
+   // Structural entries of the matrix by columns and by rows.
+   uint64_t *columns = calloc(n * words, sizeof(uint64_t));
+   uint64_t *rows = calloc(n * words, sizeof(uint64_t));
+   uint64_t *graph = calloc(n * words, sizeof(uint64_t));
+   uint64_t *upper = calloc(n * words, sizeof(uint64_t));
+   size_t *match = malloc(n * sizeof(size_t));
+   size_t *owner = malloc(n * sizeof(size_t));
+   size_t *order = malloc(n * sizeof(size_t));
+   size_t *position = malloc(n * sizeof(size_t));
+   size_t *lower = calloc(n, sizeof(size_t));
+   unsigned char *visited = malloc(n);
+   assert (columns != NULL && rows != NULL && graph != NULL &&
+           upper != NULL && match != NULL && owner != NULL &&
+           order != NULL && position != NULL && lower != NULL &&
+           visited != NULL);
+   size_t e[9], u[9];
+   for (size_t i=0; i<netlist->num_elements; i++) {
+      size_t count = _netlist_entries_(netlist, &netlist->elements[i],
+                                       e, u);
+      for (size_t k=0; k<count; k++) {
+         if (e[k] == NETLIST_NONE || u[k] == NETLIST_NONE) continue;
+         columns[u[k] * words + e[k] / 64] |= (uint64_t) 1 << e[k] % 64;
+         rows[e[k] * words + u[k] / 64] |= (uint64_t) 1 << u[k] % 64;
+      }
+   }
+
+   // Keep the structural diagonal (node rows), then match the others.
+   for (size_t k=0; k<n; k++) match[k] = owner[k] = NETLIST_NONE;
+   for (size_t k=0; k<n; k++)
+      if (columns[k * words + k / 64] >> k % 64 & 1)
+         match[k] = owner[k] = k;
+   int found = 1;
+   for (size_t k=0; k<n && found; k++) {
+      if (match[k] != NETLIST_NONE) continue;
+      memset(visited, 0, n);
+      found = _netlist_augment_(k, columns, words, match, owner,
+                                visited);
+   }
+   if (!found) {
+      free(columns); free(rows); free(graph); free(upper); free(match);
+      free(owner); free(order); free(position); free(lower);
+      free(visited);
+      return 0;
+   }
+
+   // Symmetric pattern of the matched matrix (row of unknown 'k' is
+   // the equation matched to it).
+   for (size_t k=0; k<n; k++) {
+      uint64_t *set = graph + k * words;
+      memcpy(set, rows + match[k] * words, words * sizeof(uint64_t));
+      size_t r;
+      NETLIST_EACH(r, columns + k * words, words)
+         set[owner[r] / 64] |= (uint64_t) 1 << owner[r] % 64;
+      set[k / 64] &= ~((uint64_t) 1 << k % 64);
+   }
+   // Order the unknowns by minimum degree of the elimination graph.
+   memset(visited, 0, n);
+   for (size_t i=0; i<n; i++) {
+      size_t v = NETLIST_NONE, degree = SIZE_MAX;
+      for (size_t k=0; k<n; k++) {
+         if (visited[k]) continue;
+         size_t d = _netlist_count_(graph + k * words, words);
+         if (d < degree) { v = k; degree = d; }
+      }
+      order[i] = v; position[v] = i; visited[v] = 1;
+      // Neighbors become a clique (fill-in) and forget 'v'.
+      uint64_t *neighbors = graph + v * words;
+      memcpy(upper + i * words, neighbors, words * sizeof(uint64_t));
+      size_t w;
+      NETLIST_EACH(w, upper + i * words, words) {
+         uint64_t *set = graph + w * words;
+         for (size_t k=0; k<words; k++) set[k] |= neighbors[k];
+         set[w / 64] &= ~((uint64_t) 1 << w % 64);
+         set[v / 64] &= ~((uint64_t) 1 << v % 64);
+         lower[w]++;
+      }
+   }
+
+   // Rows of LU factors in pivot order: lower part, diagonal, upper.
+   netlist->n = n;
+   netlist->start = malloc((n + 1) * sizeof(size_t));
+   netlist->diagonal = malloc(n * sizeof(size_t));
+   netlist->unknowns = malloc(n * sizeof(size_t));
+   netlist->equations = malloc(n * sizeof(size_t));
+   assert (netlist->start != NULL && netlist->diagonal != NULL &&
+           netlist->unknowns != NULL && netlist->equations != NULL);
+   netlist->start[0] = 0;
+   for (size_t i=0; i<n; i++) {
+      size_t nu = _netlist_count_(upper + i * words, words);
+      netlist->diagonal[i] = netlist->start[i] + lower[order[i]];
+      netlist->start[i+1] = netlist->diagonal[i] + 1 + nu;
+      netlist->unknowns[i] = order[i];
+      netlist->equations[i] = match[order[i]];
+   }
+   size_t entries = netlist->start[n];
+   netlist->columns = malloc(entries * sizeof(size_t));
+   assert (netlist->columns != NULL);
+   memset(lower, 0, n * sizeof(size_t));
+   for (size_t i=0; i<n; i++) {
+      size_t *pattern = netlist->columns, w, next = 0;
+      pattern[netlist->diagonal[i]] = i;
+      NETLIST_EACH(w, upper + i * words, words) {
+         size_t r = position[w];
+         // Lower entries arrive in ascending pivot order.
+         pattern[netlist->start[r] + lower[r]++] = i;
+         pattern[netlist->diagonal[i] + 1 + next++] = r;
+      }
+      qsort(pattern + netlist->diagonal[i] + 1, next,
+            sizeof(size_t), _netlist_compare_);
+   }
+
+   // Find the LU entries of all stamps.
+   for (size_t i=0; i<netlist->num_elements; i++) {
+      struct NetlistElement *element = &netlist->elements[i];
+      size_t count = _netlist_entries_(netlist, element, e, u);
+      for (size_t k=0; k<count; k++) {
+         element->stamps[k] = NETLIST_NONE;
+         if (e[k] == NETLIST_NONE || u[k] == NETLIST_NONE) continue;
+         size_t r = position[owner[e[k]]], c = position[u[k]];
+         size_t *found = bsearch(&c, netlist->columns + netlist->start[r],
+                                 netlist->start[r+1] - netlist->start[r],
+                                 sizeof(size_t), _netlist_compare_);
+         assert (found != NULL);
+         element->stamps[k] = found - netlist->columns;
+      }
+   }
+
+   netlist->values = malloc(entries * sizeof(double));
+   netlist->rhs = malloc(n * sizeof(double));
+   netlist->work = malloc(n * sizeof(double));
+   netlist->x = calloc(n, sizeof(double));
+   assert (netlist->values != NULL && netlist->rhs != NULL &&
+           netlist->work != NULL && netlist->x != NULL);
+   free(columns); free(rows); free(graph); free(upper); free(match);
+   free(owner); free(order); free(position); free(lower);
+   free(visited);
+   return 1;
+}
+
+/* Add 'current' to the right-hand side of an equation (the ground
+hasn't any). */
+void _netlist_inject_(struct Netlist *netlist, size_t equation,
+                      double current) {
+   if (equation != NETLIST_NONE) netlist->rhs[equation] += current;
+}
+
+/* Stamp the linearized model of a transistor: terminal currents 'I'
+at the controlling voltages 'v' and their derivatives 'g' (by the
+first and second controlling voltage of each terminal row). */
+void _netlist_companion_(struct Netlist *netlist,
+                         const struct NetlistElement *element,
+                         const double *I, const double (*g)[2],
+                         const double *v, double *entries) {
+   for (size_t t=0; t<3; t++) {
+      _netlist_inject_(netlist, _netlist_unknown_(element->nodes[t]),
+                       -(I[t] - g[t][0] * v[0] - g[t][1] * v[1]));
+   }
+   if (element->kind == NETLIST_BJT) {
+      // Vbe = Vb - Ve and Vbc = Vb - Vc by (collector, base, emitter).
+      for (size_t t=0; t<3; t++) {
+         entries[3*t] = -g[t][1];
+         entries[3*t + 1] = g[t][0] + g[t][1];
+         entries[3*t + 2] = -g[t][0];
+      }
+   }
+   else {
+      // Vgs = Vg - Vs by (gate, source) of drain and source rows.
+      entries[0] = g[0][0]; entries[1] = -g[0][0];
+      entries[2] = g[2][0]; entries[3] = -g[2][0];
+   }
+}
+
+/* Stamp an element at the last solution. */
+void _netlist_stamp_(struct Netlist *netlist,
+                     const struct NetlistElement *element) {
+   double entries[9] = {0};
+   size_t t0 = _netlist_unknown_(element->nodes[0]);
+   size_t t1 = _netlist_unknown_(element->nodes[1]);
+   switch (element->kind) {
+   case NETLIST_RESISTOR: {
+      double G = 1 / element->value;
+      entries[0] = G; entries[1] = -G; entries[2] = -G; entries[3] = G;
+      break;
+   }
+   case NETLIST_VOLTAGE:
+      entries[0] = 1; entries[1] = -1; entries[2] = 1; entries[3] = -1;
+      netlist->rhs[netlist->num_nodes - 1 + element->branch] +=
+            element->value;
+      break;
+   case NETLIST_CURRENT:
+      _netlist_inject_(netlist, t0, -element->value);
+      _netlist_inject_(netlist, t1, element->value);
+      break;
+   case NETLIST_BJT: {
+      // Ebers-Moll currents into terminals (like EbersMoll.h, but
+      // scalar, so 'exp()' of libm is faster).
+      struct BJT_EbersMoll model = bjt_junctions;
+      struct BJT_Junctions x = element->junctions;
+      double uT = 1 / model.VT, uR = 1 / model.betaR;
+      double uF = 1 / element->value, kR = 1 + uR;
+      double Ef = exp(x.be * uT), Er = exp(x.bc * uT);
+      double If = model.Is * (Ef - 1), Ir = model.Is * (Er - 1);
+      double gf = model.Is * uT * Ef, gr = model.Is * uT * Er;
+      double Ic = If - kR * Ir, Ib = If * uF + Ir * uR;
+      double I[3] = {Ic, Ib, -(Ic + Ib)};
+      double g[3][2] = {{gf, -kR * gr}, {gf * uF, gr * uR},
+                        {-(gf + gf * uF), kR * gr - gr * uR}};
+      double v[2] = {x.be, x.bc};
+      _netlist_companion_(netlist, element, I, g, v, entries);
+      break;
+   }
+   default: {
+      // Square-law drain current of Vgs at the last solution.
+      double gm, Vgs = _netlist_node_(netlist, element->nodes[1]) -
+                       _netlist_node_(netlist, element->nodes[2]);
+      double Id = _netlist_square_law_(element, Vgs, &gm);
+      double I[3] = {Id, 0, -Id};
+      double g[3][2] = {{gm, 0}, {0, 0}, {-gm, 0}};
+      double v[2] = {Vgs, 0};
+      _netlist_companion_(netlist, element, I, g, v, entries);
+      break;
+   }
+   }
+   double *values = netlist->values;
+   for (size_t k=0; k<9; k++)
+      if (element->stamps[k] != NETLIST_NONE)
+         values[element->stamps[k]] += entries[k];
+}
+
+/* Factorize the stamped matrix in place (the pattern of fill-in is
+already there). If a pivot is zero or not finite, 0 is returned. */
+int _netlist_factor_(struct Netlist *netlist) {
+   const size_t *start = netlist->start, *diagonal = netlist->diagonal;
+   const size_t *columns = netlist->columns;
+   double *values = netlist->values, *work = netlist->work;
+   for (size_t r=0; r<netlist->n; r++) {
+      for (size_t p=start[r]; p<start[r+1]; p++)
+         work[columns[p]] = values[p];
+      // Eliminate the lower entries by the rows of earlier pivots.
+      for (size_t p=start[r]; p<diagonal[r]; p++) {
+         size_t k = columns[p];
+         double l = work[k] / values[diagonal[k]];
+         work[k] = l;
+         for (size_t q=diagonal[k]+1; q<start[k+1]; q++)
+            work[columns[q]] -= l * values[q];
+      }
+      for (size_t p=start[r]; p<start[r+1]; p++)
+         values[p] = work[columns[p]];
+      double pivot = values[diagonal[r]];
+      if (pivot == 0 || !isfinite(pivot)) return 0;
+   }
+   return 1;
+}
+
+/* Solve the factorized matrix for the right-hand side. The solution
+is left in 'work' in pivot order. */
+void _netlist_substitute_(struct Netlist *netlist) {
+   const size_t *start = netlist->start, *diagonal = netlist->diagonal;
+   const size_t *columns = netlist->columns;
+   const double *values = netlist->values;
+   double *y = netlist->work;
+   for (size_t r=0; r<netlist->n; r++) {
+      double sum = netlist->rhs[netlist->equations[r]];
+      for (size_t p=start[r]; p<diagonal[r]; p++)
+         sum -= values[p] * y[columns[p]];
+      y[r] = sum;
+   }
+   for (size_t r=netlist->n; r-->0;) {
+      double sum = y[r];
+      for (size_t p=diagonal[r]+1; p<start[r+1]; p++)
+         sum -= values[p] * y[columns[p]];
+      y[r] = sum / values[diagonal[r]];
+   }
+}
+
+/* Move the BJT junctions toward the last solution, limiting forward
+steps above BJT_EM_ON (a reverse junction moves freely, its current
+doesn't overflow). If any step is limited, 1 is returned. */
+int _netlist_limit_(struct Netlist *netlist) {
+   int limited = 0;
+   for (size_t i=0; i<netlist->num_elements; i++) {
+      struct NetlistElement *element = &netlist->elements[i];
+      if (element->kind != NETLIST_BJT) continue;
+      double Vb = _netlist_node_(netlist, element->nodes[1]);
+      struct BJT_Junctions y = {
+         Vb - _netlist_node_(netlist, element->nodes[2]),
+         Vb - _netlist_node_(netlist, element->nodes[0])};
+      struct BJT_Junctions *x = &element->junctions;
+      struct BJT_Junctions cap = {fmax(x->be, BJT_EM_ON) + BJT_EM_STEP,
+                                  fmax(x->bc, BJT_EM_ON) + BJT_EM_STEP};
+      limited |= (y.be > cap.be) | (y.bc > cap.bc);
+      x->be = fmin(y.be, cap.be);
+      x->bc = fmin(y.bc, cap.bc);
+   }
+   return limited;
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Create an empty netlist of 'nodes' nodes (node 0 is the ground)
+and at most 'elements' elements. */
+struct Netlist *create_netlist(size_t nodes, size_t elements) {
+   // Check if the sizes are consistent.
+   assert (nodes > 1 && elements > 0);
+   struct Netlist *netlist = calloc(1, sizeof(struct Netlist));
+   assert (netlist != NULL);
+   netlist->num_nodes = nodes;
+   netlist->capacity = elements;
+   netlist->elements = malloc(elements *
+                              sizeof(struct NetlistElement));
+   assert (netlist->elements != NULL);
+   return netlist;
+}
+
+/* Destroy a netlist created by 'create_netlist()'. */
+void destroy_netlist(struct Netlist *netlist) {
+   _netlist_discard_(netlist);
+   free(netlist->elements);
+   free(netlist);
+}
+
+/* Get the voltage of a node at the last solution. */
+double netlist_voltage(const struct Netlist *netlist, size_t node) {
+   assert (node < netlist->num_nodes);
+   return _netlist_node_(netlist, node);
+}
+
+/* Add a resistor between nodes 'a' and 'b'. The index of element is
+returned (like all elements). */
+size_t netlist_resistor(struct Netlist *netlist, string name,
+                        size_t a, size_t b, double R) {
+   assert (R > 0);
+   return _netlist_add_(netlist, NETLIST_RESISTOR, name, a, b, 0, R,
+                        0);
+}
+
+/* Add a voltage source of 'V' from node 'minus' to node 'plus'. */
+size_t netlist_voltage_source(struct Netlist *netlist, string name,
+                              size_t plus, size_t minus, double V) {
+   return _netlist_add_(netlist, NETLIST_VOLTAGE, name, plus, minus, 0,
+                        V, 0);
+}
+
+/* Add a current source of 'I' flowing from node 'from' through the
+source to node 'to'. */
+size_t netlist_current_source(struct Netlist *netlist, string name,
+                              size_t from, size_t to, double I) {
+   return _netlist_add_(netlist, NETLIST_CURRENT, name, from, to, 0, I,
+                        0);
+}
+
+/* Add an NPN BJT (Ebers-Moll with 'bjt_junctions'). */
+size_t netlist_bjt(struct Netlist *netlist, string name,
+                   size_t collector, size_t base, size_t emitter,
+                   double beta) {
+   assert (beta > 0);
+   return _netlist_add_(netlist, NETLIST_BJT, name, collector, base,
+                        emitter, beta, 0);
+}
+
+/* Add an n-channel JFET (Idss(1 - Vgs/Vp)^2 above Vp). */
+size_t netlist_jfet(struct Netlist *netlist, string name, size_t drain,
+                    size_t gate, size_t source, double Idss,
+                    double Vp) {
+   assert (Idss > 0 && Vp < 0);
+   return _netlist_add_(netlist, NETLIST_JFET, name, drain, gate,
+                        source, Idss, Vp);
+}
+
+/* Add an n-channel E-MOSFET (k(Vgs - Vgsth)^2 above Vgsth, 'k' is
+found from Id(on) at Vgs(on) like MOSFET.h). */
+size_t netlist_mosfet(struct Netlist *netlist, string name,
+                      size_t drain, size_t gate, size_t source,
+                      double Idon, double Vgson, double Vgsth) {
+   assert (Idon > 0 && Vgson > Vgsth);
+   double k = Idon / ((Vgson - Vgsth) * (Vgson - Vgsth));
+   return _netlist_add_(netlist, NETLIST_MOSFET, name, drain, gate,
+                        source, k, Vgsth);
+}
+
+/* Change the main value of an element (see 'NetlistKind'). The
+symbolic factorization is kept. */
+void netlist_set_value(struct Netlist *netlist, size_t element,
+                       double value) {
+   assert (element < netlist->num_elements);
+   assert (value > 0 ||
+           netlist->elements[element].kind == NETLIST_VOLTAGE ||
+           netlist->elements[element].kind == NETLIST_CURRENT);
+   netlist->elements[element].value = value;
+}
+
+/* Solve the netlist by Newton-Raphson from the last solution. If it
+converges, 1 is returned (also kept in 'netlist->converged' with the
+count of iterations). */
+int netlist_solve(struct Netlist *netlist) {
+   netlist->converged = 0;
+   netlist->iterations = 0;
+   // A structurally singular netlist fails like a zero pivot.
+   if (netlist->values == NULL && !_netlist_analyze_(netlist)) return 0;
+   size_t n = netlist->n, voltages = netlist->num_nodes - 1;
+   while (!netlist->converged &&
+          netlist->iterations < NETLIST_ITERATIONS) {
+      netlist->iterations++;
+      memset(netlist->values, 0,
+             netlist->start[n] * sizeof(double));
+      memset(netlist->rhs, 0, n * sizeof(double));
+      for (size_t i=0; i<netlist->num_elements; i++)
+         _netlist_stamp_(netlist, &netlist->elements[i]);
+      if (!_netlist_factor_(netlist)) return 0;
+      _netlist_substitute_(netlist);
+      // Take the new solution and find the step of node voltages.
+      double step = 0;
+      for (size_t r=0; r<n; r++) {
+         size_t u = netlist->unknowns[r];
+         double y = netlist->work[r];
+         if (!isfinite(y)) return 0;
+         if (u < voltages) step = fmax(step, fabs(y - netlist->x[u]));
+         netlist->x[u] = y;
+      }
+      int limited = _netlist_limit_(netlist);
+      netlist->converged = !netlist->nonlinear ||
+                           (step <= NETLIST_TOLERANCE && !limited);
+   }
+   return netlist->converged;
+}
+
+/* Solve the netlist for each of 'num' values of an element (see
+'netlist_set_value()'), each one starting from the solution before
+it. The voltage of 'node' is written to 'voltages' (NAN if the solve
+fails). The count of converged solves is returned.
+
+double R2[3] = {3300, 3900, 4700}, Vc[3];
+size_t converged = netlist_sweep(netlist, 2, 3, R2, 3, Vc);
+*/
+size_t netlist_sweep(struct Netlist *netlist, size_t element,
+                     size_t num, const double *values, size_t node,
+                     double *voltages) {
+   size_t converged = 0;
+   for (size_t i=0; i<num; i++) {
+      netlist_set_value(netlist, element, values[i]);
+      int solved = netlist_solve(netlist);
+      voltages[i] = solved ? netlist_voltage(netlist, node) : NAN;
+      converged += solved;
+   }
+   return converged;
+}
+
+/* Get the current of an element at the last solution: through a
+resistor (from 'a' to 'b'), into the '+' of a voltage source (a
+supplying source has a negative one, like SPICE), of a current
+source, into the collector of a BJT and into the drain of a FET. */
+double netlist_current(const struct Netlist *netlist, size_t element) {
+   assert (element < netlist->num_elements);
+   const struct NetlistElement *e = &netlist->elements[element];
+   double V0 = netlist_voltage(netlist, e->nodes[0]);
+   double V1 = netlist_voltage(netlist, e->nodes[1]);
+   double V2 = netlist_voltage(netlist, e->nodes[2]);
+   switch (e->kind) {
+   case NETLIST_RESISTOR: return (V0 - V1) / e->value;
+   case NETLIST_VOLTAGE:
+      if (netlist->x == NULL) return 0;
+      return netlist->x[netlist->num_nodes - 1 + e->branch];
+   case NETLIST_CURRENT: return e->value;
+   case NETLIST_BJT: {
+      struct BJT_EbersMoll model = bjt_junctions;
+      double uT = 1 / model.VT, uR = 1 / model.betaR;
+      double If = model.Is * (exp((V1 - V2) * uT) - 1);
+      double Ir = model.Is * (exp((V1 - V0) * uT) - 1);
+      return If - (1 + uR) * Ir;
+   }
+   default: {
+      double gm;
+      return _netlist_square_law_(e, V1 - V2, &gm);
+   }
+   }
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------- Display Results --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Display the node voltages and element currents of the last
+solution (see the example of this file). */
+void display_netlist_results(const struct Netlist *netlist) {
+   for (size_t node=1; node<netlist->num_nodes; node++)
+      printf("V(%zu): %f V\n", node, netlist_voltage(netlist, node));
+   for (size_t i=0; i<netlist->num_elements; i++)
+      printf("I(%s): %e A\n", netlist->elements[i].name,
+             netlist_current(netlist, i));
+   printf("iterations: %d\n", netlist->iterations);
+}
+
+#endif
@@ -0,0 +1,167 @@
+/* Parallel Execution Support for the Engines
+
+The engines (like Monte Carlo) split their work into independent
+parts and run each part on its own thread. This source file
+contains that small thread support over POSIX threads.
+
+IMPORTANT NOTES:
+----------------
+
+1. Link with '-pthread'.
+2. Giving 'threads' as 0 means using all online processors.
+3. This source file is included by both the library (TransCal.c)
+and the programs which link it. So, its definitions are static.
+4. When the parts aren't equally expensive, threads balance them by
+work stealing: each thread owns a range of work items in its
+'WorkQueue' and takes them from the front. A thread without any
+work steals the back half of another thread's range.
+*/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+// Libraries:
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Worker function type which takes its thread index:
+typedef void (*Worker)(void *args, size_t index);
+
+// Arguments of each started thread:
+struct WorkerArgs {
+   Worker worker; // function to run
+   void *args; // common arguments
+   size_t index; // thread index
+};
+
+/* Find the count of threads to use. If 'threads' is 0, the count of
+online processors is returned. */
+static inline size_t _num_threads_(size_t threads) {
+   // Prefer the given thread count if it exists.
+   if (threads > 0) return threads;
+   long online = sysconf(_SC_NPROCESSORS_ONLN);
+   return (online > 0) ? (size_t) online : 1;
+}
+
+/* Start the worker with its arguments on a POSIX thread. */
+static inline void *_start_worker_(void *args) {
+   struct WorkerArgs *worker = args;
+   worker->worker(worker->args, worker->index);
+   return NULL;
+}
+
+/* Run 'worker' on 'threads' threads and wait all of them. Each call
+takes the same 'args' and its own thread index (0, 1, ...). The
+calling thread runs the index 0 itself.
+
+void square(void *args, size_t index) {
+   double *values = args;
+   values[index] *= values[index];
+}
+double values[4] = {1, 2, 3, 4};
+parallel_run(4, square, values);
+
+values: 1, 4, 9, 16
+*/
+static inline void parallel_run(size_t threads, Worker worker,
+                                void *args) {
+   // Check if the parameters are consistent.
+   assert (threads > 0 && worker != NULL);
+   // Start all other threads than the calling one.
+   pthread_t *ids = malloc(threads * sizeof(pthread_t));
+   struct WorkerArgs *workers = malloc(threads *
+                                       sizeof(struct WorkerArgs));
+   assert (ids != NULL && workers != NULL);
+   size_t started = 1;
+   for (size_t i=1; i<threads; i++) {
+      workers[i] = (struct WorkerArgs) {worker, args, i};
+      if (pthread_create(&ids[i], NULL, _start_worker_,
+                         &workers[i]) != 0) break;
+      started++;
+   }
+   // If some threads couldn't be started, run them here.
+   for (size_t i=started; i<threads; i++) worker(args, i);
+   // Run the first part and wait for the others.
+   worker(args, 0);
+   for (size_t i=1; i<started; i++) pthread_join(ids[i], NULL);
+
+   free(ids); free(workers);
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Work Stealing ------------------------ */
+/* --------------------------------------------------------------- */
+
+// Range of work items owned by a thread:
+struct WorkQueue {
+   pthread_mutex_t lock; // guards the range
+   size_t begin; // next item of the owner
+   size_t end; // end of range (thieves take from here)
+};
+
+/* Create 'num' empty work queues. */
+static inline struct WorkQueue *create_work_queues(size_t num) {
+   struct WorkQueue *queues = calloc(num, sizeof(struct WorkQueue));
+   assert (queues != NULL);
+   for (size_t i=0; i<num; i++)
+      pthread_mutex_init(&queues[i].lock, NULL);
+   return queues;
+}
+
+/* Destroy the work queues created by 'create_work_queues()'. */
+static inline void destroy_work_queues(struct WorkQueue *queues,
+                                       size_t num) {
+   for (size_t i=0; i<num; i++)
+      pthread_mutex_destroy(&queues[i].lock);
+   free(queues);
+}
+
+/* Give the items between 'begin' and 'end' to the queue. */
+static inline void fill_work_queue(struct WorkQueue *queue,
+                                   size_t begin, size_t end) {
+   pthread_mutex_lock(&queue->lock);
+   queue->begin = begin;
+   queue->end = end;
+   pthread_mutex_unlock(&queue->lock);
+}
+
+/* Take the first item of the queue (its owner calls it). If the
+queue is empty, 0 is returned. */
+static inline int take_work(struct WorkQueue *queue, size_t *item) {
+   pthread_mutex_lock(&queue->lock);
+   int found = queue->begin < queue->end;
+   if (found) *item = queue->begin++;
+   pthread_mutex_unlock(&queue->lock);
+   return found;
+}
+
+/* Steal the back half of another queue into the empty queue of
+'thief'. Victims are searched starting from the next thread. If
+there isn't any work to steal, 0 is returned.
+
+queues[0]: 0..8, queues[1]: empty
+steal_work(queues, 2, 1);
+
+queues[0]: 0..4, queues[1]: 4..8
+*/
+static inline int steal_work(struct WorkQueue *queues, size_t num,
+                             size_t thief) {
+   for (size_t i=1; i<num; i++) {
+      struct WorkQueue *victim = &queues[(thief + i) % num];
+      // Take the back half, rounding up for single items.
+      pthread_mutex_lock(&victim->lock);
+      size_t left = victim->end - victim->begin;
+      size_t end = victim->end;
+      size_t begin = end - (left + 1) / 2;
+      if (left > 0) victim->end = begin;
+      pthread_mutex_unlock(&victim->lock);
+      if (left == 0) continue;
+      fill_work_queue(&queues[thief], begin, end);
+      return 1;
+   }
+   return 0;
+}
+
+#endif
@@ -0,0 +1,523 @@
+/* Single-Precision Screening of Transistor Configurations
+
+The uniform configurations are evaluated in double. But a screening
+sweep (like rejecting the designs out of a current window) doesn't
+need 16 digits, and a SIMD register holds twice as many floats as
+doubles. So, this source file evaluates the formulas of each
+configuration in float over float columns, and it reports the error
+of float results against the double evaluations. So, a sweep can be
+screened in float and only the designs close to a limit are
+analyzed again in double.
+
+IMPORTANT NOTES:
+----------------
+
+1. Include this file instead of BJT.h, JFET.h and MOSFET.h, it
+includes them.
+2. The configurations are the uniform descriptions of the families
+(see Configuration.h), so the parameters and results are in the same
+order as the 'analyze_*()' functions.
+3. The formulas are the same as the fused analyses, but every
+operation (also 'sqrt()' of the drain current) is in float. So, the
+results can be far from the double ones where close numbers are
+subtracted (like 'Vce' near saturation). Check the error with
+'precision_report()' before trusting a float sweep.
+4. Compile with '-O3 -fno-math-errno', the batch loops are vectorized
+(see Batch.h).
+5. Long double isn't supported, the double evaluations are the
+references.
+
+EXISTING OPERATIONS:
+--------------------
+
++ Float Batches (find_screening, screen_configuration)
++ Error Reports (precision_report, display_precision_report)
+*/
+
+#ifndef PRECISION_H
+#define PRECISION_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include "BJT.h"
+#include "JFET.h"
+#include "MOSFET.h"
+
+// General constants:
+#define PRECISION_BLOCK 256 // designs compared together
+
+// Float evaluation of one configuration:
+struct Screening {
+   const struct Configuration *config; // uniform description
+   // Results of 'num' designs from float parameter columns.
+   void (*evaluate)(size_t num, const float *const *params,
+                    float *const *results);
+};
+
+// Error of float results against double results:
+struct PrecisionReport {
+   size_t num; // compared designs
+   size_t outside; // designs with any field out of tolerance
+   double tolerance; // relative tolerance of fields
+   double max_error[MAX_RESULTS]; // maximum relative error of fields
+   size_t worst[MAX_RESULTS]; // designs of maximum errors
+};
+
+// User-defined report type:
+typedef struct PrecisionReport PrecisionReport;
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Get the parallel resultant of 'R1' and 'R2' in float. */
+float _parallel_float_(float R1, float R2) {
+   return 1.0f / (1.0f / R1 + 1.0f / R2);
+}
+
+/* Select the right drain current like _drain_current_() in float. */
+float _drain_current_float_(float a, float b, float c) {
+   float discriminant = (b * b) - (4 * a * c);
+   float q = -0.5f * (b + copysignf(sqrtf(discriminant), b));
+   float root1 = q / a;
+   float root2 = c / q;
+   float low = (root1 < root2) ? root1 : root2;
+   float high = (root1 < root2) ? root2 : root1;
+   return (low >= 0) ? low : fabsf(high);
+}
+
+/* Get the transconductance factor like _gm_factor_() in float. */
+float _gm_factor_float_(float Idss, float Vp, float Vgs) {
+   return (2.0f * Idss / fabsf(Vp)) * (1.0f - Vgs / Vp);
+}
+
+/* Fill the DC results of common-emitter configurations from 'Ib'.
+The emitter resistance 'Re' is zero for fixed-bias. */
+void _bjt_float_dc_(float *r, float Vcc, float Ib, float beta,
+                    float Rc, float Re) {
+   r[0] = Ib;
+   r[1] = beta * Ib;
+   r[2] = (beta + 1) * Ib;
+   r[3] = Vcc / (Rc + Re);
+   r[4] = Vcc - r[1] * (Rc + Re);
+   r[6] = r[2] * Re;
+   r[5] = r[4] + r[6];
+   r[7] = (float) Vbe + r[6];
+   r[8] = r[7] - r[5];
+}
+
+/* Fill the AC results like _bjt_ac_bypassed_() in float. */
+void _bjt_float_bypassed_(float *r, float Rb, float Rc, float beta,
+                          float ro) {
+   float re = 0.026f / r[2];
+   r[9] = re;
+   r[10] = _parallel_float_(Rb, beta * re);
+   r[11] = _parallel_float_(Rc, ro);
+   r[12] = -1 * r[11] / re;
+}
+
+/* Fill the AC results like _bjt_ac_unbypassed_() in float. */
+void _bjt_float_unbypassed_(float *r, float Rb, float Rc, float Re,
+                            float beta, float ro) {
+   float re = 0.026f / r[2];
+   float Zb1 = (beta + 1) + (Rc / ro);
+   float Zb2 = 1 + (Rc + Re) / ro;
+   float Zb = beta * re + (Zb1 / Zb2) * Re;
+   float Zo1 = beta * (ro + re);
+   float Zo2 = 1 + (beta * re) / Re;
+   float Zo3 = ro + Zo1 / Zo2;
+   float Av1 = (-1 * (beta * Rc) / Zb) * (1 + (re / ro)) + (Rc / ro);
+   r[9] = re;
+   r[10] = _parallel_float_(Rb, Zb);
+   r[11] = _parallel_float_(Rc, Zo3);
+   r[12] = Av1 / (1 + (Rc / ro));
+}
+
+/* Fill the AC results like _bjt_ac_feedback_() in float. */
+void _bjt_float_feedback_(float *r, float Rf, float Rc, float beta,
+                          float ro) {
+   float re = 0.026f / r[2];
+   float Rco = _parallel_float_(Rc, ro);
+   float Zi1 = 1 + Rco / Rf;
+   float Zi2 = 1 / (beta * re) + 1 / Rf;
+   float Zi3 = Rco / (beta * re * Rf);
+   float Zi4 = Rco / (Rf * re);
+   r[9] = re;
+   r[10] = Zi1 / (Zi2 + Zi3 + Zi4);
+   r[11] = _parallel_float_(_parallel_float_(ro, Rc), Rf);
+   r[12] = -1 * (Rf / (Rco + Rf)) * (Rco / re);
+}
+
+/* Fill the DC results of FET configurations from 'Id'. The source
+voltage is 'Id * Rs - Vss' and the gate voltage is 'Vg'. */
+void _jfet_float_dc_(float *r, float Vdd, float Vss, float Vg,
+                     float Vgs, float Id, float Rd, float Rs) {
+   r[0] = Id;
+   r[1] = Vgs;
+   r[2] = (Vdd + Vss) - Id * (Rs + Rd);
+   r[3] = Id * Rs - Vss;
+   r[4] = Vdd - Id * Rd;
+   r[5] = Vg;
+}
+
+/* Solve the drain current of a JFET with the gate-source loop
+'Vgs = V - Id * Rs' in float. */
+float _jfet_float_quadratic_(float V, float Rs, float Idss,
+                             float Vp) {
+   float ratio = Rs / Vp, factor = 1 - V / Vp;
+   float a = Idss * ratio * ratio;
+   float b = 2 * Idss * ratio * factor - 1;
+   float c = Idss * factor * factor;
+   return _drain_current_float_(a, b, c);
+}
+
+/* Solve the MOSFET whose gate-source loop is 'Vgs = Vg - Id * Rs'
+and fill its DC results in float. */
+void _mosfet_float_dc_(float *r, float Idon, float Vgson,
+                       float Vgsth, float Vg, float Rs) {
+   float k = Idon / ((Vgson - Vgsth) * (Vgson - Vgsth));
+   float a = Rs * Rs * k;
+   float b = -2 * k * Rs * (Vg - Vgsth) - 1;
+   float c = k * (Vgsth - Vg) * (Vgsth - Vg);
+   r[0] = k;
+   r[1] = _drain_current_float_(a, b, c);
+   r[2] = Vg - r[1] * Rs;
+   r[4] = 2 * k * (r[2] - Vgsth);
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Float evaluations of uniform BJT configurations. */
+void _bjt_float_fixed_bias_(const float *p, float *r) {
+   // Parameters: Vcc, Rb, Rc, beta, ro.
+   float Ib = (p[0] - (float) Vbe) / p[1];
+   _bjt_float_dc_(r, p[0], Ib, p[3], p[2], 0);
+   r[6] = 0;
+   r[7] = (float) Vbe;
+   _bjt_float_bypassed_(r, p[1], p[2], p[3], p[4]);
+}
+
+void _bjt_float_emitter_bias_(const float *p, float *r) {
+   // Parameters: Vcc, Rb, Rc, Re, beta, ro.
+   float Ib = (p[0] - (float) Vbe) / (p[1] + (p[4] + 1) * p[3]);
+   _bjt_float_dc_(r, p[0], Ib, p[4], p[2], p[3]);
+   _bjt_float_unbypassed_(r, p[1], p[2], p[3], p[4], p[5]);
+}
+
+/* Solve the voltage-divider BJT in float, 'Rth' is returned. */
+float _bjt_float_voltage_divider_dc_(const float *p, float *r) {
+   // Parameters: Vcc, Rb1, Rb2, Rc, Re, beta, ro.
+   float rth = _parallel_float_(p[1], p[2]);
+   float eth = p[0] * (p[2] / (p[1] + p[2]));
+   float Ib = (eth - (float) Vbe) / (rth + (p[5] + 1) * p[4]);
+   _bjt_float_dc_(r, p[0], Ib, p[5], p[3], p[4]);
+   return rth;
+}
+
+void _bjt_float_voltage_divider_(const float *p, float *r) {
+   float rth = _bjt_float_voltage_divider_dc_(p, r);
+   _bjt_float_bypassed_(r, rth, p[3], p[5], p[6]);
+}
+
+void _bjt_float_voltage_divider_unbypassed_(const float *p, float *r) {
+   float rth = _bjt_float_voltage_divider_dc_(p, r);
+   _bjt_float_unbypassed_(r, rth, p[3], p[4], p[5], p[6]);
+}
+
+void _bjt_float_collector_feedback_(const float *p, float *r) {
+   // Parameters: Vcc, Rf, Rc, Re, beta, ro.
+   float Ib = (p[0] - (float) Vbe) / (p[1] + p[4] * (p[2] + p[3]));
+   _bjt_float_dc_(r, p[0], Ib, p[4], p[2], p[3]);
+   _bjt_float_feedback_(r, p[1], p[2], p[4], p[5]);
+}
+
+void _bjt_float_emitter_follower_(const float *p, float *r) {
+   // Parameters: Vee, Rb, Re, beta, ro.
+   float beta1 = p[3] + 1;
+   float Ib = (p[0] - (float) Vbe) / (p[1] + beta1 * p[2]);
+   float IeRe = beta1 * Ib * p[2];
+   r[0] = Ib;
+   r[1] = p[3] * Ib;
+   r[2] = beta1 * Ib;
+   r[3] = -1.0f;
+   r[4] = p[0] - IeRe;
+   r[6] = IeRe + p[0];
+   r[5] = r[4] + r[6];
+   r[7] = r[6] + (float) Vbe;
+   r[8] = r[7] - r[5];
+   float re = 0.026f / r[2];
+   float Reo = 1 + p[2] / p[4];
+   float Zb = p[3] * re + (beta1 * p[2]) / Reo;
+   r[9] = re;
+   r[10] = _parallel_float_(p[1], Zb);
+   r[11] = _parallel_float_(_parallel_float_(p[4], p[2]),
+                            p[3] * re / beta1);
+   r[12] = (beta1 * p[2] / Zb) / Reo;
+}
+
+void _bjt_float_common_base_(const float *p, float *r) {
+   // Parameters: Vcc, Vee, Rc, Re, beta.
+   r[2] = (p[1] - (float) Vbe) / p[3];
+   r[0] = r[2] / (p[4] + 1);
+   r[1] = r[0] * p[4];
+   r[3] = -1.0f;
+   r[4] = (p[1] + p[0]) - r[2] * (p[2] + p[3]);
+   r[5] = r[6] = r[7] = -1.0f;
+   r[8] = r[1] * p[2] - p[0];
+   float re = 0.026f / r[2];
+   r[9] = re;
+   r[10] = _parallel_float_(p[3], re);
+   r[11] = p[2];
+   r[12] = (p[4] / (p[4] + 1)) * p[2] / re;
+}
+
+/* Float evaluations of uniform JFET configurations. */
+void _jfet_float_fixed_bias_(const float *p, float *r) {
+   // Parameters: Vdd, Vgg, Rg, Rd, Idss, Vp, rd.
+   float Vgs = -p[1];
+   float factor = 1 - Vgs / p[5];
+   float Id = p[4] * factor * factor;
+   _jfet_float_dc_(r, p[0], 0, Vgs, Vgs, Id, p[3], 0);
+   r[3] = 0;
+   r[6] = _gm_factor_float_(p[4], p[5], Vgs);
+   r[7] = p[2];
+   r[8] = _parallel_float_(p[3], p[6]);
+   r[9] = -1 * r[6] * r[8];
+}
+
+void _jfet_float_self_bias_(const float *p, float *r) {
+   // Parameters: Vdd, Rg, Rd, Rs, Idss, Vp, rd.
+   float Id = _jfet_float_quadratic_(0, p[3], p[4], p[5]);
+   float Vgs = -Id * p[3];
+   _jfet_float_dc_(r, p[0], 0, 0, Vgs, Id, p[2], p[3]);
+   float gm = _gm_factor_float_(p[4], p[5], Vgs);
+   float Zo1 = 1 + gm * p[3] + p[3] / p[6];
+   float Zo2 = Zo1 + p[2] / p[6];
+   float Av2 = 1 + gm * p[3] + (p[2] + p[3]) / p[6];
+   r[6] = gm;
+   r[7] = p[1];
+   r[8] = Zo1 * p[2] / Zo2;
+   r[9] = -1 * gm * p[2] / Av2;
+}
+
+void _jfet_float_voltage_divider_(const float *p, float *r) {
+   // Parameters: Vdd, Rg1, Rg2, Rd, Rs, Idss, Vp, rd.
+   float Vg = p[2] * p[0] / (p[1] + p[2]);
+   float Id = _jfet_float_quadratic_(Vg, p[4], p[5], p[6]);
+   float Vgs = Vg - Id * p[4];
+   _jfet_float_dc_(r, p[0], 0, Vg, Vgs, Id, p[3], p[4]);
+   r[6] = _gm_factor_float_(p[5], p[6], Vgs);
+   r[7] = _parallel_float_(p[1], p[2]);
+   r[8] = _parallel_float_(p[3], p[7]);
+   r[9] = -1 * r[6] * r[8];
+}
+
+void _jfet_float_common_gate_(const float *p, float *r) {
+   // Parameters: Vdd, Vss, Rd, Rs, Idss, Vp, rd.
+   float Id = _jfet_float_quadratic_(p[1], p[3], p[4], p[5]);
+   float Vgs = p[1] - Id * p[3];
+   _jfet_float_dc_(r, p[0], p[1], 0, Vgs, Id, p[2], p[3]);
+   float gm = _gm_factor_float_(p[4], p[5], Vgs);
+   float Rdo = p[2] / p[6];
+   r[6] = gm;
+   r[7] = _parallel_float_(p[3], (p[6] + p[2]) / (1 + gm * p[6]));
+   r[8] = _parallel_float_(p[2], p[6]);
+   r[9] = (gm * p[2] + Rdo) / (1 + Rdo);
+}
+
+/* Float evaluations of uniform MOSFET configurations. */
+void _mosfet_float_drain_feedback_(const float *p, float *r) {
+   // Parameters: Vdd, Rg, Rd, Idon, Vgson, Vgsth, rd.
+   _mosfet_float_dc_(r, p[3], p[4], p[5], p[0], p[2]);
+   r[3] = r[2];
+   float Rdo = _parallel_float_(p[6], p[2]);
+   r[5] = (p[1] + Rdo) / (1 + r[4] * Rdo);
+   r[6] = _parallel_float_(p[1], Rdo);
+   r[7] = -1 * r[4] * r[6];
+}
+
+void _mosfet_float_voltage_divider_(const float *p, float *r) {
+   // Parameters: Vdd, Rg1, Rg2, Rd, Rs, Idon, Vgson, Vgsth, rd.
+   float Vg = p[2] * p[0] / (p[1] + p[2]);
+   _mosfet_float_dc_(r, p[5], p[6], p[7], Vg, p[4]);
+   r[3] = p[0] - r[1] * (p[4] + p[3]);
+   r[5] = _parallel_float_(p[1], p[2]);
+   r[6] = _parallel_float_(p[8], p[3]);
+   r[7] = -1 * r[4] * r[6];
+}
+
+/* --------------------------------------------------------------- */
+/* ----------------------- Batch Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+// Float batch of a configuration with 'nparams' parameters and
+// 'nresults' results. The scalar evaluation is inlined, so the loop
+// is vectorized with twice the lanes of double batches.
+#define FLOAT_BATCH(name, evaluation, nparams, nresults) \
+   BATCH_DISPATCH \
+   void name(size_t num, const float *const *params, \
+             float *const *results) { \
+      BATCH_LOOP \
+      for (size_t i=0; i<num; i++) { \
+         float p[nparams], r[nresults]; \
+         for (size_t j=0; j<nparams; j++) p[j] = params[j][i]; \
+         evaluation(p, r); \
+         for (size_t k=0; k<nresults; k++) results[k][i] = r[k]; \
+      } \
+   }
+
+FLOAT_BATCH(_bjt_screen_fixed_bias_, _bjt_float_fixed_bias_, 5, 13)
+FLOAT_BATCH(_bjt_screen_emitter_bias_, _bjt_float_emitter_bias_, 6,
+            13)
+FLOAT_BATCH(_bjt_screen_voltage_divider_, _bjt_float_voltage_divider_,
+            7, 13)
+FLOAT_BATCH(_bjt_screen_voltage_divider_unbypassed_,
+            _bjt_float_voltage_divider_unbypassed_, 7, 13)
+FLOAT_BATCH(_bjt_screen_collector_feedback_,
+            _bjt_float_collector_feedback_, 6, 13)
+FLOAT_BATCH(_bjt_screen_emitter_follower_, _bjt_float_emitter_follower_,
+            5, 13)
+FLOAT_BATCH(_bjt_screen_common_base_, _bjt_float_common_base_, 5, 13)
+FLOAT_BATCH(_jfet_screen_fixed_bias_, _jfet_float_fixed_bias_, 7, 10)
+FLOAT_BATCH(_jfet_screen_self_bias_, _jfet_float_self_bias_, 7, 10)
+FLOAT_BATCH(_jfet_screen_voltage_divider_, _jfet_float_voltage_divider_,
+            8, 10)
+FLOAT_BATCH(_jfet_screen_common_gate_, _jfet_float_common_gate_, 7, 10)
+FLOAT_BATCH(_mosfet_screen_drain_feedback_,
+            _mosfet_float_drain_feedback_, 7, 8)
+FLOAT_BATCH(_mosfet_screen_voltage_divider_,
+            _mosfet_float_voltage_divider_, 9, 8)
+
+/* Float evaluations of all uniform configurations. */
+const struct Screening screenings[] = {
+   {&bjt_configurations[0], _bjt_screen_fixed_bias_},
+   {&bjt_configurations[1], _bjt_screen_emitter_bias_},
+   {&bjt_configurations[2], _bjt_screen_voltage_divider_},
+   {&bjt_configurations[3], _bjt_screen_voltage_divider_unbypassed_},
+   {&bjt_configurations[4], _bjt_screen_collector_feedback_},
+   {&bjt_configurations[5], _bjt_screen_emitter_follower_},
+   {&bjt_configurations[6], _bjt_screen_common_base_},
+   {&jfet_configurations[0], _jfet_screen_fixed_bias_},
+   {&jfet_configurations[1], _jfet_screen_self_bias_},
+   {&jfet_configurations[2], _jfet_screen_voltage_divider_},
+   {&jfet_configurations[3], _jfet_screen_common_gate_},
+   {&mosfet_configurations[0], _mosfet_screen_drain_feedback_},
+   {&mosfet_configurations[1], _mosfet_screen_voltage_divider_},
+};
+
+// Number of float evaluations:
+const size_t num_screenings = sizeof(screenings) / sizeof(screenings[0]);
+
+/* Find the float evaluation of 'config' (an entry of a family table).
+If it doesn't exist, NULL is returned. */
+const struct Screening *find_screening(
+      const struct Configuration *config) {
+   // Search the table linearly, it is small.
+   for (size_t i=0; i<num_screenings; i++)
+      if (screenings[i].config == config) return &screenings[i];
+   return NULL;
+}
+
+/* Analyze 'num' designs of 'config' in float. Parameter and result
+columns are in the same order as 'config->params' and
+'config->results'.
+
+const struct Configuration *config = &bjt_configurations[2];
+float Vcc=22, Rb1=39000, Rb2=3900, Rc=10000, Re=1500, beta=100;
+float ro=50000;
+const float *params[7] = {&Vcc, &Rb1, &Rb2, &Rc, &Re, &beta, &ro};
+float values[13], *results[13];
+for (size_t r=0; r<13; r++) results[r] = &values[r];
+screen_configuration(config, 1, params, results);
+
+Ic: 8.384638e-04 A  (values[1])
+Vce: 12.357667 V  (values[4])
+*/
+void screen_configuration(const struct Configuration *config,
+      size_t num, const float *const *params, float *const *results) {
+   // Check if the configuration has a float evaluation.
+   const struct Screening *screening = find_screening(config);
+   assert (screening != NULL);
+   screening->evaluate(num, params, results);
+}
+
+/* Compare the float evaluations of 'num' designs of 'config' with the
+double evaluations. A field is inside the tolerance if its relative
+error is at most 'tolerance' (both NAN is equal). If 'status' isn't
+NULL, its i'th entry is set to 1 if any field of i'th design is
+outside the tolerance, otherwise to 0.
+
+PrecisionReport report = precision_report(config, num, params, 1e-4,
+                                          status);
+display_precision_report(config, report);
+*/
+PrecisionReport precision_report(const struct Configuration *config,
+      size_t num, const double *const *params, double tolerance,
+      unsigned char *status) {
+   // Check if the parameters of report are consistent.
+   const struct Screening *screening = find_screening(config);
+   assert (screening != NULL && tolerance >= 0);
+   // Create report object.
+   PrecisionReport report = {num, 0, tolerance, {0}, {0}};
+   // Block columns of both precisions.
+   float fparams[MAX_PARAMS][PRECISION_BLOCK];
+   float fresults[MAX_RESULTS][PRECISION_BLOCK];
+   double dresults[MAX_RESULTS][PRECISION_BLOCK];
+   const float *fp[MAX_PARAMS];
+   const double *dp[MAX_PARAMS];
+   float *fr[MAX_RESULTS];
+   double *dr[MAX_RESULTS];
+   for (size_t k=0; k<MAX_RESULTS; k++) {
+      fr[k] = fresults[k];
+      dr[k] = dresults[k];
+   }
+   for (size_t i=0; i<num; i+=PRECISION_BLOCK) {
+      size_t block = (num - i < PRECISION_BLOCK) ? num - i :
+                     PRECISION_BLOCK;
+      // Evaluate the block in both precisions.
+      for (size_t j=0; j<config->nparams; j++) {
+         for (size_t b=0; b<block; b++)
+            fparams[j][b] = (float) params[j][i + b];
+         fp[j] = fparams[j];
+         dp[j] = params[j] + i;
+      }
+      screening->evaluate(block, fp, fr);
+      config->evaluate(block, dp, dr);
+      // Find the relative errors of fields.
+      for (size_t b=0; b<block; b++) {
+         int outside = 0;
+         for (size_t k=0; k<config->nresults; k++) {
+            double x = fresults[k][b], y = dresults[k][b];
+            double error = (isnan(x) && isnan(y)) ? 0 :
+                           (x == y) ? 0 : fabs(x - y) / fabs(y);
+            if (isnan(error)) error = INFINITY;
+            if (error > report.max_error[k]) {
+               report.max_error[k] = error;
+               report.worst[k] = i + b;
+            }
+            outside |= !(error <= tolerance);
+         }
+         report.outside += outside;
+         if (status != NULL) status[i + b] = outside;
+      }
+   }
+
+   return report;
+}
+
+/* Display the error report of float evaluations of 'config'. */
+void display_precision_report(const struct Configuration *config,
+                              PrecisionReport report) {
+   printf("%s: %zu of %zu designs outside %.3g\n", config->name,
+          report.outside, report.num, report.tolerance);
+   for (size_t k=0; k<config->nresults; k++)
+      printf("%s: %.3e (design %zu)\n", config->results[k],
+             report.max_error[k], report.worst[k]);
+}
+
+#endif
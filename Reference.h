@@ -0,0 +1,554 @@
+/* Compile-Time Reference Designs
+
+Firmware tables embed fixed reference designs (like the documented
+22 V / 39k / 3.9k / 10k / 1.5k / beta=100 voltage-divider BJT). The
+'dc_*()' and 'ac_*()' functions are evaluated at run time, so their
+results can't initialize a constant table or be checked by the
+compiler. So, this source file restates each of them (and the
+helpers '_Rth_()', '_Eth_()', '_parallel_()', '_gm_factor_()' and
+'_drain_current_()') as macros which are constant expressions. A
+reference design costs nothing at run time and a '_Static_assert'
+fails the build if it leaves the active region.
+
+static const BJT_DCAnalysis reference = REF_BJT_DC_VOLTAGE_DIVIDER(
+      22.0, 39000.0, 3900.0, 10000.0, 1500.0, 100.0);
+_Static_assert(REF_BJT_ACTIVE_VOLTAGE_DIVIDER(22.0, 39000.0, 3900.0,
+      10000.0, 1500.0, 100.0), "reference isn't in the active region");
+
+IMPORTANT NOTES:
+----------------
+
+1. The macros evaluate the same operations in the same order as the
+functions, so the results are bit-identical to them (also MOSFET
+results, whose float roundings are restated).
+2. Arguments are evaluated many times, so give only constants (or
+expressions without side effects). Unlike parameters of functions,
+they aren't converted to double, so write 22.0 (not 22) or else
+integer divisions are done.
+3. Floating comparisons in '_Static_assert' and the constant folding
+of 'sqrt()' are GCC and Clang extensions ('__builtin_sqrt()'). With
+other compilers, the macros still work at run time.
+4. 'REF_*_DC_*()' and 'REF_*_AC_*()' are initializers of the result
+structures, the phase of AC results is included. Region checks are
+integer expressions.
+5. The active region of BJT is a forward-biased base-emitter (Ib > 0)
+and a reverse-biased base-collector (Vbc < 0) junction. FETs are in
+the saturation (pinch-off) region if the channel is on and 'Vds' is
+at least 'Vgs - Vp' (or 'Vgs - Vgsth').
+
+EXISTING MACROS:
+----------------
+
++ Helpers (REF_RTH, REF_ETH, REF_PARALLEL, REF_GM_FACTOR,
+REF_DRAIN_CURRENT)
++ BJT (REF_BJT_DC_*, REF_BJT_AC_*, REF_BJT_ACTIVE_*)
++ JFET (REF_JFET_DC_*, REF_JFET_AC_*, REF_JFET_ACTIVE_*)
++ MOSFET (REF_MOSFET_DC_*, REF_MOSFET_AC_*, REF_MOSFET_ACTIVE_*)
+*/
+
+#ifndef REFERENCE_H
+#define REFERENCE_H
+
+// Libraries:
+#include <math.h>
+#include "BJT.h"
+#include "JFET.h"
+#include "MOSFET.h"
+
+// Math functions which are folded in constant expressions:
+#if defined(__GNUC__) || defined(__clang__)
+#define REF_SQRT(x) __builtin_sqrt(x)
+#define REF_COPYSIGN(x, y) __builtin_copysign(x, y)
+#define REF_FABS(x) __builtin_fabs(x)
+#else
+#define REF_SQRT(x) sqrt(x)
+#define REF_COPYSIGN(x, y) copysign(x, y)
+#define REF_FABS(x) fabs(x)
+#endif
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+// Rth and Eth of voltage dividers (like _Rth_() and _Eth_()):
+#define REF_RTH(R1, R2) (1 / (1 / (R1) + 1 / (R2)))
+#define REF_ETH(Vcc, R1, R2) ((Vcc) * ((R2) / ((R1) + (R2))))
+
+// Parallel resultant of FETs (like _parallel_()):
+#define REF_PARALLEL(R1, R2) (1.0 / (1.0 / (R1) + 1.0 / (R2)))
+
+// Transconductance factor (like _gm_factor_()):
+#define REF_GM_FACTOR(Idss, Vp, Vgs) \
+   ((2.0 * (Idss) / REF_FABS(Vp)) * (1.0 - (Vgs) / (Vp)))
+
+// Selected drain current of a quadratic (like _drain_current_()):
+#define _REF_Q_(a, b, c) \
+   (-0.5 * ((b) + REF_COPYSIGN(REF_SQRT(((b) * (b)) - \
+                                        (4 * (a) * (c))), (b))))
+#define _REF_ROOT1_(a, b, c) (_REF_Q_(a, b, c) / (a))
+#define _REF_ROOT2_(a, b, c) ((c) / _REF_Q_(a, b, c))
+#define _REF_LOW_(a, b, c) \
+   ((_REF_ROOT1_(a, b, c) < _REF_ROOT2_(a, b, c)) ? \
+    _REF_ROOT1_(a, b, c) : _REF_ROOT2_(a, b, c))
+#define _REF_HIGH_(a, b, c) \
+   ((_REF_ROOT1_(a, b, c) < _REF_ROOT2_(a, b, c)) ? \
+    _REF_ROOT2_(a, b, c) : _REF_ROOT1_(a, b, c))
+#define REF_DRAIN_CURRENT(a, b, c) \
+   ((_REF_LOW_(a, b, c) >= 0) ? _REF_LOW_(a, b, c) : \
+    REF_FABS(_REF_HIGH_(a, b, c)))
+
+/* --------------------------------------------------------------- */
+/* ------------------------ BJT Definations ---------------------- */
+/* --------------------------------------------------------------- */
+
+// Common-emitter DC results from 'Ib' (fixed-bias has Re = 0):
+#define _REF_BJT_IC_(Ib, beta) ((beta) * (Ib))
+#define _REF_BJT_IE_(Ib, beta) (((beta) + 1) * (Ib))
+#define _REF_BJT_VCE_(Vcc, Ib, beta, Rc, Re) \
+   ((Vcc) - _REF_BJT_IC_(Ib, beta) * ((Rc) + (Re)))
+#define _REF_BJT_VE_(Ib, beta, Re) (_REF_BJT_IE_(Ib, beta) * (Re))
+#define _REF_BJT_VC_(Vcc, Ib, beta, Rc, Re) \
+   (_REF_BJT_VCE_(Vcc, Ib, beta, Rc, Re) + _REF_BJT_VE_(Ib, beta, Re))
+#define _REF_BJT_VB_(Ib, beta, Re) (Vbe + _REF_BJT_VE_(Ib, beta, Re))
+#define _REF_BJT_VBC_(Vcc, Ib, beta, Rc, Re) \
+   (_REF_BJT_VB_(Ib, beta, Re) - _REF_BJT_VC_(Vcc, Ib, beta, Rc, Re))
+#define _REF_BJT_DC_(Vcc, ib, beta, Rc, Re) { \
+   .Ib = (ib), .Ic = _REF_BJT_IC_(ib, beta), \
+   .Ie = _REF_BJT_IE_(ib, beta), .Icsat = (Vcc) / ((Rc) + (Re)), \
+   .Vce = _REF_BJT_VCE_(Vcc, ib, beta, Rc, Re), \
+   .Vc = _REF_BJT_VC_(Vcc, ib, beta, Rc, Re), \
+   .Ve = _REF_BJT_VE_(ib, beta, Re), .Vb = _REF_BJT_VB_(ib, beta, Re), \
+   .Vbc = _REF_BJT_VBC_(Vcc, ib, beta, Rc, Re)}
+#define _REF_BJT_ACTIVE_(Vcc, Ib, beta, Rc, Re) \
+   ((Ib) > 0 && _REF_BJT_VBC_(Vcc, Ib, beta, Rc, Re) < 0)
+
+// Base currents of common-emitter configurations:
+#define _REF_BJT_IB_FIXED_BIAS_(Vcc, Rb) (((Vcc) - Vbe) / (Rb))
+#define _REF_BJT_IB_EMITTER_BIAS_(Vcc, Rb, Re, beta) \
+   (((Vcc) - Vbe) / ((Rb) + ((beta) + 1) * (Re)))
+#define _REF_BJT_IB_VOLTAGE_DIVIDER_(Vcc, Rb1, Rb2, Re, beta) \
+   ((REF_ETH(Vcc, Rb1, Rb2) - Vbe) / \
+    (REF_RTH(Rb1, Rb2) + ((beta) + 1) * (Re)))
+#define _REF_BJT_IB_COLLECTOR_FEEDBACK_(Vcc, Rf, Rc, Re, beta) \
+   (((Vcc) - Vbe) / ((Rf) + (beta) * ((Rc) + (Re))))
+
+/* DC analyses of common-emitter configurations (like
+bjt_dc_fixed_bias(), bjt_dc_emitter_bias(), bjt_dc_voltage_divider()
+and bjt_dc_collector_feedback()). */
+#define REF_BJT_DC_FIXED_BIAS(Vcc, Rb, Rc, beta) \
+   _REF_BJT_DC_(Vcc, _REF_BJT_IB_FIXED_BIAS_(Vcc, Rb), beta, Rc, 0)
+#define REF_BJT_DC_EMITTER_BIAS(Vcc, Rb, Rc, Re, beta) \
+   _REF_BJT_DC_(Vcc, _REF_BJT_IB_EMITTER_BIAS_(Vcc, Rb, Re, beta), \
+                beta, Rc, Re)
+#define REF_BJT_DC_VOLTAGE_DIVIDER(Vcc, Rb1, Rb2, Rc, Re, beta) \
+   _REF_BJT_DC_(Vcc, _REF_BJT_IB_VOLTAGE_DIVIDER_(Vcc, Rb1, Rb2, Re, \
+                beta), beta, Rc, Re)
+#define REF_BJT_DC_COLLECTOR_FEEDBACK(Vcc, Rf, Rc, Re, beta) \
+   _REF_BJT_DC_(Vcc, _REF_BJT_IB_COLLECTOR_FEEDBACK_(Vcc, Rf, Rc, Re, \
+                beta), beta, Rc, Re)
+
+/* Active regions of common-emitter configurations. */
+#define REF_BJT_ACTIVE_FIXED_BIAS(Vcc, Rb, Rc, beta) \
+   _REF_BJT_ACTIVE_(Vcc, _REF_BJT_IB_FIXED_BIAS_(Vcc, Rb), beta, Rc, 0)
+#define REF_BJT_ACTIVE_EMITTER_BIAS(Vcc, Rb, Rc, Re, beta) \
+   _REF_BJT_ACTIVE_(Vcc, _REF_BJT_IB_EMITTER_BIAS_(Vcc, Rb, Re, beta), \
+                    beta, Rc, Re)
+#define REF_BJT_ACTIVE_VOLTAGE_DIVIDER(Vcc, Rb1, Rb2, Rc, Re, beta) \
+   _REF_BJT_ACTIVE_(Vcc, _REF_BJT_IB_VOLTAGE_DIVIDER_(Vcc, Rb1, Rb2, \
+                    Re, beta), beta, Rc, Re)
+#define REF_BJT_ACTIVE_COLLECTOR_FEEDBACK(Vcc, Rf, Rc, Re, beta) \
+   _REF_BJT_ACTIVE_(Vcc, _REF_BJT_IB_COLLECTOR_FEEDBACK_(Vcc, Rf, Rc, \
+                    Re, beta), beta, Rc, Re)
+
+/* DC analysis of emitter-follower configuration (like
+bjt_dc_emitter_follower()). */
+#define _REF_BJT_IERE_FOLLOWER_(Vee, Rb, Re, beta) \
+   (_REF_BJT_IE_(_REF_BJT_IB_EMITTER_BIAS_(Vee, Rb, Re, beta), beta) * \
+    Re)
+#define _REF_BJT_VBC_FOLLOWER_(Vee, Rb, Re, beta) \
+   ((Vbe + (_REF_BJT_IERE_FOLLOWER_(Vee, Rb, Re, beta) + (Vee))) - \
+    (((Vee) - _REF_BJT_IERE_FOLLOWER_(Vee, Rb, Re, beta)) + \
+     (_REF_BJT_IERE_FOLLOWER_(Vee, Rb, Re, beta) + (Vee))))
+#define REF_BJT_DC_EMITTER_FOLLOWER(Vee, Rb, Re, beta) { \
+   .Ib = _REF_BJT_IB_EMITTER_BIAS_(Vee, Rb, Re, beta), \
+   .Ic = _REF_BJT_IC_(_REF_BJT_IB_EMITTER_BIAS_(Vee, Rb, Re, beta), \
+                      beta), \
+   .Ie = _REF_BJT_IE_(_REF_BJT_IB_EMITTER_BIAS_(Vee, Rb, Re, beta), \
+                      beta), \
+   .Icsat = -1.0, \
+   .Vce = (Vee) - _REF_BJT_IERE_FOLLOWER_(Vee, Rb, Re, beta), \
+   .Vc = ((Vee) - _REF_BJT_IERE_FOLLOWER_(Vee, Rb, Re, beta)) + \
+         (_REF_BJT_IERE_FOLLOWER_(Vee, Rb, Re, beta) + (Vee)), \
+   .Ve = _REF_BJT_IERE_FOLLOWER_(Vee, Rb, Re, beta) + (Vee), \
+   .Vb = Vbe + (_REF_BJT_IERE_FOLLOWER_(Vee, Rb, Re, beta) + (Vee)), \
+   .Vbc = _REF_BJT_VBC_FOLLOWER_(Vee, Rb, Re, beta)}
+#define REF_BJT_ACTIVE_EMITTER_FOLLOWER(Vee, Rb, Re, beta) \
+   (_REF_BJT_IB_EMITTER_BIAS_(Vee, Rb, Re, beta) > 0 && \
+    _REF_BJT_VBC_FOLLOWER_(Vee, Rb, Re, beta) < 0)
+
+/* DC analysis of common-base configuration (like
+bjt_dc_common_base()). */
+#define _REF_BJT_IE_BASE_(Vee, Re) (((Vee) - Vbe) / (Re))
+#define _REF_BJT_IC_BASE_(Vee, Re, beta) \
+   ((_REF_BJT_IE_BASE_(Vee, Re) / ((beta) + 1)) * (beta))
+#define _REF_BJT_VBC_BASE_(Vcc, Vee, Rc, Re, beta) \
+   (-1 * ((Vcc) - _REF_BJT_IC_BASE_(Vee, Re, beta) * (Rc)))
+#define REF_BJT_DC_COMMON_BASE(Vcc, Vee, Rc, Re, beta) { \
+   .Ib = _REF_BJT_IE_BASE_(Vee, Re) / ((beta) + 1), \
+   .Ic = _REF_BJT_IC_BASE_(Vee, Re, beta), \
+   .Ie = _REF_BJT_IE_BASE_(Vee, Re), .Icsat = -1.0, \
+   .Vce = (Vee) + (Vcc) - _REF_BJT_IE_BASE_(Vee, Re) * ((Rc) + (Re)), \
+   .Vc = -1.0, .Ve = -1.0, .Vb = -1.0, \
+   .Vbc = _REF_BJT_VBC_BASE_(Vcc, Vee, Rc, Re, beta)}
+#define REF_BJT_ACTIVE_COMMON_BASE(Vcc, Vee, Rc, Re, beta) \
+   (_REF_BJT_IE_BASE_(Vee, Re) > 0 && \
+    _REF_BJT_VBC_BASE_(Vcc, Vee, Rc, Re, beta) < 0)
+
+/* DC analysis of miscellaneous-bias configuration (like
+bjt_dc_miscellaneous_bias()). */
+#define _REF_BJT_IB_MISCELLANEOUS_(Vcc, Rb, Rc, beta) \
+   (((Vcc) - Vbe) / ((Rb) + (beta) * (Rc)))
+#define _REF_BJT_VCE_MISCELLANEOUS_(Vcc, Rb, Rc, beta) \
+   ((Vcc) - (_REF_BJT_IE_(_REF_BJT_IB_MISCELLANEOUS_(Vcc, Rb, Rc, \
+                          beta), beta) * (Rc)))
+#define REF_BJT_DC_MISCELLANEOUS_BIAS(Vcc, Rb, Rc, beta) { \
+   .Ib = _REF_BJT_IB_MISCELLANEOUS_(Vcc, Rb, Rc, beta), \
+   .Ic = _REF_BJT_IC_(_REF_BJT_IB_MISCELLANEOUS_(Vcc, Rb, Rc, beta), \
+                      beta), \
+   .Ie = _REF_BJT_IE_(_REF_BJT_IB_MISCELLANEOUS_(Vcc, Rb, Rc, beta), \
+                      beta), \
+   .Icsat = -1.0, .Vce = _REF_BJT_VCE_MISCELLANEOUS_(Vcc, Rb, Rc, beta), \
+   .Vc = _REF_BJT_VCE_MISCELLANEOUS_(Vcc, Rb, Rc, beta) + 0, \
+   .Ve = 0, .Vb = Vbe + 0, \
+   .Vbc = (Vbe + 0) - (_REF_BJT_VCE_MISCELLANEOUS_(Vcc, Rb, Rc, beta) + \
+                       0)}
+#define REF_BJT_ACTIVE_MISCELLANEOUS_BIAS(Vcc, Rb, Rc, beta) \
+   (_REF_BJT_IB_MISCELLANEOUS_(Vcc, Rb, Rc, beta) > 0 && \
+    (Vbe + 0) - (_REF_BJT_VCE_MISCELLANEOUS_(Vcc, Rb, Rc, beta) + 0) < 0)
+
+// AC results at the operating point of 'r_e' (like _bjt_ac_*_()):
+#define _REF_BJT_RE_(Ib, beta) (0.026 / _REF_BJT_IE_(Ib, beta))
+#define _REF_BJT_AC_BYPASSED_(r_e, Rb, Rc, beta, ro) { \
+   .re = (r_e), .Zi = REF_RTH(Rb, ((beta) * (r_e))), \
+   .Zo = REF_RTH(Rc, ro), .Av = -1 * REF_RTH(Rc, ro) / (r_e), \
+   .phase = "Out of phase"}
+#define _REF_BJT_ZB_(re, Rc, Re, beta, ro) \
+   ((beta) * (re) + ((((beta) + 1) + ((Rc) / (ro))) / \
+                     (1 + ((Rc) + (Re)) / (ro))) * (Re))
+#define _REF_BJT_AC_UNBYPASSED_(r_e, Rb, Rc, Re, beta, ro) { \
+   .re = (r_e), .Zi = REF_RTH(Rb, _REF_BJT_ZB_(r_e, Rc, Re, beta, ro)), \
+   .Zo = REF_RTH(Rc, (ro) + ((beta) * ((ro) + (r_e))) / \
+                 (1 + ((beta) * (r_e)) / (Re))), \
+   .Av = ((-1 * ((beta) * (Rc)) / _REF_BJT_ZB_(r_e, Rc, Re, beta, ro)) * \
+          (1 + ((r_e) / (ro))) + ((Rc) / (ro))) / (1 + ((Rc) / (ro))), \
+   .phase = "Out of phase"}
+
+/* AC analyses of common-emitter configurations (like
+bjt_ac_fixed_bias(), bjt_ac_emitter_bias() and
+bjt_ac_voltage_divider() with "bypassed" or "unbypassed"). */
+#define REF_BJT_AC_FIXED_BIAS(Vcc, Rb, Rc, beta, ro) \
+   _REF_BJT_AC_BYPASSED_(_REF_BJT_RE_(_REF_BJT_IB_FIXED_BIAS_(Vcc, Rb), \
+                         beta), Rb, Rc, beta, ro)
+#define REF_BJT_AC_EMITTER_BIAS(Vcc, Rb, Rc, Re, beta, ro) \
+   _REF_BJT_AC_UNBYPASSED_(_REF_BJT_RE_(_REF_BJT_IB_EMITTER_BIAS_(Vcc, \
+         Rb, Re, beta), beta), Rb, Rc, Re, beta, ro)
+#define REF_BJT_AC_VOLTAGE_DIVIDER_BYPASSED(Vcc, Rb1, Rb2, Rc, Re, beta, \
+                                            ro) \
+   _REF_BJT_AC_BYPASSED_(_REF_BJT_RE_(_REF_BJT_IB_VOLTAGE_DIVIDER_(Vcc, \
+         Rb1, Rb2, Re, beta), beta), REF_RTH(Rb1, Rb2), Rc, beta, ro)
+#define REF_BJT_AC_VOLTAGE_DIVIDER_UNBYPASSED(Vcc, Rb1, Rb2, Rc, Re, \
+                                              beta, ro) \
+   _REF_BJT_AC_UNBYPASSED_(_REF_BJT_RE_(_REF_BJT_IB_VOLTAGE_DIVIDER_( \
+         Vcc, Rb1, Rb2, Re, beta), beta), REF_RTH(Rb1, Rb2), Rc, Re, \
+         beta, ro)
+
+/* AC analysis of collector-feedback configuration (like
+bjt_ac_collector_feedback()). */
+#define _REF_BJT_RE_FEEDBACK_(Vcc, Rf, Rc, beta) \
+   _REF_BJT_RE_(((Vcc) - Vbe) / ((Rf) + (beta) * (Rc)), beta)
+#define REF_BJT_AC_COLLECTOR_FEEDBACK(Vcc, Rf, Rc, beta, ro) { \
+   .re = _REF_BJT_RE_FEEDBACK_(Vcc, Rf, Rc, beta), \
+   .Zi = (1 + (REF_RTH(Rc, ro) / (Rf))) / \
+         (((1 / ((beta) * _REF_BJT_RE_FEEDBACK_(Vcc, Rf, Rc, beta))) + \
+           (1 / (Rf))) + \
+          REF_RTH(Rc, ro) / ((beta) * \
+             _REF_BJT_RE_FEEDBACK_(Vcc, Rf, Rc, beta) * (Rf)) + \
+          REF_RTH(Rc, ro) / ((Rf) * \
+             _REF_BJT_RE_FEEDBACK_(Vcc, Rf, Rc, beta))), \
+   .Zo = 1 / (1 / (ro) + 1 / (Rc) + 1 / (Rf)), \
+   .Av = -1 * ((Rf) / (REF_RTH(Rc, ro) + (Rf))) * \
+         (REF_RTH(Rc, ro) / _REF_BJT_RE_FEEDBACK_(Vcc, Rf, Rc, beta)), \
+   .phase = "Out of phase"}
+
+/* AC analysis of collector-dc-feedback configuration (like
+bjt_ac_collector_dc_feedback()). */
+#define _REF_BJT_RE_DC_FEEDBACK_(Vcc, Rf1, Rf2, Rc, beta) \
+   _REF_BJT_RE_(((Vcc) - Vbe) / ((Rf1) + (Rf2) + ((beta) * (Rc))), beta)
+#define _REF_BJT_ZO_DC_FEEDBACK_(Rf2, Rc, ro) \
+   (1 / (1 / (Rc) + 1 / (Rf2) + 1 / (ro)))
+#define REF_BJT_AC_COLLECTOR_DC_FEEDBACK(Vcc, Rf1, Rf2, Rc, beta, ro) { \
+   .re = _REF_BJT_RE_DC_FEEDBACK_(Vcc, Rf1, Rf2, Rc, beta), \
+   .Zi = REF_RTH(Rf1, ((beta) * \
+         _REF_BJT_RE_DC_FEEDBACK_(Vcc, Rf1, Rf2, Rc, beta))), \
+   .Zo = _REF_BJT_ZO_DC_FEEDBACK_(Rf2, Rc, ro), \
+   .Av = -1 * _REF_BJT_ZO_DC_FEEDBACK_(Rf2, Rc, ro) / \
+         _REF_BJT_RE_DC_FEEDBACK_(Vcc, Rf1, Rf2, Rc, beta), \
+   .phase = "Out of phase"}
+
+/* AC analysis of emitter-follower configuration (like
+bjt_ac_emitter_follower()). */
+#define _REF_BJT_RE_FOLLOWER_(Vcc, Rb, Re, beta) \
+   _REF_BJT_RE_(_REF_BJT_IB_EMITTER_BIAS_(Vcc, Rb, Re, beta), beta)
+#define _REF_BJT_ZB_FOLLOWER_(Vcc, Rb, Re, beta, ro) \
+   (((beta) * _REF_BJT_RE_FOLLOWER_(Vcc, Rb, Re, beta)) + \
+    ((((beta) + 1) * (Re)) / (1 + ((Re) / (ro)))))
+#define REF_BJT_AC_EMITTER_FOLLOWER(Vcc, Rb, Re, beta, ro) { \
+   .re = _REF_BJT_RE_FOLLOWER_(Vcc, Rb, Re, beta), \
+   .Zi = 1 / (1 / (Rb) + 1 / _REF_BJT_ZB_FOLLOWER_(Vcc, Rb, Re, beta, \
+                                                   ro)), \
+   .Zo = 1 / (1 / (ro) + 1 / (Re) + 1 / (((beta) * \
+         _REF_BJT_RE_FOLLOWER_(Vcc, Rb, Re, beta)) / ((beta) + 1))), \
+   .Av = (((beta) + 1) * (Re) / _REF_BJT_ZB_FOLLOWER_(Vcc, Rb, Re, \
+         beta, ro)) / (1 + ((Re) / (ro))), \
+   .phase = "In phase"}
+
+/* AC analysis of common-base configuration (like
+bjt_ac_common_base()). */
+#define REF_BJT_AC_COMMON_BASE(Vcc, Vee, Rc, Re, alpha) { \
+   .re = 0.026 / _REF_BJT_IE_BASE_(Vee, Re), \
+   .Zi = REF_RTH(Re, 0.026 / _REF_BJT_IE_BASE_(Vee, Re)), \
+   .Zo = (Rc), \
+   .Av = (alpha) * (Rc) / (0.026 / _REF_BJT_IE_BASE_(Vee, Re)), \
+   .phase = "In phase"}
+
+/* --------------------------------------------------------------- */
+/* ----------------------- JFET Definations ---------------------- */
+/* --------------------------------------------------------------- */
+
+// Saturation region of an n-channel JFET:
+#define _REF_JFET_ACTIVE_(Id, Vgs, Vds, Vp) \
+   ((Id) > 0 && (Vgs) > (Vp) && (Vds) >= (Vgs) - (Vp))
+
+/* DC and AC analyses of fixed-bias configuration (like
+jfet_dc_fixed_bias() and jfet_ac_fixed_bias()). */
+#define _REF_JFET_ID_FIXED_(Vgg, Idss, Vp) \
+   ((Idss) * (1.0 - (-1 * (Vgg)) / (Vp)) * (1.0 - (-1 * (Vgg)) / (Vp)))
+#define REF_JFET_DC_FIXED_BIAS(Vdd, Vgg, Rd, Idss, Vp) { \
+   .Id = _REF_JFET_ID_FIXED_(Vgg, Idss, Vp), .Vgs = -1 * (Vgg), \
+   .Vds = (Vdd) - _REF_JFET_ID_FIXED_(Vgg, Idss, Vp) * (Rd), .Vs = 0, \
+   .Vd = (Vdd) - _REF_JFET_ID_FIXED_(Vgg, Idss, Vp) * (Rd), \
+   .Vg = -1 * (Vgg)}
+#define REF_JFET_ACTIVE_FIXED_BIAS(Vdd, Vgg, Rd, Idss, Vp) \
+   _REF_JFET_ACTIVE_(_REF_JFET_ID_FIXED_(Vgg, Idss, Vp), -1 * (Vgg), \
+         (Vdd) - _REF_JFET_ID_FIXED_(Vgg, Idss, Vp) * (Rd), Vp)
+#define REF_JFET_AC_FIXED_BIAS(Vdd, Vgg, Rg, Rd, Idss, Vp, rd) { \
+   .gm = REF_GM_FACTOR(Idss, Vp, -1 * (Vgg)), .Zi = (Rg), \
+   .Zo = REF_PARALLEL(Rd, rd), \
+   .Av = -1.0 * REF_GM_FACTOR(Idss, Vp, -1 * (Vgg)) * \
+         REF_PARALLEL(Rd, rd), \
+   .phase = "Out of phase"}
+
+/* DC and AC analyses of self-bias configuration (like
+jfet_dc_self_bias() and jfet_ac_self_bias()). */
+#define _REF_JFET_ID_SELF_(Rs, Idss, Vp) \
+   REF_DRAIN_CURRENT((Rs) * (Rs) * (Idss) / (Vp) / (Vp), \
+                     (Idss) * 2.0 * (Rs) / (Vp) - 1, Idss)
+#define _REF_JFET_GM_SELF_(Rs, Idss, Vp) \
+   REF_GM_FACTOR(Idss, Vp, -1 * _REF_JFET_ID_SELF_(Rs, Idss, Vp) * (Rs))
+#define REF_JFET_DC_SELF_BIAS(Vdd, Rd, Rs, Idss, Vp) { \
+   .Id = _REF_JFET_ID_SELF_(Rs, Idss, Vp), \
+   .Vgs = -1 * _REF_JFET_ID_SELF_(Rs, Idss, Vp) * (Rs), \
+   .Vds = (Vdd) - _REF_JFET_ID_SELF_(Rs, Idss, Vp) * ((Rs) + (Rd)), \
+   .Vs = _REF_JFET_ID_SELF_(Rs, Idss, Vp) * (Rs), \
+   .Vd = ((Vdd) - _REF_JFET_ID_SELF_(Rs, Idss, Vp) * ((Rs) + (Rd))) + \
+         _REF_JFET_ID_SELF_(Rs, Idss, Vp) * (Rs), \
+   .Vg = 0}
+#define REF_JFET_ACTIVE_SELF_BIAS(Vdd, Rd, Rs, Idss, Vp) \
+   _REF_JFET_ACTIVE_(_REF_JFET_ID_SELF_(Rs, Idss, Vp), \
+         -1 * _REF_JFET_ID_SELF_(Rs, Idss, Vp) * (Rs), \
+         (Vdd) - _REF_JFET_ID_SELF_(Rs, Idss, Vp) * ((Rs) + (Rd)), Vp)
+#define REF_JFET_AC_SELF_BIAS(Vdd, Rg, Rd, Rs, Idss, Vp, rd) { \
+   .gm = _REF_JFET_GM_SELF_(Rs, Idss, Vp), .Zi = (Rg), \
+   .Zo = (1 + _REF_JFET_GM_SELF_(Rs, Idss, Vp) * (Rs) + (Rs) / (rd)) * \
+         (Rd) / (1 + _REF_JFET_GM_SELF_(Rs, Idss, Vp) * (Rs) + \
+                 (Rs) / (rd) + (Rd) / (rd)), \
+   .Av = -1.0 * (_REF_JFET_GM_SELF_(Rs, Idss, Vp) * (Rd)) / \
+         (1.0 + _REF_JFET_GM_SELF_(Rs, Idss, Vp) * (Rs) + \
+          ((Rd) + (Rs)) / (rd)), \
+   .phase = "Out of phase"}
+
+/* DC and AC analyses of voltage-divider configuration (like
+jfet_dc_voltage_divider() and jfet_ac_voltage_divider()). */
+#define _REF_JFET_VG_(Vdd, Rg1, Rg2) (((Rg2) * (Vdd)) / ((Rg1) + (Rg2)))
+#define _REF_JFET_ID_DIVIDER_(Vg, Rs, Idss, Vp) \
+   REF_DRAIN_CURRENT((Rs) * (Rs) * (Idss) / (Vp) / (Vp), \
+         (2.0 * (Rs) * (Idss) / (Vp)) - \
+         (2.0 * (Vg) * (Rs) * (Idss) / (Vp) / (Vp)) - 1, \
+         (Idss) * (1.0 - (2.0 * (Vg) / (Vp)) + \
+                   ((Vg) * (Vg) / (Vp) / (Vp))))
+#define _REF_JFET_ID_VOLTAGE_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idss, Vp) \
+   _REF_JFET_ID_DIVIDER_(_REF_JFET_VG_(Vdd, Rg1, Rg2), Rs, Idss, Vp)
+#define _REF_JFET_VGS_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idss, Vp) \
+   (_REF_JFET_VG_(Vdd, Rg1, Rg2) - \
+    _REF_JFET_ID_VOLTAGE_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idss, Vp) * (Rs))
+#define REF_JFET_DC_VOLTAGE_DIVIDER(Vdd, Rg1, Rg2, Rd, Rs, Idss, Vp) { \
+   .Id = _REF_JFET_ID_VOLTAGE_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idss, Vp), \
+   .Vgs = _REF_JFET_VGS_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idss, Vp), \
+   .Vds = (Vdd) - _REF_JFET_ID_VOLTAGE_DIVIDER_(Vdd, Rg1, Rg2, Rs, \
+         Idss, Vp) * ((Rs) + (Rd)), \
+   .Vs = _REF_JFET_ID_VOLTAGE_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idss, Vp) * \
+         Rs, \
+   .Vd = (Vdd) - _REF_JFET_ID_VOLTAGE_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idss, \
+         Vp) * (Rd), \
+   .Vg = _REF_JFET_VG_(Vdd, Rg1, Rg2)}
+#define REF_JFET_ACTIVE_VOLTAGE_DIVIDER(Vdd, Rg1, Rg2, Rd, Rs, Idss, Vp) \
+   _REF_JFET_ACTIVE_(_REF_JFET_ID_VOLTAGE_DIVIDER_(Vdd, Rg1, Rg2, Rs, \
+         Idss, Vp), _REF_JFET_VGS_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idss, Vp), \
+         (Vdd) - _REF_JFET_ID_VOLTAGE_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idss, \
+         Vp) * ((Rs) + (Rd)), Vp)
+#define REF_JFET_AC_VOLTAGE_DIVIDER(Vdd, Rg1, Rg2, Rd, Rs, Idss, Vp, \
+                                    rd) { \
+   .gm = REF_GM_FACTOR(Idss, Vp, _REF_JFET_VGS_DIVIDER_(Vdd, Rg1, Rg2, \
+         Rs, Idss, Vp)), \
+   .Zi = REF_PARALLEL(Rg1, Rg2), .Zo = REF_PARALLEL(Rd, rd), \
+   .Av = -1 * REF_GM_FACTOR(Idss, Vp, _REF_JFET_VGS_DIVIDER_(Vdd, Rg1, \
+         Rg2, Rs, Idss, Vp)) * REF_PARALLEL(Rd, rd), \
+   .phase = "Out of phase"}
+
+/* DC and AC analyses of common-gate configuration (like
+jfet_dc_common_gate() and jfet_ac_common_gate()). */
+#define _REF_JFET_ID_GATE_(Vss, Rs, Idss, Vp) \
+   REF_DRAIN_CURRENT(((Rs) * (Rs)) * (Idss) / ((Vp) * (Vp)), \
+         2.0 * (Rs) * (Idss) / (Vp) + \
+         -2.0 * (Vss) * (Rs) * (Idss) / (Vp) / (Vp) - 1.0, \
+         (1.0 - 2.0 * (Vss) / (Vp) + (Vss) * (Vss) / (Vp) / (Vp)) * \
+         Idss)
+#define _REF_JFET_VGS_GATE_(Vss, Rs, Idss, Vp) \
+   ((Vss) - _REF_JFET_ID_GATE_(Vss, Rs, Idss, Vp) * (Rs))
+#define _REF_JFET_GM_GATE_(Vss, Rs, Idss, Vp) \
+   REF_GM_FACTOR(Idss, Vp, _REF_JFET_VGS_GATE_(Vss, Rs, Idss, Vp))
+#define REF_JFET_DC_COMMON_GATE(Vdd, Vss, Rd, Rs, Idss, Vp) { \
+   .Id = _REF_JFET_ID_GATE_(Vss, Rs, Idss, Vp), \
+   .Vgs = _REF_JFET_VGS_GATE_(Vss, Rs, Idss, Vp), \
+   .Vds = (Vdd) + (Vss) - _REF_JFET_ID_GATE_(Vss, Rs, Idss, Vp) * \
+          ((Rs) + (Rd)), \
+   .Vs = -(Vss) + _REF_JFET_ID_GATE_(Vss, Rs, Idss, Vp) * (Rs), \
+   .Vd = (Vdd) - _REF_JFET_ID_GATE_(Vss, Rs, Idss, Vp) * (Rd), \
+   .Vg = 0}
+#define REF_JFET_ACTIVE_COMMON_GATE(Vdd, Vss, Rd, Rs, Idss, Vp) \
+   _REF_JFET_ACTIVE_(_REF_JFET_ID_GATE_(Vss, Rs, Idss, Vp), \
+         _REF_JFET_VGS_GATE_(Vss, Rs, Idss, Vp), (Vdd) + (Vss) - \
+         _REF_JFET_ID_GATE_(Vss, Rs, Idss, Vp) * ((Rs) + (Rd)), Vp)
+#define REF_JFET_AC_COMMON_GATE(Vdd, Vss, Rd, Rs, Idss, Vp, rd) { \
+   .gm = _REF_JFET_GM_GATE_(Vss, Rs, Idss, Vp), \
+   .Zi = REF_PARALLEL(Rs, ((rd) + (Rd)) / \
+         (1 + _REF_JFET_GM_GATE_(Vss, Rs, Idss, Vp) * (rd))), \
+   .Zo = REF_PARALLEL(Rd, rd), \
+   .Av = (_REF_JFET_GM_GATE_(Vss, Rs, Idss, Vp) * (Rd) + (Rd) / (rd)) / \
+         (1 + (Rd) / (rd)), \
+   .phase = "In phase"}
+
+/* AC analysis of source-follower configuration (like
+jfet_ac_source_follower()). */
+#define REF_JFET_AC_SOURCE_FOLLOWER(Vdd, Vgs, Rg, Rs, Idss, Vp, rd) { \
+   .gm = REF_GM_FACTOR(Idss, Vp, Vgs), .Zi = (Rg), \
+   .Zo = REF_PARALLEL(rd, REF_PARALLEL(Rs, 1 / REF_GM_FACTOR(Idss, Vp, \
+                                                             Vgs))), \
+   .Av = (REF_GM_FACTOR(Idss, Vp, Vgs) * REF_PARALLEL(rd, Rs)) / \
+         (1.0 + REF_GM_FACTOR(Idss, Vp, Vgs) * REF_PARALLEL(rd, Rs)), \
+   .phase = "In phase"}
+
+/* --------------------------------------------------------------- */
+/* ---------------------- MOSFET Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+// MOSFET results are float, the DC analyses reuse the float 'k' and
+// 'Id' fields and the AC analyses reuse the float 'gm' and 'Zo'.
+#define _REF_MOSFET_K_(Idon, Vgson, Vgsth) \
+   ((Idon) / (((Vgson) - (Vgsth)) * ((Vgson) - (Vgsth))))
+#define _REF_MOSFET_ID_(k, Vg, Rs, Vgsth) \
+   REF_DRAIN_CURRENT((Rs) * (Rs) * (k), \
+         -2 * (k) * (Rs) * ((Vg) - (Vgsth)) - 1, \
+         (k) * ((Vgsth) - (Vg)) * ((Vgsth) - (Vg)))
+#define _REF_MOSFET_ACTIVE_(Id, Vgs, Vds, Vgsth) \
+   ((Id) > 0 && (Vgs) > (Vgsth) && (Vds) >= (Vgs) - (Vgsth))
+
+/* DC and AC analyses of drain-feedback configuration (like
+mosfet_dc_drain_feedback() and mosfet_ac_drain_feedback()). The
+loop is 'Vgs = Vdd - Id * Rd'. */
+#define _REF_MOSFET_ID_LOOP_(k, Vdd, Rd, Vgsth) \
+   REF_DRAIN_CURRENT((Rd) * (Rd) * (k), \
+         2 * (k) * (Rd) * ((Vgsth) - (Vdd)) - 1, \
+         (k) * ((Vgsth) - (Vdd)) * ((Vgsth) - (Vdd)))
+#define _REF_MOSFET_ID_FEEDBACK_(Vdd, Rd, Idon, Vgson, Vgsth) \
+   ((float) _REF_MOSFET_ID_LOOP_((float) _REF_MOSFET_K_(Idon, Vgson, \
+         Vgsth), Vdd, Rd, Vgsth))
+#define _REF_MOSFET_VGS_FEEDBACK_(Vdd, Rd, Idon, Vgson, Vgsth) \
+   ((float) ((Vdd) - _REF_MOSFET_ID_FEEDBACK_(Vdd, Rd, Idon, Vgson, \
+                                              Vgsth) * (Rd)))
+#define REF_MOSFET_DC_DRAIN_FEEDBACK(Vdd, Rg, Rd, Idon, Vgson, Vgsth) { \
+   .k = _REF_MOSFET_K_(Idon, Vgson, Vgsth), \
+   .Id = _REF_MOSFET_ID_FEEDBACK_(Vdd, Rd, Idon, Vgson, Vgsth), \
+   .Vgs = _REF_MOSFET_VGS_FEEDBACK_(Vdd, Rd, Idon, Vgson, Vgsth), \
+   .Vds = _REF_MOSFET_VGS_FEEDBACK_(Vdd, Rd, Idon, Vgson, Vgsth)}
+#define REF_MOSFET_ACTIVE_DRAIN_FEEDBACK(Vdd, Rg, Rd, Idon, Vgson, \
+                                         Vgsth) \
+   _REF_MOSFET_ACTIVE_(_REF_MOSFET_ID_FEEDBACK_(Vdd, Rd, Idon, Vgson, \
+         Vgsth), _REF_MOSFET_VGS_FEEDBACK_(Vdd, Rd, Idon, Vgson, Vgsth), \
+         _REF_MOSFET_VGS_FEEDBACK_(Vdd, Rd, Idon, Vgson, Vgsth), Vgsth)
+#define _REF_MOSFET_GM_FEEDBACK_(Vdd, Rd, Idon, Vgson, Vgsth) \
+   ((float) (2 * _REF_MOSFET_K_(Idon, Vgson, Vgsth) * \
+    (((Vdd) - _REF_MOSFET_ID_LOOP_(_REF_MOSFET_K_(Idon, Vgson, Vgsth), \
+      Vdd, Rd, Vgsth) * (Rd)) - (Vgsth))))
+#define REF_MOSFET_AC_DRAIN_FEEDBACK(Vdd, Rg, Rd, Idon, Vgson, Vgsth, \
+                                     rd) { \
+   .gm = _REF_MOSFET_GM_FEEDBACK_(Vdd, Rd, Idon, Vgson, Vgsth), \
+   .Zi = ((Rg) + REF_PARALLEL(rd, Rd)) / \
+         (1 + _REF_MOSFET_GM_FEEDBACK_(Vdd, Rd, Idon, Vgson, Vgsth) * \
+          REF_PARALLEL(rd, Rd)), \
+   .Zo = REF_PARALLEL(Rg, REF_PARALLEL(rd, Rd)), \
+   .Av = -1 * _REF_MOSFET_GM_FEEDBACK_(Vdd, Rd, Idon, Vgson, Vgsth) * \
+         (float) REF_PARALLEL(Rg, REF_PARALLEL(rd, Rd)), \
+   .phase = "Out of phase"}
+
+/* DC and AC analyses of voltage-divider configuration (like
+mosfet_dc_voltage_divider() and mosfet_ac_voltage_divider()). */
+#define _REF_MOSFET_VG_(Vdd, Rg1, Rg2) ((Rg2) * (Vdd) / ((Rg1) + (Rg2)))
+#define _REF_MOSFET_ID_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idon, Vgson, Vgsth) \
+   ((float) _REF_MOSFET_ID_((float) _REF_MOSFET_K_(Idon, Vgson, Vgsth), \
+         _REF_MOSFET_VG_(Vdd, Rg1, Rg2), Rs, Vgsth))
+#define _REF_MOSFET_VGS_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idon, Vgson, Vgsth) \
+   (_REF_MOSFET_VG_(Vdd, Rg1, Rg2) - _REF_MOSFET_ID_DIVIDER_(Vdd, Rg1, \
+         Rg2, Rs, Idon, Vgson, Vgsth) * (Rs))
+#define _REF_MOSFET_VDS_DIVIDER_(Vdd, Rg1, Rg2, Rd, Rs, Idon, Vgson, \
+                                 Vgsth) \
+   ((Vdd) - _REF_MOSFET_ID_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idon, Vgson, \
+         Vgsth) * ((Rs) + (Rd)))
+#define REF_MOSFET_DC_VOLTAGE_DIVIDER(Vdd, Rg1, Rg2, Rd, Rs, Idon, \
+                                      Vgson, Vgsth) { \
+   .k = _REF_MOSFET_K_(Idon, Vgson, Vgsth), \
+   .Id = _REF_MOSFET_ID_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idon, Vgson, Vgsth), \
+   .Vgs = _REF_MOSFET_VGS_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idon, Vgson, \
+                                   Vgsth), \
+   .Vds = _REF_MOSFET_VDS_DIVIDER_(Vdd, Rg1, Rg2, Rd, Rs, Idon, Vgson, \
+                                   Vgsth)}
+#define REF_MOSFET_ACTIVE_VOLTAGE_DIVIDER(Vdd, Rg1, Rg2, Rd, Rs, Idon, \
+                                          Vgson, Vgsth) \
+   _REF_MOSFET_ACTIVE_(_REF_MOSFET_ID_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idon, \
+         Vgson, Vgsth), (float) _REF_MOSFET_VGS_DIVIDER_(Vdd, Rg1, Rg2, \
+         Rs, Idon, Vgson, Vgsth), (float) _REF_MOSFET_VDS_DIVIDER_(Vdd, \
+         Rg1, Rg2, Rd, Rs, Idon, Vgson, Vgsth), Vgsth)
+#define _REF_MOSFET_GM_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idon, Vgson, Vgsth) \
+   ((float) (2 * _REF_MOSFET_K_(Idon, Vgson, Vgsth) * \
+    ((_REF_MOSFET_VG_(Vdd, Rg1, Rg2) - _REF_MOSFET_ID_( \
+      _REF_MOSFET_K_(Idon, Vgson, Vgsth), _REF_MOSFET_VG_(Vdd, Rg1, \
+      Rg2), Rs, Vgsth) * (Rs)) - (Vgsth))))
+#define REF_MOSFET_AC_VOLTAGE_DIVIDER(Vdd, Rg1, Rg2, Rd, Rs, Idon, \
+                                      Vgson, Vgsth, rd) { \
+   .gm = _REF_MOSFET_GM_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idon, Vgson, Vgsth), \
+   .Zi = REF_PARALLEL(Rg1, Rg2), .Zo = REF_PARALLEL(rd, Rd), \
+   .Av = -1 * _REF_MOSFET_GM_DIVIDER_(Vdd, Rg1, Rg2, Rs, Idon, Vgson, \
+         Vgsth) * (float) REF_PARALLEL(rd, Rd), \
+   .phase = "Out of phase"}
+
+#endif
@@ -0,0 +1,344 @@
+/* Binary Columnar Result Files
+
+Formatting text is much more expensive than the analyses. So, large
+results (like sweeps of billions of designs) are stored in binary
+result files: a header which describes the configuration and its
+columns, followed by one aligned column per parameter and result
+field. The writer maps a preallocated file and gives the column
+pointers to the engines, so the analyses write directly to the file.
+The reader maps a file and gives its columns without any parsing.
+
+IMPORTANT NOTES:
+----------------
+
+1. File layout: a RESULT_ALIGN bytes header, then 'nparams'
+parameter columns and 'nresults' result columns. Each column has
+room for 'capacity' rows and begins at a RESULT_ALIGN boundary. Only
+the first 'rows' entries of columns are valid.
+2. Values are native doubles. The 'endian' field of header is
+checked by the reader, so files aren't read on a machine of other
+byte order.
+3. 'config_id' is found from the device, configuration, parameter
+and result names. So, readers can check that a file has the schema
+they expect.
+4. Functions return 0 on success and -1 on failure (with 'errno'
+set). A writer must be closed, otherwise its row count isn't stored.
+5. A writer isn't thread-safe: reserve rows from one thread (like a
+sweep consumer), then any threads can fill the reserved rows.
+*/
+
+#ifndef RESULT_FILE_H
+#define RESULT_FILE_H
+
+// Libraries:
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Configuration.h"
+
+// General constants:
+#define RESULT_MAGIC "TRANSCAL" // first bytes of files
+#define RESULT_VERSION 1 // version of file layout
+#define RESULT_ENDIAN 0x01020304 // byte order marker
+#define RESULT_ALIGN 4096 // alignment of header and columns
+#define MAX_COLUMNS (MAX_PARAMS + MAX_RESULTS)
+
+// Kinds of columns:
+enum ColumnKind {
+   COLUMN_PARAM, // parameter of configuration
+   COLUMN_RESULT // result field of configuration
+};
+
+// Types of column values:
+enum ColumnType {
+   COLUMN_F64 = 1 // native double
+};
+
+// Description of a column:
+struct ResultColumn {
+   char name[24]; // parameter or result name
+   uint32_t kind; // enum ColumnKind
+   uint32_t type; // enum ColumnType
+   uint64_t offset; // bytes from the beginning of file
+};
+
+// Header of result files:
+struct ResultHeader {
+   char magic[8]; // RESULT_MAGIC
+   uint32_t version; // RESULT_VERSION
+   uint32_t endian; // RESULT_ENDIAN in native byte order
+   uint64_t header_size; // bytes of header (RESULT_ALIGN)
+   uint64_t config_id; // hash of device, configuration and columns
+   char device[16]; // transistor family ("bjt", "jfet", "mosfet")
+   char config[48]; // configuration name
+   uint32_t nparams; // count of parameter columns
+   uint32_t nresults; // count of result columns
+   uint64_t rows; // count of valid rows
+   uint64_t capacity; // rows that each column has room for
+   struct ResultColumn columns[MAX_COLUMNS]; // parameters, results
+};
+
+// Writer of a result file:
+struct ResultWriter {
+   int fd; // file descriptor
+   char *map; // mapped file
+   size_t bytes; // size of file
+   struct ResultHeader *header; // header in the mapped file
+   double *columns[MAX_COLUMNS]; // columns in the mapped file
+};
+
+// Reader of a result file:
+struct ResultReader {
+   int fd; // file descriptor
+   const char *map; // mapped file
+   size_t bytes; // size of file
+   const struct ResultHeader *header; // header in the mapped file
+   size_t rows; // count of valid rows
+};
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Mix a string to the FNV-1a hash (with its terminating NUL). */
+uint64_t _hash_name_(uint64_t hash, const char *name) {
+   do {
+      hash ^= (unsigned char) *name;
+      hash *= 0x100000001B3;
+   } while (*name++ != '\0');
+   return hash;
+}
+
+/* Round the size up to the alignment of columns. */
+size_t _align_columns_(size_t bytes) {
+   return (bytes + RESULT_ALIGN - 1) / RESULT_ALIGN * RESULT_ALIGN;
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Find the schema ID of a configuration of a family. */
+uint64_t result_config_id(const char *device,
+                          const struct Configuration *config) {
+   // Hash all names in order.
+   uint64_t hash = _hash_name_(0xCBF29CE484222325, device);
+   hash = _hash_name_(hash, config->name);
+   for (size_t p=0; p<config->nparams; p++)
+      hash = _hash_name_(hash, config->params[p]);
+   for (size_t r=0; r<config->nresults; r++)
+      hash = _hash_name_(hash, config->results[r]);
+   return hash;
+}
+
+/* Create a result file of 'capacity' rows for a configuration.
+
+const struct Configuration *config = find_configuration(
+      bjt_configurations, num_bjt_configurations, "fixed_bias");
+struct ResultWriter writer;
+result_writer_open(&writer, "fixed_bias.tcr", "bjt", config, 1000);
+
+double *params[MAX_PARAMS], *results[MAX_RESULTS];
+result_writer_reserve(&writer, 1000, params, results);
+... fill 'params' ...
+config->evaluate(1000, (const double *const *) params, results);
+result_writer_close(&writer);
+*/
+int result_writer_open(struct ResultWriter *writer, const char *path,
+                       const char *device,
+                       const struct Configuration *config,
+                       size_t capacity) {
+   // Check if the parameters of writer are consistent.
+   assert (writer != NULL && path != NULL && device != NULL);
+   assert (config != NULL && capacity > 0);
+   assert (strlen(device) < sizeof(((struct ResultHeader *) 0)->device));
+   assert (strlen(config->name) <
+           sizeof(((struct ResultHeader *) 0)->config));
+   size_t ncolumns = config->nparams + config->nresults;
+   size_t column = _align_columns_(capacity * sizeof(double));
+   assert (capacity <= SIZE_MAX / sizeof(double) - RESULT_ALIGN);
+   assert (column <= (SIZE_MAX - RESULT_ALIGN) / ncolumns);
+   writer->bytes = _align_columns_(sizeof(struct ResultHeader)) +
+                   ncolumns * column;
+
+   // Preallocate the file, so the mapped pages always have blocks.
+   writer->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+   if (writer->fd < 0) return -1;
+   int error = posix_fallocate(writer->fd, 0, writer->bytes);
+   if (error != 0 && ftruncate(writer->fd, writer->bytes) < 0)
+      error = errno;
+   else error = 0;
+   if (error == 0) {
+      writer->map = mmap(NULL, writer->bytes, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, writer->fd, 0);
+      if (writer->map == MAP_FAILED) error = errno;
+   }
+   if (error != 0) {
+      close(writer->fd);
+      unlink(path);
+      errno = error;
+      return -1;
+   }
+   madvise(writer->map, writer->bytes, MADV_SEQUENTIAL);
+
+   // Describe the configuration and its columns.
+   struct ResultHeader *header = (struct ResultHeader *) writer->map;
+   memcpy(header->magic, RESULT_MAGIC, sizeof(header->magic));
+   header->version = RESULT_VERSION;
+   header->endian = RESULT_ENDIAN;
+   header->header_size = _align_columns_(sizeof(struct ResultHeader));
+   header->config_id = result_config_id(device, config);
+   strcpy(header->device, device);
+   strcpy(header->config, config->name);
+   header->nparams = config->nparams;
+   header->nresults = config->nresults;
+   header->rows = 0;
+   header->capacity = capacity;
+   for (size_t c=0; c<ncolumns; c++) {
+      int param = c < config->nparams;
+      string name = param ? config->params[c] :
+                    config->results[c - config->nparams];
+      struct ResultColumn *info = &header->columns[c];
+      strncpy(info->name, name, sizeof(info->name) - 1);
+      info->kind = param ? COLUMN_PARAM : COLUMN_RESULT;
+      info->type = COLUMN_F64;
+      info->offset = header->header_size + c * column;
+      writer->columns[c] = (double *) (writer->map + info->offset);
+   }
+   writer->header = header;
+   return 0;
+}
+
+/* Reserve the next 'num' rows and get their parameter and result
+columns. The analyses can write these columns directly. */
+void result_writer_reserve(struct ResultWriter *writer, size_t num,
+                           double **params, double **results) {
+   // Check if the rows fit the capacity.
+   struct ResultHeader *header = writer->header;
+   assert (header->rows + num <= header->capacity);
+   for (size_t p=0; p<header->nparams; p++)
+      params[p] = writer->columns[p] + header->rows;
+   for (size_t r=0; r<header->nresults; r++)
+      results[r] = writer->columns[header->nparams + r] + header->rows;
+   header->rows += num;
+}
+
+/* Append 'num' rows from parameter and result columns. It fits the
+'SweepConsumer' of Sweep.h (with the writer as context). Faulty rows
+are appended too, their results are NAN.
+
+sweep(config, axes, result_writer_append, &writer, 0);
+*/
+void result_writer_append(void *context, size_t first, size_t num,
+                          const double *const *params,
+                          const double *const *results,
+                          const unsigned char *status) {
+   struct ResultWriter *writer = context;
+   double *to_params[MAX_PARAMS], *to_results[MAX_RESULTS];
+   (void) first; (void) status;
+   result_writer_reserve(writer, num, to_params, to_results);
+   for (size_t p=0; p<writer->header->nparams; p++)
+      memcpy(to_params[p], params[p], num * sizeof(double));
+   for (size_t r=0; r<writer->header->nresults; r++)
+      memcpy(to_results[r], results[r], num * sizeof(double));
+}
+
+/* Store the row count and close the result file. */
+int result_writer_close(struct ResultWriter *writer) {
+   // Write the mapped pages to the file before unmapping them.
+   int failed = msync(writer->map, writer->bytes, MS_SYNC) < 0;
+   failed |= munmap(writer->map, writer->bytes) < 0;
+   failed |= close(writer->fd) < 0;
+   return failed ? -1 : 0;
+}
+
+/* Open a result file and check its header.
+
+struct ResultReader reader;
+result_reader_open(&reader, "fixed_bias.tcr");
+const double *Ic = result_reader_column(&reader, "Ic");
+
+reader.rows: 1000, reader.header->config: fixed_bias
+*/
+int result_reader_open(struct ResultReader *reader, const char *path) {
+   // Check if the parameters of reader are consistent.
+   assert (reader != NULL && path != NULL);
+   struct stat info;
+   reader->fd = open(path, O_RDONLY);
+   if (reader->fd < 0) return -1;
+   if (fstat(reader->fd, &info) < 0) {
+      int error = errno;
+      close(reader->fd);
+      errno = error;
+      return -1;
+   }
+   reader->bytes = info.st_size;
+   if (reader->bytes < sizeof(struct ResultHeader)) {
+      close(reader->fd);
+      errno = EINVAL;
+      return -1;
+   }
+   reader->map = mmap(NULL, reader->bytes, PROT_READ, MAP_SHARED,
+                      reader->fd, 0);
+   if (reader->map == MAP_FAILED) {
+      int error = errno;
+      close(reader->fd);
+      errno = error;
+      return -1;
+   }
+
+   // Check the header and the bounds of all columns.
+   const struct ResultHeader *header = (const void *) reader->map;
+   int valid = memcmp(header->magic, RESULT_MAGIC, 8) == 0 &&
+               header->version == RESULT_VERSION &&
+               header->endian == RESULT_ENDIAN &&
+               header->nparams <= MAX_PARAMS &&
+               header->nresults <= MAX_RESULTS &&
+               header->rows <= header->capacity &&
+               header->capacity <= reader->bytes / sizeof(double);
+   for (size_t c=0; valid && c<header->nparams + header->nresults;
+        c++) {
+      const struct ResultColumn *column = &header->columns[c];
+      valid = column->type == COLUMN_F64 &&
+              column->offset % sizeof(double) == 0 &&
+              column->offset <= reader->bytes &&
+              header->capacity * sizeof(double) <=
+              reader->bytes - column->offset &&
+              memchr(column->name, '\0', sizeof(column->name)) != NULL;
+   }
+   if (!valid) {
+      munmap((void *) reader->map, reader->bytes);
+      close(reader->fd);
+      errno = EINVAL;
+      return -1;
+   }
+   reader->header = header;
+   reader->rows = header->rows;
+   return 0;
+}
+
+/* Get the column named 'name'. If it doesn't exist, NULL is
+returned. */
+const double *result_reader_column(const struct ResultReader *reader,
+                                   const char *name) {
+   // Search the parameter and result columns.
+   const struct ResultHeader *header = reader->header;
+   for (size_t c=0; c<header->nparams + header->nresults; c++)
+      if (strcmp(header->columns[c].name, name) == 0)
+         return (const double *) (reader->map +
+                                  header->columns[c].offset);
+   return NULL;
+}
+
+/* Close a result file. */
+void result_reader_close(struct ResultReader *reader) {
+   munmap((void *) reader->map, reader->bytes);
+   close(reader->fd);
+}
+
+#endif
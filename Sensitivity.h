@@ -0,0 +1,779 @@
+/* Sensitivities of Transistor Configurations
+
+Sensitivities (like dIc/dbeta or dAv/dRe) by finite differences need
+two extra analyses for each parameter and their step sizes trade the
+truncation errors against the rounding errors. So, this source file
+evaluates the formulas of each configuration with dual numbers,
+which carry the partial derivatives of a value with respect to all
+parameters. One evaluation gives the results and the exact Jacobian
+of every result field with respect to every parameter.
+
+IMPORTANT NOTES:
+----------------
+
+1. Include this file instead of BJT.h, JFET.h and MOSFET.h, it
+includes them.
+2. The configurations are the uniform descriptions of the families
+(see Configuration.h), so the parameters and results are in the same
+order as the 'analyze_*()' functions.
+3. The formulas are the same as the fused analyses. Results are
+computed in double (also MOSFET results, which are stored as float
+by MOSFET.h).
+4. At a branch (like the root selection of a quadratic), derivatives
+are of the selected branch. Constant results have zero derivatives.
+5. A dual number carries MAX_PARAMS partials, so the cost of one
+evaluation doesn't depend on the count of parameters.
+6. Batch Jacobians are evaluated in blocks of JACOBIAN_BLOCK designs
+and each block is stored column by column. So, the many Jacobian
+columns are written sequentially instead of one value per column.
+
+EXISTING OPERATIONS:
+--------------------
+
++ Constants and Variables (dual_constant, dual_variable)
++ Arithmetic (dual_add, dual_sub, dual_mul, dual_div, dual_scale,
+dual_shift)
++ Functions (dual_sqrt, dual_parallel)
++ Jacobians (find_sensitivity, configuration_jacobian)
+*/
+
+#ifndef SENSITIVITY_H
+#define SENSITIVITY_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include "BJT.h"
+#include "JFET.h"
+#include "MOSFET.h"
+
+// General constants:
+#define JACOBIAN_BLOCK 16 // designs stored to the columns together
+
+// Value and its partial derivatives:
+struct Dual {
+   double v; // value
+   double d[MAX_PARAMS]; // partial derivatives of parameters
+};
+
+// Dual evaluation of one configuration:
+struct Sensitivity {
+   const struct Configuration *config; // uniform description
+   // Results of one design from dual parameters.
+   void (*evaluate)(const struct Dual *params, struct Dual *results);
+   // Results and Jacobians of 'num' designs (see below).
+   void (*jacobian)(size_t num, const double *const *params,
+                    double *const *results, double *const *jacobian);
+};
+
+// User-defined dual type:
+typedef struct Dual dual;
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Dual Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Get the constant 'v', all of its partials are zero. */
+dual dual_constant(double v) {
+   dual x = {v, {0}};
+   return x;
+}
+
+/* Get the i'th parameter 'v', its own partial is one. */
+dual dual_variable(double v, size_t i) {
+   assert (i < MAX_PARAMS);
+   dual x = {v, {0}};
+   x.d[i] = 1;
+   return x;
+}
+
+/* Get 'x + y'. */
+dual dual_add(dual x, dual y) {
+   dual z = {x.v + y.v, {0}};
+   for (size_t j=0; j<MAX_PARAMS; j++) z.d[j] = x.d[j] + y.d[j];
+   return z;
+}
+
+/* Get 'x - y'. */
+dual dual_sub(dual x, dual y) {
+   dual z = {x.v - y.v, {0}};
+   for (size_t j=0; j<MAX_PARAMS; j++) z.d[j] = x.d[j] - y.d[j];
+   return z;
+}
+
+/* Get 'x * y'. */
+dual dual_mul(dual x, dual y) {
+   dual z = {x.v * y.v, {0}};
+   for (size_t j=0; j<MAX_PARAMS; j++)
+      z.d[j] = x.d[j] * y.v + x.v * y.d[j];
+   return z;
+}
+
+/* Get 'x / y'. */
+dual dual_div(dual x, dual y) {
+   dual z = {x.v / y.v, {0}};
+   double inverse = 1 / y.v;
+   for (size_t j=0; j<MAX_PARAMS; j++)
+      z.d[j] = (x.d[j] - z.v * y.d[j]) * inverse;
+   return z;
+}
+
+/* Get 'x * s' for the constant 's'. */
+dual dual_scale(dual x, double s) {
+   dual z = {x.v * s, {0}};
+   for (size_t j=0; j<MAX_PARAMS; j++) z.d[j] = x.d[j] * s;
+   return z;
+}
+
+/* Get 'x + s' for the constant 's'. */
+dual dual_shift(dual x, double s) {
+   x.v += s;
+   return x;
+}
+
+/* Get the square root of 'x'. */
+dual dual_sqrt(dual x) {
+   dual z = {sqrt(x.v), {0}};
+   double half = 0.5 / z.v;
+   for (size_t j=0; j<MAX_PARAMS; j++) z.d[j] = x.d[j] * half;
+   return z;
+}
+
+/* Get the parallel resultant of 'R1' and 'R2' (like _parallel_()
+and _Rth_()). */
+dual dual_parallel(dual R1, dual R2) {
+   dual z = {1 / (1 / R1.v + 1 / R2.v), {0}};
+   // dz = (z / R1)^2 * dR1 + (z / R2)^2 * dR2.
+   double w1 = z.v / R1.v, w2 = z.v / R2.v;
+   w1 *= w1; w2 *= w2;
+   for (size_t j=0; j<MAX_PARAMS; j++)
+      z.d[j] = w1 * R1.d[j] + w2 * R2.d[j];
+   return z;
+}
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Select the right drain current like _drain_current_(). */
+dual _dual_drain_current_(dual a, dual b, dual c) {
+   dual discriminant = dual_sub(dual_mul(b, b),
+                                dual_scale(dual_mul(a, c), 4));
+   dual root = dual_sqrt(discriminant);
+   // Add the root with the sign of 'b' to avoid cancellation.
+   dual q = dual_scale(signbit(b.v) ? dual_sub(b, root) :
+                       dual_add(b, root), -0.5);
+   dual root1 = dual_div(q, a), root2 = dual_div(c, q);
+   dual low = (root1.v < root2.v) ? root1 : root2;
+   dual high = (root1.v < root2.v) ? root2 : root1;
+   if (low.v >= 0) return low;
+   return (high.v < 0) ? dual_scale(high, -1) : high;
+}
+
+/* Get the transconductance factor like _gm_factor_(). The partials
+of '|Vp|' are the ones of 'Vp' times its sign. */
+dual _dual_gm_factor_(dual Idss, dual Vp, dual Vgs) {
+   dual Vp_abs = dual_scale(Vp, copysign(1.0, Vp.v));
+   dual factor = dual_scale(dual_div(Idss, Vp_abs), 2.0);
+   return dual_mul(factor, dual_sub(dual_constant(1),
+                                    dual_div(Vgs, Vp)));
+}
+
+/* Fill the DC results of common-emitter configurations from 'Ib'.
+The emitter resistance 'Re' is zero for fixed-bias. */
+void _bjt_dual_dc_(dual *r, dual Vcc, dual Ib, dual beta, dual Rc,
+                   dual Re) {
+   dual Rce = dual_add(Rc, Re);
+   r[0] = Ib;
+   r[1] = dual_mul(beta, Ib);
+   r[2] = dual_mul(dual_shift(beta, 1), Ib);
+   r[3] = dual_div(Vcc, Rce);
+   r[4] = dual_sub(Vcc, dual_mul(r[1], Rce));
+   r[6] = dual_mul(r[2], Re);
+   r[5] = dual_add(r[4], r[6]);
+   r[7] = dual_shift(r[6], Vbe);
+   r[8] = dual_sub(r[7], r[5]);
+}
+
+/* Fill the AC results like _bjt_ac_bypassed_(). */
+void _bjt_dual_bypassed_(dual *r, dual Rb, dual Rc, dual beta,
+                         dual ro) {
+   dual re = dual_div(dual_constant(0.026), r[2]);
+   r[9] = re;
+   r[10] = dual_parallel(Rb, dual_mul(beta, re));
+   r[11] = dual_parallel(Rc, ro);
+   r[12] = dual_scale(dual_div(r[11], re), -1);
+}
+
+/* Fill the AC results like _bjt_ac_unbypassed_(). */
+void _bjt_dual_unbypassed_(dual *r, dual Rb, dual Rc, dual Re,
+                           dual beta, dual ro) {
+   dual re = dual_div(dual_constant(0.026), r[2]);
+   dual one = dual_constant(1), Rco = dual_div(Rc, ro);
+   dual Zb1 = dual_add(dual_shift(beta, 1), Rco);
+   dual Zb2 = dual_add(one, dual_div(dual_add(Rc, Re), ro));
+   dual Zb = dual_add(dual_mul(beta, re),
+                      dual_mul(dual_div(Zb1, Zb2), Re));
+   dual Zo1 = dual_mul(beta, dual_add(ro, re));
+   dual Zo2 = dual_add(one, dual_div(dual_mul(beta, re), Re));
+   dual Zo3 = dual_add(ro, dual_div(Zo1, Zo2));
+   dual Av1 = dual_add(dual_mul(dual_scale(dual_div(dual_mul(beta,
+         Rc), Zb), -1), dual_add(one, dual_div(re, ro))), Rco);
+   r[9] = re;
+   r[10] = dual_parallel(Rb, Zb);
+   r[11] = dual_parallel(Rc, Zo3);
+   r[12] = dual_div(Av1, dual_add(one, Rco));
+}
+
+/* Fill the AC results like _bjt_ac_feedback_(). */
+void _bjt_dual_feedback_(dual *r, dual Rf, dual Rc, dual beta,
+                         dual ro) {
+   dual re = dual_div(dual_constant(0.026), r[2]);
+   dual one = dual_constant(1), Rco = dual_parallel(Rc, ro);
+   dual Bre = dual_mul(beta, re);
+   dual Zi1 = dual_add(one, dual_div(Rco, Rf));
+   dual Zi2 = dual_add(dual_div(one, Bre), dual_div(one, Rf));
+   dual Zi3 = dual_div(Rco, dual_mul(Bre, Rf));
+   dual Zi4 = dual_div(Rco, dual_mul(Rf, re));
+   dual Av1 = dual_div(Rf, dual_add(Rco, Rf));
+   r[9] = re;
+   r[10] = dual_div(Zi1, dual_add(dual_add(Zi2, Zi3), Zi4));
+   r[11] = dual_parallel(dual_parallel(ro, Rc), Rf);
+   r[12] = dual_scale(dual_mul(Av1, dual_div(Rco, re)), -1);
+}
+
+/* Fill the DC results of FET configurations from 'Id'. The source
+voltage is 'Id * Rs + Vs0' and the gate voltage is 'Vg'. */
+void _jfet_dual_dc_(dual *r, dual Vdd, dual Vss, dual Vg, dual Vgs,
+                    dual Id, dual Rd, dual Rs) {
+   r[0] = Id;
+   r[1] = Vgs;
+   r[2] = dual_sub(dual_add(Vdd, Vss),
+                   dual_mul(Id, dual_add(Rs, Rd)));
+   r[3] = dual_sub(dual_mul(Id, Rs), Vss);
+   r[4] = dual_sub(Vdd, dual_mul(Id, Rd));
+   r[5] = Vg;
+}
+
+/* Solve the drain current of a JFET with the gate-source loop
+'Vgs = V - Id * Rs'. */
+dual _jfet_dual_quadratic_(dual V, dual Rs, dual Idss, dual Vp) {
+   dual one = dual_constant(1);
+   dual ratio = dual_div(Rs, Vp);
+   dual factor = dual_sub(one, dual_div(V, Vp));
+   dual a = dual_mul(Idss, dual_mul(ratio, ratio));
+   dual b = dual_shift(dual_scale(dual_mul(dual_mul(Idss, ratio),
+                                           factor), 2), -1);
+   dual c = dual_mul(Idss, dual_mul(factor, factor));
+   return _dual_drain_current_(a, b, c);
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Dual evaluations of uniform BJT configurations. */
+void _bjt_dual_fixed_bias_(const dual *p, dual *r) {
+   // Parameters: Vcc, Rb, Rc, beta, ro.
+   dual Ib = dual_div(dual_shift(p[0], -Vbe), p[1]);
+   _bjt_dual_dc_(r, p[0], Ib, p[3], p[2], dual_constant(0));
+   r[6] = dual_constant(0);
+   r[7] = dual_constant(Vbe);
+   _bjt_dual_bypassed_(r, p[1], p[2], p[3], p[4]);
+}
+
+void _bjt_dual_emitter_bias_(const dual *p, dual *r) {
+   // Parameters: Vcc, Rb, Rc, Re, beta, ro.
+   dual Ib = dual_div(dual_shift(p[0], -Vbe), dual_add(p[1],
+                      dual_mul(dual_shift(p[4], 1), p[3])));
+   _bjt_dual_dc_(r, p[0], Ib, p[4], p[2], p[3]);
+   _bjt_dual_unbypassed_(r, p[1], p[2], p[3], p[4], p[5]);
+}
+
+/* Solve the voltage-divider BJT, 'Rth' is written to 'rth'. */
+void _bjt_dual_voltage_divider_dc_(const dual *p, dual *r, dual *rth) {
+   // Parameters: Vcc, Rb1, Rb2, Rc, Re, beta, ro.
+   *rth = dual_parallel(p[1], p[2]);
+   dual eth = dual_mul(p[0], dual_div(p[2], dual_add(p[1], p[2])));
+   dual Ib = dual_div(dual_shift(eth, -Vbe), dual_add(*rth,
+                      dual_mul(dual_shift(p[5], 1), p[4])));
+   _bjt_dual_dc_(r, p[0], Ib, p[5], p[3], p[4]);
+}
+
+void _bjt_dual_voltage_divider_(const dual *p, dual *r) {
+   dual rth;
+   _bjt_dual_voltage_divider_dc_(p, r, &rth);
+   _bjt_dual_bypassed_(r, rth, p[3], p[5], p[6]);
+}
+
+void _bjt_dual_voltage_divider_unbypassed_(const dual *p, dual *r) {
+   dual rth;
+   _bjt_dual_voltage_divider_dc_(p, r, &rth);
+   _bjt_dual_unbypassed_(r, rth, p[3], p[4], p[5], p[6]);
+}
+
+void _bjt_dual_collector_feedback_(const dual *p, dual *r) {
+   // Parameters: Vcc, Rf, Rc, Re, beta, ro.
+   dual Ib = dual_div(dual_shift(p[0], -Vbe), dual_add(p[1],
+                      dual_mul(p[4], dual_add(p[2], p[3]))));
+   _bjt_dual_dc_(r, p[0], Ib, p[4], p[2], p[3]);
+   _bjt_dual_feedback_(r, p[1], p[2], p[4], p[5]);
+}
+
+void _bjt_dual_emitter_follower_(const dual *p, dual *r) {
+   // Parameters: Vee, Rb, Re, beta, ro.
+   dual one = dual_constant(1), beta1 = dual_shift(p[3], 1);
+   dual Ib = dual_div(dual_shift(p[0], -Vbe), dual_add(p[1],
+                      dual_mul(beta1, p[2])));
+   dual IeRe = dual_mul(dual_mul(beta1, Ib), p[2]);
+   r[0] = Ib;
+   r[1] = dual_mul(p[3], Ib);
+   r[2] = dual_mul(beta1, Ib);
+   r[3] = dual_constant(-1.0);
+   r[4] = dual_sub(p[0], IeRe);
+   r[6] = dual_add(IeRe, p[0]);
+   r[5] = dual_add(r[4], r[6]);
+   r[7] = dual_shift(r[6], Vbe);
+   r[8] = dual_sub(r[7], r[5]);
+   dual re = dual_div(dual_constant(0.026), r[2]);
+   dual Bre = dual_mul(p[3], re);
+   dual Reo = dual_add(one, dual_div(p[2], p[4]));
+   dual Zb = dual_add(Bre, dual_div(dual_mul(beta1, p[2]), Reo));
+   r[9] = re;
+   r[10] = dual_parallel(p[1], Zb);
+   r[11] = dual_parallel(dual_parallel(p[4], p[2]),
+                         dual_div(Bre, beta1));
+   r[12] = dual_div(dual_div(dual_mul(beta1, p[2]), Zb), Reo);
+}
+
+void _bjt_dual_common_base_(const dual *p, dual *r) {
+   // Parameters: Vcc, Vee, Rc, Re, beta.
+   dual beta1 = dual_shift(p[4], 1);
+   r[2] = dual_div(dual_shift(p[1], -Vbe), p[3]);
+   r[0] = dual_div(r[2], beta1);
+   r[1] = dual_mul(r[0], p[4]);
+   r[3] = dual_constant(-1.0);
+   r[4] = dual_sub(dual_add(p[1], p[0]),
+                   dual_mul(r[2], dual_add(p[2], p[3])));
+   r[5] = r[6] = r[7] = dual_constant(-1.0);
+   r[8] = dual_sub(dual_mul(r[1], p[2]), p[0]);
+   dual re = dual_div(dual_constant(0.026), r[2]);
+   r[9] = re;
+   r[10] = dual_parallel(p[3], re);
+   r[11] = p[2];
+   r[12] = dual_div(dual_mul(dual_div(p[4], beta1), p[2]), re);
+}
+
+/* Dual evaluations of uniform JFET configurations. */
+void _jfet_dual_fixed_bias_(const dual *p, dual *r) {
+   // Parameters: Vdd, Vgg, Rg, Rd, Idss, Vp, rd.
+   dual Vgs = dual_scale(p[1], -1);
+   dual factor = dual_sub(dual_constant(1), dual_div(Vgs, p[5]));
+   dual Id = dual_mul(p[4], dual_mul(factor, factor));
+   _jfet_dual_dc_(r, p[0], dual_constant(0), Vgs, Vgs, Id, p[3],
+                  dual_constant(0));
+   r[3] = dual_constant(0);
+   r[6] = _dual_gm_factor_(p[4], p[5], Vgs);
+   r[7] = p[2];
+   r[8] = dual_parallel(p[3], p[6]);
+   r[9] = dual_scale(dual_mul(r[6], r[8]), -1);
+}
+
+void _jfet_dual_self_bias_(const dual *p, dual *r) {
+   // Parameters: Vdd, Rg, Rd, Rs, Idss, Vp, rd.
+   dual zero = dual_constant(0), one = dual_constant(1);
+   dual Id = _jfet_dual_quadratic_(zero, p[3], p[4], p[5]);
+   dual Vgs = dual_scale(dual_mul(Id, p[3]), -1);
+   _jfet_dual_dc_(r, p[0], zero, zero, Vgs, Id, p[2], p[3]);
+   dual gm = _dual_gm_factor_(p[4], p[5], Vgs);
+   dual Zo1 = dual_add(dual_add(one, dual_mul(gm, p[3])),
+                       dual_div(p[3], p[6]));
+   dual Zo2 = dual_add(Zo1, dual_div(p[2], p[6]));
+   dual Av2 = dual_add(dual_add(one, dual_mul(gm, p[3])),
+                       dual_div(dual_add(p[2], p[3]), p[6]));
+   r[6] = gm;
+   r[7] = p[1];
+   r[8] = dual_div(dual_mul(Zo1, p[2]), Zo2);
+   r[9] = dual_scale(dual_div(dual_mul(gm, p[2]), Av2), -1);
+}
+
+void _jfet_dual_voltage_divider_(const dual *p, dual *r) {
+   // Parameters: Vdd, Rg1, Rg2, Rd, Rs, Idss, Vp, rd.
+   dual Vg = dual_div(dual_mul(p[2], p[0]), dual_add(p[1], p[2]));
+   dual Id = _jfet_dual_quadratic_(Vg, p[4], p[5], p[6]);
+   dual Vgs = dual_sub(Vg, dual_mul(Id, p[4]));
+   _jfet_dual_dc_(r, p[0], dual_constant(0), Vg, Vgs, Id, p[3], p[4]);
+   r[6] = _dual_gm_factor_(p[5], p[6], Vgs);
+   r[7] = dual_parallel(p[1], p[2]);
+   r[8] = dual_parallel(p[3], p[7]);
+   r[9] = dual_scale(dual_mul(r[6], r[8]), -1);
+}
+
+void _jfet_dual_common_gate_(const dual *p, dual *r) {
+   // Parameters: Vdd, Vss, Rd, Rs, Idss, Vp, rd.
+   dual one = dual_constant(1);
+   dual Id = _jfet_dual_quadratic_(p[1], p[3], p[4], p[5]);
+   dual Vgs = dual_sub(p[1], dual_mul(Id, p[3]));
+   _jfet_dual_dc_(r, p[0], p[1], dual_constant(0), Vgs, Id, p[2],
+                  p[3]);
+   dual gm = _dual_gm_factor_(p[4], p[5], Vgs);
+   dual Rdo = dual_div(p[2], p[6]);
+   dual Zi1 = dual_div(dual_add(p[6], p[2]), dual_add(one,
+                       dual_mul(gm, p[6])));
+   r[6] = gm;
+   r[7] = dual_parallel(p[3], Zi1);
+   r[8] = dual_parallel(p[2], p[6]);
+   r[9] = dual_div(dual_add(dual_mul(gm, p[2]), Rdo),
+                   dual_add(one, Rdo));
+}
+
+/* Solve the MOSFET whose gate-source loop is 'Vgs = Vg - Id * Rs'
+and fill its DC results. */
+void _mosfet_dual_dc_(dual *r, dual Idon, dual Vgson, dual Vgsth,
+                      dual Vg, dual Rs) {
+   dual on = dual_sub(Vgson, Vgsth), over = dual_sub(Vg, Vgsth);
+   dual k = dual_div(Idon, dual_mul(on, on));
+   dual a = dual_mul(dual_mul(Rs, Rs), k);
+   dual b = dual_shift(dual_scale(dual_mul(dual_mul(k, Rs), over),
+                                  -2), -1);
+   dual c = dual_mul(k, dual_mul(over, over));
+   r[0] = k;
+   r[1] = _dual_drain_current_(a, b, c);
+   r[2] = dual_sub(Vg, dual_mul(r[1], Rs));
+   r[4] = dual_scale(dual_mul(k, dual_sub(r[2], Vgsth)), 2);
+}
+
+/* Dual evaluations of uniform MOSFET configurations. */
+void _mosfet_dual_drain_feedback_(const dual *p, dual *r) {
+   // Parameters: Vdd, Rg, Rd, Idon, Vgson, Vgsth, rd.
+   _mosfet_dual_dc_(r, p[3], p[4], p[5], p[0], p[2]);
+   r[3] = r[2];
+   dual Rdo = dual_parallel(p[6], p[2]);
+   r[5] = dual_div(dual_add(p[1], Rdo), dual_add(dual_constant(1),
+                   dual_mul(r[4], Rdo)));
+   r[6] = dual_parallel(p[1], Rdo);
+   r[7] = dual_scale(dual_mul(r[4], r[6]), -1);
+}
+
+void _mosfet_dual_voltage_divider_(const dual *p, dual *r) {
+   // Parameters: Vdd, Rg1, Rg2, Rd, Rs, Idon, Vgson, Vgsth, rd.
+   dual Vg = dual_div(dual_mul(p[2], p[0]), dual_add(p[1], p[2]));
+   _mosfet_dual_dc_(r, p[5], p[6], p[7], Vg, p[4]);
+   r[3] = dual_sub(p[0], dual_mul(r[1], dual_add(p[4], p[3])));
+   r[5] = dual_parallel(p[1], p[2]);
+   r[6] = dual_parallel(p[8], p[3]);
+   r[7] = dual_scale(dual_mul(r[4], r[6]), -1);
+}
+
+/* --------------------------------------------------------------- */
+/* ----------------------- Batch Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Seed the dual parameters of i'th design. */
+void _dual_seed_(dual *p, size_t nparams, const double *const *params,
+                 size_t i) {
+   for (size_t j=0; j<nparams; j++)
+      p[j] = dual_variable(params[j][i], j);
+}
+
+/* Store the results and partials of 'num' designs from the block
+'r' to the columns starting at 'i'. */
+void _dual_store_(const dual (*r)[MAX_RESULTS], size_t num,
+                  size_t nresults, size_t nparams, size_t i,
+                  double *const *results, double *const *jacobian) {
+   for (size_t k=0; k<nresults; k++) {
+      if (results != NULL)
+         for (size_t b=0; b<num; b++) results[k][i + b] = r[b][k].v;
+      for (size_t j=0; j<nparams; j++) {
+         double *column = jacobian[k * nparams + j] + i;
+         for (size_t b=0; b<num; b++) column[b] = r[b][k].d[j];
+      }
+   }
+}
+
+/* Batch Jacobians of dual evaluations. The dual operations are
+inlined and vectorized across the partials. */
+BATCH_DISPATCH
+void _bjt_jacobian_fixed_bias_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 5, params, i + b);
+         _bjt_dual_fixed_bias_(p, r[b]);
+      }
+      _dual_store_(r, block, 13, 5, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _bjt_jacobian_emitter_bias_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 6, params, i + b);
+         _bjt_dual_emitter_bias_(p, r[b]);
+      }
+      _dual_store_(r, block, 13, 6, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _bjt_jacobian_voltage_divider_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 7, params, i + b);
+         _bjt_dual_voltage_divider_(p, r[b]);
+      }
+      _dual_store_(r, block, 13, 7, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _bjt_jacobian_voltage_divider_unbypassed_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 7, params, i + b);
+         _bjt_dual_voltage_divider_unbypassed_(p, r[b]);
+      }
+      _dual_store_(r, block, 13, 7, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _bjt_jacobian_collector_feedback_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 6, params, i + b);
+         _bjt_dual_collector_feedback_(p, r[b]);
+      }
+      _dual_store_(r, block, 13, 6, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _bjt_jacobian_emitter_follower_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 5, params, i + b);
+         _bjt_dual_emitter_follower_(p, r[b]);
+      }
+      _dual_store_(r, block, 13, 5, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _bjt_jacobian_common_base_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 5, params, i + b);
+         _bjt_dual_common_base_(p, r[b]);
+      }
+      _dual_store_(r, block, 13, 5, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _jfet_jacobian_fixed_bias_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 7, params, i + b);
+         _jfet_dual_fixed_bias_(p, r[b]);
+      }
+      _dual_store_(r, block, 10, 7, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _jfet_jacobian_self_bias_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 7, params, i + b);
+         _jfet_dual_self_bias_(p, r[b]);
+      }
+      _dual_store_(r, block, 10, 7, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _jfet_jacobian_voltage_divider_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 8, params, i + b);
+         _jfet_dual_voltage_divider_(p, r[b]);
+      }
+      _dual_store_(r, block, 10, 8, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _jfet_jacobian_common_gate_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 7, params, i + b);
+         _jfet_dual_common_gate_(p, r[b]);
+      }
+      _dual_store_(r, block, 10, 7, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _mosfet_jacobian_drain_feedback_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 7, params, i + b);
+         _mosfet_dual_drain_feedback_(p, r[b]);
+      }
+      _dual_store_(r, block, 8, 7, i, results, jacobian);
+   }
+}
+
+BATCH_DISPATCH
+void _mosfet_jacobian_voltage_divider_(size_t num,
+      const double *const *params, double *const *results,
+      double *const *jacobian) {
+   dual p[MAX_PARAMS], r[JACOBIAN_BLOCK][MAX_RESULTS];
+   for (size_t i=0; i<num; i+=JACOBIAN_BLOCK) {
+      size_t block = (num - i < JACOBIAN_BLOCK) ? num - i :
+                     JACOBIAN_BLOCK;
+      for (size_t b=0; b<block; b++) {
+         _dual_seed_(p, 9, params, i + b);
+         _mosfet_dual_voltage_divider_(p, r[b]);
+      }
+      _dual_store_(r, block, 8, 9, i, results, jacobian);
+   }
+}
+
+/* Dual evaluations of all uniform configurations. */
+const struct Sensitivity sensitivities[] = {
+   {&bjt_configurations[0], _bjt_dual_fixed_bias_,
+    _bjt_jacobian_fixed_bias_},
+   {&bjt_configurations[1], _bjt_dual_emitter_bias_,
+    _bjt_jacobian_emitter_bias_},
+   {&bjt_configurations[2], _bjt_dual_voltage_divider_,
+    _bjt_jacobian_voltage_divider_},
+   {&bjt_configurations[3], _bjt_dual_voltage_divider_unbypassed_,
+    _bjt_jacobian_voltage_divider_unbypassed_},
+   {&bjt_configurations[4], _bjt_dual_collector_feedback_,
+    _bjt_jacobian_collector_feedback_},
+   {&bjt_configurations[5], _bjt_dual_emitter_follower_,
+    _bjt_jacobian_emitter_follower_},
+   {&bjt_configurations[6], _bjt_dual_common_base_,
+    _bjt_jacobian_common_base_},
+   {&jfet_configurations[0], _jfet_dual_fixed_bias_,
+    _jfet_jacobian_fixed_bias_},
+   {&jfet_configurations[1], _jfet_dual_self_bias_,
+    _jfet_jacobian_self_bias_},
+   {&jfet_configurations[2], _jfet_dual_voltage_divider_,
+    _jfet_jacobian_voltage_divider_},
+   {&jfet_configurations[3], _jfet_dual_common_gate_,
+    _jfet_jacobian_common_gate_},
+   {&mosfet_configurations[0], _mosfet_dual_drain_feedback_,
+    _mosfet_jacobian_drain_feedback_},
+   {&mosfet_configurations[1], _mosfet_dual_voltage_divider_,
+    _mosfet_jacobian_voltage_divider_},
+};
+
+// Number of dual evaluations:
+const size_t num_sensitivities =
+   sizeof(sensitivities) / sizeof(sensitivities[0]);
+
+/* Find the dual evaluation of 'config' (an entry of a family table).
+If it doesn't exist, NULL is returned.
+
+const struct Sensitivity *sensitivity = find_sensitivity(
+      find_configuration(bjt_configurations, num_bjt_configurations,
+                         "emitter_bias"));
+*/
+const struct Sensitivity *find_sensitivity(
+      const struct Configuration *config) {
+   // Search the table linearly, it is small.
+   for (size_t i=0; i<num_sensitivities; i++)
+      if (sensitivities[i].config == config) return &sensitivities[i];
+   return NULL;
+}
+
+/* Analyze 'num' designs of 'config' and find their Jacobians. If
+'results' isn't NULL, the result fields are written to its columns.
+The partial derivative of result 'r' with respect to parameter 'p'
+is written to the column 'r * nparams + p' of 'jacobian'.
+
+const struct Configuration *config = &bjt_configurations[1];
+double Vcc=20, Rb=470000, Rc=2200, Re=560, beta=120, ro=40000;
+const double *params[6] = {&Vcc, &Rb, &Rc, &Re, &beta, &ro};
+double values[13 * 6], *jacobian[13 * 6];
+for (size_t c=0; c<13 * 6; c++) jacobian[c] = &values[c];
+configuration_jacobian(config, 1, params, NULL, jacobian);
+
+dIc/dbeta: 3.140475e-05 A  (jacobian[1 * 6 + 4])
+dAv/dRe: 6.809955e-03 1/ohm  (jacobian[12 * 6 + 3])
+*/
+void configuration_jacobian(const struct Configuration *config,
+      size_t num, const double *const *params,
+      double *const *results, double *const *jacobian) {
+   // Check if the configuration has a dual evaluation.
+   const struct Sensitivity *sensitivity = find_sensitivity(config);
+   assert (sensitivity != NULL && jacobian != NULL);
+   sensitivity->jacobian(num, params, results, jacobian);
+}
+
+#endif
@@ -0,0 +1,397 @@
+/* Parallel N-Dimensional Parameter Sweep of Transistor Configurations
+
+A sweep analyzes every combination of the parameter values of any
+configuration (see Configuration.h). Each parameter has its own
+axis: linear, logarithmic or a list of values. For example, 6 axes
+with 20 points give 64M designs. So, the results are never stored
+all together. Instead, they are analyzed in cache-sized chunks and
+given to a consumer function chunk by chunk.
+
+IMPORTANT NOTES:
+----------------
+
+1. Points are ordered like nested loops: the first axis changes
+slowest and the last axis changes fastest.
+2. Chunks are analyzed on a work-stealing thread pool, but the
+consumer is called in point order and by one thread at a time.
+Chunk sizes don't depend on the count of threads. So, the consumer
+sees the same calls for any count of threads.
+3. Memory usage is bounded: only a window of chunks (some per
+thread) exists at any time.
+4. 'sweep_regions()' classifies each chunk (see 'classify_regions()')
+and gives only the points in the accepted regions. They are packed
+together and numbered in order, so the consumer sees the same calls
+for any count of threads too. Most points of a wide grid are often
+cut off or saturated, so skipping them saves their output.
+5. Every chunk is validated (see 'validate_results()'), so a
+non-positive resistance on an axis doesn't abort the sweep. Faulty
+points keep their parameters, but their results are NAN and the
+consumer gets their faults (bits of 'enum Fault') in 'status'. They
+have no region, so 'sweep_regions()' skips them.
+6. Link with '-pthread' and '-lm'.
+*/
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+// Libraries:
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <math.h>
+#include <pthread.h>
+#include "Configuration.h"
+#include "Parallel.h"
+
+// General constants:
+#define SWEEP_TILE 65536 // bytes of parameter and result columns
+#define SWEEP_ROUND 4 // chunks given to a thread at once
+
+// Kinds of sweep axes:
+enum AxisKind {
+   AXIS_LINEAR, // equally spaced between start and stop
+   AXIS_LOG, // logarithmically spaced between start and stop
+   AXIS_LIST // given values
+};
+
+// Axis of a parameter:
+struct Axis {
+   enum AxisKind kind; // kind of axis
+   double start; // first value (linear and log axes)
+   double stop; // last value (linear and log axes)
+   size_t points; // count of values
+   const double *values; // values of list axes
+};
+
+// Consumer of the analyzed chunks:
+typedef void (*SweepConsumer)(void *context, size_t first, size_t num,
+                              const double *const *params,
+                              const double *const *results,
+                              const unsigned char *status);
+
+// Common state of a sweep:
+struct SweepRun {
+   const struct Configuration *config; // analyzed configuration
+   double *values[MAX_PARAMS]; // values of each axis
+   size_t points[MAX_PARAMS]; // count of values of each axis
+   size_t total; // count of all points
+   size_t chunk; // points of a chunk
+   size_t chunks; // count of all chunks
+   size_t threads; // count of threads
+   size_t window; // chunks that may exist at once
+   unsigned accept; // accepted regions (0 accepts all points)
+   double *tiles; // columns of window chunks
+   unsigned char *regions; // regions of window chunks
+   unsigned char *status; // faults of window chunks (see 'enum Fault')
+   size_t *kept; // accepted points of window chunks
+   unsigned char *done; // analyzed chunks of the window
+   size_t emitted; // chunks given to the consumer
+   size_t given; // points given to the consumer
+   int emitting; // a thread is calling the consumer
+   SweepConsumer consumer; // consumer of chunks
+   void *context; // first argument of consumer
+   pthread_mutex_t lock; // guards the window
+   pthread_cond_t advanced; // window moved forward
+   struct WorkQueue *queues; // chunks of each thread
+};
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Find the i'th value of the axis. */
+double _axis_value_(struct Axis axis, size_t i) {
+   // Lists don't need any calculation.
+   if (axis.kind == AXIS_LIST) return axis.values[i];
+   if (axis.points == 1) return axis.start;
+   double fraction = (double) i / (axis.points - 1);
+   if (axis.kind == AXIS_LOG)
+      return axis.start * pow(axis.stop / axis.start, fraction);
+   return axis.start + (axis.stop - axis.start) * fraction;
+}
+
+/* Get the parameter and result columns of a window slot. */
+void _tile_columns_(const struct SweepRun *run, size_t slot,
+                    double **params, double **results) {
+   const struct Configuration *config = run->config;
+   double *tile = run->tiles + slot * run->chunk *
+                  (config->nparams + config->nresults);
+   for (size_t p=0; p<config->nparams; p++)
+      params[p] = tile + p * run->chunk;
+   for (size_t r=0; r<config->nresults; r++)
+      results[r] = tile + (config->nparams + r) * run->chunk;
+}
+
+/* Write the parameters of the points in a chunk. */
+void _fill_points_(const struct SweepRun *run, size_t first,
+                   size_t num, double *const *params) {
+   size_t nparams = run->config->nparams;
+   size_t digits[MAX_PARAMS];
+   // Find the axis indices of first point (last axis is fastest).
+   size_t rest = first;
+   for (size_t p=nparams; p-->0;) {
+      digits[p] = rest % run->points[p];
+      rest /= run->points[p];
+   }
+   // Count the next points like an odometer.
+   for (size_t i=0; i<num; i++) {
+      for (size_t p=0; p<nparams; p++)
+         params[p][i] = run->values[p][digits[p]];
+      for (size_t p=nparams; p-->0;) {
+         if (++digits[p] < run->points[p]) break;
+         digits[p] = 0;
+      }
+   }
+}
+
+/* Pack the points of a chunk in the accepted regions to its front
+(in point order) and count them. */
+size_t _keep_points_(const struct SweepRun *run, size_t num,
+                     const unsigned char *regions, unsigned char *status,
+                     double *const *params, double *const *results) {
+   const struct Configuration *config = run->config;
+   size_t kept = 0;
+   for (size_t i=0; i<num; i++) {
+      if ((regions[i] & run->accept) == 0) continue;
+      for (size_t p=0; p<config->nparams; p++)
+         params[p][kept] = params[p][i];
+      for (size_t r=0; r<config->nresults; r++)
+         results[r][kept] = results[r][i];
+      status[kept++] = status[i];
+   }
+   return kept;
+}
+
+/* Restore the parameters of a chunk (its faulty points were
+evaluated with harmless ones) and mask the results of its faulty
+points with NAN. */
+void _mask_faults_(const struct SweepRun *run, size_t first, size_t num,
+                   const unsigned char *status, double *const *params,
+                   double *const *results) {
+   _fill_points_(run, first, num, params);
+   for (size_t r=0; r<run->config->nresults; r++)
+      for (size_t i=0; i<num; i++)
+         if (status[i] != 0) results[r][i] = NAN;
+}
+
+/* Analyze a chunk and give the finished chunks to the consumer in
+point order. */
+void _sweep_chunk_(struct SweepRun *run, size_t chunk) {
+   double *params[MAX_PARAMS], *results[MAX_RESULTS];
+   size_t first = chunk * run->chunk;
+   size_t num = (run->total - first < run->chunk) ?
+                run->total - first : run->chunk;
+   // Analyze the chunk in its window slot.
+   _tile_columns_(run, chunk % run->window, params, results);
+   _fill_points_(run, first, num, params);
+   size_t slot = chunk % run->window, kept = num;
+   unsigned char *status = run->status + slot * run->chunk;
+   // Faulty points are evaluated with harmless parameters, then
+   // masked.
+   if (validate_params(run->config, num, (const double *const *) params,
+                       status) > 0)
+      replace_faulty_params(run->config, num, params, status);
+   run->config->evaluate(num, (const double *const *) params, results);
+   if (validate_results(run->config, num,
+                        (const double *const *) results, status) > 0)
+      _mask_faults_(run, first, num, status, params, results);
+   if (run->accept != 0) {
+      unsigned char *regions = run->regions + slot * run->chunk;
+      classify_regions(run->config, num, (const double *const *) params,
+                       (const double *const *) results, regions);
+      BATCH_LOOP
+      for (size_t i=0; i<num; i++) regions[i] *= (status[i] == 0);
+      kept = _keep_points_(run, num, regions, status, params, results);
+   }
+
+   pthread_mutex_lock(&run->lock);
+   run->kept[slot] = kept;
+   run->done[slot] = 1;
+   // Only one thread calls the consumer, the others go on analyzing.
+   if (!run->emitting) {
+      run->emitting = 1;
+      while (run->emitted < run->chunks &&
+             run->done[run->emitted % run->window]) {
+         size_t next = run->emitted;
+         size_t start = run->given;
+         size_t count = run->kept[next % run->window];
+         pthread_mutex_unlock(&run->lock);
+         // Chunks without any accepted point aren't given.
+         _tile_columns_(run, next % run->window, params, results);
+         if (count > 0)
+            run->consumer(run->context, start, count,
+                          (const double *const *) params,
+                          (const double *const *) results,
+                          run->status + next % run->window * run->chunk);
+         pthread_mutex_lock(&run->lock);
+         run->given += count;
+         run->done[next % run->window] = 0;
+         run->emitted++;
+         pthread_cond_broadcast(&run->advanced);
+      }
+      run->emitting = 0;
+   }
+   pthread_mutex_unlock(&run->lock);
+}
+
+/* Analyze the chunks of a thread and steal others when it's idle. */
+void _sweep_worker_(void *args, size_t index) {
+   struct SweepRun *run = args;
+   struct WorkQueue *queue = &run->queues[index];
+   size_t round = 0, chunk;
+
+   while (1) {
+      // Prefer own chunks, then the chunks of other threads.
+      if (take_work(queue, &chunk)) {
+         _sweep_chunk_(run, chunk);
+         continue;
+      }
+      if (steal_work(run->queues, run->threads, index)) continue;
+      // Take the next own round when the window reaches it.
+      size_t begin = (round * run->threads + index) * SWEEP_ROUND;
+      if (begin >= run->chunks) break;
+      size_t end = (run->chunks - begin < SWEEP_ROUND) ?
+                   run->chunks : begin + SWEEP_ROUND;
+      pthread_mutex_lock(&run->lock);
+      while (end > run->emitted + run->window)
+         pthread_cond_wait(&run->advanced, &run->lock);
+      pthread_mutex_unlock(&run->lock);
+      fill_work_queue(queue, begin, end);
+      round++;
+   }
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Sweep like 'sweep()', but give only the points whose regions are
+in 'accept' (a mask of 'enum Region' bits). The consumer takes the
+accepted points packed in chunks and numbered from 0 in point order,
+and their count is returned. For example, the fixed-bias designs of
+an 'Rb' axis which aren't saturated:
+
+void print_rb(void *context, size_t first, size_t num,
+              const double *const *params,
+              const double *const *results,
+              const unsigned char *status) {
+   for (size_t i=0; i<num; i++)
+      printf("%zu: Rb=%g Ic=%e\n", first + i, params[1][i],
+             results[1][i]);
+}
+struct Axis axes[5] = {
+   {AXIS_LINEAR, 12, 12, 1}, // Vcc
+   {AXIS_LOG, 100000, 1000000, 5}, // Rb
+   {AXIS_LINEAR, 2400, 2400, 1}, // Rc
+   {AXIS_LINEAR, 100, 100, 1}, // beta
+   {AXIS_LINEAR, 50000, 50000, 1}, // ro
+};
+sweep_regions(find_configuration(bjt_configurations,
+      num_bjt_configurations, "fixed_bias"), axes, REGION_ACTIVE,
+      print_rb, NULL, 0);
+
+0: Rb=316228 Ic=3.573374e-03
+1: Rb=562341 Ic=2.009456e-03
+2: Rb=1e+06 Ic=1.130000e-03
+*/
+size_t sweep_regions(const struct Configuration *config,
+                     const struct Axis *axes, unsigned accept,
+                     SweepConsumer consumer, void *context,
+                     size_t threads) {
+   // Check if the parameters of sweep are consistent.
+   assert (config != NULL && axes != NULL && consumer != NULL);
+   // Create the sweep state.
+   struct SweepRun run = {config};
+   run.total = 1;
+   for (size_t p=0; p<config->nparams; p++) {
+      struct Axis axis = axes[p];
+      assert (axis.points > 0);
+      assert (axis.kind != AXIS_LIST || axis.values != NULL);
+      assert (axis.kind != AXIS_LOG || axis.start * axis.stop > 0);
+      assert (run.total <= SIZE_MAX / axis.points);
+      // Calculate the axis values only once.
+      run.points[p] = axis.points;
+      run.values[p] = malloc(axis.points * sizeof(double));
+      assert (run.values[p] != NULL);
+      for (size_t i=0; i<axis.points; i++)
+         run.values[p][i] = _axis_value_(axis, i);
+      run.total *= axis.points;
+   }
+   // A chunk (parameter and result columns) fits the tile size.
+   size_t columns = config->nparams + config->nresults;
+   run.chunk = SWEEP_TILE / (columns * sizeof(double)) / 8 * 8;
+   if (run.chunk < 8) run.chunk = 8;
+   run.chunks = (run.total + run.chunk - 1) / run.chunk;
+   run.threads = _num_threads_(threads);
+   if (run.threads > run.chunks) run.threads = run.chunks;
+   run.window = 2 * run.threads * SWEEP_ROUND;
+   run.accept = accept;
+   run.consumer = consumer;
+   run.context = context;
+   run.tiles = malloc(run.window * run.chunk * columns * sizeof(double));
+   run.regions = malloc(run.window * run.chunk);
+   run.status = malloc(run.window * run.chunk);
+   run.kept = malloc(run.window * sizeof(size_t));
+   run.done = calloc(run.window, 1);
+   assert (run.tiles != NULL && run.regions != NULL &&
+           run.status != NULL);
+   assert (run.kept != NULL && run.done != NULL);
+   pthread_mutex_init(&run.lock, NULL);
+   pthread_cond_init(&run.advanced, NULL);
+   run.queues = create_work_queues(run.threads);
+   // Analyze all chunks in parallel.
+   parallel_run(run.threads, _sweep_worker_, &run);
+
+   destroy_work_queues(run.queues, run.threads);
+   pthread_cond_destroy(&run.advanced);
+   pthread_mutex_destroy(&run.lock);
+   for (size_t p=0; p<config->nparams; p++) free(run.values[p]);
+   free(run.tiles); free(run.regions); free(run.status);
+   free(run.kept); free(run.done);
+   return run.given;
+}
+
+/* Sweep all parameters of any configuration on their axes.
+
+Each parameter of 'config' has its own axis in 'axes' (in the same
+order as 'config->params'). The points are analyzed on 'threads'
+threads (0 means all processors) and 'consumer' takes the parameter
+and result columns and the status mask of each chunk in point order.
+The count of all points is returned.
+
+void print_ic(void *context, size_t first, size_t num,
+              const double *const *params,
+              const double *const *results,
+              const unsigned char *status) {
+   for (size_t i=0; i<num; i++)
+      if (status[i] != 0) printf("%zu: faulty\n", first + i);
+      else printf("%zu: Rf=%g Ic=%e\n", first + i, params[1][i],
+                  results[1][i]);
+}
+const struct Configuration *config = find_configuration(
+      bjt_configurations, num_bjt_configurations,
+      "collector_feedback");
+const double betas[2] = {100, 200};
+struct Axis axes[6] = {
+   {AXIS_LINEAR, 10, 10, 1}, // Vcc
+   {AXIS_LOG, 100000, 1000000, 3}, // Rf
+   {AXIS_LINEAR, 4700, 4700, 1}, // Rc
+   {AXIS_LINEAR, 1200, 1200, 1}, // Re
+   {AXIS_LIST, 0, 0, 2, betas}, // beta
+   {AXIS_LINEAR, 40000, 40000, 1}, // ro
+};
+sweep(config, axes, print_ic, NULL, 0);
+
+0: Rf=100000 Ic=1.347826e-03
+1: Rf=100000 Ic=1.453125e-03
+2: Rf=316228 Ic=1.026232e-03
+3: Rf=316228 Ic=1.243126e-03
+4: Rf=1e+06 Ic=5.849057e-04
+5: Rf=1e+06 Ic=8.532110e-04
+*/
+size_t sweep(const struct Configuration *config, const struct Axis *axes,
+             SweepConsumer consumer, void *context, size_t threads) {
+   return sweep_regions(config, axes, 0, consumer, context, threads);
+}
+
+#endif
@@ -0,0 +1,466 @@
+/* Temperature Analysis of BJT Configurations
+
+BJT.h assumes a room temperature transistor: Vbe is 0.7 V and the
+thermal voltage is 26 mV. But Vbe falls, beta rises and the reverse
+saturation current Ico doubles about every 10 C when the transistor
+is heated. So, this source file solves the operating points of the
+bias configurations at any temperature and finds their stability
+factors, the sensitivities of the collector current to Ico, Vbe and
+beta. Boards can be qualified by a batch run over temperatures and
+designs (like -40..125 C).
+
+IMPORTANT NOTES:
+----------------
+
+1. Include this file instead of BJT.h, it includes it.
+2. Temperatures are in Celsius. At the reference temperature 'T0'
+with no leakage ('Ico0' is 0), the results are equal to the fused
+analyses of BJT.h.
+3. The leakage flows into the base node, so 'Ic = beta * Ib +
+(beta + 1) * Ico' (Boylestad's model).
+4. Stability factors are the exact partial derivatives of Ic:
+S(Ico) = dIc/dIco, S(Vbe) = dIc/dVbe (in A/V) and S(beta) =
+dIc/dbeta (in A).
+5. Only the bias configurations with a feedback path (and fixed-bias
+as the reference) are supported: fixed-bias, emitter-bias,
+voltage-divider and collector-feedback.
+6. Link with '-lm' and '-pthread'.
+
+EXISTING CONFIGURATIONS:
+------------------------
+
++ Fixed-Bias Configuration (bjt_thermal_fixed_bias)
++ Emitter-Bias Configuration (bjt_thermal_emitter_bias)
++ Voltage-Divider Configuration (bjt_thermal_voltage_divider)
++ Collector-Feedback Configuration (bjt_thermal_collector_feedback)
+
+UNIFORM DESCRIPTIONS:
+---------------------
+
++ bjt_thermal_configurations[] (parameters end with "T")
+*/
+
+#ifndef TEMPERATURE_H
+#define TEMPERATURE_H
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include "BJT.h"
+#include "Parallel.h"
+
+// General constants:
+#define KELVIN 273.15
+#define THERMAL_CHUNK 256 // designs of one batch call
+
+// Temperature model of a transistor:
+struct BJT_Thermal {
+   double T0; // reference temperature (C)
+   double VT0; // thermal voltage at T0
+   double Vbe0; // base-emitter voltage at T0
+   double dVbe; // base-emitter voltage change per C
+   double XTB; // temperature exponent of beta
+   double Ico0; // reverse saturation current at T0
+   double Tdouble; // temperature change which doubles Ico
+};
+
+// Typical silicon transistor (beta is given at T0):
+const struct BJT_Thermal bjt_silicon = {25, 0.026, Vbe, -2e-3, 1.5,
+                                        0.1e-9, 10};
+
+// Results of temperature analysis:
+struct BJT_ThermalResults {
+   double T; // temperature (C)
+   double VT; // thermal voltage
+   double VbeT; // base-emitter voltage
+   double betaT; // current gain
+   double IcoT; // reverse saturation current
+   struct BJT_DCResults dc; // DC analysis
+   struct BJT_ACResults ac; // AC analysis
+   double SIco; // stability factor of Ico
+   double SVbe; // stability factor of Vbe
+   double Sbeta; // stability factor of beta
+};
+
+// Columns of a batch temperature run:
+struct ThermalRun {
+   const struct Configuration *config; // thermal configuration
+   size_t ndesigns; // count of designs
+   const double *const *params; // design columns (without "T")
+   size_t ntemperatures; // count of temperatures
+   const double *temperatures; // common temperatures
+   double *const *results; // result columns of all rows
+   size_t threads; // count of threads
+};
+
+// User-defined analysis types:
+typedef struct BJT_ThermalResults BJT_ThermalAnalysis;
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Solve the operating point of a bias configuration at 'T'. The base
+loop is 'V = Ib * Rb + Vbe + ((beta + k) * Ib + (beta + 1) * Ico) *
+Rx', where 'Rx' is the resistance shared by the base and collector
+currents and 'k' is 1 when Ib flows through it. */
+BJT_ThermalAnalysis _bjt_thermal_bias_(double Vcc, double V,
+      double Rb, double Rx, double k, double Rc, double Re,
+      double beta, double T, struct BJT_Thermal model) {
+   // Check if the temperature is above absolute zero.
+   assert (T > -KELVIN && model.T0 > -KELVIN && model.Tdouble > 0);
+   // Create temperature analysis object.
+   BJT_ThermalAnalysis analysis;
+   double ratio = (T + KELVIN) / (model.T0 + KELVIN);
+   analysis.T = T;
+   analysis.VT = model.VT0 * ratio;
+   analysis.VbeT = model.Vbe0 + model.dVbe * (T - model.T0);
+   analysis.betaT = beta * pow(ratio, model.XTB);
+   analysis.IcoT = model.Ico0 * exp2((T - model.T0) / model.Tdouble);
+   // Solve the base current with the leakage.
+   double b = analysis.betaT, Ico = analysis.IcoT;
+   double D = Rb + (b + k) * Rx;
+   double Ib = (V - analysis.VbeT - (b + 1) * Ico * Rx) / D;
+   analysis.dc.Ib = Ib;
+   analysis.dc.Ic = b * Ib + (b + 1) * Ico;
+   analysis.dc.Ie = analysis.dc.Ib + analysis.dc.Ic;
+   analysis.dc.Icsat = Vcc / (Rc + Re);
+   analysis.dc.Vce = Vcc - analysis.dc.Ic * (Rc + Re);
+   analysis.dc.Ve = analysis.dc.Ie * Re;
+   analysis.dc.Vc = analysis.dc.Vce + analysis.dc.Ve;
+   analysis.dc.Vb = analysis.VbeT + analysis.dc.Ve;
+   analysis.dc.Vbc = analysis.dc.Vb - analysis.dc.Vc;
+   // Differentiate Ic = b * Ib + (b + 1) * Ico.
+   double feedback = 1 - b * Rx / D;
+   analysis.SIco = (b + 1) * feedback;
+   analysis.SVbe = -b / D;
+   analysis.Sbeta = (Ib + Ico) * feedback;
+
+   return analysis;
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------- Display Results --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Display the temperature dependent results of any configuration. */
+void bjt_display_thermal_results(BJT_ThermalAnalysis analysis) {
+   // Display the transistor parameters and stability factors.
+   printf("T: %f C\n", analysis.T);
+   printf("VT: %f V\n", analysis.VT);
+   printf("Vbe: %f V\n", analysis.VbeT);
+   printf("beta: %f\n", analysis.betaT);
+   printf("Ico: %e A\n", analysis.IcoT);
+   printf("S(Ico): %f\n", analysis.SIco);
+   printf("S(Vbe): %e A/V\n", analysis.SVbe);
+   printf("S(beta): %e A\n", analysis.Sbeta);
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Temperature analysis of fixed-bias transistor configuration.
+
+double Vcc=12, Rb=470000, Rc=3000, beta=100, ro=50000, T=100;
+BJT_ThermalAnalysis analysis = bjt_thermal_fixed_bias(Vcc, Rb, Rc,
+      beta, ro, T, bjt_silicon);
+bjt_display_thermal_results(analysis);
+
+T: 100.000000 C
+VT: 0.032540 V
+Vbe: 0.550000 V
+beta: 140.014479
+Ico: 1.810193e-08 A
+S(Ico): 141.014479
+S(Vbe): -2.979031e-04 A/V
+S(beta): 2.437980e-05 A
+*/
+BJT_ThermalAnalysis bjt_thermal_fixed_bias(double Vcc, double Rb,
+      double Rc, double beta, double ro, double T,
+      struct BJT_Thermal model) {
+   // Check if parameters of transistor are consistent.
+   assert (Rb > 0 && Rc > 0 && beta > 0 && ro > 0);
+   BJT_ThermalAnalysis analysis = _bjt_thermal_bias_(Vcc, Vcc, Rb, 0,
+         1, Rc, 0, beta, T, model);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac = _bjt_ac_bypassed_(analysis.VT / analysis.dc.Ie, Rb,
+                                   Rc, analysis.betaT, ro);
+
+   return analysis;
+}
+
+/* Temperature analysis of emitter-bias transistor configuration.
+
+double Vcc=20, Rb=470000, Rc=2200, Re=560, beta=120, ro=40000;
+double T=-40;
+BJT_ThermalAnalysis analysis = bjt_thermal_emitter_bias(Vcc, Rb, Rc,
+      Re, beta, ro, T, bjt_silicon);
+bjt_display_thermal_results(analysis);
+
+T: -40.000000 C
+VT: 0.020332 V
+Vbe: 0.830000 V
+beta: 82.981667
+Ico: 1.104854e-12 A
+S(Ico): 76.433541
+S(Vbe): -1.604969e-04 A/V
+S(beta): 3.374474e-05 A
+*/
+BJT_ThermalAnalysis bjt_thermal_emitter_bias(double Vcc, double Rb,
+      double Rc, double Re, double beta, double ro, double T,
+      struct BJT_Thermal model) {
+   // Check if parameters of transistor are consistent.
+   assert (Rb > 0 && Rc > 0 && Re > 0 && beta > 0 && ro > 0);
+   BJT_ThermalAnalysis analysis = _bjt_thermal_bias_(Vcc, Vcc, Rb, Re,
+         1, Rc, Re, beta, T, model);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac = _bjt_ac_unbypassed_(analysis.VT / analysis.dc.Ie, Rb,
+                                     Rc, Re, analysis.betaT, ro);
+
+   return analysis;
+}
+
+/* Temperature analysis of voltage-divider transistor configuration.
+
+double Vcc=16, Rb1=90000, Rb2=10000, Rc=2200;
+double Re=680, beta=210, ro=50000, T=125;
+string bypass = "bypassed";
+BJT_ThermalAnalysis analysis = bjt_thermal_voltage_divider(Vcc, Rb1,
+      Rb2, Rc, Re, beta, ro, bypass, T, bjt_silicon);
+bjt_display_thermal_results(analysis);
+
+T: 125.000000 C
+VT: 0.034720 V
+Vbe: 0.500000 V
+beta: 324.068750
+Ico: 1.024000e-07 A
+S(Ico): 13.678374
+S(Vbe): -1.408708e-03 A/V
+S(beta): 2.013722e-07 A
+*/
+BJT_ThermalAnalysis bjt_thermal_voltage_divider(double Vcc,
+      double Rb1, double Rb2, double Rc, double Re, double beta,
+      double ro, string bypass, double T, struct BJT_Thermal model) {
+   // Check if parameters of transistor are consistent.
+   assert (Rb1 > 0 && Rb2 > 0 && Rc > 0 && Re > 0 && beta > 0 &&
+           ro > 0);
+   assert (strcmp(bypass, "bypassed") == 0 ||
+           strcmp(bypass, "unbypassed") == 0);
+   double rth = _Rth_(Rb1, Rb2);
+   BJT_ThermalAnalysis analysis = _bjt_thermal_bias_(Vcc, _Eth_(Vcc,
+         Rb1, Rb2), rth, Re, 1, Rc, Re, beta, T, model);
+   // According to 'bypass' parameter, there are two options.
+   double re = analysis.VT / analysis.dc.Ie;
+   if (strcmp(bypass, "bypassed") == 0)
+      analysis.ac = _bjt_ac_bypassed_(re, rth, Rc, analysis.betaT, ro);
+   else analysis.ac = _bjt_ac_unbypassed_(re, rth, Rc, Re,
+                                          analysis.betaT, ro);
+
+   return analysis;
+}
+
+/* Temperature analysis of collector-feedback transistor
+configuration. In AC domain, 'Re' is assumed as bypassed.
+
+double Vcc=9, Rf=180000, Rc=2700, Re=1200, beta=200, ro=1e+6, T=0;
+BJT_ThermalAnalysis analysis = bjt_thermal_collector_feedback(Vcc,
+      Rf, Rc, Re, beta, ro, T, bjt_silicon);
+bjt_display_thermal_results(analysis);
+
+T: 0.000000 C
+VT: 0.023820 V
+Vbe: 0.750000 V
+beta: 175.379805
+Ico: 1.767767e-11 A
+S(Ico): 36.746591
+S(Vbe): -2.029903e-04 A/V
+S(beta): 1.989381e-06 A
+*/
+BJT_ThermalAnalysis bjt_thermal_collector_feedback(double Vcc,
+      double Rf, double Rc, double Re, double beta, double ro,
+      double T, struct BJT_Thermal model) {
+   // Check if parameters of transistor are consistent.
+   assert (Rf > 0 && Rc > 0 && Re > 0 && beta > 0 && ro > 0);
+   BJT_ThermalAnalysis analysis = _bjt_thermal_bias_(Vcc, Vcc, Rf,
+         Rc + Re, 0, Rc, Re, beta, T, model);
+   // Calculate the AC analyzes at the same operating point.
+   analysis.ac = _bjt_ac_feedback_(analysis.VT / analysis.dc.Ie, Rf,
+                                   Rc, analysis.betaT, ro);
+
+   return analysis;
+}
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Uniform Definations -------------------- */
+/* --------------------------------------------------------------- */
+
+/* Store the temperature analysis of i'th design to the uniform
+result columns. */
+void _bjt_store_thermal_(BJT_ThermalAnalysis analysis, size_t i,
+                         double *const *results) {
+   BJT_FusedAnalysis fused = {analysis.dc, analysis.ac};
+   _bjt_store_fused_(fused, i, _bjt_dc_columns_(results),
+                     _bjt_ac_columns_(results));
+   results[13][i] = analysis.SIco;
+   results[14][i] = analysis.SVbe;
+   results[15][i] = analysis.Sbeta;
+}
+
+/* Uniform evaluations of temperature analyses for the engines. The
+transistors are typical silicon transistors ('bjt_silicon'). */
+BATCH_DISPATCH
+void _bjt_thermal_fixed_bias_(size_t num, const double *const *params,
+                              double *const *results) {
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _bjt_store_thermal_(bjt_thermal_fixed_bias(params[0][i],
+            params[1][i], params[2][i], params[3][i], params[4][i],
+            params[5][i], bjt_silicon), i, results);
+}
+
+BATCH_DISPATCH
+void _bjt_thermal_emitter_bias_(size_t num,
+      const double *const *params, double *const *results) {
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _bjt_store_thermal_(bjt_thermal_emitter_bias(params[0][i],
+            params[1][i], params[2][i], params[3][i], params[4][i],
+            params[5][i], params[6][i], bjt_silicon), i, results);
+}
+
+BATCH_DISPATCH
+void _bjt_thermal_voltage_divider_(size_t num,
+      const double *const *params, double *const *results) {
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _bjt_store_thermal_(bjt_thermal_voltage_divider(params[0][i],
+            params[1][i], params[2][i], params[3][i], params[4][i],
+            params[5][i], params[6][i], "bypassed", params[7][i],
+            bjt_silicon), i, results);
+}
+
+BATCH_DISPATCH
+void _bjt_thermal_voltage_divider_unbypassed_(size_t num,
+      const double *const *params, double *const *results) {
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _bjt_store_thermal_(bjt_thermal_voltage_divider(params[0][i],
+            params[1][i], params[2][i], params[3][i], params[4][i],
+            params[5][i], params[6][i], "unbypassed", params[7][i],
+            bjt_silicon), i, results);
+}
+
+BATCH_DISPATCH
+void _bjt_thermal_collector_feedback_(size_t num,
+      const double *const *params, double *const *results) {
+   BATCH_LOOP
+   for (size_t i=0; i<num; i++)
+      _bjt_store_thermal_(bjt_thermal_collector_feedback(params[0][i],
+            params[1][i], params[2][i], params[3][i], params[4][i],
+            params[5][i], params[6][i], bjt_silicon), i, results);
+}
+
+// Result fields of all thermal BJT configurations:
+#define BJT_THERMAL_RESULTS 16, {"Ib", "Ic", "Ie", "Icsat", "Vce", \
+   "Vc", "Ve", "Vb", "Vbc", "re", "Zi", "Zo", "Av", "SIco", "SVbe", \
+   "Sbeta"}, {1, 4, 12, 10, 11}
+
+/* Uniform descriptions of thermal BJT configurations. The parameters
+are in the same order as the 'thermal_*()' functions. So, a sweep
+(see Sweep.h) can add a temperature axis to any design axes. Their
+DC fields are the BJT ones, so are their regions. */
+const struct Configuration bjt_thermal_configurations[] = {
+   {"fixed_bias", 6, {"Vcc", "Rb", "Rc", "beta", "ro", "T"},
+    BJT_THERMAL_RESULTS, _bjt_thermal_fixed_bias_, _bjt_uniform_regions_,
+    0x1E},
+   {"emitter_bias", 7, {"Vcc", "Rb", "Rc", "Re", "beta", "ro", "T"},
+    BJT_THERMAL_RESULTS, _bjt_thermal_emitter_bias_,
+    _bjt_uniform_regions_, 0x3E},
+   {"voltage_divider", 8, {"Vcc", "Rb1", "Rb2", "Rc", "Re", "beta",
+    "ro", "T"}, BJT_THERMAL_RESULTS, _bjt_thermal_voltage_divider_,
+    _bjt_uniform_regions_, 0x7E},
+   {"voltage_divider_unbypassed", 8, {"Vcc", "Rb1", "Rb2", "Rc",
+    "Re", "beta", "ro", "T"}, BJT_THERMAL_RESULTS,
+    _bjt_thermal_voltage_divider_unbypassed_, _bjt_uniform_regions_,
+    0x7E},
+   {"collector_feedback", 7, {"Vcc", "Rf", "Rc", "Re", "beta", "ro",
+    "T"}, BJT_THERMAL_RESULTS, _bjt_thermal_collector_feedback_,
+    _bjt_uniform_regions_, 0x3E},
+};
+
+// Number of uniform thermal BJT configurations:
+const size_t num_bjt_thermal_configurations =
+   sizeof(bjt_thermal_configurations) /
+   sizeof(bjt_thermal_configurations[0]);
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Batch Definations -------------------- */
+/* --------------------------------------------------------------- */
+
+/* Evaluate the chunks of a batch temperature run. A chunk is up to
+THERMAL_CHUNK designs at one temperature. */
+void _thermal_worker_(void *args, size_t index) {
+   struct ThermalRun *run = args;
+   const struct Configuration *config = run->config;
+   size_t last_param = config->nparams - 1;
+   size_t chunks = (run->ndesigns + THERMAL_CHUNK - 1) / THERMAL_CHUNK;
+   size_t total = chunks * run->ntemperatures;
+   size_t first = total * index / run->threads;
+   size_t last = total * (index + 1) / run->threads;
+   double temperatures[THERMAL_CHUNK];
+   const double *params[MAX_PARAMS];
+   double *results[MAX_RESULTS];
+   for (size_t c=first; c<last; c++) {
+      size_t t = c / chunks, begin = (c % chunks) * THERMAL_CHUNK;
+      size_t num = run->ndesigns - begin;
+      if (num > THERMAL_CHUNK) num = THERMAL_CHUNK;
+      // Offset the columns to the chunk and fill the temperatures.
+      for (size_t p=0; p<last_param; p++)
+         params[p] = run->params[p] + begin;
+      for (size_t i=0; i<num; i++)
+         temperatures[i] = run->temperatures[t];
+      params[last_param] = temperatures;
+      size_t row = t * run->ndesigns + begin;
+      for (size_t r=0; r<config->nresults; r++)
+         results[r] = run->results[r] + row;
+      config->evaluate(num, params, results);
+   }
+}
+
+/* Analyze 'ndesigns' designs at 'ntemperatures' temperatures on
+'threads' threads (0 means all processors). 'params' has a column
+for each parameter of 'config' except the last ("T"). The results of
+design 'd' at temperature 't' are written to the row
+'t * ndesigns + d' of 'results' columns.
+
+const struct Configuration *config = find_configuration(
+      bjt_thermal_configurations, num_bjt_thermal_configurations,
+      "voltage_divider");
+double temperatures[166];
+for (size_t t=0; t<166; t++) temperatures[t] = -40 + (double) t;
+bjt_thermal_batch(config, ndesigns, params, 166, temperatures,
+                  results, 0);
+*/
+void bjt_thermal_batch(const struct Configuration *config,
+      size_t ndesigns, const double *const *params,
+      size_t ntemperatures, const double *temperatures,
+      double *const *results, size_t threads) {
+   // Check if the configuration and columns are consistent.
+   assert (config != NULL && params != NULL && results != NULL);
+   assert (config->nparams > 0 &&
+           strcmp(config->params[config->nparams - 1], "T") == 0);
+   assert (temperatures != NULL || ntemperatures == 0);
+   struct ThermalRun run = {config, ndesigns, params, ntemperatures,
+                            temperatures, results};
+   size_t chunks = (ndesigns + THERMAL_CHUNK - 1) / THERMAL_CHUNK;
+   run.threads = _num_threads_(threads);
+   if (run.threads > chunks * ntemperatures)
+      run.threads = chunks * ntemperatures;
+   if (run.threads > 0) parallel_run(run.threads, _thermal_worker_,
+                                     &run);
+}
+
+#endif
@@ -0,0 +1,241 @@
+/* TransCal Library: Mixed-Device Dispatch and Batch Jobs
+
+This source file is the only one which includes all families. See
+TransCal.h for the usage.
+*/
+
+// Libraries:
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "BJT.h"
+#include "JFET.h"
+#include "MOSFET.h"
+#include "Parallel.h"
+#include "TransCal.h"
+
+// Configuration table of a family:
+struct DeviceTable {
+   const struct Configuration *configurations; // family table
+   size_t num; // count of configurations
+};
+
+// Group of jobs with the same configuration:
+struct JobGroup {
+   const struct Configuration *config; // common configuration
+   size_t first; // first position in the job order
+   size_t num; // count of jobs
+};
+
+// Block of jobs analyzed together:
+struct JobBlock {
+   const struct Configuration *config; // common configuration
+   size_t first; // first position in the job order
+   size_t num; // count of jobs (at most JOB_BLOCK)
+};
+
+// Common state of a job run:
+struct JobRun {
+   struct Job *jobs; // all jobs
+   size_t *order; // job indices grouped by configuration
+   struct JobBlock *blocks; // blocks of all groups
+   struct WorkQueue *queues; // blocks of each thread
+   size_t threads; // count of threads
+   size_t *faults; // faulty jobs found by each thread
+};
+
+// Names of transistor families:
+const string device_names[NUM_DEVICES] = {"bjt", "jfet", "mosfet"};
+
+// Dispatch table of all families (see 'enum Device'):
+static const struct DeviceTable device_tables[NUM_DEVICES] = {
+   {bjt_configurations,
+    sizeof(bjt_configurations) / sizeof(bjt_configurations[0])},
+   {jfet_configurations,
+    sizeof(jfet_configurations) / sizeof(jfet_configurations[0])},
+   {mosfet_configurations,
+    sizeof(mosfet_configurations) / sizeof(mosfet_configurations[0])},
+};
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Analyze a block of jobs with the batch evaluation and count its
+faulty jobs. */
+static size_t _run_block_(const struct JobRun *run,
+                          struct JobBlock block, double *columns) {
+   const struct Configuration *config = block.config;
+   double *params[MAX_PARAMS], *results[MAX_RESULTS];
+   unsigned char status[JOB_BLOCK];
+   // Gather the parameter columns of jobs.
+   for (size_t p=0; p<config->nparams; p++) {
+      params[p] = columns + p * JOB_BLOCK;
+      for (size_t i=0; i<block.num; i++)
+         params[p][i] = run->jobs[run->order[block.first + i]].params[p];
+   }
+   for (size_t r=0; r<config->nresults; r++)
+      results[r] = columns + (MAX_PARAMS + r) * JOB_BLOCK;
+   // Analyze all jobs together (faulty ones with harmless
+   // parameters) and scatter their results and faults.
+   if (validate_params(config, block.num,
+                       (const double *const *) params, status) > 0)
+      replace_faulty_params(config, block.num, params, status);
+   config->evaluate(block.num, (const double *const *) params, results);
+   size_t faults = validate_results(config, block.num,
+                                    (const double *const *) results,
+                                    status);
+   for (size_t r=0; r<config->nresults; r++)
+      for (size_t i=0; i<block.num; i++)
+         run->jobs[run->order[block.first + i]].results[r] =
+            results[r][i];
+   for (size_t i=0; i<block.num; i++)
+      run->jobs[run->order[block.first + i]].status = status[i];
+   return faults;
+}
+
+/* Analyze the blocks of a thread and steal others when it's idle. */
+static void _job_worker_(void *args, size_t index) {
+   struct JobRun *run = args;
+   double *columns = malloc((MAX_PARAMS + MAX_RESULTS) * JOB_BLOCK *
+                            sizeof(double));
+   assert (columns != NULL);
+   size_t item;
+   // Prefer own blocks, then the blocks of other threads.
+   while (1) {
+      if (take_work(&run->queues[index], &item))
+         run->faults[index] += _run_block_(run, run->blocks[item],
+                                           columns);
+      else if (!steal_work(run->queues, run->threads, index)) break;
+   }
+   free(columns);
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Find the family named 'name'.
+
+enum Device device = find_device("jfet");
+
+device: DEVICE_JFET
+*/
+enum Device find_device(const char *name) {
+   // Search the family names.
+   for (int d=0; d<NUM_DEVICES; d++)
+      if (strcmp(device_names[d], name) == 0) return d;
+   return NUM_DEVICES;
+}
+
+/* Get the configuration table of a family and its size.
+
+size_t num;
+const struct Configuration *table = device_configurations(
+      DEVICE_MOSFET, &num);
+
+table[0].name: drain_feedback, num: 2
+*/
+const struct Configuration *device_configurations(enum Device device,
+                                                  size_t *num) {
+   // Check if the family exists.
+   assert (device < NUM_DEVICES && num != NULL);
+   *num = device_tables[device].num;
+   return device_tables[device].configurations;
+}
+
+/* Find the configuration named 'name' of a family.
+
+const struct Configuration *config = dispatch(DEVICE_BJT,
+                                              "voltage_divider");
+
+config->nparams: 7, config->params[1]: Rb1
+*/
+const struct Configuration *dispatch(enum Device device,
+                                     const char *name) {
+   // Check if the family exists.
+   assert (device < NUM_DEVICES && name != NULL);
+   return find_configuration(device_tables[device].configurations,
+                             device_tables[device].num, name);
+}
+
+/* Analyze 'num' jobs of any configurations and count the faulty
+ones. A faulty job has its fault in 'status' (see 'enum Fault').
+
+struct Job jobs[3] = {
+   {dispatch(DEVICE_BJT, "fixed_bias"), {12, 240000, 2200, 50, 40000}},
+   {dispatch(DEVICE_JFET, "self_bias"),
+    {20, 1000000, 3300, 1000, 0.008, -6, 50000}},
+   {dispatch(DEVICE_BJT, "fixed_bias"), {12, 0, 2200, 50, 40000}},
+};
+size_t faults = run_jobs(jobs, 3, 0);
+
+jobs[0].results[1] (Ic): 2.354167e-03
+jobs[1].results[0] (Id): 2.587624e-03
+faults: 1, jobs[2].status: FAULT_PARAMETER
+*/
+size_t run_jobs(struct Job *jobs, size_t num, size_t threads) {
+   // Check if the jobs are consistent.
+   assert (jobs != NULL || num == 0);
+   if (num == 0) return 0;
+   // Find the groups in the order of first appearances.
+   size_t ngroups = 0, capacity = NUM_DEVICES * 8;
+   struct JobGroup *groups = malloc(capacity * sizeof(struct JobGroup));
+   size_t *group = malloc(num * sizeof(size_t));
+   assert (groups != NULL && group != NULL);
+   for (size_t j=0; j<num; j++) {
+      assert (jobs[j].config != NULL);
+      size_t g = 0;
+      while (g < ngroups && groups[g].config != jobs[j].config) g++;
+      if (g == ngroups) {
+         if (ngroups == capacity) {
+            capacity *= 2;
+            groups = realloc(groups, capacity * sizeof(struct JobGroup));
+            assert (groups != NULL);
+         }
+         groups[ngroups++] = (struct JobGroup) {jobs[j].config, 0, 0};
+      }
+      groups[g].num++;
+      group[j] = g;
+   }
+   // Sort the jobs by groups (counting sort keeps their order).
+   struct JobRun run = {jobs};
+   run.order = malloc(num * sizeof(size_t));
+   assert (run.order != NULL);
+   size_t nblocks = 0;
+   for (size_t g=0, first=0; g<ngroups; g++) {
+      groups[g].first = first;
+      first += groups[g].num;
+      nblocks += (groups[g].num + JOB_BLOCK - 1) / JOB_BLOCK;
+   }
+   size_t *next = malloc(ngroups * sizeof(size_t));
+   assert (next != NULL);
+   for (size_t g=0; g<ngroups; g++) next[g] = groups[g].first;
+   for (size_t j=0; j<num; j++) run.order[next[group[j]]++] = j;
+   // Split the groups to blocks.
+   run.blocks = malloc(nblocks * sizeof(struct JobBlock));
+   assert (run.blocks != NULL);
+   nblocks = 0;
+   for (size_t g=0; g<ngroups; g++)
+      for (size_t i=0; i<groups[g].num; i+=JOB_BLOCK)
+         run.blocks[nblocks++] = (struct JobBlock) {groups[g].config,
+            groups[g].first + i, (groups[g].num - i < JOB_BLOCK) ?
+            groups[g].num - i : JOB_BLOCK};
+   // Analyze the blocks in parallel.
+   run.threads = _num_threads_(threads);
+   if (run.threads > nblocks) run.threads = nblocks;
+   run.queues = create_work_queues(run.threads);
+   run.faults = calloc(run.threads, sizeof(size_t));
+   assert (run.faults != NULL);
+   for (size_t t=0; t<run.threads; t++)
+      fill_work_queue(&run.queues[t], nblocks * t / run.threads,
+                      nblocks * (t + 1) / run.threads);
+   parallel_run(run.threads, _job_worker_, &run);
+
+   size_t faults = 0;
+   for (size_t t=0; t<run.threads; t++) faults += run.faults[t];
+   destroy_work_queues(run.queues, run.threads);
+   free(groups); free(group); free(next);
+   free(run.order); free(run.blocks); free(run.faults);
+   return faults;
+}
@@ -0,0 +1,75 @@
+/* TransCal Library: Mixed-Device Dispatch and Batch Jobs
+
+BJT.h, JFET.h and MOSFET.h define their functions in themselves as
+'static inline' ones (like Format.h), so any source files can
+include them. TransCal.c is the source file of the library: it
+includes all families and provides a dispatch table keyed by
+(device, configuration) and a batch job runner. So, one process
+handles mixed BJT and FET jobs.
+
+cc -O3 -DNDEBUG -fno-math-errno -c TransCal.c
+cc -O3 program.c TransCal.o -lm -pthread
+
+IMPORTANT NOTES:
+----------------
+
+1. Programs which link the library may include the family files
+too (like golden.c), for example to call 'bjt_analyze_*()' directly.
+Only the functions of this file are external symbols of the library.
+2. Jobs are grouped by configuration and each group is analyzed by
+the batch (vectorized) evaluation of its configuration. So, the
+order of jobs doesn't matter for the throughput.
+3. Results are written to the jobs themselves, in the same order
+as 'config->results'.
+4. Jobs are validated (see 'validate_results()'), so a faulty job
+doesn't abort the others. Its fault is written to 'status' and its
+results are meaningless.
+*/
+
+#ifndef TRANSCAL_H
+#define TRANSCAL_H
+
+// Libraries:
+#include <stddef.h>
+#include "Configuration.h"
+
+// General constants:
+#define JOB_BLOCK 256 // jobs analyzed together
+
+// Transistor families:
+enum Device {
+   DEVICE_BJT, // BJT.h configurations
+   DEVICE_JFET, // JFET.h configurations
+   DEVICE_MOSFET, // MOSFET.h configurations
+   NUM_DEVICES
+};
+
+// A job of any configuration:
+struct Job {
+   const struct Configuration *config; // found by 'dispatch()'
+   double params[MAX_PARAMS]; // parameters in 'config->params' order
+   double results[MAX_RESULTS]; // results in 'config->results' order
+   unsigned char status; // fault of the job (see 'enum Fault') or 0
+};
+
+// Names of transistor families ("bjt", "jfet", "mosfet"):
+extern const string device_names[NUM_DEVICES];
+
+/* Find the family named 'name'. If it doesn't exist, NUM_DEVICES is
+returned. */
+enum Device find_device(const char *name);
+
+/* Get the configuration table of a family and its size. */
+const struct Configuration *device_configurations(enum Device device,
+                                                  size_t *num);
+
+/* Find the configuration named 'name' of a family. If it doesn't
+exist, NULL is returned. */
+const struct Configuration *dispatch(enum Device device,
+                                     const char *name);
+
+/* Analyze 'num' jobs of any configurations on 'threads' threads (0
+means all processors). The count of faulty jobs is returned. */
+size_t run_jobs(struct Job *jobs, size_t num, size_t threads);
+
+#endif
@@ -0,0 +1,948 @@
+/* Microbenchmarks of TransCal Configurations
+
+This program measures every configuration function of BJT.h, JFET.h
+and MOSFET.h (plus two-port and cascaded systems, see Cascade.h for
+their batch and tree paths) in scalar, fused
+and batch paths, their Jacobians (see Sensitivity.h), their float
+screening (see Precision.h), their cached lookups (see Cache.h),
+their incremental sweeps (see Incremental.h), their exact operating
+points (see EbersMoll.h), their netlists (see Netlist.h), their
+region classifiers (see Configuration.h), their curves (see Curve.h)
+and the text formatting of results. Inputs are
+randomized around the documented examples (+-20%), every benchmark
+is warmed up before measuring and the process is pinned to one CPU.
+Results are written as JSON, so they can be compared between
+compiler flags and releases.
+
+cc -O3 -DNDEBUG -fno-math-errno -o bench bench.c -lm -pthread
+./bench [-n points] [-r repeats] [-c cpu] [-f filter] > bench.json
+
+IMPORTANT NOTES:
+----------------
+
+1. 'ns_per_op' is the median of repeats, 'min_ns_per_op' is the
+fastest repeat. 'points_per_second' is found from the median.
+2. '-c -1' doesn't pin the process to any CPU.
+3. '-f' runs only the benchmarks whose names contain the filter.
+4. Cache paths are warmed up like the others, so they measure hits
+(the cache holds twice the points).
+5. Incremental paths keep the first design and sweep only its load
+side ('ro' or 'rd') over the points. Compare them with the scalar
+'ac_*' benchmarks of the same configuration.
+6. 'bjt_cascade_update' builds one chain of all points (its stages
+are the first three parameters) and updates each stage once, so it
+measures O(log points) updates.
+7. Exact paths solve the same designs as the closed-form ones (the
+fixed-bias designs straddle saturation), so compare 'bjt_exact_*'
+with 'bjt_analyze_*' and the exact batches with the closed-form
+batches.
+8. Netlist paths build their netlists once (on the first pass) and
+change only values, so they measure numeric refactorizations.
+'netlist_sweep_64_stages' sweeps the shared divider of 64 stages
+(195 unknowns) over 'R2', one point per design.
+9. Region paths evaluate the batches and classify them, so compare
+them with the batch paths of the same configuration for the cost of
+classifiers.
+10. Curve paths write BENCH_CURVE_POINTS points of each design to
+/dev/null (binary or CSV) and find its Q-point, so their 'ns_per_op'
+is per curve.
+11. Validation paths find the status masks of the batches before and
+after evaluating them (like the engines, see 'validate_results()'),
+so compare them with the batch paths for the cost of validation.
+*/
+
+#define _GNU_SOURCE
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "Sensitivity.h"
+#include "Precision.h"
+#include "Cache.h"
+#include "Incremental.h"
+#include "Cascade.h"
+#include "EbersMoll.h"
+#include "Netlist.h"
+#include "Curve.h"
+
+// General constants:
+#define BENCH_POINTS 4096 // default points of each pass
+#define BENCH_REPEATS 11 // default measured passes
+#define BENCH_WARMUP 0.05 // seconds of warmup
+#define BENCH_SPREAD 0.2 // relative spread of inputs
+#define BENCH_SEED 0x5EED2024 // seed of inputs
+#define BENCH_CURVE_POINTS 256 // points of each curve in curve paths
+
+// Benchmark runner over parameter columns:
+typedef void (*Runner)(size_t num, const double *const *params,
+                       double *sink);
+
+// A benchmark:
+struct Benchmark {
+   string name; // measured function
+   string device; // transistor family
+   string path; // scalar, fused, batch, jacobian, screen, cache,
+                // incremental, exact, netlist, regions, validate,
+                // curves or format
+   string config; // uniform configuration of batch, jacobian, screen,
+                  // cache, exact, regions and validate
+   Runner run; // runner of scalar and explicit batch paths
+   size_t nparams; // count of parameters
+   double nominal[MAX_PARAMS]; // documented example parameters
+};
+
+// Result columns of batch paths:
+double *bench_results[MAX_RESULTS];
+double *bench_jacobian[MAX_RESULTS * MAX_PARAMS];
+double *bench_tree;
+float *bench_float_params[MAX_PARAMS];
+float *bench_float_results[MAX_RESULTS];
+unsigned char *bench_status;
+unsigned char *bench_regions;
+struct ResultCache *bench_cache;
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Sum all fields of results, so none of them is optimized away. */
+double _bjt_dc_sum_(BJT_DCAnalysis a) {
+   return a.Ib + a.Ic + a.Ie + a.Icsat + a.Vce + a.Vc + a.Ve + a.Vb +
+          a.Vbc;
+}
+double _bjt_ac_sum_(BJT_ACAnalysis a) {
+   return a.re + a.Zi + a.Zo + a.Av;
+}
+double _jfet_dc_sum_(JFET_DCAnalysis a) {
+   return a.Id + a.Vgs + a.Vds + a.Vs + a.Vd + a.Vg;
+}
+double _jfet_ac_sum_(JFET_ACAnalysis a) {
+   return a.gm + a.Zi + a.Zo + a.Av;
+}
+double _mosfet_dc_sum_(MOSFET_DCAnalysis a) {
+   return a.k + a.Id + a.Vgs + a.Vds;
+}
+double _mosfet_ac_sum_(MOSFET_ACAnalysis a) {
+   return a.gm + a.Zi + a.Zo + a.Av;
+}
+
+// Scalar runner of a call whose results are summed by 'sum':
+#define P(k) params[k][i]
+#define SCALAR(runner, sum, call) \
+   void runner(size_t num, const double *const *params, double *sink) {\
+      double total = 0; \
+      for (size_t i=0; i<num; i++) total += sum(call); \
+      *sink += total; \
+   }
+
+SCALAR(_bjt_dc_fixed_bias_, _bjt_dc_sum_,
+       bjt_dc_fixed_bias(P(0), P(1), P(2), P(3)))
+SCALAR(_bjt_ac_fixed_bias_, _bjt_ac_sum_,
+       bjt_ac_fixed_bias(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_bjt_dc_emitter_bias_, _bjt_dc_sum_,
+       bjt_dc_emitter_bias(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_bjt_ac_emitter_bias_, _bjt_ac_sum_,
+       bjt_ac_emitter_bias(P(0), P(1), P(2), P(3), P(4), P(5)))
+SCALAR(_bjt_dc_voltage_divider_, _bjt_dc_sum_,
+       bjt_dc_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5)))
+SCALAR(_bjt_ac_voltage_divider_, _bjt_ac_sum_,
+       bjt_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                              P(6), "bypassed"))
+SCALAR(_bjt_ac_voltage_divider_unbypassed_, _bjt_ac_sum_,
+       bjt_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                              P(6), "unbypassed"))
+SCALAR(_bjt_dc_collector_feedback_, _bjt_dc_sum_,
+       bjt_dc_collector_feedback(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_bjt_ac_collector_feedback_, _bjt_ac_sum_,
+       bjt_ac_collector_feedback(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_bjt_ac_collector_dc_feedback_, _bjt_ac_sum_,
+       bjt_ac_collector_dc_feedback(P(0), P(1), P(2), P(3), P(4),
+                                    P(5)))
+SCALAR(_bjt_dc_emitter_follower_, _bjt_dc_sum_,
+       bjt_dc_emitter_follower(P(0), P(1), P(2), P(3)))
+SCALAR(_bjt_ac_emitter_follower_, _bjt_ac_sum_,
+       bjt_ac_emitter_follower(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_bjt_dc_common_base_, _bjt_dc_sum_,
+       bjt_dc_common_base(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_bjt_ac_common_base_, _bjt_ac_sum_,
+       bjt_ac_common_base(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_bjt_dc_miscellaneous_bias_, _bjt_dc_sum_,
+       bjt_dc_miscellaneous_bias(P(0), P(1), P(2), P(3)))
+
+SCALAR(_jfet_dc_fixed_bias_, _jfet_dc_sum_,
+       jfet_dc_fixed_bias(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_jfet_ac_fixed_bias_, _jfet_ac_sum_,
+       jfet_ac_fixed_bias(P(0), P(1), P(2), P(3), P(4), P(5), P(6)))
+SCALAR(_jfet_dc_self_bias_, _jfet_dc_sum_,
+       jfet_dc_self_bias(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_jfet_ac_self_bias_, _jfet_ac_sum_,
+       jfet_ac_self_bias(P(0), P(1), P(2), P(3), P(4), P(5), P(6)))
+SCALAR(_jfet_dc_voltage_divider_, _jfet_dc_sum_,
+       jfet_dc_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                               P(6)))
+SCALAR(_jfet_ac_voltage_divider_, _jfet_ac_sum_,
+       jfet_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                               P(6), P(7)))
+SCALAR(_jfet_dc_common_gate_, _jfet_dc_sum_,
+       jfet_dc_common_gate(P(0), P(1), P(2), P(3), P(4), P(5)))
+SCALAR(_jfet_ac_common_gate_, _jfet_ac_sum_,
+       jfet_ac_common_gate(P(0), P(1), P(2), P(3), P(4), P(5), P(6)))
+SCALAR(_jfet_ac_source_follower_, _jfet_ac_sum_,
+       jfet_ac_source_follower(P(0), P(1), P(2), P(3), P(4), P(5),
+                               P(6)))
+
+SCALAR(_mosfet_dc_drain_feedback_, _mosfet_dc_sum_,
+       mosfet_dc_drain_feedback(P(0), P(1), P(2), P(3), P(4), P(5)))
+SCALAR(_mosfet_ac_drain_feedback_, _mosfet_ac_sum_,
+       mosfet_ac_drain_feedback(P(0), P(1), P(2), P(3), P(4), P(5),
+                                P(6)))
+SCALAR(_mosfet_dc_voltage_divider_, _mosfet_dc_sum_,
+       mosfet_dc_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                 P(6), P(7)))
+SCALAR(_mosfet_ac_voltage_divider_, _mosfet_ac_sum_,
+       mosfet_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                 P(6), P(7), P(8)))
+
+// Fused paths sum both DC and AC results:
+#define BJT_FUSED(a) (_bjt_dc_sum_((a).dc) + _bjt_ac_sum_((a).ac))
+#define JFET_FUSED(a) (_jfet_dc_sum_((a).dc) + _jfet_ac_sum_((a).ac))
+#define MOSFET_FUSED(a) \
+   (_mosfet_dc_sum_((a).dc) + _mosfet_ac_sum_((a).ac))
+
+SCALAR(_bjt_analyze_fixed_bias_, BJT_FUSED,
+       bjt_analyze_fixed_bias(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_bjt_analyze_emitter_bias_, BJT_FUSED,
+       bjt_analyze_emitter_bias(P(0), P(1), P(2), P(3), P(4), P(5)))
+SCALAR(_bjt_analyze_voltage_divider_, BJT_FUSED,
+       bjt_analyze_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                   P(6), "bypassed"))
+SCALAR(_bjt_analyze_collector_feedback_, BJT_FUSED,
+       bjt_analyze_collector_feedback(P(0), P(1), P(2), P(3), P(4),
+                                      P(5)))
+SCALAR(_bjt_analyze_emitter_follower_, BJT_FUSED,
+       bjt_analyze_emitter_follower(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_bjt_analyze_common_base_, BJT_FUSED,
+       bjt_analyze_common_base(P(0), P(1), P(2), P(3), P(4)))
+SCALAR(_jfet_analyze_fixed_bias_, JFET_FUSED,
+       jfet_analyze_fixed_bias(P(0), P(1), P(2), P(3), P(4), P(5),
+                               P(6)))
+SCALAR(_jfet_analyze_self_bias_, JFET_FUSED,
+       jfet_analyze_self_bias(P(0), P(1), P(2), P(3), P(4), P(5),
+                              P(6)))
+SCALAR(_jfet_analyze_voltage_divider_, JFET_FUSED,
+       jfet_analyze_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                    P(6), P(7)))
+SCALAR(_jfet_analyze_common_gate_, JFET_FUSED,
+       jfet_analyze_common_gate(P(0), P(1), P(2), P(3), P(4), P(5),
+                                P(6)))
+SCALAR(_mosfet_analyze_drain_feedback_, MOSFET_FUSED,
+       mosfet_analyze_drain_feedback(P(0), P(1), P(2), P(3), P(4),
+                                     P(5), P(6)))
+SCALAR(_mosfet_analyze_voltage_divider_, MOSFET_FUSED,
+       mosfet_analyze_voltage_divider(P(0), P(1), P(2), P(3), P(4),
+                                      P(5), P(6), P(7), P(8)))
+
+// Exact analyses (with typical silicon junctions) sum both DC and AC
+// results like fused paths:
+SCALAR(_bjt_exact_fixed_bias_runner_, BJT_FUSED,
+       bjt_exact_fixed_bias(P(0), P(1), P(2), P(3), P(4),
+                            bjt_junctions))
+SCALAR(_bjt_exact_emitter_bias_runner_, BJT_FUSED,
+       bjt_exact_emitter_bias(P(0), P(1), P(2), P(3), P(4), P(5),
+                              bjt_junctions))
+SCALAR(_bjt_exact_voltage_divider_runner_, BJT_FUSED,
+       bjt_exact_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                 P(6), "bypassed", bjt_junctions))
+SCALAR(_bjt_exact_collector_feedback_runner_, BJT_FUSED,
+       bjt_exact_collector_feedback(P(0), P(1), P(2), P(3), P(4), P(5),
+                                    bjt_junctions))
+
+/* Voltage-divider designs solved by one netlist (element 'k' is the
+k'th parameter). */
+void _bjt_netlist_voltage_divider_(size_t num,
+      const double *const *params, double *sink) {
+   static struct Netlist *netlist = NULL;
+   if (netlist == NULL) {
+      netlist = create_netlist(5, 6);
+      netlist_voltage_source(netlist, "Vcc", 1, 0, 1);
+      netlist_resistor(netlist, "Rb1", 1, 2, 1);
+      netlist_resistor(netlist, "Rb2", 2, 0, 1);
+      netlist_resistor(netlist, "Rc", 1, 3, 1);
+      netlist_resistor(netlist, "Re", 4, 0, 1);
+      netlist_bjt(netlist, "Q", 3, 2, 4, 1);
+   }
+   double total = 0;
+   for (size_t i=0; i<num; i++) {
+      for (size_t k=0; k<6; k++) netlist_set_value(netlist, k, P(k));
+      netlist_solve(netlist);
+      total += netlist_current(netlist, 5) + netlist_voltage(netlist, 3);
+   }
+   *sink += total;
+}
+
+/* 64 voltage-divider stages sharing one divider, swept over 'R2'
+(the third parameter). */
+void _netlist_sweep_64_stages_(size_t num, const double *const *params,
+                               double *sink) {
+   static struct Netlist *netlist = NULL;
+   if (netlist == NULL) {
+      netlist = create_netlist(3 + 2*64, 3 + 3*64);
+      netlist_voltage_source(netlist, "Vcc", 1, 0, 22);
+      netlist_resistor(netlist, "R1", 1, 2, 39000);
+      netlist_resistor(netlist, "R2", 2, 0, 3900);
+      for (size_t s=0; s<64; s++) {
+         size_t c = 3 + 2*s;
+         netlist_resistor(netlist, "Rc", 1, c, 10000 + 100*s);
+         netlist_resistor(netlist, "Re", c + 1, 0, 1500 + 10*s);
+         netlist_bjt(netlist, "Q", c, 2, c + 1, 100 + s);
+      }
+   }
+   netlist_sweep(netlist, 2, num, params[2], 3, bench_results[0]);
+   *sink += bench_results[0][num - 1];
+}
+
+/* Two-port system of each parameter set. */
+void _bjt_two_port_system_(size_t num, const double *const *params,
+                           double *sink) {
+   double total = 0;
+   for (size_t i=0; i<num; i++) {
+      BJT_TwoPortAnalysis a = bjt_two_port_system(P(0), P(1), P(2),
+                                                  P(3), P(4));
+      total += a.Avl + a.Avs + a.Ail;
+   }
+   *sink += total;
+}
+
+/* Three-stage cascaded system of each parameter set. */
+void _bjt_cascaded_system_(size_t num, const double *const *params,
+                           double *sink) {
+   double total = 0;
+   for (size_t i=0; i<num; i++) {
+      double Avnls[3] = {P(0), P(1), P(2)};
+      double Zis[3] = {P(3), P(4), P(5)};
+      double Zos[3] = {P(6), P(7), P(8)};
+      BJT_CascadedAnalysis a = bjt_cascaded_system(3, Avnls, Zis, Zos,
+                                                   P(9), P(10));
+      total += a.Avt + a.Avs + a.Ait;
+   }
+   *sink += total;
+}
+
+/* Three-stage cascaded systems of all points together. */
+void _bjt_cascade_batch_(size_t num, const double *const *params,
+                         double *sink) {
+   double **r = bench_results;
+   BJT_CascadeBatch totals = {r[3], r[4], r[5]};
+   bjt_cascade_batch(num, 3, params, params + 3, params + 6, params[9],
+                     params[10], r, totals);
+   *sink += r[3][num - 1];
+}
+
+/* One chain of all points whose stages are updated one by one. */
+void _bjt_cascade_update_(size_t num, const double *const *params,
+                          double *sink) {
+   // The updates write the stage arrays, so work on copies.
+   double *Avnls = bench_results[0], *Zis = bench_results[1];
+   double *Zos = bench_results[2];
+   memcpy(Avnls, params[0], num * sizeof(double));
+   memcpy(Zis, params[1], num * sizeof(double));
+   memcpy(Zos, params[2], num * sizeof(double));
+   struct BJT_Cascade cascade = bjt_cascade(num, Avnls, Zis, Zos, 1000,
+                                            1000, bench_tree);
+   for (size_t i=0; i<num; i++)
+      bjt_cascade_update_stage(&cascade, i, P(0) * 1.0001, P(1), P(2));
+   *sink += bjt_cascade_totals(&cascade).Avs;
+}
+
+/* Explicit batch entry points. */
+void _bjt_dc_voltage_divider_batch_(size_t num,
+      const double *const *params, double *sink) {
+   double **r = bench_results;
+   BJT_DCBatch dc = {r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7],
+                     r[8]};
+   bjt_dc_voltage_divider_batch(num, params[0], params[1], params[2],
+         params[3], params[4], params[5], dc);
+   *sink += r[1][num - 1];
+}
+
+void _bjt_ac_voltage_divider_batch_(size_t num,
+      const double *const *params, double *sink) {
+   double **r = bench_results;
+   BJT_ACBatch ac = {r[0], r[1], r[2], r[3]};
+   bjt_ac_voltage_divider_batch(num, params[0], params[1], params[2],
+         params[3], params[4], params[5], params[6], "bypassed", ac);
+   *sink += r[3][num - 1];
+}
+
+void _drain_current_batch_runner_(size_t num,
+      const double *const *params, double *sink) {
+   *sink += _drain_current_batch_(num, params[0], params[1], params[2],
+                                  bench_results[0], bench_status);
+   *sink += bench_results[0][num - 1];
+}
+
+/* Incremental sweep of a load-side parameter over all points (the
+other parameters are the ones of first point). */
+void _incremental_sweep_(const struct IncrementalGraph *graph,
+                         size_t index, size_t num,
+                         const double *const *params, double *sink) {
+   double first[MAX_PARAMS];
+   for (size_t p=0; p<graph->nparams; p++) first[p] = params[p][0];
+   struct IncrementalAnalysis analysis = incremental_analysis(graph,
+                                                              first);
+   incremental_sweep(&analysis, index, num, params[index],
+                     bench_results);
+   *sink += bench_results[3][num - 1];
+}
+
+void _bjt_incremental_emitter_bias_(size_t num,
+      const double *const *params, double *sink) {
+   _incremental_sweep_(&bjt_incremental_emitter_bias, 5, num, params,
+                       sink);
+}
+
+void _jfet_incremental_voltage_divider_(size_t num,
+      const double *const *params, double *sink) {
+   _incremental_sweep_(&jfet_incremental_voltage_divider, 7, num,
+                       params, sink);
+}
+
+/* Text formatting of numbers (see Format.h) and its printf baseline. */
+void _format_double_(size_t num, const double *const *params,
+                     double *sink) {
+   char out[TEXT_NUMBER];
+   size_t total = 0;
+   for (size_t i=0; i<num; i++) total += format_double(out, P(0));
+   *sink += total;
+}
+
+void _sprintf_double_(size_t num, const double *const *params,
+                      double *sink) {
+   char out[TEXT_NUMBER];
+   size_t total = 0;
+   for (size_t i=0; i<num; i++) total += sprintf(out, "%.17g", P(0));
+   *sink += total;
+}
+
+/* Fused analysis formatted as a CSV row (the row isn't written). */
+void _bjt_format_fixed_bias_(size_t num, const double *const *params,
+                             double *sink) {
+   char row[1024];
+   struct TextBuffer text = {row, 0, sizeof(row), -1, TEXT_CSV};
+   size_t total = 0;
+   for (size_t i=0; i<num; i++) {
+      BJT_FusedAnalysis a = bjt_analyze_fixed_bias(P(0), P(1), P(2),
+                                                   P(3), P(4));
+      bjt_format_dc_results(&text, a.dc);
+      bjt_format_ac_results(&text, a.ac);
+      text_end_row(&text);
+      total += text.length;
+      text.length = 0;
+   }
+   *sink += total;
+}
+
+/* Stream of curve paths (curves to /dev/null). */
+struct CurveStream _bench_curves_(enum CurveFormat format) {
+   static struct TextBuffer text;
+   if (text.data == NULL) {
+      text.data = malloc(TEXT_BUFFER);
+      text.fd = open("/dev/null", O_WRONLY);
+      text.size = TEXT_BUFFER;
+   }
+   return (struct CurveStream) {&text, format};
+}
+
+/* Transfer curves of self-bias designs (VG = 0, see Curve.h). */
+void _jfet_curves_(size_t num, const double *const *params,
+                   double *sink, enum CurveFormat format) {
+   memset(bench_results[0], 0, num * sizeof(double));
+   struct JFET_CurveParts parts = {params[4], params[5],
+                                   bench_results[0], params[3]};
+   struct CurveQPoints q = {bench_results[1], bench_results[2]};
+   jfet_transfer_curves(num, parts, BENCH_CURVE_POINTS,
+                        _bench_curves_(format), q);
+   *sink += bench_results[2][num - 1];
+}
+
+void _jfet_curves_binary_(size_t num, const double *const *params,
+                          double *sink) {
+   _jfet_curves_(num, params, sink, CURVE_BINARY);
+}
+
+void _jfet_curves_csv_(size_t num, const double *const *params,
+                       double *sink) {
+   _jfet_curves_(num, params, sink, CURVE_CSV);
+}
+
+/* Load lines of the uniform fixed-bias evaluations. */
+void _bjt_load_lines_(size_t num, const double *const *params,
+                      double *sink) {
+   find_configuration(bjt_configurations, num_bjt_configurations,
+                      "fixed_bias")->evaluate(num, params, bench_results);
+   struct BJT_CurveParts parts = {params[0], bench_results[3],
+                                  bench_results[1]};
+   struct CurveQPoints q = {bench_results[13], bench_results[14]};
+   bjt_load_lines(num, parts, BENCH_CURVE_POINTS,
+                  _bench_curves_(CURVE_BINARY), q);
+   *sink += bench_results[14][num - 1];
+}
+
+// Documented examples of the benchmarks:
+#define BJT_FIXED_BIAS 5, {12, 470000, 3000, 100, 50000}
+#define BJT_SATURATING_BIAS 5, {12, 240000, 2400, 100, 50000}
+#define BJT_EMITTER_BIAS 6, {20, 470000, 2200, 560, 120, 40000}
+#define BJT_VOLTAGE_DIVIDER 7, {16, 90000, 10000, 2200, 680, 210, 50000}
+#define BJT_COLLECTOR_FEEDBACK 6, {9, 180000, 2700, 1200, 200, 1e+6}
+#define BJT_EMITTER_FOLLOWER 5, {12, 220000, 3300, 100, 1e+6}
+#define BJT_COMMON_BASE 5, {8, 2, 5000, 1000, 49}
+#define JFET_FIXED_BIAS 7, {16, 2, 1e+6, 2000, 0.01, -8, 25000}
+#define JFET_SELF_BIAS 7, {20, 1e+6, 3300, 1000, 0.008, -6, 50000}
+#define JFET_VOLTAGE_DIVIDER 8, {20, 82e+6, 11e+6, 2000, 610, 0.012, \
+                                 -3, 5e+5}
+#define JFET_COMMON_GATE 7, {15, 0, 3300, 1500, 0.008, -2.8, 4e+4}
+#define MOSFET_DRAIN_FEEDBACK 7, {12, 1e+7, 2000, 0.006, 8, 3, 5e+4}
+#define MOSFET_VOLTAGE_DIVIDER 9, {24, 1e+7, 6.8e+6, 2200, 750, 0.005, \
+                                   6, 3, 1e+6}
+
+// All benchmarks:
+const struct Benchmark benchmarks[] = {
+   // BJT scalar configurations.
+   {"bjt_dc_fixed_bias", "bjt", "scalar", NULL, _bjt_dc_fixed_bias_,
+    4, {12, 240000, 2200, 50}},
+   {"bjt_ac_fixed_bias", "bjt", "scalar", NULL, _bjt_ac_fixed_bias_,
+    5, {12, 470000, 3000, 100, 50000}},
+   {"bjt_dc_emitter_bias", "bjt", "scalar", NULL,
+    _bjt_dc_emitter_bias_, 5, {20, 430000, 2000, 1000, 50}},
+   {"bjt_ac_emitter_bias", "bjt", "scalar", NULL,
+    _bjt_ac_emitter_bias_, BJT_EMITTER_BIAS},
+   {"bjt_dc_voltage_divider", "bjt", "scalar", NULL,
+    _bjt_dc_voltage_divider_, 6, {22, 39000, 3900, 10000, 1500, 100}},
+   {"bjt_ac_voltage_divider", "bjt", "scalar", NULL,
+    _bjt_ac_voltage_divider_, BJT_VOLTAGE_DIVIDER},
+   {"bjt_ac_voltage_divider_unbypassed", "bjt", "scalar", NULL,
+    _bjt_ac_voltage_divider_unbypassed_, BJT_VOLTAGE_DIVIDER},
+   {"bjt_dc_collector_feedback", "bjt", "scalar", NULL,
+    _bjt_dc_collector_feedback_, 5, {10, 250000, 4700, 1200, 90}},
+   {"bjt_ac_collector_feedback", "bjt", "scalar", NULL,
+    _bjt_ac_collector_feedback_, 5, {9, 180000, 2700, 200, 1e+6}},
+   {"bjt_ac_collector_dc_feedback", "bjt", "scalar", NULL,
+    _bjt_ac_collector_dc_feedback_,
+    6, {12, 120000, 68000, 3000, 140, 30000}},
+   {"bjt_dc_emitter_follower", "bjt", "scalar", NULL,
+    _bjt_dc_emitter_follower_, 4, {20, 240000, 2000, 90}},
+   {"bjt_ac_emitter_follower", "bjt", "scalar", NULL,
+    _bjt_ac_emitter_follower_, 5, {12, 220000, 3300, 100, 1e+6}},
+   {"bjt_dc_common_base", "bjt", "scalar", NULL, _bjt_dc_common_base_,
+    5, {10, 4, 2400, 1200, 60}},
+   {"bjt_ac_common_base", "bjt", "scalar", NULL, _bjt_ac_common_base_,
+    5, {8, 2, 5000, 1000, 0.98}},
+   {"bjt_dc_miscellaneous_bias", "bjt", "scalar", NULL,
+    _bjt_dc_miscellaneous_bias_, 4, {20, 680000, 4700, 120}},
+   {"bjt_two_port_system", "bjt", "scalar", NULL,
+    _bjt_two_port_system_, 5, {-480, 4000, 2000, 200, 5600}},
+   {"bjt_cascaded_system", "bjt", "scalar", NULL,
+    _bjt_cascaded_system_,
+    11, {1, 250, 100, 500, 26, 100, 1000, 5100, 100, 10000, 820}},
+   // JFET scalar configurations.
+   {"jfet_dc_fixed_bias", "jfet", "scalar", NULL, _jfet_dc_fixed_bias_,
+    5, {16, 2, 2000, 0.01, -8}},
+   {"jfet_ac_fixed_bias", "jfet", "scalar", NULL, _jfet_ac_fixed_bias_,
+    JFET_FIXED_BIAS},
+   {"jfet_dc_self_bias", "jfet", "scalar", NULL, _jfet_dc_self_bias_,
+    5, {20, 3300, 1000, 0.008, -6}},
+   {"jfet_ac_self_bias", "jfet", "scalar", NULL, _jfet_ac_self_bias_,
+    JFET_SELF_BIAS},
+   {"jfet_dc_voltage_divider", "jfet", "scalar", NULL,
+    _jfet_dc_voltage_divider_,
+    7, {16, 2.1e+6, 2.7e+5, 2400, 1500, 0.008, -4}},
+   {"jfet_ac_voltage_divider", "jfet", "scalar", NULL,
+    _jfet_ac_voltage_divider_, JFET_VOLTAGE_DIVIDER},
+   {"jfet_dc_common_gate", "jfet", "scalar", NULL,
+    _jfet_dc_common_gate_, 6, {12, 0, 1500, 680, 0.012, -6}},
+   {"jfet_ac_common_gate", "jfet", "scalar", NULL,
+    _jfet_ac_common_gate_, JFET_COMMON_GATE},
+   {"jfet_ac_source_follower", "jfet", "scalar", NULL,
+    _jfet_ac_source_follower_,
+    7, {9, -2.86, 1e+6, 2200, 0.016, -4, 4e+4}},
+   // MOSFET scalar configurations.
+   {"mosfet_dc_drain_feedback", "mosfet", "scalar", NULL,
+    _mosfet_dc_drain_feedback_, 6, {12, 1e+7, 2000, 0.006, 8, 3}},
+   {"mosfet_ac_drain_feedback", "mosfet", "scalar", NULL,
+    _mosfet_ac_drain_feedback_, MOSFET_DRAIN_FEEDBACK},
+   {"mosfet_dc_voltage_divider", "mosfet", "scalar", NULL,
+    _mosfet_dc_voltage_divider_,
+    8, {40, 22e+6, 18e+6, 3000, 820, 0.003, 10, 5}},
+   {"mosfet_ac_voltage_divider", "mosfet", "scalar", NULL,
+    _mosfet_ac_voltage_divider_, MOSFET_VOLTAGE_DIVIDER},
+   // Fused (DC and AC) analyses.
+   {"bjt_analyze_fixed_bias", "bjt", "fused", NULL,
+    _bjt_analyze_fixed_bias_, BJT_FIXED_BIAS},
+   {"bjt_analyze_emitter_bias", "bjt", "fused", NULL,
+    _bjt_analyze_emitter_bias_, BJT_EMITTER_BIAS},
+   {"bjt_analyze_voltage_divider", "bjt", "fused", NULL,
+    _bjt_analyze_voltage_divider_, BJT_VOLTAGE_DIVIDER},
+   {"bjt_analyze_collector_feedback", "bjt", "fused", NULL,
+    _bjt_analyze_collector_feedback_, BJT_COLLECTOR_FEEDBACK},
+   {"bjt_analyze_emitter_follower", "bjt", "fused", NULL,
+    _bjt_analyze_emitter_follower_, BJT_EMITTER_FOLLOWER},
+   {"bjt_analyze_common_base", "bjt", "fused", NULL,
+    _bjt_analyze_common_base_, BJT_COMMON_BASE},
+   {"jfet_analyze_fixed_bias", "jfet", "fused", NULL,
+    _jfet_analyze_fixed_bias_, JFET_FIXED_BIAS},
+   {"jfet_analyze_self_bias", "jfet", "fused", NULL,
+    _jfet_analyze_self_bias_, JFET_SELF_BIAS},
+   {"jfet_analyze_voltage_divider", "jfet", "fused", NULL,
+    _jfet_analyze_voltage_divider_, JFET_VOLTAGE_DIVIDER},
+   {"jfet_analyze_common_gate", "jfet", "fused", NULL,
+    _jfet_analyze_common_gate_, JFET_COMMON_GATE},
+   {"mosfet_analyze_drain_feedback", "mosfet", "fused", NULL,
+    _mosfet_analyze_drain_feedback_, MOSFET_DRAIN_FEEDBACK},
+   {"mosfet_analyze_voltage_divider", "mosfet", "fused", NULL,
+    _mosfet_analyze_voltage_divider_, MOSFET_VOLTAGE_DIVIDER},
+   // Batch entry points.
+   {"bjt_dc_voltage_divider_batch", "bjt", "batch", NULL,
+    _bjt_dc_voltage_divider_batch_,
+    6, {22, 39000, 3900, 10000, 1500, 100}},
+   {"bjt_ac_voltage_divider_batch", "bjt", "batch", NULL,
+    _bjt_ac_voltage_divider_batch_, BJT_VOLTAGE_DIVIDER},
+   {"_drain_current_batch_", "fet", "batch", NULL,
+    _drain_current_batch_runner_, 3, {0.222222, -3.666667, 0.008}},
+   {"bjt_cascade_batch", "bjt", "batch", NULL, _bjt_cascade_batch_,
+    11, {1, 250, 100, 500, 26, 100, 1000, 5100, 100, 10000, 820}},
+   {"bjt_cascade_update", "bjt", "batch", NULL, _bjt_cascade_update_,
+    3, {1.05, 1000, 50}},
+   {"bjt_analyze_fixed_bias_batch", "bjt", "batch", "fixed_bias",
+    NULL, BJT_FIXED_BIAS},
+   {"bjt_analyze_emitter_bias_batch", "bjt", "batch", "emitter_bias",
+    NULL, BJT_EMITTER_BIAS},
+   {"bjt_analyze_voltage_divider_batch", "bjt", "batch",
+    "voltage_divider", NULL, BJT_VOLTAGE_DIVIDER},
+   {"bjt_analyze_collector_feedback_batch", "bjt", "batch",
+    "collector_feedback", NULL, BJT_COLLECTOR_FEEDBACK},
+   {"bjt_analyze_emitter_follower_batch", "bjt", "batch",
+    "emitter_follower", NULL, BJT_EMITTER_FOLLOWER},
+   {"bjt_analyze_common_base_batch", "bjt", "batch", "common_base",
+    NULL, BJT_COMMON_BASE},
+   {"jfet_analyze_fixed_bias_batch", "jfet", "batch", "fixed_bias",
+    NULL, JFET_FIXED_BIAS},
+   {"jfet_analyze_self_bias_batch", "jfet", "batch", "self_bias",
+    NULL, JFET_SELF_BIAS},
+   {"jfet_analyze_voltage_divider_batch", "jfet", "batch",
+    "voltage_divider", NULL, JFET_VOLTAGE_DIVIDER},
+   {"jfet_analyze_common_gate_batch", "jfet", "batch", "common_gate",
+    NULL, JFET_COMMON_GATE},
+   {"mosfet_analyze_drain_feedback_batch", "mosfet", "batch",
+    "drain_feedback", NULL, MOSFET_DRAIN_FEEDBACK},
+   {"mosfet_analyze_voltage_divider_batch", "mosfet", "batch",
+    "voltage_divider", NULL, MOSFET_VOLTAGE_DIVIDER},
+   // Classified batches (compare with the batches above).
+   {"bjt_regions_fixed_bias", "bjt", "regions", "fixed_bias", NULL,
+    BJT_SATURATING_BIAS},
+   {"jfet_regions_self_bias", "jfet", "regions", "self_bias", NULL,
+    JFET_SELF_BIAS},
+   {"mosfet_regions_voltage_divider", "mosfet", "regions",
+    "voltage_divider", NULL, MOSFET_VOLTAGE_DIVIDER},
+   // Validated batches (compare with the batches above).
+   {"bjt_validate_fixed_bias", "bjt", "validate", "fixed_bias", NULL,
+    BJT_FIXED_BIAS},
+   {"jfet_validate_self_bias", "jfet", "validate", "self_bias", NULL,
+    JFET_SELF_BIAS},
+   {"mosfet_validate_voltage_divider", "mosfet", "validate",
+    "voltage_divider", NULL, MOSFET_VOLTAGE_DIVIDER},
+   // Jacobians of fused analyses.
+   {"bjt_jacobian_fixed_bias", "bjt", "jacobian", "fixed_bias", NULL,
+    BJT_FIXED_BIAS},
+   {"bjt_jacobian_emitter_bias", "bjt", "jacobian", "emitter_bias",
+    NULL, BJT_EMITTER_BIAS},
+   {"bjt_jacobian_voltage_divider", "bjt", "jacobian",
+    "voltage_divider", NULL, BJT_VOLTAGE_DIVIDER},
+   {"bjt_jacobian_collector_feedback", "bjt", "jacobian",
+    "collector_feedback", NULL, BJT_COLLECTOR_FEEDBACK},
+   {"bjt_jacobian_emitter_follower", "bjt", "jacobian",
+    "emitter_follower", NULL, BJT_EMITTER_FOLLOWER},
+   {"bjt_jacobian_common_base", "bjt", "jacobian", "common_base",
+    NULL, BJT_COMMON_BASE},
+   {"jfet_jacobian_fixed_bias", "jfet", "jacobian", "fixed_bias",
+    NULL, JFET_FIXED_BIAS},
+   {"jfet_jacobian_self_bias", "jfet", "jacobian", "self_bias",
+    NULL, JFET_SELF_BIAS},
+   {"jfet_jacobian_voltage_divider", "jfet", "jacobian",
+    "voltage_divider", NULL, JFET_VOLTAGE_DIVIDER},
+   {"jfet_jacobian_common_gate", "jfet", "jacobian", "common_gate",
+    NULL, JFET_COMMON_GATE},
+   {"mosfet_jacobian_drain_feedback", "mosfet", "jacobian",
+    "drain_feedback", NULL, MOSFET_DRAIN_FEEDBACK},
+   {"mosfet_jacobian_voltage_divider", "mosfet", "jacobian",
+    "voltage_divider", NULL, MOSFET_VOLTAGE_DIVIDER},
+   // Float screening of uniform configurations.
+   {"bjt_screen_fixed_bias", "bjt", "screen", "fixed_bias", NULL,
+    BJT_FIXED_BIAS},
+   {"bjt_screen_voltage_divider", "bjt", "screen", "voltage_divider",
+    NULL, BJT_VOLTAGE_DIVIDER},
+   {"jfet_screen_self_bias", "jfet", "screen", "self_bias", NULL,
+    JFET_SELF_BIAS},
+   {"jfet_screen_voltage_divider", "jfet", "screen", "voltage_divider",
+    NULL, JFET_VOLTAGE_DIVIDER},
+   {"mosfet_screen_drain_feedback", "mosfet", "screen",
+    "drain_feedback", NULL, MOSFET_DRAIN_FEEDBACK},
+   {"mosfet_screen_voltage_divider", "mosfet", "screen",
+    "voltage_divider", NULL, MOSFET_VOLTAGE_DIVIDER},
+   // Cached lookups of uniform configurations.
+   {"bjt_cache_emitter_follower", "bjt", "cache", "emitter_follower",
+    NULL, BJT_EMITTER_FOLLOWER},
+   {"jfet_cache_self_bias", "jfet", "cache", "self_bias", NULL,
+    JFET_SELF_BIAS},
+   {"mosfet_cache_voltage_divider", "mosfet", "cache",
+    "voltage_divider", NULL, MOSFET_VOLTAGE_DIVIDER},
+   // Incremental sweeps of load sides.
+   {"bjt_incremental_emitter_bias_ro", "bjt", "incremental", NULL,
+    _bjt_incremental_emitter_bias_, BJT_EMITTER_BIAS},
+   {"jfet_incremental_voltage_divider_rd", "jfet", "incremental", NULL,
+    _jfet_incremental_voltage_divider_, JFET_VOLTAGE_DIVIDER},
+   // Exact (Ebers-Moll) operating points.
+   {"bjt_exact_fixed_bias", "bjt", "exact", NULL,
+    _bjt_exact_fixed_bias_runner_, BJT_SATURATING_BIAS},
+   {"bjt_exact_emitter_bias", "bjt", "exact", NULL,
+    _bjt_exact_emitter_bias_runner_, BJT_EMITTER_BIAS},
+   {"bjt_exact_voltage_divider", "bjt", "exact", NULL,
+    _bjt_exact_voltage_divider_runner_, BJT_VOLTAGE_DIVIDER},
+   {"bjt_exact_collector_feedback", "bjt", "exact", NULL,
+    _bjt_exact_collector_feedback_runner_, BJT_COLLECTOR_FEEDBACK},
+   {"bjt_analyze_saturating_bias", "bjt", "fused", NULL,
+    _bjt_analyze_fixed_bias_, BJT_SATURATING_BIAS},
+   {"bjt_exact_fixed_bias_batch", "bjt", "exact", "fixed_bias", NULL,
+    BJT_SATURATING_BIAS},
+   {"bjt_exact_emitter_bias_batch", "bjt", "exact", "emitter_bias",
+    NULL, BJT_EMITTER_BIAS},
+   {"bjt_exact_voltage_divider_batch", "bjt", "exact",
+    "voltage_divider", NULL, BJT_VOLTAGE_DIVIDER},
+   {"bjt_exact_collector_feedback_batch", "bjt", "exact",
+    "collector_feedback", NULL, BJT_COLLECTOR_FEEDBACK},
+   {"bjt_analyze_saturating_bias_batch", "bjt", "batch", "fixed_bias",
+    NULL, BJT_SATURATING_BIAS},
+   // Netlists (compare with 'bjt_exact_voltage_divider').
+   {"bjt_netlist_voltage_divider", "bjt", "netlist", NULL,
+    _bjt_netlist_voltage_divider_, BJT_VOLTAGE_DIVIDER},
+   {"netlist_sweep_64_stages", "bjt", "netlist", NULL,
+    _netlist_sweep_64_stages_, 3, {22, 39000, 3900}},
+   // Curves (per curve of BENCH_CURVE_POINTS points).
+   {"jfet_transfer_curves_binary", "jfet", "curves", NULL,
+    _jfet_curves_binary_, JFET_SELF_BIAS},
+   {"jfet_transfer_curves_csv", "jfet", "curves", NULL,
+    _jfet_curves_csv_, JFET_SELF_BIAS},
+   {"bjt_load_lines_fixed_bias", "bjt", "curves", NULL,
+    _bjt_load_lines_, BJT_SATURATING_BIAS},
+   // Text formatting.
+   {"format_double", "any", "format", NULL, _format_double_,
+    1, {2.354166666666667e-03}},
+   {"sprintf_double", "any", "format", NULL, _sprintf_double_,
+    1, {2.354166666666667e-03}},
+   {"bjt_format_fixed_bias", "bjt", "format", NULL,
+    _bjt_format_fixed_bias_, BJT_FIXED_BIAS},
+};
+
+// Number of benchmarks:
+const size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+/* Get the next random number in [0, 1) (splitmix64 generator). */
+double _random_(uint64_t *state) {
+   // Mix the incremented state.
+   uint64_t z = (*state += 0x9E3779B97F4A7C15);
+   z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+   z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+   z ^= z >> 31;
+   return (z >> 11) * 0x1p-53;
+}
+
+/* Get the monotonic time in seconds. */
+double _now_(void) {
+   struct timespec time;
+   clock_gettime(CLOCK_MONOTONIC, &time);
+   return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+/* Compare two doubles for sorting. */
+int _compare_(const void *a, const void *b) {
+   double x = *(const double *) a, y = *(const double *) b;
+   return (x > y) - (x < y);
+}
+
+/* Get the uniform configuration of a batch, jacobian, screen, cache or
+exact benchmark. */
+const struct Configuration *_bench_config_(const struct Benchmark *b) {
+   // Search the family table of benchmark.
+   if (strcmp(b->path, "exact") == 0)
+      return find_configuration(bjt_exact_configurations,
+                                num_bjt_exact_configurations,
+                                b->config);
+   if (strcmp(b->device, "bjt") == 0)
+      return find_configuration(bjt_configurations,
+                                num_bjt_configurations, b->config);
+   if (strcmp(b->device, "jfet") == 0)
+      return find_configuration(jfet_configurations,
+                                num_jfet_configurations, b->config);
+   return find_configuration(mosfet_configurations,
+                             num_mosfet_configurations, b->config);
+}
+
+/* Run one pass of a benchmark over 'num' points. */
+void _bench_pass_(const struct Benchmark *b, size_t num,
+                  const double *const *params, double *sink) {
+   // Scalar and explicit batch paths have their own runners.
+   if (b->run != NULL) { b->run(num, params, sink); return; }
+   const struct Configuration *config = _bench_config_(b);
+   // Screen paths read the float copies of parameters.
+   if (strcmp(b->path, "screen") == 0) {
+      screen_configuration(config, num,
+            (const float *const *) bench_float_params,
+            bench_float_results);
+      *sink += bench_float_results[config->metrics[METRIC_I]][num - 1];
+      return;
+   }
+   if (strcmp(b->path, "validate") == 0)
+      *sink += validate_params(config, num, params, bench_status);
+   if (strcmp(b->path, "jacobian") == 0)
+      configuration_jacobian(config, num, params, bench_results,
+                             bench_jacobian);
+   else if (strcmp(b->path, "cache") == 0)
+      cached_configuration(bench_cache, config, num, params,
+                           bench_results);
+   else config->evaluate(num, params, bench_results);
+   if (strcmp(b->path, "regions") == 0) {
+      classify_regions(config, num, params,
+                       (const double *const *) bench_results,
+                       bench_regions);
+      *sink += bench_regions[num - 1];
+   }
+   if (strcmp(b->path, "validate") == 0)
+      *sink += validate_results(config, num,
+                                (const double *const *) bench_results,
+                                bench_status);
+   *sink += bench_results[config->metrics[METRIC_I]][num - 1];
+}
+
+/* Name the instruction set of batch clones which is used. */
+string _isa_(void) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+   // Check the same features as the runtime dispatch.
+   if (__builtin_cpu_supports("avx512f")) return "avx512f";
+   if (__builtin_cpu_supports("avx2")) return "avx2";
+   return "sse2";
+#else
+   return "default";
+#endif
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+int main(int argc, char **argv) {
+   size_t points = BENCH_POINTS, repeats = BENCH_REPEATS;
+   int cpu = 0;
+   const char *filter = "";
+   // Read the options.
+   for (int i=1; i+1<argc; i+=2) {
+      if (strcmp(argv[i], "-n") == 0) points = strtoul(argv[i+1], 0, 10);
+      else if (strcmp(argv[i], "-r") == 0)
+         repeats = strtoul(argv[i+1], 0, 10);
+      else if (strcmp(argv[i], "-c") == 0) cpu = atoi(argv[i+1]);
+      else if (strcmp(argv[i], "-f") == 0) filter = argv[i+1];
+      else {
+         fprintf(stderr, "usage: %s [-n points] [-r repeats] "
+                 "[-c cpu] [-f filter]\n", argv[0]);
+         return 1;
+      }
+   }
+   if (points == 0 || repeats == 0) {
+      fprintf(stderr, "points and repeats must be positive\n");
+      return 1;
+   }
+   // Pin the process to the CPU, so it isn't migrated while timing.
+   int pinned = 0;
+   if (cpu >= 0) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+      pinned = sched_setaffinity(0, sizeof(set), &set) == 0;
+   }
+   // Allocate the parameter and result columns.
+   double *params[MAX_PARAMS], *times = malloc(repeats * sizeof(double));
+   for (size_t p=0; p<MAX_PARAMS; p++)
+      params[p] = malloc(points * sizeof(double));
+   for (size_t r=0; r<MAX_RESULTS; r++)
+      bench_results[r] = malloc(points * sizeof(double));
+   for (size_t c=0; c<MAX_RESULTS * MAX_PARAMS; c++)
+      bench_jacobian[c] = malloc(points * sizeof(double));
+   for (size_t p=0; p<MAX_PARAMS; p++)
+      bench_float_params[p] = malloc(points * sizeof(float));
+   for (size_t r=0; r<MAX_RESULTS; r++)
+      bench_float_results[r] = malloc(points * sizeof(float));
+   bench_status = malloc(points);
+   bench_regions = malloc(points);
+   bench_tree = malloc(BJT_CASCADE_TREE(points) * sizeof(double));
+   bench_cache = create_result_cache(2 * points, 0);
+   double sink = 0;
+
+   printf("{\n  \"compiler\": \"%s\",\n", __VERSION__);
+#ifdef NDEBUG
+   printf("  \"assertions\": false,\n");
+#else
+   printf("  \"assertions\": true,\n");
+#endif
+   printf("  \"isa\": \"%s\",\n  \"points\": %zu,\n  \"repeats\": %zu,\n"
+          "  \"cpu\": %d,\n  \"seed\": %d,\n  \"benchmarks\": [",
+          _isa_(), points, repeats, pinned ? cpu : -1, BENCH_SEED);
+   int first = 1;
+   for (size_t k=0; k<num_benchmarks; k++) {
+      const struct Benchmark *b = &benchmarks[k];
+      if (strstr(b->name, filter) == NULL) continue;
+      // Randomize the inputs around the documented example.
+      uint64_t state = BENCH_SEED + k;
+      for (size_t p=0; p<b->nparams; p++)
+         for (size_t i=0; i<points; i++)
+            params[p][i] = b->nominal[p] * (1 + BENCH_SPREAD *
+                           (2 * _random_(&state) - 1));
+      for (size_t p=0; p<b->nparams; p++)
+         for (size_t i=0; i<points; i++)
+            bench_float_params[p][i] = params[p][i];
+      // Warm up the caches, branch predictors and CPU frequency.
+      double start = _now_();
+      while (_now_() - start < BENCH_WARMUP)
+         _bench_pass_(b, points, (const double *const *) params, &sink);
+      // Measure the passes.
+      for (size_t r=0; r<repeats; r++) {
+         double begin = _now_();
+         _bench_pass_(b, points, (const double *const *) params, &sink);
+         times[r] = (_now_() - begin) * 1e9 / points;
+      }
+      qsort(times, repeats, sizeof(double), _compare_);
+      double median = times[repeats / 2];
+      printf("%s\n    {\"name\": \"%s\", \"device\": \"%s\", "
+             "\"path\": \"%s\", \"ns_per_op\": %.4f, "
+             "\"min_ns_per_op\": %.4f, \"points_per_second\": %.6e}",
+             first ? "" : ",", b->name, b->device, b->path, median,
+             times[0], 1e9 / median);
+      first = 0;
+   }
+   // Print the sink, so no benchmark is optimized away.
+   printf("\n  ],\n  \"checksum\": %.6e\n}\n", sink);
+
+   for (size_t p=0; p<MAX_PARAMS; p++) free(params[p]);
+   for (size_t r=0; r<MAX_RESULTS; r++) free(bench_results[r]);
+   for (size_t c=0; c<MAX_RESULTS * MAX_PARAMS; c++)
+      free(bench_jacobian[c]);
+   for (size_t p=0; p<MAX_PARAMS; p++) free(bench_float_params[p]);
+   for (size_t r=0; r<MAX_RESULTS; r++) free(bench_float_results[r]);
+   free(bench_status); free(bench_regions); free(bench_tree);
+   free(times);
+   destroy_result_cache(bench_cache);
+   return 0;
+}
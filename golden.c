@@ -0,0 +1,2109 @@
+/* Golden-Value Corpus of TransCal Configurations
+
+This program checks the library in three steps:
+
+1. Golden examples: every documented example of BJT.h, JFET.h,
+MOSFET.h, EbersMoll.h, Netlist.h and Curve.h (and
+'sweep_regions()', 'validate_results()', a Vp spread and the
+thread counts of 'monte_carlo()' and the ranges of
+'design_voltage_divider()') is analyzed again and each printed value
+is compared with the documentation. A value may differ at most one
+unit in its last printed digit (for example 1e-11 for
+"4.708333e-05"). Some of them are also compile-time reference
+designs (see Reference.h).
+2. Fast paths: fused and batch (vectorized) paths are compared with
+their scalar references on randomized inputs (+-20% around the
+documented examples). Each result field has its own budget of ULPs
+and relative error, and the throughputs of fast and reference paths
+are reported.
+3. Sensitivities: the Jacobian of each configuration (see
+Sensitivity.h) is compared with the central differences of its
+uniform evaluation, partial by partial.
+
+cc -O3 -fno-math-errno -o golden golden.c TransCal.c -lm -pthread
+./golden [-n points] [-v]
+
+IMPORTANT NOTES:
+----------------
+
+1. The reference of fused paths is the separate DC and AC analyses.
+The reference of batch paths is the scalar fused analysis (which is
+checked against the separate analyses first).
+2. A value passes if it is in any of its ULP, relative or absolute
+budgets. The absolute budget is only given to the fields which are
+found by subtracting nearly equal numbers (like 'Vbc'), because
+their relative error isn't bounded near zero.
+3. MOSFET results are stored as float, so their ULPs are float ULPs.
+The uniform MOSFET evaluations are computed in double, so their
+'Vds' is only compared to the float reference with an absolute
+budget.
+4. Float screening paths (see Precision.h) are compared with the
+uniform double evaluations. Their throughputs include the conversion
+of columns between double and float.
+5. Cached paths (see Cache.h) must give the same bits as the uniform
+evaluations. Only MOSFET ones have the budgets of batch paths: their
+vectorized loop and its remainder are contracted differently, so a
+design may be rounded differently in another position of a batch.
+The warm-up run fills the cache, so the throughput of cached paths
+is the one of repeated queries.
+6. Incremental paths (see Incremental.h) must give the same bits as
+the 'ac_*' functions. Each design updates its parameters one by one
+in reverse order and refreshes after each update. The supply voltage
+is updated last and it reaches the results only through dependent
+nodes, so their invalidation is checked too.
+7. Cascade paths (see Cascade.h) are compared with
+'bjt_cascaded_system()'. The batch one must give the same bits. The
+tree one updates the stages of one tree design by design, and only
+its total gains (multiplied in pairs) have a budget.
+8. Exact paths (see EbersMoll.h) are the uniform exact evaluations
+compared with the scalar 'bjt_exact_*' functions. The fixed-bias
+designs straddle saturation, so both regions are checked. Regions
+must be the same and iterations may differ by one (a contracted
+clone may round the last step across the tolerance).
+9. Netlist paths (see Netlist.h) solve the netlists of configurations
+and are compared with the exact BJT and the closed-form JFET
+analyses. BJT netlists keep their symbolic factorization and only
+change values design by design, JFET ones are built for each design
+(Vp isn't a value).
+10. Region paths classify uniform evaluations (see
+'classify_regions()') and are compared with the region definitions
+on the scalar (double) analyses. Their designs straddle saturation,
+ohmic or cutoff regions, so each boundary is checked.
+11. Curve paths (see Curve.h) write the curves of designs to
+/dev/null and compare their Q-points with the DC analyses (on load
+lines, saturated BJT designs are at Icsat and Vce = 0). Their
+throughputs include the writing of GOLDEN_CURVE_POINTS points of
+each design.
+12. Validation paths find the status masks of uniform evaluations
+like the engines (see 'validate_results()') and are compared with the
+fault definitions on a scalar loop. Their designs straddle the
+negative discriminant of MOSFET quadratics.
+13. The exit status is 0 only if all checks pass. '-v' prints the
+worst field of each check.
+14. Keep the assertions (don't define NDEBUG), the inputs are valid.
+15. Jacobian designs have non-integer Vp and Vgsth. Each step is
+GOLDEN_STEP of its parameter, so a partial passes if it is in
+GOLDEN_SLOPE relative error or in the rounding of the results
+amplified by the step.
+16. TransCal.c is linked as another translation unit which includes
+BJT.h, JFET.h and MOSFET.h too, so the build itself checks that the
+family headers can be included next to the library.
+*/
+
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+#include <assert.h>
+#include <fcntl.h>
+#include "Precision.h"
+#include "Reference.h"
+#include "Cache.h"
+#include "Incremental.h"
+#include "Cascade.h"
+#include "EbersMoll.h"
+#include "Netlist.h"
+#include "Sweep.h"
+#include "Curve.h"
+#include "MonteCarlo.h"
+#include "Design.h"
+#include "TransCal.h"
+#include "Sensitivity.h"
+
+// General constants:
+#define GOLDEN_POINTS 65536 // default randomized points of each check
+#define GOLDEN_SPREAD 0.2 // relative spread of inputs
+#define GOLDEN_SEED 0x60D1E2024 // seed of inputs
+#define GOLDEN_CURVE_POINTS 64 // points of each curve in curve paths
+#define GOLDEN_STEP 1e-6 // relative step of central differences
+#define GOLDEN_SLOPE 1e-5 // relative budget of Jacobian entries
+
+// Analysis of 'num' designs from parameter columns:
+typedef void (*Columns)(size_t num, const double *const *params,
+                        double *const *results);
+
+// A documented example:
+struct Golden {
+   string name; // documented function
+   Columns run; // analysis of example
+   double params[MAX_PARAMS]; // parameters of example
+   string expected[MAX_RESULTS]; // printed results (NULL is skipped)
+};
+
+// Budget of a result field:
+struct Budget {
+   uint64_t ulp; // maximum distance in ULPs
+   double rel; // maximum relative error
+   double abs; // maximum absolute error (of canceled fields)
+};
+
+// A fast path and its reference:
+struct Check {
+   string name; // checked function or configuration
+   string device; // transistor family
+   string path; // fused, batch, screen, cache, incremental, cascade,
+                // exact, netlist, regions, validate or curves
+   string precision; // double or float results
+   Columns fast; // fast path
+   Columns reference; // scalar reference
+   size_t nparams; // count of parameters
+   double nominal[MAX_PARAMS]; // documented example parameters
+   size_t nresults; // count of result fields
+   unsigned mask; // compared result fields
+   struct Budget budgets[MAX_RESULTS]; // budgets of result fields
+};
+
+// A design of a Jacobian check:
+struct Slope {
+   size_t nparams; // count of parameters
+   double params[MAX_PARAMS]; // parameters in 'config->params' order
+};
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Store the results of an analysis to the i'th entries of columns. */
+void _bjt_store_dc_(BJT_DCAnalysis a, size_t i, double *const *r) {
+   r[0][i] = a.Ib; r[1][i] = a.Ic; r[2][i] = a.Ie; r[3][i] = a.Icsat;
+   r[4][i] = a.Vce; r[5][i] = a.Vc; r[6][i] = a.Ve; r[7][i] = a.Vb;
+   r[8][i] = a.Vbc;
+}
+void _bjt_store_ac_(BJT_ACAnalysis a, size_t i, double *const *r) {
+   r[0][i] = a.re; r[1][i] = a.Zi; r[2][i] = a.Zo; r[3][i] = a.Av;
+}
+void _jfet_store_dc_(JFET_DCAnalysis a, size_t i, double *const *r) {
+   r[0][i] = a.Id; r[1][i] = a.Vgs; r[2][i] = a.Vds; r[3][i] = a.Vs;
+   r[4][i] = a.Vd; r[5][i] = a.Vg;
+}
+void _jfet_store_ac_(JFET_ACAnalysis a, size_t i, double *const *r) {
+   r[0][i] = a.gm; r[1][i] = a.Zi; r[2][i] = a.Zo; r[3][i] = a.Av;
+}
+void _mosfet_store_dc_(MOSFET_DCAnalysis a, size_t i,
+                       double *const *r) {
+   r[0][i] = a.k; r[1][i] = a.Id; r[2][i] = a.Vgs; r[3][i] = a.Vds;
+}
+void _mosfet_store_ac_(MOSFET_ACAnalysis a, size_t i,
+                       double *const *r) {
+   r[0][i] = a.gm; r[1][i] = a.Zi; r[2][i] = a.Zo; r[3][i] = a.Av;
+}
+
+// Column analysis of a scalar function (with its i'th parameters):
+#define P(k) params[k][i]
+#define COLUMNS(name, ...) \
+   void name(size_t num, const double *const *params, \
+             double *const *results) { \
+      for (size_t i=0; i<num; i++) { __VA_ARGS__; } \
+   }
+// Store the fused (or separate) DC and AC results in uniform order:
+#define FUSED(family, offset, dc, ac) \
+   _##family##_store_dc_(dc, i, results); \
+   _##family##_store_ac_(ac, i, results + offset)
+#define BJT_FUSED(call) \
+   BJT_FusedAnalysis a = call; FUSED(bjt, 9, a.dc, a.ac)
+#define JFET_FUSED(call) \
+   JFET_FusedAnalysis a = call; FUSED(jfet, 6, a.dc, a.ac)
+#define MOSFET_FUSED(call) \
+   MOSFET_FusedAnalysis a = call; FUSED(mosfet, 4, a.dc, a.ac)
+
+// BJT separate analyses.
+COLUMNS(_bjt_dc_fixed_bias_, _bjt_store_dc_(
+        bjt_dc_fixed_bias(P(0), P(1), P(2), P(3)), i, results))
+COLUMNS(_bjt_ac_fixed_bias_, _bjt_store_ac_(
+        bjt_ac_fixed_bias(P(0), P(1), P(2), P(3), P(4)), i, results))
+COLUMNS(_bjt_dc_emitter_bias_, _bjt_store_dc_(
+        bjt_dc_emitter_bias(P(0), P(1), P(2), P(3), P(4)), i,
+        results))
+COLUMNS(_bjt_ac_emitter_bias_, _bjt_store_ac_(
+        bjt_ac_emitter_bias(P(0), P(1), P(2), P(3), P(4), P(5)), i,
+        results))
+COLUMNS(_bjt_dc_voltage_divider_, _bjt_store_dc_(
+        bjt_dc_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5)), i,
+        results))
+COLUMNS(_bjt_ac_voltage_divider_, _bjt_store_ac_(
+        bjt_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+        P(6), "bypassed"), i, results))
+COLUMNS(_bjt_ac_voltage_divider_unbypassed_, _bjt_store_ac_(
+        bjt_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+        P(6), "unbypassed"), i, results))
+COLUMNS(_bjt_dc_collector_feedback_, _bjt_store_dc_(
+        bjt_dc_collector_feedback(P(0), P(1), P(2), P(3), P(4)), i,
+        results))
+COLUMNS(_bjt_ac_collector_feedback_, _bjt_store_ac_(
+        bjt_ac_collector_feedback(P(0), P(1), P(2), P(3), P(4)), i,
+        results))
+COLUMNS(_bjt_ac_collector_dc_feedback_, _bjt_store_ac_(
+        bjt_ac_collector_dc_feedback(P(0), P(1), P(2), P(3), P(4),
+        P(5)), i, results))
+COLUMNS(_bjt_dc_emitter_follower_, _bjt_store_dc_(
+        bjt_dc_emitter_follower(P(0), P(1), P(2), P(3)), i, results))
+COLUMNS(_bjt_ac_emitter_follower_, _bjt_store_ac_(
+        bjt_ac_emitter_follower(P(0), P(1), P(2), P(3), P(4)), i,
+        results))
+COLUMNS(_bjt_dc_common_base_, _bjt_store_dc_(
+        bjt_dc_common_base(P(0), P(1), P(2), P(3), P(4)), i, results))
+COLUMNS(_bjt_ac_common_base_, _bjt_store_ac_(
+        bjt_ac_common_base(P(0), P(1), P(2), P(3), P(4)), i, results))
+COLUMNS(_bjt_dc_miscellaneous_bias_, _bjt_store_dc_(
+        bjt_dc_miscellaneous_bias(P(0), P(1), P(2), P(3)), i, results))
+
+// BJT systems.
+COLUMNS(_bjt_two_port_system_,
+        BJT_TwoPortAnalysis a = bjt_two_port_system(P(0), P(1), P(2),
+                                                    P(3), P(4));
+        results[0][i] = a.Avl; results[1][i] = a.Avs;
+        results[2][i] = a.Ail)
+COLUMNS(_bjt_cascaded_system_,
+        double Avnls[3] = {P(0), P(1), P(2)};
+        double Zis[3] = {P(3), P(4), P(5)};
+        double Zos[3] = {P(6), P(7), P(8)};
+        BJT_CascadedAnalysis a = bjt_cascaded_system(3, Avnls, Zis,
+                                                     Zos, P(9), P(10));
+        for (size_t s=0; s<3; s++) results[s][i] = a.voltages[s];
+        results[3][i] = a.Avt; results[4][i] = a.Avs;
+        results[5][i] = a.Ait)
+
+// BJT references of fused paths (separate DC and AC analyses).
+COLUMNS(_bjt_split_fixed_bias_, FUSED(bjt, 9,
+        bjt_dc_fixed_bias(P(0), P(1), P(2), P(3)),
+        bjt_ac_fixed_bias(P(0), P(1), P(2), P(3), P(4))))
+COLUMNS(_bjt_split_emitter_bias_, FUSED(bjt, 9,
+        bjt_dc_emitter_bias(P(0), P(1), P(2), P(3), P(4)),
+        bjt_ac_emitter_bias(P(0), P(1), P(2), P(3), P(4), P(5))))
+COLUMNS(_bjt_split_voltage_divider_, FUSED(bjt, 9,
+        bjt_dc_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5)),
+        bjt_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                               P(6), "bypassed")))
+COLUMNS(_bjt_split_voltage_divider_unbypassed_, FUSED(bjt, 9,
+        bjt_dc_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5)),
+        bjt_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                               P(6), "unbypassed")))
+// In AC domain, the separate analysis ignores 'Re' of operating
+// point. So, only the DC fields of fused analysis are compared.
+COLUMNS(_bjt_split_collector_feedback_, _bjt_store_dc_(
+        bjt_dc_collector_feedback(P(0), P(1), P(2), P(3), P(4)), i,
+        results))
+COLUMNS(_bjt_split_emitter_follower_, FUSED(bjt, 9,
+        bjt_dc_emitter_follower(P(0), P(1), P(2), P(3)),
+        bjt_ac_emitter_follower(P(0), P(1), P(2), P(3), P(4))))
+COLUMNS(_bjt_split_common_base_, FUSED(bjt, 9,
+        bjt_dc_common_base(P(0), P(1), P(2), P(3), P(4)),
+        bjt_ac_common_base(P(0), P(1), P(2), P(3),
+                           P(4) / (P(4) + 1))))
+
+// BJT fused analyses.
+COLUMNS(_bjt_analyze_fixed_bias_, BJT_FUSED(
+        bjt_analyze_fixed_bias(P(0), P(1), P(2), P(3), P(4))))
+COLUMNS(_bjt_analyze_emitter_bias_, BJT_FUSED(
+        bjt_analyze_emitter_bias(P(0), P(1), P(2), P(3), P(4), P(5))))
+COLUMNS(_bjt_analyze_voltage_divider_, BJT_FUSED(
+        bjt_analyze_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                    P(6), "bypassed")))
+COLUMNS(_bjt_analyze_voltage_divider_unbypassed_, BJT_FUSED(
+        bjt_analyze_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                    P(6), "unbypassed")))
+COLUMNS(_bjt_analyze_collector_feedback_, BJT_FUSED(
+        bjt_analyze_collector_feedback(P(0), P(1), P(2), P(3), P(4),
+                                       P(5))))
+COLUMNS(_bjt_analyze_emitter_follower_, BJT_FUSED(
+        bjt_analyze_emitter_follower(P(0), P(1), P(2), P(3), P(4))))
+COLUMNS(_bjt_analyze_common_base_, BJT_FUSED(
+        bjt_analyze_common_base(P(0), P(1), P(2), P(3), P(4))))
+
+/* BJT explicit batch analyses of voltage-divider configuration. */
+void _bjt_dc_voltage_divider_batch_(size_t num,
+      const double *const *params, double *const *results) {
+   double *const *r = results;
+   BJT_DCBatch dc = {r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7],
+                     r[8]};
+   bjt_dc_voltage_divider_batch(num, params[0], params[1], params[2],
+         params[3], params[4], params[5], dc);
+}
+
+void _bjt_ac_voltage_divider_batch_(size_t num,
+      const double *const *params, double *const *results) {
+   double *const *r = results;
+   BJT_ACBatch ac = {r[0], r[1], r[2], r[3]};
+   bjt_ac_voltage_divider_batch(num, params[0], params[1], params[2],
+         params[3], params[4], params[5], params[6], "bypassed", ac);
+}
+
+// JFET separate analyses.
+COLUMNS(_jfet_dc_fixed_bias_, _jfet_store_dc_(
+        jfet_dc_fixed_bias(P(0), P(1), P(2), P(3), P(4)), i, results))
+COLUMNS(_jfet_ac_fixed_bias_, _jfet_store_ac_(
+        jfet_ac_fixed_bias(P(0), P(1), P(2), P(3), P(4), P(5), P(6)),
+        i, results))
+COLUMNS(_jfet_dc_self_bias_, _jfet_store_dc_(
+        jfet_dc_self_bias(P(0), P(1), P(2), P(3), P(4)), i, results))
+COLUMNS(_jfet_ac_self_bias_, _jfet_store_ac_(
+        jfet_ac_self_bias(P(0), P(1), P(2), P(3), P(4), P(5), P(6)),
+        i, results))
+COLUMNS(_jfet_dc_voltage_divider_, _jfet_store_dc_(
+        jfet_dc_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+        P(6)), i, results))
+COLUMNS(_jfet_ac_voltage_divider_, _jfet_store_ac_(
+        jfet_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+        P(6), P(7)), i, results))
+COLUMNS(_jfet_dc_common_gate_, _jfet_store_dc_(
+        jfet_dc_common_gate(P(0), P(1), P(2), P(3), P(4), P(5)), i,
+        results))
+COLUMNS(_jfet_ac_common_gate_, _jfet_store_ac_(
+        jfet_ac_common_gate(P(0), P(1), P(2), P(3), P(4), P(5), P(6)),
+        i, results))
+COLUMNS(_jfet_ac_source_follower_, _jfet_store_ac_(
+        jfet_ac_source_follower(P(0), P(1), P(2), P(3), P(4), P(5),
+        P(6)), i, results))
+
+// JFET references of fused paths.
+COLUMNS(_jfet_split_fixed_bias_, FUSED(jfet, 6,
+        jfet_dc_fixed_bias(P(0), P(1), P(3), P(4), P(5)),
+        jfet_ac_fixed_bias(P(0), P(1), P(2), P(3), P(4), P(5), P(6))))
+COLUMNS(_jfet_split_self_bias_, FUSED(jfet, 6,
+        jfet_dc_self_bias(P(0), P(2), P(3), P(4), P(5)),
+        jfet_ac_self_bias(P(0), P(1), P(2), P(3), P(4), P(5), P(6))))
+COLUMNS(_jfet_split_voltage_divider_, FUSED(jfet, 6,
+        jfet_dc_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                P(6)),
+        jfet_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                P(6), P(7))))
+COLUMNS(_jfet_split_common_gate_, FUSED(jfet, 6,
+        jfet_dc_common_gate(P(0), P(1), P(2), P(3), P(4), P(5)),
+        jfet_ac_common_gate(P(0), P(1), P(2), P(3), P(4), P(5), P(6))))
+
+// JFET fused analyses.
+COLUMNS(_jfet_analyze_fixed_bias_, JFET_FUSED(
+        jfet_analyze_fixed_bias(P(0), P(1), P(2), P(3), P(4), P(5),
+                                P(6))))
+COLUMNS(_jfet_analyze_self_bias_, JFET_FUSED(
+        jfet_analyze_self_bias(P(0), P(1), P(2), P(3), P(4), P(5),
+                               P(6))))
+COLUMNS(_jfet_analyze_voltage_divider_, JFET_FUSED(
+        jfet_analyze_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                     P(6), P(7))))
+COLUMNS(_jfet_analyze_common_gate_, JFET_FUSED(
+        jfet_analyze_common_gate(P(0), P(1), P(2), P(3), P(4), P(5),
+                                 P(6))))
+
+// MOSFET separate analyses.
+COLUMNS(_mosfet_dc_drain_feedback_, _mosfet_store_dc_(
+        mosfet_dc_drain_feedback(P(0), P(1), P(2), P(3), P(4), P(5)),
+        i, results))
+COLUMNS(_mosfet_ac_drain_feedback_, _mosfet_store_ac_(
+        mosfet_ac_drain_feedback(P(0), P(1), P(2), P(3), P(4), P(5),
+        P(6)), i, results))
+COLUMNS(_mosfet_dc_voltage_divider_, _mosfet_store_dc_(
+        mosfet_dc_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+        P(6), P(7)), i, results))
+COLUMNS(_mosfet_ac_voltage_divider_, _mosfet_store_ac_(
+        mosfet_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+        P(6), P(7), P(8)), i, results))
+
+// MOSFET references of fused paths.
+COLUMNS(_mosfet_split_drain_feedback_, FUSED(mosfet, 4,
+        mosfet_dc_drain_feedback(P(0), P(1), P(2), P(3), P(4), P(5)),
+        mosfet_ac_drain_feedback(P(0), P(1), P(2), P(3), P(4), P(5),
+                                 P(6))))
+COLUMNS(_mosfet_split_voltage_divider_, FUSED(mosfet, 4,
+        mosfet_dc_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                  P(6), P(7)),
+        mosfet_ac_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+                                  P(6), P(7), P(8))))
+
+// MOSFET fused analyses.
+COLUMNS(_mosfet_analyze_drain_feedback_, MOSFET_FUSED(
+        mosfet_analyze_drain_feedback(P(0), P(1), P(2), P(3), P(4),
+                                      P(5), P(6))))
+COLUMNS(_mosfet_analyze_voltage_divider_, MOSFET_FUSED(
+        mosfet_analyze_voltage_divider(P(0), P(1), P(2), P(3), P(4),
+                                       P(5), P(6), P(7), P(8))))
+
+// Drain current of quadratics ('a', 'b' and 'c' columns).
+COLUMNS(_drain_current_columns_,
+        results[0][i] = _drain_current_(P(0), P(1), P(2)))
+
+void _drain_current_batch_columns_(size_t num,
+      const double *const *params, double *const *results) {
+   static unsigned char status[GOLDEN_POINTS];
+   for (size_t i=0; i<num; i+=GOLDEN_POINTS) {
+      size_t n = (num - i < GOLDEN_POINTS) ? num - i : GOLDEN_POINTS;
+      _drain_current_batch_(n, params[0] + i, params[1] + i,
+                            params[2] + i, results[0] + i, status);
+   }
+}
+
+// Compile-time reference designs of documented examples (their
+// parameters are ignored).
+const BJT_DCAnalysis bjt_dc_reference = REF_BJT_DC_VOLTAGE_DIVIDER(
+      22.0, 39000.0, 3900.0, 10000.0, 1500.0, 100.0);
+const BJT_ACAnalysis bjt_ac_reference =
+      REF_BJT_AC_VOLTAGE_DIVIDER_UNBYPASSED(16.0, 90000.0, 10000.0,
+                                            2200.0, 680.0, 210.0,
+                                            50000.0);
+const JFET_DCAnalysis jfet_dc_reference = REF_JFET_DC_SELF_BIAS(20.0,
+      3300.0, 1000.0, 0.008, -6.0);
+const JFET_ACAnalysis jfet_ac_reference = REF_JFET_AC_COMMON_GATE(15.0,
+      0.0, 3300.0, 1500.0, 0.008, -2.8, 4e+4);
+const MOSFET_ACAnalysis mosfet_ac_reference =
+      REF_MOSFET_AC_VOLTAGE_DIVIDER(24.0, 1e+7, 6.8e+6, 2200.0, 750.0,
+                                    0.005, 6.0, 3.0, 1e+6);
+_Static_assert(REF_BJT_ACTIVE_VOLTAGE_DIVIDER(22.0, 39000.0, 3900.0,
+      10000.0, 1500.0, 100.0), "BJT reference isn't active");
+_Static_assert(REF_JFET_ACTIVE_SELF_BIAS(20.0, 3300.0, 1000.0, 0.008,
+      -6.0), "JFET reference isn't saturated");
+_Static_assert(REF_MOSFET_ACTIVE_VOLTAGE_DIVIDER(24.0, 1e+7, 6.8e+6,
+      2200.0, 750.0, 0.005, 6.0, 3.0), "MOSFET reference isn't "
+      "saturated");
+COLUMNS(_bjt_dc_reference_, _bjt_store_dc_(bjt_dc_reference, i,
+        results))
+COLUMNS(_bjt_ac_reference_, _bjt_store_ac_(bjt_ac_reference, i,
+        results))
+COLUMNS(_jfet_dc_reference_, _jfet_store_dc_(jfet_dc_reference, i,
+        results))
+COLUMNS(_jfet_ac_reference_, _jfet_store_ac_(jfet_ac_reference, i,
+        results))
+COLUMNS(_mosfet_ac_reference_, _mosfet_store_ac_(mosfet_ac_reference, i,
+        results))
+
+/* Run the uniform batch evaluation of a configuration. */
+#define UNIFORM(name, table, config) \
+   void name(size_t num, const double *const *params, \
+             double *const *results) { \
+      find_configuration(table, num_##table, config)->evaluate( \
+            num, params, results); \
+   }
+UNIFORM(_bjt_batch_fixed_bias_, bjt_configurations, "fixed_bias")
+UNIFORM(_bjt_batch_emitter_bias_, bjt_configurations, "emitter_bias")
+UNIFORM(_bjt_batch_voltage_divider_, bjt_configurations,
+        "voltage_divider")
+UNIFORM(_bjt_batch_voltage_divider_unbypassed_, bjt_configurations,
+        "voltage_divider_unbypassed")
+UNIFORM(_bjt_batch_collector_feedback_, bjt_configurations,
+        "collector_feedback")
+UNIFORM(_bjt_batch_emitter_follower_, bjt_configurations,
+        "emitter_follower")
+UNIFORM(_bjt_batch_common_base_, bjt_configurations, "common_base")
+UNIFORM(_jfet_batch_fixed_bias_, jfet_configurations, "fixed_bias")
+UNIFORM(_jfet_batch_self_bias_, jfet_configurations, "self_bias")
+UNIFORM(_jfet_batch_voltage_divider_, jfet_configurations,
+        "voltage_divider")
+UNIFORM(_jfet_batch_common_gate_, jfet_configurations, "common_gate")
+UNIFORM(_mosfet_batch_drain_feedback_, mosfet_configurations,
+        "drain_feedback")
+UNIFORM(_mosfet_batch_voltage_divider_, mosfet_configurations,
+        "voltage_divider")
+
+/* Run the float screening of a configuration on double columns. */
+void _screen_(const struct Configuration *config, size_t num,
+              const double *const *params, double *const *results) {
+   float fparams[MAX_PARAMS][PRECISION_BLOCK];
+   float fresults[MAX_RESULTS][PRECISION_BLOCK];
+   const float *fp[MAX_PARAMS];
+   float *fr[MAX_RESULTS];
+   for (size_t k=0; k<MAX_RESULTS; k++) fr[k] = fresults[k];
+   for (size_t i=0; i<num; i+=PRECISION_BLOCK) {
+      size_t n = (num - i < PRECISION_BLOCK) ? num - i : PRECISION_BLOCK;
+      for (size_t j=0; j<config->nparams; j++) {
+         for (size_t b=0; b<n; b++) fparams[j][b] = params[j][i + b];
+         fp[j] = fparams[j];
+      }
+      screen_configuration(config, n, fp, fr);
+      for (size_t k=0; k<config->nresults; k++)
+         for (size_t b=0; b<n; b++) results[k][i + b] = fresults[k][b];
+   }
+}
+#define SCREEN(name, table, config) \
+   void name(size_t num, const double *const *params, \
+             double *const *results) { \
+      _screen_(find_configuration(table, num_##table, config), num, \
+               params, results); \
+   }
+SCREEN(_bjt_screened_fixed_bias_, bjt_configurations, "fixed_bias")
+SCREEN(_bjt_screened_emitter_bias_, bjt_configurations, "emitter_bias")
+SCREEN(_bjt_screened_voltage_divider_, bjt_configurations,
+       "voltage_divider")
+SCREEN(_bjt_screened_voltage_divider_unbypassed_, bjt_configurations,
+       "voltage_divider_unbypassed")
+SCREEN(_bjt_screened_collector_feedback_, bjt_configurations,
+       "collector_feedback")
+SCREEN(_bjt_screened_emitter_follower_, bjt_configurations,
+       "emitter_follower")
+SCREEN(_bjt_screened_common_base_, bjt_configurations, "common_base")
+SCREEN(_jfet_screened_fixed_bias_, jfet_configurations, "fixed_bias")
+SCREEN(_jfet_screened_self_bias_, jfet_configurations, "self_bias")
+SCREEN(_jfet_screened_voltage_divider_, jfet_configurations,
+       "voltage_divider")
+SCREEN(_jfet_screened_common_gate_, jfet_configurations, "common_gate")
+SCREEN(_mosfet_screened_drain_feedback_, mosfet_configurations,
+       "drain_feedback")
+SCREEN(_mosfet_screened_voltage_divider_, mosfet_configurations,
+       "voltage_divider")
+
+// Cache of cached paths (created for the count of points):
+struct ResultCache *golden_cache;
+
+#define CACHED(name, table, config) \
+   void name(size_t num, const double *const *params, \
+             double *const *results) { \
+      cached_configuration(golden_cache, find_configuration(table, \
+            num_##table, config), num, params, results); \
+   }
+CACHED(_bjt_cached_emitter_follower_, bjt_configurations,
+       "emitter_follower")
+CACHED(_jfet_cached_self_bias_, jfet_configurations, "self_bias")
+CACHED(_mosfet_cached_voltage_divider_, mosfet_configurations,
+       "voltage_divider")
+
+/* Analyze designs with one incremental analysis, updating the
+parameters of each design one by one (in reverse order). */
+void _incremental_(const struct IncrementalGraph *graph, size_t num,
+                   const double *const *params,
+                   double *const *results) {
+   double first[MAX_PARAMS];
+   for (size_t p=0; p<graph->nparams; p++) first[p] = params[p][0];
+   struct IncrementalAnalysis analysis = incremental_analysis(graph,
+                                                              first);
+   for (size_t i=0; i<num; i++) {
+      for (size_t p=graph->nparams; p-->0;) {
+         incremental_update(&analysis, p, P(p));
+         incremental_refresh(&analysis);
+      }
+      for (size_t r=0; r<INCREMENTAL_RESULTS; r++)
+         results[r][i] = incremental_value(&analysis, r);
+   }
+}
+
+// Incremental analyses:
+void _bjt_incremental_emitter_bias_(size_t num,
+      const double *const *params, double *const *results) {
+   _incremental_(&bjt_incremental_emitter_bias, num, params, results);
+}
+void _jfet_incremental_voltage_divider_(size_t num,
+      const double *const *params, double *const *results) {
+   _incremental_(&jfet_incremental_voltage_divider, num, params,
+                 results);
+}
+
+// Three-stage cascaded systems as a batch and as one updated tree:
+void _bjt_cascade_batch_(size_t num, const double *const *params,
+                         double *const *results) {
+   BJT_CascadeBatch totals = {results[3], results[4], results[5]};
+   bjt_cascade_batch(num, 3, params, params + 3, params + 6, params[9],
+                     params[10], results, totals);
+}
+void _bjt_cascade_tree_(size_t num, const double *const *params,
+                        double *const *results) {
+   double Avnls[3], Zis[3], Zos[3], tree[BJT_CASCADE_TREE(3)];
+   for (size_t s=0; s<3; s++) {
+      Avnls[s] = params[s][0]; Zis[s] = params[3 + s][0];
+      Zos[s] = params[6 + s][0];
+   }
+   struct BJT_Cascade cascade = bjt_cascade(3, Avnls, Zis, Zos,
+                                            params[9][0], params[10][0],
+                                            tree);
+   for (size_t i=0; i<num; i++) {
+      for (size_t s=0; s<3; s++)
+         bjt_cascade_update_stage(&cascade, s, P(s), P(3 + s),
+                                  P(6 + s));
+      bjt_cascade_update_load(&cascade, P(9), P(10));
+      BJT_CascadeTotals totals = bjt_cascade_totals(&cascade);
+      for (size_t s=0; s<3; s++)
+         results[s][i] = bjt_cascade_gain(&cascade, s);
+      results[3][i] = totals.Avt; results[4][i] = totals.Avs;
+      results[5][i] = totals.Ait;
+   }
+}
+
+// BJT exact analyses (with typical silicon junctions).
+#define BJT_EXACT(call) _bjt_store_exact_(call, i, results)
+COLUMNS(_bjt_solve_fixed_bias_, BJT_EXACT(bjt_exact_fixed_bias(P(0),
+        P(1), P(2), P(3), P(4), bjt_junctions)))
+COLUMNS(_bjt_solve_emitter_bias_, BJT_EXACT(bjt_exact_emitter_bias(
+        P(0), P(1), P(2), P(3), P(4), P(5), bjt_junctions)))
+COLUMNS(_bjt_solve_voltage_divider_, BJT_EXACT(
+        bjt_exact_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+        P(6), "bypassed", bjt_junctions)))
+COLUMNS(_bjt_solve_voltage_divider_unbypassed_, BJT_EXACT(
+        bjt_exact_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+        P(6), "unbypassed", bjt_junctions)))
+COLUMNS(_bjt_solve_collector_feedback_, BJT_EXACT(
+        bjt_exact_collector_feedback(P(0), P(1), P(2), P(3), P(4), P(5),
+        bjt_junctions)))
+UNIFORM(_bjt_exact_batch_fixed_bias_, bjt_exact_configurations,
+        "fixed_bias")
+UNIFORM(_bjt_exact_batch_emitter_bias_, bjt_exact_configurations,
+        "emitter_bias")
+UNIFORM(_bjt_exact_batch_voltage_divider_, bjt_exact_configurations,
+        "voltage_divider")
+UNIFORM(_bjt_exact_batch_voltage_divider_unbypassed_,
+        bjt_exact_configurations, "voltage_divider_unbypassed")
+UNIFORM(_bjt_exact_batch_collector_feedback_, bjt_exact_configurations,
+        "collector_feedback")
+
+// DC results of exact BJT analyses (netlist references).
+COLUMNS(_bjt_exact_dc_fixed_bias_, _bjt_store_dc_(bjt_exact_fixed_bias(
+        P(0), P(1), P(2), P(3), P(4), bjt_junctions).dc, i, results))
+COLUMNS(_bjt_exact_dc_voltage_divider_, _bjt_store_dc_(
+        bjt_exact_voltage_divider(P(0), P(1), P(2), P(3), P(4), P(5),
+        P(6), "bypassed", bjt_junctions).dc, i, results))
+
+/* Store the DC results of the BJT (element 'q') of a netlist with
+its base node 'b', collector node 'c' and emitter resistor 're' (or
+the grounded emitter if it is NETLIST_NONE). */
+void _bjt_store_netlist_(const struct Netlist *netlist, size_t q,
+                         size_t b, size_t c, size_t re, double Icsat,
+                         size_t i, double *const *results) {
+   BJT_DCAnalysis a;
+   size_t e = (re == NETLIST_NONE) ? 0 : c + 1;
+   a.Ic = netlist_current(netlist, q);
+   a.Ie = (re == NETLIST_NONE) ? a.Ic + netlist_current(netlist, 1) :
+          netlist_current(netlist, re);
+   a.Ib = a.Ie - a.Ic;
+   a.Icsat = Icsat;
+   a.Vb = netlist_voltage(netlist, b);
+   a.Vc = netlist_voltage(netlist, c);
+   a.Ve = netlist_voltage(netlist, e);
+   a.Vce = a.Vc - a.Ve;
+   a.Vbc = a.Vb - a.Vc;
+   _bjt_store_dc_(a, i, results);
+   // Failed solves don't match any reference.
+   if (!netlist->converged) results[1][i] = NAN;
+}
+
+/* Solve fixed-bias designs with one netlist (element 'k' is the k'th
+parameter, so only values change). */
+void _bjt_netlist_fixed_bias_(size_t num, const double *const *params,
+                              double *const *results) {
+   struct Netlist *netlist = create_netlist(4, 4);
+   netlist_voltage_source(netlist, "Vcc", 1, 0, 1);
+   netlist_resistor(netlist, "Rb", 1, 2, 1);
+   netlist_resistor(netlist, "Rc", 1, 3, 1);
+   netlist_bjt(netlist, "Q", 3, 2, 0, 1);
+   for (size_t i=0; i<num; i++) {
+      for (size_t k=0; k<4; k++) netlist_set_value(netlist, k, P(k));
+      netlist_solve(netlist);
+      _bjt_store_netlist_(netlist, 3, 2, 3, NETLIST_NONE,
+                          P(0) / P(2), i, results);
+   }
+   destroy_netlist(netlist);
+}
+
+/* Solve voltage-divider designs with one netlist. */
+void _bjt_netlist_voltage_divider_(size_t num,
+      const double *const *params, double *const *results) {
+   struct Netlist *netlist = create_netlist(5, 6);
+   netlist_voltage_source(netlist, "Vcc", 1, 0, 1);
+   netlist_resistor(netlist, "Rb1", 1, 2, 1);
+   netlist_resistor(netlist, "Rb2", 2, 0, 1);
+   netlist_resistor(netlist, "Rc", 1, 3, 1);
+   netlist_resistor(netlist, "Re", 4, 0, 1);
+   netlist_bjt(netlist, "Q", 3, 2, 4, 1);
+   for (size_t i=0; i<num; i++) {
+      for (size_t k=0; k<6; k++) netlist_set_value(netlist, k, P(k));
+      netlist_solve(netlist);
+      _bjt_store_netlist_(netlist, 5, 2, 3, 4, P(0) / (P(3) + P(4)), i,
+                          results);
+   }
+   destroy_netlist(netlist);
+}
+
+/* Solve self-bias designs with a new netlist for each one. */
+void _jfet_netlist_self_bias_(size_t num, const double *const *params,
+                              double *const *results) {
+   for (size_t i=0; i<num; i++) {
+      struct Netlist *netlist = create_netlist(5, 5);
+      netlist_voltage_source(netlist, "Vdd", 1, 0, P(0));
+      netlist_resistor(netlist, "Rg", 3, 0, P(1));
+      netlist_resistor(netlist, "Rd", 1, 2, P(2));
+      netlist_resistor(netlist, "Rs", 4, 0, P(3));
+      netlist_jfet(netlist, "J", 2, 3, 4, P(4), P(5));
+      JFET_DCAnalysis a;
+      a.Id = netlist_solve(netlist) ? netlist_current(netlist, 4) : NAN;
+      a.Vg = netlist_voltage(netlist, 3);
+      a.Vs = netlist_voltage(netlist, 4);
+      a.Vd = netlist_voltage(netlist, 2);
+      a.Vgs = a.Vg - a.Vs;
+      a.Vds = a.Vd - a.Vs;
+      _jfet_store_dc_(a, i, results);
+      destroy_netlist(netlist);
+   }
+}
+COLUMNS(_jfet_dc_self_bias_columns_, _jfet_store_dc_(jfet_dc_self_bias(
+        P(0), P(2), P(3), P(4), P(5)), i, results))
+
+/* Classify the uniform evaluations of a configuration. The region
+bits are the only result field. */
+void _classify_(const struct Configuration *config, size_t num,
+                const double *const *params, double *const *results) {
+   double columns[MAX_RESULTS][PRECISION_BLOCK];
+   unsigned char regions[PRECISION_BLOCK];
+   const double *p[MAX_PARAMS];
+   double *r[MAX_RESULTS];
+   for (size_t k=0; k<MAX_RESULTS; k++) r[k] = columns[k];
+   for (size_t i=0; i<num; i+=PRECISION_BLOCK) {
+      size_t n = (num - i < PRECISION_BLOCK) ? num - i : PRECISION_BLOCK;
+      for (size_t j=0; j<config->nparams; j++) p[j] = params[j] + i;
+      config->evaluate(n, p, r);
+      classify_regions(config, n, p, (const double *const *) r,
+                       regions);
+      for (size_t b=0; b<n; b++) results[0][i + b] = regions[b];
+   }
+}
+#define CLASSIFY(name, table, config) \
+   void name(size_t num, const double *const *params, \
+             double *const *results) { \
+      _classify_(find_configuration(table, num_##table, config), num, \
+                 params, results); \
+   }
+CLASSIFY(_bjt_classified_fixed_bias_, bjt_configurations, "fixed_bias")
+CLASSIFY(_bjt_classified_emitter_follower_, bjt_configurations,
+         "emitter_follower")
+CLASSIFY(_bjt_classified_common_base_, bjt_configurations, "common_base")
+CLASSIFY(_jfet_classified_self_bias_, jfet_configurations, "self_bias")
+CLASSIFY(_mosfet_classified_voltage_divider_, mosfet_configurations,
+         "voltage_divider")
+
+/* Regions by their definitions (the references of classifiers). */
+double _bjt_region_(BJT_DCAnalysis dc) {
+   if (isnan(dc.Ic)) return 0;
+   if (dc.Ic <= 0) return REGION_CUTOFF;
+   if (isnan(dc.Vce)) return 0;
+   if (dc.Vce <= VCE_SAT) return REGION_SATURATION;
+   return REGION_ACTIVE;
+}
+
+double _fet_region_(double Vgs, double Vds, double Voff) {
+   if (isnan(Vgs) || isnan(Vds)) return 0;
+   if (Vgs - Voff <= 0) return REGION_CUTOFF;
+   if (Vds < Vgs - Voff) return REGION_OHMIC;
+   return REGION_ACTIVE;
+}
+COLUMNS(_bjt_region_fixed_bias_, results[0][i] = _bjt_region_(
+        bjt_dc_fixed_bias(P(0), P(1), P(2), P(3))))
+COLUMNS(_bjt_region_emitter_follower_, results[0][i] = _bjt_region_(
+        bjt_dc_emitter_follower(P(0), P(1), P(2), P(3))))
+COLUMNS(_bjt_region_common_base_, results[0][i] = _bjt_region_(
+        bjt_dc_common_base(P(0), P(1), P(2), P(3), P(4))))
+COLUMNS(_jfet_region_self_bias_, results[0][i] = _fet_region_(
+        jfet_dc_self_bias(P(0), P(2), P(3), P(4), P(5)).Vgs,
+        jfet_dc_self_bias(P(0), P(2), P(3), P(4), P(5)).Vds, P(5)))
+
+/* Regions of MOSFET voltage-divider designs by their definitions (on
+the double evaluations, the scalar ones are float). */
+void _mosfet_region_voltage_divider_(size_t num,
+      const double *const *params, double *const *results) {
+   double columns[MAX_RESULTS][PRECISION_BLOCK];
+   const double *p[MAX_PARAMS];
+   double *r[MAX_RESULTS];
+   for (size_t k=0; k<MAX_RESULTS; k++) r[k] = columns[k];
+   for (size_t i=0; i<num; i+=PRECISION_BLOCK) {
+      size_t n = (num - i < PRECISION_BLOCK) ? num - i : PRECISION_BLOCK;
+      for (size_t j=0; j<9; j++) p[j] = params[j] + i;
+      _mosfet_batch_voltage_divider_(n, p, r);
+      for (size_t b=0; b<n; b++)
+         results[0][i + b] = _fet_region_(r[2][b], r[3][b], p[7][b]);
+   }
+}
+
+/* Validate the uniform evaluations of a configuration like the
+engines. The status is the only result field. */
+void _validate_(const struct Configuration *config, size_t num,
+                const double *const *params, double *const *results) {
+   double columns[MAX_PARAMS + MAX_RESULTS][PRECISION_BLOCK];
+   unsigned char status[PRECISION_BLOCK];
+   double *p[MAX_PARAMS], *r[MAX_RESULTS];
+   for (size_t k=0; k<MAX_PARAMS; k++) p[k] = columns[k];
+   for (size_t k=0; k<MAX_RESULTS; k++) r[k] = columns[MAX_PARAMS + k];
+   for (size_t i=0; i<num; i+=PRECISION_BLOCK) {
+      size_t n = (num - i < PRECISION_BLOCK) ? num - i : PRECISION_BLOCK;
+      for (size_t j=0; j<config->nparams; j++)
+         memcpy(p[j], params[j] + i, n * sizeof(double));
+      if (validate_params(config, n, (const double *const *) p,
+                          status) > 0)
+         replace_faulty_params(config, n, p, status);
+      config->evaluate(n, (const double *const *) p, r);
+      validate_results(config, n, (const double *const *) r, status);
+      for (size_t b=0; b<n; b++) results[0][i + b] = status[b];
+   }
+}
+#define VALIDATE(name, table, config) \
+   void name(size_t num, const double *const *params, \
+             double *const *results) { \
+      _validate_(find_configuration(table, num_##table, config), num, \
+                 params, results); \
+   }
+VALIDATE(_mosfet_validated_voltage_divider_, mosfet_configurations,
+         "voltage_divider")
+
+/* Faults by their definitions (the reference of validation). The
+first fault of each design is found on the scalar loop. */
+double _fault_(const struct Configuration *config, size_t i,
+               const double *const *params, double *const *results) {
+   for (size_t p=0; p<config->nparams; p++) {
+      int positive = (config->positive >> p) & 1;
+      if (!isfinite(P(p)) || (positive && P(p) <= 0))
+         return FAULT_PARAMETER;
+   }
+   for (size_t r=0; r<config->nresults; r++)
+      if (isinf(results[r][i])) return FAULT_DIVISION;
+   if (isnan(results[config->metrics[METRIC_I]][i]))
+      return FAULT_DISCRIMINANT;
+   for (size_t r=0; r<config->nresults; r++)
+      if (isnan(results[r][i])) return FAULT_NONFINITE;
+   return 0;
+}
+
+/* Faults of MOSFET voltage-divider designs by their definitions (on
+the double evaluations, the scalar ones are float). */
+void _mosfet_fault_voltage_divider_(size_t num,
+      const double *const *params, double *const *results) {
+   const struct Configuration *config = find_configuration(
+         mosfet_configurations, num_mosfet_configurations,
+         "voltage_divider");
+   double columns[MAX_RESULTS][PRECISION_BLOCK];
+   const double *p[MAX_PARAMS];
+   double *r[MAX_RESULTS];
+   for (size_t k=0; k<MAX_RESULTS; k++) r[k] = columns[k];
+   for (size_t i=0; i<num; i+=PRECISION_BLOCK) {
+      size_t n = (num - i < PRECISION_BLOCK) ? num - i : PRECISION_BLOCK;
+      for (size_t j=0; j<9; j++) p[j] = params[j] + i;
+      config->evaluate(n, p, r);
+      for (size_t b=0; b<n; b++)
+         results[0][i + b] = _fault_(config, b, p, r);
+   }
+}
+
+/* Validate the documented faults of 'validate_results()': a valid
+MOSFET voltage-divider design, then one with Rd = 0, Vgson = Vgsth
+and a gate voltage far below Vgsth (the parameters are ignored). */
+void _validate_example_(size_t num, const double *const *params,
+                        double *const *results) {
+   (void) params;
+   const struct Configuration *config = find_configuration(
+         mosfet_configurations, num_mosfet_configurations,
+         "voltage_divider");
+   double designs[9][4] = {
+      {24, 24, 24, 24}, {1e+7, 1e+7, 1e+7, 1e+7},
+      {6.8e+6, 6.8e+6, 6.8e+6, 1e+5}, {2200, 0, 2200, 2200},
+      {750, 750, 750, 750}, {0.005, 0.005, 0.005, 0.005},
+      {6, 6, 3, 6}, {3, 3, 3, 3}, {1e+6, 1e+6, 1e+6, 1e+6},
+   };
+   double columns[MAX_RESULTS][4], *p[9], *r[MAX_RESULTS];
+   unsigned char status[4];
+   for (size_t k=0; k<9; k++) p[k] = designs[k];
+   for (size_t k=0; k<MAX_RESULTS; k++) r[k] = columns[k];
+   for (size_t i=0; i<num; i++) {
+      if (validate_params(config, 4, (const double *const *) p,
+                          status) > 0)
+         replace_faulty_params(config, 4, p, status);
+      config->evaluate(4, (const double *const *) p, r);
+      results[4][i] = validate_results(config, 4,
+                                       (const double *const *) r,
+                                       status);
+      for (size_t b=0; b<4; b++) results[b][i] = status[b];
+   }
+}
+
+/* Analyze a self-bias JFET whose Vp spreads across |Vp| = 1 by
+'monte_carlo()' and store its failures and the means of its Id and Av
+(its parameters are ignored). */
+void _monte_carlo_example_(size_t num, const double *const *params,
+                           double *const *results) {
+   (void) params;
+   const struct Configuration *config = find_configuration(
+         jfet_configurations, num_jfet_configurations, "self_bias");
+   struct Distribution distributions[7] = {
+      {DIST_FIXED, 20, 0}, {DIST_FIXED, 1e+6, 0}, {DIST_FIXED, 3300, 0},
+      {DIST_FIXED, 1000, 0}, {DIST_FIXED, 0.008, 0},
+      {DIST_UNIFORM, -1, 0.2}, {DIST_FIXED, 50000, 0},
+   };
+   for (size_t i=0; i<num; i++) {
+      MonteCarloAnalysis analysis = monte_carlo(config, distributions,
+                                                100000, 2024, 0);
+      results[0][i] = analysis.failures;
+      results[1][i] = analysis.metrics[METRIC_I].mean;
+      results[2][i] = analysis.metrics[METRIC_AV].mean;
+   }
+}
+
+/* Analyze a self-bias JFET whose Rs and Vp spread across 0 by
+'monte_carlo()' and store its failures and their count of each kind
+(its parameters are ignored). */
+void _monte_carlo_faults_(size_t num, const double *const *params,
+                          double *const *results) {
+   (void) params;
+   const struct Configuration *config = find_configuration(
+         jfet_configurations, num_jfet_configurations, "self_bias");
+   struct Distribution distributions[7] = {
+      {DIST_FIXED, 20, 0}, {DIST_FIXED, 1e+6, 0}, {DIST_FIXED, 3300, 0},
+      {DIST_UNIFORM, 1000, 1.5}, {DIST_FIXED, 0.008, 0},
+      {DIST_UNIFORM, -1, 1.5}, {DIST_FIXED, 50000, 0},
+   };
+   for (size_t i=0; i<num; i++) {
+      MonteCarloAnalysis analysis = monte_carlo(config, distributions,
+                                                100000, 2024, 0);
+      results[0][i] = analysis.failures;
+      for (int f=0; f<NUM_FAULTS; f++)
+         results[1 + f][i] = analysis.faults[f];
+   }
+}
+
+/* Analyze the emitter-bias spread of 'monte_carlo()' on 1, 3 and 7
+threads and store if the means and stddevs of 3 and 7 threads are the
+same bits as the ones of 1 thread (its parameters are ignored). */
+void _monte_carlo_threads_(size_t num, const double *const *params,
+                           double *const *results) {
+   (void) params;
+   const struct Configuration *config = find_configuration(
+         bjt_configurations, num_bjt_configurations, "emitter_bias");
+   struct Distribution distributions[6] = {
+      {DIST_FIXED, 20, 0}, {DIST_UNIFORM, 470000, 0.05},
+      {DIST_UNIFORM, 2200, 0.05}, {DIST_UNIFORM, 560, 0.05},
+      {DIST_GAUSSIAN, 120, 0.1}, {DIST_FIXED, 40000, 0},
+   };
+   for (size_t i=0; i<num; i++) {
+      MonteCarloAnalysis single = monte_carlo(config, distributions,
+                                              1000003, 2024, 1);
+      for (size_t t=0; t<2; t++) {
+         MonteCarloAnalysis analysis = monte_carlo(config,
+               distributions, 1000003, 2024, t ? 7 : 3);
+         int same = 1;
+         for (int m=0; m<NUM_METRICS; m++)
+            same &= analysis.metrics[m].mean == single.metrics[m].mean &&
+                    analysis.metrics[m].stddev ==
+                    single.metrics[m].stddev;
+         results[t][i] = same;
+      }
+   }
+}
+
+/* Write the E96 values from 0.1 to 1e+10 (more than MAX_VALUES) and
+store their count and the last written one, then search the
+documented design of 'design_voltage_divider()' in that range and in
+an empty one and store their counts of designs and clamped values
+(its parameters are ignored). */
+void _design_range_example_(size_t num, const double *const *params,
+                            double *const *results) {
+   (void) params;
+   double values[MAX_VALUES];
+   for (size_t i=0; i<num; i++) {
+      results[0][i] = standard_resistors(E96, 0.1, 1e+10, values);
+      results[1][i] = values[MAX_VALUES - 1];
+      DesignAnalysis wide = design_voltage_divider(22, 100, 0.002, 10,
+                                                   0.01, E96, 0.1,
+                                                   1e+10, 1);
+      DesignAnalysis empty = design_voltage_divider(22, 100, 0.002, 10,
+                                                    0.01, E12, 1050,
+                                                    1060, 1);
+      results[2][i] = wide.count;
+      results[3][i] = wide.clamped;
+      results[4][i] = wide.designs[0].error;
+      results[5][i] = empty.count;
+      results[6][i] = empty.evaluated;
+   }
+}
+
+/* Format the layout examples of Format.h and a value whose Grisu2
+digits aren't the shortest ones, and store their lengths and whether
+they read back (its parameters are ignored). */
+void _format_example_(size_t num, const double *const *params,
+                      double *const *results) {
+   (void) params;
+   const double values[3] = {6.820833333333333, 4.708333333333334e-05,
+                             1.1912524749460141e+17};
+   char out[TEXT_NUMBER];
+   for (size_t i=0; i<num; i++) {
+      results[3][i] = 0;
+      for (size_t v=0; v<3; v++) {
+         int length = format_double(out, values[v]);
+         out[length] = '\0';
+         results[v][i] = length;
+         results[3][i] += strtod(out, NULL) == values[v];
+      }
+   }
+}
+
+/* Analyze the documented jobs of 'run_jobs()' with the library
+(TransCal.c is another translation unit, which includes the family
+headers too) and store the Ic and Id of the valid jobs, the count of
+faulty jobs and the status of the faulty one. */
+void _run_jobs_example_(size_t num, const double *const *params,
+                        double *const *results) {
+   (void) params;
+   for (size_t i=0; i<num; i++) {
+      struct Job jobs[3] = {
+         {dispatch(DEVICE_BJT, "fixed_bias"),
+          {12, 240000, 2200, 50, 40000}},
+         {dispatch(DEVICE_JFET, "self_bias"),
+          {20, 1000000, 3300, 1000, 0.008, -6, 50000}},
+         {dispatch(DEVICE_BJT, "fixed_bias"), {12, 0, 2200, 50, 40000}},
+      };
+      results[2][i] = run_jobs(jobs, 3, 0);
+      results[0][i] = jobs[0].results[1];
+      results[1][i] = jobs[1].results[0];
+      results[3][i] = jobs[2].status;
+   }
+}
+
+/* Sweep the documented example of 'sweep_regions()' and store the
+Ic of its accepted points and their count. */
+void _sweep_regions_consumer_(void *context, size_t first, size_t num,
+                              const double *const *params,
+                              const double *const *results,
+                              const unsigned char *status) {
+   (void) params; (void) status;
+   double *const *columns = context;
+   for (size_t i=0; i<num && first + i < 3; i++)
+      columns[first + i][0] = results[1][i];
+}
+void _sweep_regions_example_(size_t num, const double *const *params,
+                             double *const *results) {
+   (void) params;
+   struct Axis axes[5] = {
+      {AXIS_LINEAR, 12, 12, 1}, {AXIS_LOG, 100000, 1000000, 5},
+      {AXIS_LINEAR, 2400, 2400, 1}, {AXIS_LINEAR, 100, 100, 1},
+      {AXIS_LINEAR, 50000, 50000, 1},
+   };
+   for (size_t i=0; i<num; i++)
+      results[3][i] = sweep_regions(find_configuration(
+            bjt_configurations, num_bjt_configurations, "fixed_bias"),
+            axes, REGION_ACTIVE, _sweep_regions_consumer_,
+            (void *) results, 1);
+}
+
+/* Sweep emitter-bias designs whose Re axis starts at -100 (the first
+two points are faulty) and store the count of points, the count of
+faulty ones (with NAN Ic), the Re and the fault of the first point
+and the Ic of the third one. */
+void _sweep_faulty_consumer_(void *context, size_t first, size_t num,
+                             const double *const *params,
+                             const double *const *results,
+                             const unsigned char *status) {
+   double *const *columns = context;
+   for (size_t i=0; i<num; i++) {
+      columns[1][0] += (status[i] != 0) & isnan(results[1][i]);
+      if (first + i == 0) columns[2][0] = params[3][i];
+      if (first + i == 0) columns[4][0] = status[i];
+      if (first + i == 2) columns[3][0] = results[1][i];
+   }
+}
+void _sweep_faulty_example_(size_t num, const double *const *params,
+                            double *const *results) {
+   (void) params;
+   struct Axis axes[6] = {
+      {AXIS_LINEAR, 20, 20, 1}, {AXIS_LINEAR, 470000, 470000, 1},
+      {AXIS_LINEAR, 2200, 2200, 1}, {AXIS_LINEAR, -100, 1000, 12},
+      {AXIS_LINEAR, 120, 120, 1}, {AXIS_LINEAR, 40000, 40000, 1},
+   };
+   for (size_t i=0; i<num; i++) {
+      results[1][0] = 0;
+      results[0][i] = sweep(find_configuration(bjt_configurations,
+            num_bjt_configurations, "emitter_bias"), axes,
+            _sweep_faulty_consumer_, (void *) results, 1);
+   }
+}
+
+/* Solve a structurally singular netlist (node 2 is only fed by a
+current source) and store the result of the solve and V(2). */
+void _netlist_singular_(size_t num, const double *const *params,
+                        double *const *results) {
+   (void) params;
+   struct Netlist *netlist = create_netlist(3, 3);
+   netlist_voltage_source(netlist, "Vcc", 1, 0, 12);
+   netlist_resistor(netlist, "R1", 1, 0, 1000);
+   netlist_current_source(netlist, "I1", 1, 2, 0.001);
+   for (size_t i=0; i<num; i++) {
+      results[0][i] = netlist_solve(netlist);
+      results[1][i] = netlist_voltage(netlist, 2);
+   }
+   destroy_netlist(netlist);
+}
+
+/* Solve the documented example of Netlist.h (its parameters are
+ignored). */
+void _netlist_example_(size_t num, const double *const *params,
+                       double *const *results) {
+   (void) params;
+   struct Netlist *netlist = create_netlist(7, 9);
+   netlist_voltage_source(netlist, "Vcc", 1, 0, 22);
+   netlist_resistor(netlist, "R1", 1, 2, 39000);
+   netlist_resistor(netlist, "R2", 2, 0, 3900);
+   netlist_resistor(netlist, "Rc1", 1, 3, 10000);
+   netlist_resistor(netlist, "Re1", 4, 0, 1500);
+   size_t Q1 = netlist_bjt(netlist, "Q1", 3, 2, 4, 100);
+   netlist_resistor(netlist, "Rc2", 1, 5, 4700);
+   netlist_resistor(netlist, "Re2", 6, 0, 1200);
+   size_t Q2 = netlist_bjt(netlist, "Q2", 5, 2, 6, 100);
+   for (size_t i=0; i<num; i++) {
+      netlist_solve(netlist);
+      results[0][i] = netlist_voltage(netlist, 2);
+      results[1][i] = netlist_voltage(netlist, 3);
+      results[2][i] = netlist_voltage(netlist, 5);
+      results[3][i] = netlist_current(netlist, 0);
+      results[4][i] = netlist_current(netlist, Q1);
+      results[5][i] = netlist_current(netlist, Q2);
+      results[6][i] = netlist->iterations;
+   }
+   destroy_netlist(netlist);
+}
+
+/* Get the stream of curve paths (binary curves to /dev/null). */
+struct CurveStream _golden_curves_(void) {
+   static struct TextBuffer text;
+   if (text.data == NULL) {
+      text.data = malloc(TEXT_BUFFER);
+      text.fd = open("/dev/null", O_WRONLY);
+      assert (text.data != NULL && text.fd >= 0);
+      text.size = TEXT_BUFFER;
+   }
+   return (struct CurveStream) {&text, CURVE_BINARY};
+}
+
+/* Spoil the Q-points of 'num' designs if their curves couldn't be
+written ('status' isn't 0), so the check counts them as failures (also
+without assertions). */
+void _golden_curve_status_(int status, size_t num,
+                           struct CurveQPoints q) {
+   for (size_t i=0; i<num && status != 0; i++) q.V[i] = q.I[i] = NAN;
+}
+
+/* Find the Q-points of self-bias designs on their transfer curves
+(Id and Vgs, like the DC analyses). */
+void _jfet_curves_self_bias_(size_t num, const double *const *params,
+                             double *const *results) {
+   double *VG = calloc(num, sizeof(double));
+   assert (VG != NULL);
+   struct JFET_CurveParts parts = {params[4], params[5], VG, params[3]};
+   struct CurveQPoints q = {results[1], results[0]};
+   int status = jfet_transfer_curves(num, parts, GOLDEN_CURVE_POINTS,
+                                     _golden_curves_(), q);
+   _golden_curve_status_(status, num, q);
+   free(VG);
+}
+
+/* Find the Q-points of MOSFET voltage-divider designs on their
+transfer curves (k, Id and Vgs, like the uniform evaluations). */
+void _mosfet_curves_voltage_divider_(size_t num,
+      const double *const *params, double *const *results) {
+   double *VG = malloc(num * sizeof(double));
+   assert (VG != NULL);
+   for (size_t i=0; i<num; i++) {
+      double Von = P(6) - P(7);
+      results[0][i] = P(5) / (Von * Von);
+      VG[i] = P(2) * P(0) / (P(1) + P(2));
+   }
+   struct MOSFET_CurveParts parts = {results[0], params[7], VG,
+                                     params[4]};
+   struct CurveQPoints q = {results[2], results[1]};
+   int status = mosfet_transfer_curves(num, parts, GOLDEN_CURVE_POINTS,
+                                       _golden_curves_(), q);
+   _golden_curve_status_(status, num, q);
+   free(VG);
+}
+
+/* Find the Q-points of fixed-bias designs on the load lines of their
+uniform evaluations (Ic and Vce). */
+void _bjt_curves_fixed_bias_(size_t num, const double *const *params,
+                             double *const *results) {
+   double columns[MAX_RESULTS][PRECISION_BLOCK];
+   const double *p[MAX_PARAMS];
+   double *r[MAX_RESULTS];
+   for (size_t k=0; k<MAX_RESULTS; k++) r[k] = columns[k];
+   for (size_t i=0; i<num; i+=PRECISION_BLOCK) {
+      size_t n = (num - i < PRECISION_BLOCK) ? num - i : PRECISION_BLOCK;
+      for (size_t j=0; j<5; j++) p[j] = params[j] + i;
+      _bjt_batch_fixed_bias_(n, p, r);
+      struct BJT_CurveParts parts = {p[0], r[3], r[1]};
+      struct CurveQPoints q = {results[1] + i, results[0] + i};
+      int status = bjt_load_lines(n, parts, GOLDEN_CURVE_POINTS,
+                                  _golden_curves_(), q);
+      _golden_curve_status_(status, n, q);
+   }
+}
+
+/* Q-points on the load lines of fixed-bias designs by their
+definition. */
+void _bjt_store_load_line_(BJT_DCAnalysis a, size_t i,
+                           double *const *r) {
+   int saturated = a.Ic > a.Icsat;
+   r[0][i] = saturated ? a.Icsat : a.Ic;
+   r[1][i] = saturated ? 0 : a.Vce;
+}
+COLUMNS(_bjt_load_line_fixed_bias_, _bjt_store_load_line_(
+        bjt_dc_fixed_bias(P(0), P(1), P(2), P(3)), i, results))
+
+/* Find the Q-points of the documented examples of Curve.h (their
+curves are written to /dev/null and parameters are ignored). */
+void _curve_example_(size_t num, const double *const *params,
+                     double *const *results) {
+   (void) params;
+   double Idss[2] = {0.008, 0.01}, Vp[2] = {-6, -8};
+   double VG[2] = {0, -2}, Rs[2] = {1000, 0}, V[2], I[2];
+   double k[1] = {2.4e-4}, Vgsth[1] = {3}, Vdd[1] = {12};
+   double Rd[1] = {2000}, Vcc[1] = {12}, Icsat[1] = {4e-3};
+   double Ic[1] = {2.354167e-03};
+   struct JFET_CurveParts jfets = {Idss, Vp, VG, Rs};
+   struct MOSFET_CurveParts mosfets = {k, Vgsth, Vdd, Rd};
+   struct BJT_CurveParts bjts = {Vcc, Icsat, Ic};
+   struct CurveQPoints q = {V, I};
+   for (size_t i=0; i<num; i++) {
+      jfet_transfer_curves(2, jfets, 3, _golden_curves_(), q);
+      results[0][i] = V[0]; results[1][i] = V[1];
+      results[2][i] = I[0]; results[3][i] = I[1];
+      mosfet_transfer_curves(1, mosfets, 1000, _golden_curves_(), q);
+      results[4][i] = V[0]; results[5][i] = I[0];
+      bjt_load_lines(1, bjts, 3, _golden_curves_(), q);
+      results[6][i] = V[0]; results[7][i] = I[0];
+   }
+}
+
+// Documented examples (results in the order of uniform columns):
+const struct Golden goldens[] = {
+   // BJT.h
+   {"bjt_dc_fixed_bias", _bjt_dc_fixed_bias_, {12, 240000, 2200, 50},
+    {"4.708333e-05", "2.354167e-03", "2.401250e-03", "5.454545e-03",
+     "6.820833", "6.820833", "0.000000", "0.700000", "-6.120833"}},
+   {"bjt_ac_fixed_bias", _bjt_ac_fixed_bias_,
+    {12, 470000, 3000, 100, 50000},
+    {"10.707088", "1068.275199", "2830.188679", "-264.328506"}},
+   {"bjt_dc_emitter_bias", _bjt_dc_emitter_bias_,
+    {20, 430000, 2000, 1000, 50},
+    {"4.012474e-05", "2.006237e-03", "2.046362e-03", "6.666667e-03",
+     "13.981289", "16.027651", "2.046362", "2.746362", "-13.281289"}},
+   {"bjt_ac_emitter_bias", _bjt_ac_emitter_bias_,
+    {20, 470000, 2200, 560, 120, 40000},
+    {"5.987137", "56433.065511", "2197.743643", "-3.850258"}},
+   {"bjt_dc_voltage_divider", _bjt_dc_voltage_divider_,
+    {22, 39000, 3900, 10000, 1500, 100},
+    {"8.384638e-06", "8.384638e-04", "8.468484e-04", "1.913043e-03",
+     "12.357666", "13.627939", "1.270273", "1.970273", "-11.657666"}},
+   {"bjt_ac_voltage_divider", _bjt_ac_voltage_divider_,
+    {16, 90000, 10000, 2200, 680, 210, 50000},
+    {"20.876672", "2948.043327", "2107.279693", "-100.939446"}},
+   {"bjt_ac_voltage_divider (unbypassed)",
+    _bjt_ac_voltage_divider_unbypassed_,
+    {16, 90000, 10000, 2200, 680, 210, 50000},
+    {"20.876672", "8456.660453", "2196.691081", "-3.118332"}},
+   {"bjt_dc_collector_feedback", _bjt_dc_collector_feedback_,
+    {10, 250000, 4700, 1200, 90},
+    {"1.190781e-05", "1.071703e-03", "1.083611e-03", "1.694915e-03",
+     "3.676953", "4.977286", "1.300333", "2.000333", "-2.976953"}},
+   {"bjt_ac_collector_feedback", _bjt_ac_collector_feedback_,
+    {9, 180000, 2700, 200, 1e+6},
+    {"11.221003", "566.701954", "2653.041171", "-236.435288"}},
+   {"bjt_ac_collector_dc_feedback", _bjt_ac_collector_dc_feedback_,
+    {12, 120000, 68000, 3000, 140, 30000},
+    {"9.921546", "1373.122426", "2622.107969", "-264.284200"}},
+   {"bjt_dc_emitter_follower", _bjt_dc_emitter_follower_,
+    {20, 240000, 2000, 90},
+    {"4.573460e-05", "4.116114e-03", "4.161848e-03", "-1.000000e+00",
+     "11.676303", "40.000000", "28.323696", "29.023697", "-10.976303"}},
+   {"bjt_ac_emitter_follower", _bjt_ac_emitter_follower_,
+    {12, 220000, 3300, 100, 1e+6},
+    {"12.604749", "132550.803154", "12.432776", "0.996220"}},
+   {"bjt_dc_common_base", _bjt_dc_common_base_,
+    {10, 4, 2400, 1200, 60},
+    {"4.508197e-05", "2.704918e-03", "2.750000e-03", "-1.000000e+00",
+     "4.100000", "-1.000000", "-1.000000", "-1.000000", "-3.508196"}},
+   {"bjt_ac_common_base", _bjt_ac_common_base_,
+    {8, 2, 5000, 1000, 0.98},
+    {"20.000000", "19.607843", "5000.000000", "245.000000"}},
+   {"bjt_dc_miscellaneous_bias", _bjt_dc_miscellaneous_bias_,
+    {20, 680000, 4700, 120},
+    {"1.551447e-05", "1.861736e-03", "1.877251e-03", "-1.000000e+00",
+     "11.176921", "11.176921", "0.000000", "0.700000", "-10.476921"}},
+   {"bjt_two_port_system", _bjt_two_port_system_,
+    {-480, 4000, 2000, 200, 5600},
+    {"-353.684211", "-336.842105", "252.631579"}},
+   {"bjt_cascaded_system", _bjt_cascaded_system_,
+    {1, 250, 100, 500, 26, 100, 1000, 5100, 100, 10000, 820},
+    {"0.025341", "4.807692", "89.130435", "10.858971", "0.517094",
+     "-6.621324"}},
+   {"bjt_analyze_fixed_bias", _bjt_analyze_fixed_bias_,
+    {12, 470000, 3000, 100, 50000},
+    {"2.404255e-05", "2.404255e-03", [9] = "10.707088", "1068.275199",
+     "2830.188679", "-264.328506"}},
+   {"bjt_analyze_emitter_bias", _bjt_analyze_emitter_bias_,
+    {20, 470000, 2200, 560, 120, 40000},
+    {"3.588962e-05", "4.306754e-03", [9] = "5.987137", "56433.065511",
+     "2197.743643", "-3.850258"}},
+   {"bjt_analyze_voltage_divider (unbypassed)",
+    _bjt_analyze_voltage_divider_unbypassed_,
+    {16, 90000, 10000, 2200, 680, 210, 50000},
+    {"5.902413e-06", "1.239507e-03", [9] = "20.876672", "8456.660453",
+     "2196.691081", "-3.118332"}},
+   {"bjt_analyze_collector_feedback", _bjt_analyze_collector_feedback_,
+    {9, 180000, 2700, 1200, 200, 1e+6},
+    {"8.645833e-06", "1.729167e-03", [9] = "14.961338", "754.822135",
+     "2653.041171", "-177.326466"}},
+   {"bjt_analyze_emitter_follower", _bjt_analyze_emitter_follower_,
+    {12, 220000, 3300, 100, 1e+6},
+    {"2.042292e-05", "2.042292e-03", [9] = "12.604749", "132550.803154",
+     "12.432776", "0.996220"}},
+   {"bjt_analyze_common_base", _bjt_analyze_common_base_,
+    {8, 2, 5000, 1000, 49},
+    {"2.600000e-05", "1.274000e-03", [9] = "20.000000", "19.607843",
+     "5000.000000", "245.000000"}},
+   {"REF_BJT_DC_VOLTAGE_DIVIDER", _bjt_dc_reference_, {0},
+    {"8.384638e-06", "8.384638e-04", "8.468484e-04", "1.913043e-03",
+     "12.357666", "13.627939", "1.270273", "1.970273", "-11.657666"}},
+   {"REF_BJT_AC_VOLTAGE_DIVIDER_UNBYPASSED", _bjt_ac_reference_, {0},
+    {"20.876672", "8456.660453", "2196.691081", "-3.118332"}},
+   // EbersMoll.h (Ic, Vce, Vbe and iterations)
+   {"EbersMoll.h (saturated)", _bjt_solve_fixed_bias_,
+    {12, 240000, 4700, 100, 50000},
+    {[1] = "2.526676e-03", [4] = "0.124625", [13] = "0.724919",
+     [15] = "7"}},
+   {"bjt_exact_fixed_bias", _bjt_solve_fixed_bias_,
+    {12, 240000, 2200, 50, 50000},
+    {[1] = "2.349460e-03", [4] = "6.831189", [13] = "0.722594",
+     [15] = "6"}},
+   {"bjt_exact_emitter_bias", _bjt_solve_emitter_bias_,
+    {20, 430000, 2000, 1000, 50, 50000},
+    {[1] = "2.004318e-03", [4] = "13.946960", [13] = "0.718463",
+     [15] = "6"}},
+   {"bjt_exact_voltage_divider", _bjt_solve_voltage_divider_,
+    {22, 39000, 3900, 10000, 1500, 100, 50000},
+    {[1] = "8.411172e-04", [4] = "12.314536", [13] = "0.695886",
+     [15] = "4"}},
+   {"bjt_exact_collector_feedback", _bjt_solve_collector_feedback_,
+    {10, 250000, 4700, 1200, 90, 50000},
+    {[1] = "1.063441e-03", [4] = "3.655986", [13] = "0.701984",
+     [15] = "4"}},
+   // Configuration.h (status masks of the designs and their faults)
+   {"validate_results", _validate_example_, {0},
+    {"0", "1", "2", "4", "3"}},
+   // MonteCarlo.h (failures, mean Id and mean Av of a Vp spread)
+   {"monte_carlo (Vp spread)", _monte_carlo_example_, {0},
+    {"0", "7.02e-04", "-2.686"}},
+   // (failures and their count of each kind)
+   {"monte_carlo (faults)", _monte_carlo_faults_, {0},
+    {"30392", "16532", "0", "13860", "0"}},
+   // (same statistics on 3 and 7 threads as on 1 thread, exact to a
+   // tenth)
+   {"monte_carlo (threads)", _monte_carlo_threads_, {0},
+    {"1.0", "1.0"}},
+   // Design.h (count of E96 values, last written one, wide designs,
+   // clamped values, best error, empty designs and evaluated ones)
+   {"design_voltage_divider (ranges)", _design_range_example_, {0},
+    {"1057", "4.53e+09", "10", "33", "2.182393e-06", "0", "0"}},
+   // Format.h (lengths of formatted values, exact to a tenth, and how
+   // many read back)
+   {"format_double", _format_example_, {0},
+    {"17.0", "21.0", "21.0", "3"}},
+   // TransCal.h (Ic and Id of valid jobs, faulty jobs and the status
+   // of the faulty one)
+   {"run_jobs", _run_jobs_example_, {0},
+    {"2.354167e-03", "2.587624e-03", "1", "1"}},
+   // Sweep.h (Ic of the accepted points and their count)
+   {"sweep_regions", _sweep_regions_example_, {0},
+    {"3.573374e-03", "2.009456e-03", "1.130000e-03", "3"}},
+   // (count of points, faulty points, first Re, third Ic and first
+   // fault)
+   {"sweep (faulty Re axis)", _sweep_faulty_example_, {0},
+    {"12", "2", "-100", "4.803983e-03", "1"}},
+   // Netlist.h (V(2), V(3), V(5), I(Vcc), I(Q1), I(Q2), iterations)
+   {"Netlist.h", _netlist_example_, {0},
+    {"1.934889", "13.817045", "17.214549", "-2.350967e-03",
+     "8.182955e-04", "1.018181e-03", "5"}},
+   {"Netlist.h (structurally singular)", _netlist_singular_, {0},
+    {"0", "0.000000"}},
+   // Curve.h (Vq and Iq of the JFET, MOSFET and BJT examples)
+   {"Curve.h", _curve_example_, {0},
+    {"-2.587624", "-2.000000", "2.587624e-03", "5.625000e-03",
+     "6.411991", "2.794004e-03", "4.937499", "2.354167e-03"}},
+   {"bjt_dc_voltage_divider_batch", _bjt_dc_voltage_divider_batch_,
+    {22, 39000, 3900, 10000, 1200, 100},
+    {[1] = "1.042122e-03", [4] = "10.328232"}},
+   {"bjt_ac_voltage_divider_batch", _bjt_ac_voltage_divider_batch_,
+    {16, 90000, 10000, 2200, 680, 210, 40000},
+    {"20.876672", [3] = "-99.886997"}},
+   // FET.h
+   {"_drain_current_batch_", _drain_current_batch_columns_,
+    {0.222222, -3.666667, 0.008}, {"2.182107e-03"}},
+   {"_drain_current_batch_", _drain_current_batch_columns_,
+    {0.1, 1, 5}, {"nan"}},
+   // JFET.h
+   {"jfet_dc_fixed_bias", _jfet_dc_fixed_bias_, {16, 2, 2000, 0.01, -8},
+    {"5.625000e-03", "-2.000000", "4.750000", "0.000000", "4.750000",
+     "-2.000000"}},
+   {"jfet_ac_fixed_bias", _jfet_ac_fixed_bias_,
+    {16, 2, 1e+6, 2000, 0.01, -8, 25000},
+    {"1.875000e-03", "1000000.000000", "1851.851852", "-3.472222"}},
+   {"jfet_dc_self_bias", _jfet_dc_self_bias_,
+    {20, 3300, 1000, 0.008, -6},
+    {"2.587624e-03", "-2.587624", "8.873216", "2.587624", "11.460840",
+     "0.000000"}},
+   {"jfet_ac_self_bias", _jfet_ac_self_bias_,
+    {20, 1e+6, 3300, 1000, 0.008, -6, 50000},
+    {"1.516611e-03", "1000000.000000", "3216.314824", "-1.922998"}},
+   {"REF_JFET_DC_SELF_BIAS", _jfet_dc_reference_, {0},
+    {"2.587624e-03", "-2.587624", "8.873216", "2.587624", "11.460840",
+     "0.000000"}},
+   {"REF_JFET_AC_COMMON_GATE", _jfet_ac_reference_, {0},
+    {"2.172962e-03", "370.766303", "3048.498845", "6.700485"}},
+   {"jfet_dc_voltage_divider", _jfet_dc_voltage_divider_,
+    {16, 21e+5, 27e+4, 2400, 1500, 0.008, -4},
+    {"2.416309e-03", "-1.801678", "6.576396", "3.624463", "10.200859",
+     "1.822785"}},
+   {"jfet_ac_voltage_divider", _jfet_ac_voltage_divider_,
+    {20, 82e+6, 11e+6, 2000, 610, 0.012, -3, 5e+5},
+    {"5.403363e-03", "9698924.731183", "1992.031873", "-10.763671"}},
+   {"jfet_dc_common_gate", _jfet_dc_common_gate_,
+    {12, 0, 1500, 680, 0.012, -6},
+    {"3.835265e-03", "-2.607980", "3.639121", "2.607980", "6.247102",
+     "0.000000"}},
+   {"jfet_ac_common_gate", _jfet_ac_common_gate_,
+    {15, 0, 3300, 1500, 0.008, -2.8, 4e+4},
+    {"2.172962e-03", "370.766303", "3048.498845", "6.700485"}},
+   {"jfet_ac_source_follower", _jfet_ac_source_follower_,
+    {9, -2.86, 1e+6, 2200, 0.016, -4, 4e+4},
+    {"2.280000e-03", "1000000.000000", "362.378521", "0.826223"}},
+   {"jfet_analyze_fixed_bias", _jfet_analyze_fixed_bias_,
+    {16, 2, 1e+6, 2000, 0.01, -8, 25000},
+    {"5.625000e-03", "-2.000000", [6] = "1.875000e-03",
+     "1000000.000000", "1851.851852", "-3.472222"}},
+   {"jfet_analyze_self_bias", _jfet_analyze_self_bias_,
+    {20, 1e+6, 3300, 1000, 0.008, -6, 50000},
+    {"2.587624e-03", "-2.587624", [6] = "1.516611e-03",
+     "1000000.000000", "3216.314824", "-1.922998"}},
+   {"jfet_analyze_self_bias (|Vp| < 1)", _jfet_analyze_self_bias_,
+    {20, 1e+6, 3300, 1000, 0.008, -0.8, 50000},
+    {"5.838750e-04", "-0.583875", [6] = "5.403124e-03",
+     "1000000.000000", "3266.436149", "-2.747722"}},
+   {"jfet_analyze_voltage_divider", _jfet_analyze_voltage_divider_,
+    {20, 82e+6, 11e+6, 2000, 610, 0.012, -3, 5e+5},
+    {"5.474312e-03", "-0.973739", [6] = "5.403363e-03",
+     "9698924.731183", "1992.031873", "-10.763671"}},
+   {"jfet_analyze_common_gate", _jfet_analyze_common_gate_,
+    {15, 0, 3300, 1500, 0.008, -2.8, 4e+4},
+    {"1.156832e-03", "-1.735249", [6] = "2.172962e-03", "370.766303",
+     "3048.498845", "6.700485"}},
+   // MOSFET.h
+   {"mosfet_dc_drain_feedback", _mosfet_dc_drain_feedback_,
+    {12, 1e+7, 2000, 0.006, 8, 3},
+    {"2.400000e-04", "2.794004e-03", "6.411991", "6.411991"}},
+   {"mosfet_ac_drain_feedback", _mosfet_ac_drain_feedback_,
+    {12, 1e+7, 2000, 0.006, 8, 3, 5e+4},
+    {"1.637756e-03", "2410374.750000", "1922.707153", "-3.148925"}},
+   {"mosfet_dc_voltage_divider", _mosfet_dc_voltage_divider_,
+    {40, 22e+6, 18e+6, 3000, 820, 0.003, 10, 5},
+    {"1.200000e-04", "6.724565e-03", "12.485856", "14.312160"}},
+   {"mosfet_ac_voltage_divider", _mosfet_ac_voltage_divider_,
+    {24, 1e+7, 6.8e+6, 2200, 750, 0.005, 6, 3, 1e+6},
+    {"3.321982e-03", "4047619.000000", "2195.170654", "-7.292316"}},
+   {"REF_MOSFET_AC_VOLTAGE_DIVIDER", _mosfet_ac_reference_, {0},
+    {"3.321982e-03", "4047619.000000", "2195.170654", "-7.292316"}},
+   {"mosfet_analyze_drain_feedback", _mosfet_analyze_drain_feedback_,
+    {12, 1e+7, 2000, 0.006, 8, 3, 5e+4},
+    {"2.400000e-04", "2.794004e-03", [4] = "1.637756e-03",
+     "2410374.500000", "1922.707153", "-3.148925"}},
+   {"mosfet_analyze_voltage_divider", _mosfet_analyze_voltage_divider_,
+    {24, 1e+7, 6.8e+6, 2200, 750, 0.005, 6, 3, 1e+6},
+    {"5.555556e-04", "4.966003e-03", [4] = "3.321982e-03",
+     "4047619.000000", "2195.170654", "-7.292317"}},
+};
+
+// Number of documented examples:
+const size_t num_goldens = sizeof(goldens) / sizeof(goldens[0]);
+
+// Budgets of result fields (ULPs, relative error):
+#define ROUNDED {16, 4e-15, 0} // a few different roundings
+#define CANCELED {16, 4e-15, 1e-12} // difference of close numbers
+#define SINGLE {8, 1e-6, 0} // float results of double analyses
+#define WIDENED {8, 1e-6, 1e-5} // double results of float references
+#define EXACT {0, 0, 0} // same bits
+#define SOLVED {64, 1e-13, 0} // Newton-Raphson solutions
+#define SOLVED_CANCELED {64, 1e-13, 1e-12} // differences of solutions
+#define SOLVED_SMALL {64, 2e-11, 0} // small differences of solutions
+#define SCREENED {32, 4e-6, 0} // float analyses
+#define SCREENED_CANCELED {32, 4e-6, 1e-4} // float differences
+#define BJT_BUDGETS {ROUNDED, ROUNDED, ROUNDED, ROUNDED, CANCELED, \
+   CANCELED, ROUNDED, ROUNDED, CANCELED, ROUNDED, ROUNDED, ROUNDED, \
+   ROUNDED}
+#define JFET_BUDGETS {ROUNDED, CANCELED, CANCELED, ROUNDED, CANCELED, \
+   ROUNDED, ROUNDED, ROUNDED, ROUNDED, ROUNDED}
+#define MOSFET_BUDGETS {SINGLE, SINGLE, SINGLE, SINGLE, SINGLE, \
+   SINGLE, SINGLE, SINGLE}
+#define MOSFET_UNIFORM_BUDGETS {SINGLE, SINGLE, SINGLE, WIDENED, \
+   SINGLE, SINGLE, SINGLE, SINGLE}
+#define BJT_SCREENED_BUDGETS {SCREENED, SCREENED, SCREENED, SCREENED, \
+   SCREENED_CANCELED, SCREENED_CANCELED, SCREENED, SCREENED, \
+   SCREENED_CANCELED, SCREENED, SCREENED, SCREENED, SCREENED}
+#define JFET_SCREENED_BUDGETS {SCREENED, SCREENED_CANCELED, \
+   SCREENED_CANCELED, SCREENED, SCREENED_CANCELED, SCREENED, SCREENED, \
+   SCREENED, SCREENED, SCREENED}
+#define MOSFET_SCREENED_BUDGETS {SCREENED, SCREENED, SCREENED, \
+   SCREENED_CANCELED, SCREENED, SCREENED, SCREENED, SCREENED}
+
+#define BJT_EXACT_BUDGETS {SOLVED, SOLVED, SOLVED, SOLVED, \
+   SOLVED_CANCELED, SOLVED_CANCELED, SOLVED, SOLVED, SOLVED_CANCELED, \
+   SOLVED, SOLVED, SOLVED, SOLVED, SOLVED, EXACT, {0, 0, 1}}
+
+// Result fields of families:
+#define BJT_FIELDS 13, 0x1FFF, BJT_BUDGETS
+#define JFET_FIELDS 10, 0x3FF, JFET_BUDGETS
+#define MOSFET_FIELDS 8, 0xFF, MOSFET_BUDGETS
+#define MOSFET_UNIFORM_FIELDS 8, 0xFF, MOSFET_UNIFORM_BUDGETS
+#define BJT_SCREENED_FIELDS 13, 0x1FFF, BJT_SCREENED_BUDGETS
+#define JFET_SCREENED_FIELDS 10, 0x3FF, JFET_SCREENED_BUDGETS
+#define MOSFET_SCREENED_FIELDS 8, 0xFF, MOSFET_SCREENED_BUDGETS
+#define BJT_CACHED_FIELDS 13, 0x1FFF, {EXACT}
+#define JFET_CACHED_FIELDS 10, 0x3FF, {EXACT}
+#define AC_INCREMENTAL_FIELDS 4, 0xF, {EXACT}
+#define CASCADE_BATCH_FIELDS 6, 0x3F, {EXACT}
+#define BJT_EXACT_FIELDS 16, 0xFFFF, BJT_EXACT_BUDGETS
+#define BJT_NETLIST_FIELDS 9, 0x1FF, {SOLVED_SMALL, SOLVED, SOLVED, SOLVED, \
+   SOLVED_CANCELED, SOLVED_CANCELED, SOLVED, SOLVED, SOLVED_CANCELED}
+#define REGION_FIELDS 1, 0x1, {EXACT}
+#define STATUS_FIELDS 1, 0x1, {EXACT}
+#define JFET_NETLIST_FIELDS 6, 0x3F, {SOLVED, SOLVED_CANCELED, \
+   SOLVED_CANCELED, SOLVED, SOLVED_CANCELED, SOLVED}
+#define CURVE_FIELDS 2, 0x3, {ROUNDED, CANCELED}
+#define MOSFET_CURVE_FIELDS 3, 0x7, {ROUNDED, ROUNDED, CANCELED}
+#define CASCADE_TREE_FIELDS 6, 0x3F, {EXACT, EXACT, EXACT, ROUNDED, \
+                                      ROUNDED, ROUNDED}
+
+// Documented example parameters (in 'analyze_*()' order):
+#define BJT_FIXED_BIAS 5, {12, 470000, 3000, 100, 50000}
+#define BJT_EMITTER_BIAS 6, {20, 470000, 2200, 560, 120, 40000}
+#define BJT_VOLTAGE_DIVIDER 7, {16, 90000, 10000, 2200, 680, 210, 50000}
+#define BJT_COLLECTOR_FEEDBACK 6, {9, 180000, 2700, 1200, 200, 1e+6}
+#define BJT_EMITTER_FOLLOWER 5, {12, 220000, 3300, 100, 1e+6}
+#define BJT_COMMON_BASE 5, {8, 2, 5000, 1000, 49}
+#define JFET_FIXED_BIAS 7, {16, 2, 1e+6, 2000, 0.01, -8, 25000}
+#define JFET_SELF_BIAS 7, {20, 1e+6, 3300, 1000, 0.008, -6, 50000}
+#define JFET_VOLTAGE_DIVIDER 8, {20, 82e+6, 11e+6, 2000, 610, 0.012, \
+                                 -3, 5e+5}
+#define JFET_COMMON_GATE 7, {15, 0, 3300, 1500, 0.008, -2.8, 4e+4}
+#define MOSFET_DRAIN_FEEDBACK 7, {12, 1e+7, 2000, 0.006, 8, 3, 5e+4}
+#define MOSFET_VOLTAGE_DIVIDER 9, {24, 1e+7, 6.8e+6, 2200, 750, 0.005, \
+                                   6, 3, 1e+6}
+#define BJT_SATURATING_BIAS 5, {12, 240000, 2400, 100, 50000}
+// Followers near saturation (Vce = 0.73, it stays above Vbe) and
+// common-base designs straddling it (Vce = 0.9).
+#define BJT_SATURATING_FOLLOWER 5, {12, 1000, 3300, 100, 1e+6}
+#define BJT_SATURATING_COMMON_BASE 5, {8, 2, 6000, 1000, 49}
+#define JFET_OHMIC_SELF_BIAS 7, {20, 1e+6, 5600, 1000, 0.008, -6, 50000}
+#define MOSFET_CUTOFF_DIVIDER 9, {24, 1e+7, 1.8e+6, 22000, 750, 0.005, \
+                                  6, 3, 1e+6}
+#define MOSFET_FAULTY_DIVIDER 9, {24, 1e+7, 1e+6, 22000, 750, 0.005, \
+                                  6, 3, 1e+6}
+#define BJT_CASCADED_SYSTEM 11, {1, 250, 100, 500, 26, 100, 1000, 5100, \
+                                 100, 10000, 820}
+
+// All fast paths and their references:
+const struct Check checks[] = {
+   // Fused analyses against separate DC and AC analyses.
+   {"bjt_analyze_fixed_bias", "bjt", "fused", "double",
+    _bjt_analyze_fixed_bias_, _bjt_split_fixed_bias_, BJT_FIXED_BIAS,
+    BJT_FIELDS},
+   {"bjt_analyze_emitter_bias", "bjt", "fused", "double",
+    _bjt_analyze_emitter_bias_, _bjt_split_emitter_bias_,
+    BJT_EMITTER_BIAS, BJT_FIELDS},
+   {"bjt_analyze_voltage_divider", "bjt", "fused", "double",
+    _bjt_analyze_voltage_divider_, _bjt_split_voltage_divider_,
+    BJT_VOLTAGE_DIVIDER, BJT_FIELDS},
+   {"bjt_analyze_voltage_divider (unbypassed)", "bjt", "fused",
+    "double", _bjt_analyze_voltage_divider_unbypassed_,
+    _bjt_split_voltage_divider_unbypassed_, BJT_VOLTAGE_DIVIDER,
+    BJT_FIELDS},
+   {"bjt_analyze_collector_feedback", "bjt", "fused", "double",
+    _bjt_analyze_collector_feedback_, _bjt_split_collector_feedback_,
+    BJT_COLLECTOR_FEEDBACK, 13, 0x1FF, BJT_BUDGETS},
+   {"bjt_analyze_emitter_follower", "bjt", "fused", "double",
+    _bjt_analyze_emitter_follower_, _bjt_split_emitter_follower_,
+    BJT_EMITTER_FOLLOWER, BJT_FIELDS},
+   {"bjt_analyze_common_base", "bjt", "fused", "double",
+    _bjt_analyze_common_base_, _bjt_split_common_base_,
+    BJT_COMMON_BASE, BJT_FIELDS},
+   {"jfet_analyze_fixed_bias", "jfet", "fused", "double",
+    _jfet_analyze_fixed_bias_, _jfet_split_fixed_bias_,
+    JFET_FIXED_BIAS, JFET_FIELDS},
+   {"jfet_analyze_self_bias", "jfet", "fused", "double",
+    _jfet_analyze_self_bias_, _jfet_split_self_bias_, JFET_SELF_BIAS,
+    JFET_FIELDS},
+   {"jfet_analyze_voltage_divider", "jfet", "fused", "double",
+    _jfet_analyze_voltage_divider_, _jfet_split_voltage_divider_,
+    JFET_VOLTAGE_DIVIDER, JFET_FIELDS},
+   {"jfet_analyze_common_gate", "jfet", "fused", "double",
+    _jfet_analyze_common_gate_, _jfet_split_common_gate_,
+    JFET_COMMON_GATE, JFET_FIELDS},
+   {"mosfet_analyze_drain_feedback", "mosfet", "fused", "float",
+    _mosfet_analyze_drain_feedback_, _mosfet_split_drain_feedback_,
+    MOSFET_DRAIN_FEEDBACK, MOSFET_FIELDS},
+   {"mosfet_analyze_voltage_divider", "mosfet", "fused", "float",
+    _mosfet_analyze_voltage_divider_, _mosfet_split_voltage_divider_,
+    MOSFET_VOLTAGE_DIVIDER, MOSFET_FIELDS},
+   // Batch analyses against scalar analyses.
+   {"bjt_dc_voltage_divider_batch", "bjt", "batch", "double",
+    _bjt_dc_voltage_divider_batch_, _bjt_dc_voltage_divider_,
+    6, {22, 39000, 3900, 10000, 1500, 100}, 9, 0x1FF, BJT_BUDGETS},
+   {"bjt_ac_voltage_divider_batch", "bjt", "batch", "double",
+    _bjt_ac_voltage_divider_batch_, _bjt_ac_voltage_divider_,
+    BJT_VOLTAGE_DIVIDER, 4, 0xF,
+    {ROUNDED, ROUNDED, ROUNDED, ROUNDED}},
+   {"_drain_current_batch_", "fet", "batch", "double",
+    _drain_current_batch_columns_, _drain_current_columns_,
+    3, {0.222222, -3.666667, 0.008}, 1, 0x1, {ROUNDED}},
+   {"bjt fixed_bias", "bjt", "batch", "double",
+    _bjt_batch_fixed_bias_, _bjt_analyze_fixed_bias_, BJT_FIXED_BIAS,
+    BJT_FIELDS},
+   {"bjt emitter_bias", "bjt", "batch", "double",
+    _bjt_batch_emitter_bias_, _bjt_analyze_emitter_bias_,
+    BJT_EMITTER_BIAS, BJT_FIELDS},
+   {"bjt voltage_divider", "bjt", "batch", "double",
+    _bjt_batch_voltage_divider_, _bjt_analyze_voltage_divider_,
+    BJT_VOLTAGE_DIVIDER, BJT_FIELDS},
+   {"bjt voltage_divider_unbypassed", "bjt", "batch", "double",
+    _bjt_batch_voltage_divider_unbypassed_,
+    _bjt_analyze_voltage_divider_unbypassed_, BJT_VOLTAGE_DIVIDER,
+    BJT_FIELDS},
+   {"bjt collector_feedback", "bjt", "batch", "double",
+    _bjt_batch_collector_feedback_, _bjt_analyze_collector_feedback_,
+    BJT_COLLECTOR_FEEDBACK, BJT_FIELDS},
+   {"bjt emitter_follower", "bjt", "batch", "double",
+    _bjt_batch_emitter_follower_, _bjt_analyze_emitter_follower_,
+    BJT_EMITTER_FOLLOWER, BJT_FIELDS},
+   {"bjt common_base", "bjt", "batch", "double",
+    _bjt_batch_common_base_, _bjt_analyze_common_base_,
+    BJT_COMMON_BASE, BJT_FIELDS},
+   {"jfet fixed_bias", "jfet", "batch", "double",
+    _jfet_batch_fixed_bias_, _jfet_analyze_fixed_bias_,
+    JFET_FIXED_BIAS, JFET_FIELDS},
+   {"jfet self_bias", "jfet", "batch", "double",
+    _jfet_batch_self_bias_, _jfet_analyze_self_bias_, JFET_SELF_BIAS,
+    JFET_FIELDS},
+   {"jfet voltage_divider", "jfet", "batch", "double",
+    _jfet_batch_voltage_divider_, _jfet_analyze_voltage_divider_,
+    JFET_VOLTAGE_DIVIDER, JFET_FIELDS},
+   {"jfet common_gate", "jfet", "batch", "double",
+    _jfet_batch_common_gate_, _jfet_analyze_common_gate_,
+    JFET_COMMON_GATE, JFET_FIELDS},
+   {"mosfet drain_feedback", "mosfet", "batch", "float",
+    _mosfet_batch_drain_feedback_, _mosfet_analyze_drain_feedback_,
+    MOSFET_DRAIN_FEEDBACK, MOSFET_UNIFORM_FIELDS},
+   {"mosfet voltage_divider", "mosfet", "batch", "float",
+    _mosfet_batch_voltage_divider_, _mosfet_analyze_voltage_divider_,
+    MOSFET_VOLTAGE_DIVIDER, MOSFET_UNIFORM_FIELDS},
+   // Float screening paths against uniform double evaluations.
+   {"bjt fixed_bias", "bjt", "screen", "float", _bjt_screened_fixed_bias_,
+    _bjt_batch_fixed_bias_, BJT_FIXED_BIAS, BJT_SCREENED_FIELDS},
+   {"bjt emitter_bias", "bjt", "screen", "float",
+    _bjt_screened_emitter_bias_, _bjt_batch_emitter_bias_,
+    BJT_EMITTER_BIAS, BJT_SCREENED_FIELDS},
+   {"bjt voltage_divider", "bjt", "screen", "float",
+    _bjt_screened_voltage_divider_, _bjt_batch_voltage_divider_,
+    BJT_VOLTAGE_DIVIDER, BJT_SCREENED_FIELDS},
+   {"bjt voltage_divider_unbypassed", "bjt", "screen", "float",
+    _bjt_screened_voltage_divider_unbypassed_,
+    _bjt_batch_voltage_divider_unbypassed_, BJT_VOLTAGE_DIVIDER,
+    BJT_SCREENED_FIELDS},
+   {"bjt collector_feedback", "bjt", "screen", "float",
+    _bjt_screened_collector_feedback_, _bjt_batch_collector_feedback_,
+    BJT_COLLECTOR_FEEDBACK, BJT_SCREENED_FIELDS},
+   {"bjt emitter_follower", "bjt", "screen", "float",
+    _bjt_screened_emitter_follower_, _bjt_batch_emitter_follower_,
+    BJT_EMITTER_FOLLOWER, BJT_SCREENED_FIELDS},
+   {"bjt common_base", "bjt", "screen", "float",
+    _bjt_screened_common_base_, _bjt_batch_common_base_,
+    BJT_COMMON_BASE, BJT_SCREENED_FIELDS},
+   {"jfet fixed_bias", "jfet", "screen", "float",
+    _jfet_screened_fixed_bias_, _jfet_batch_fixed_bias_,
+    JFET_FIXED_BIAS, JFET_SCREENED_FIELDS},
+   {"jfet self_bias", "jfet", "screen", "float",
+    _jfet_screened_self_bias_, _jfet_batch_self_bias_, JFET_SELF_BIAS,
+    JFET_SCREENED_FIELDS},
+   {"jfet voltage_divider", "jfet", "screen", "float",
+    _jfet_screened_voltage_divider_, _jfet_batch_voltage_divider_,
+    JFET_VOLTAGE_DIVIDER, JFET_SCREENED_FIELDS},
+   {"jfet common_gate", "jfet", "screen", "float",
+    _jfet_screened_common_gate_, _jfet_batch_common_gate_,
+    JFET_COMMON_GATE, JFET_SCREENED_FIELDS},
+   {"mosfet drain_feedback", "mosfet", "screen", "float",
+    _mosfet_screened_drain_feedback_, _mosfet_batch_drain_feedback_,
+    MOSFET_DRAIN_FEEDBACK, MOSFET_SCREENED_FIELDS},
+   {"mosfet voltage_divider", "mosfet", "screen", "float",
+    _mosfet_screened_voltage_divider_, _mosfet_batch_voltage_divider_,
+    MOSFET_VOLTAGE_DIVIDER, MOSFET_SCREENED_FIELDS},
+   // Cached paths against uniform double evaluations.
+   {"bjt emitter_follower", "bjt", "cache", "double",
+    _bjt_cached_emitter_follower_, _bjt_batch_emitter_follower_,
+    BJT_EMITTER_FOLLOWER, BJT_CACHED_FIELDS},
+   {"jfet self_bias", "jfet", "cache", "double",
+    _jfet_cached_self_bias_, _jfet_batch_self_bias_, JFET_SELF_BIAS,
+    JFET_CACHED_FIELDS},
+   {"mosfet voltage_divider", "mosfet", "cache", "double",
+    _mosfet_cached_voltage_divider_, _mosfet_batch_voltage_divider_,
+    MOSFET_VOLTAGE_DIVIDER, MOSFET_UNIFORM_FIELDS},
+   // Incremental analyses against the 'ac_*' functions.
+   {"bjt_ac_emitter_bias", "bjt", "incremental", "double",
+    _bjt_incremental_emitter_bias_, _bjt_ac_emitter_bias_,
+    BJT_EMITTER_BIAS, AC_INCREMENTAL_FIELDS},
+   {"jfet_ac_voltage_divider", "jfet", "incremental", "double",
+    _jfet_incremental_voltage_divider_, _jfet_ac_voltage_divider_,
+    JFET_VOLTAGE_DIVIDER, AC_INCREMENTAL_FIELDS},
+   // Cascaded systems against bjt_cascaded_system().
+   {"bjt_cascade_batch", "bjt", "cascade", "double", _bjt_cascade_batch_,
+    _bjt_cascaded_system_, BJT_CASCADED_SYSTEM, CASCADE_BATCH_FIELDS},
+   {"bjt_cascade (updated tree)", "bjt", "cascade", "double",
+    _bjt_cascade_tree_, _bjt_cascaded_system_, BJT_CASCADED_SYSTEM,
+    CASCADE_TREE_FIELDS},
+   // Exact batch analyses against scalar exact analyses.
+   {"bjt fixed_bias (saturating)", "bjt", "exact", "double",
+    _bjt_exact_batch_fixed_bias_, _bjt_solve_fixed_bias_,
+    BJT_SATURATING_BIAS, BJT_EXACT_FIELDS},
+   {"bjt emitter_bias", "bjt", "exact", "double",
+    _bjt_exact_batch_emitter_bias_, _bjt_solve_emitter_bias_,
+    BJT_EMITTER_BIAS, BJT_EXACT_FIELDS},
+   {"bjt voltage_divider", "bjt", "exact", "double",
+    _bjt_exact_batch_voltage_divider_, _bjt_solve_voltage_divider_,
+    BJT_VOLTAGE_DIVIDER, BJT_EXACT_FIELDS},
+   {"bjt voltage_divider_unbypassed", "bjt", "exact", "double",
+    _bjt_exact_batch_voltage_divider_unbypassed_,
+    _bjt_solve_voltage_divider_unbypassed_, BJT_VOLTAGE_DIVIDER,
+    BJT_EXACT_FIELDS},
+   {"bjt collector_feedback", "bjt", "exact", "double",
+    _bjt_exact_batch_collector_feedback_,
+    _bjt_solve_collector_feedback_, BJT_COLLECTOR_FEEDBACK,
+    BJT_EXACT_FIELDS},
+   // Netlists against exact (BJT) and closed-form (JFET) analyses.
+   {"bjt fixed_bias (saturating)", "bjt", "netlist", "double",
+    _bjt_netlist_fixed_bias_, _bjt_exact_dc_fixed_bias_,
+    BJT_SATURATING_BIAS, BJT_NETLIST_FIELDS},
+   {"bjt voltage_divider", "bjt", "netlist", "double",
+    _bjt_netlist_voltage_divider_, _bjt_exact_dc_voltage_divider_,
+    BJT_VOLTAGE_DIVIDER, BJT_NETLIST_FIELDS},
+   {"jfet self_bias", "jfet", "netlist", "double",
+    _jfet_netlist_self_bias_, _jfet_dc_self_bias_columns_,
+    JFET_SELF_BIAS, JFET_NETLIST_FIELDS},
+   // Region classifiers against the region definitions.
+   {"bjt fixed_bias (saturating)", "bjt", "regions", "double",
+    _bjt_classified_fixed_bias_, _bjt_region_fixed_bias_,
+    BJT_SATURATING_BIAS, REGION_FIELDS},
+   {"bjt emitter_follower (saturating)", "bjt", "regions", "double",
+    _bjt_classified_emitter_follower_, _bjt_region_emitter_follower_,
+    BJT_SATURATING_FOLLOWER, REGION_FIELDS},
+   {"bjt common_base (saturating)", "bjt", "regions", "double",
+    _bjt_classified_common_base_, _bjt_region_common_base_,
+    BJT_SATURATING_COMMON_BASE, REGION_FIELDS},
+   {"jfet self_bias (ohmic)", "jfet", "regions", "double",
+    _jfet_classified_self_bias_, _jfet_region_self_bias_,
+    JFET_OHMIC_SELF_BIAS, REGION_FIELDS},
+   {"mosfet voltage_divider (cutoff)", "mosfet", "regions", "double",
+    _mosfet_classified_voltage_divider_,
+    _mosfet_region_voltage_divider_, MOSFET_CUTOFF_DIVIDER,
+    REGION_FIELDS},
+   // Status masks against the fault definitions.
+   {"mosfet voltage_divider (faulty)", "mosfet", "validate", "double",
+    _mosfet_validated_voltage_divider_, _mosfet_fault_voltage_divider_,
+    MOSFET_FAULTY_DIVIDER, STATUS_FIELDS},
+   // Q-points of curves against DC analyses.
+   {"jfet self_bias", "jfet", "curves", "double",
+    _jfet_curves_self_bias_, _jfet_dc_self_bias_columns_,
+    JFET_SELF_BIAS, CURVE_FIELDS},
+   {"mosfet voltage_divider", "mosfet", "curves", "double",
+    _mosfet_curves_voltage_divider_, _mosfet_batch_voltage_divider_,
+    MOSFET_VOLTAGE_DIVIDER, MOSFET_CURVE_FIELDS},
+   {"bjt fixed_bias (saturating)", "bjt", "curves", "double",
+    _bjt_curves_fixed_bias_, _bjt_load_line_fixed_bias_,
+    BJT_SATURATING_BIAS, CURVE_FIELDS},
+};
+
+// Number of fast path checks:
+const size_t num_checks = sizeof(checks) / sizeof(checks[0]);
+
+/* Designs of Jacobian checks, in the order of 'sensitivities[]'. They
+are the documented examples, but Vp and Vgsth aren't integers, so a
+lost sign or factor of them can't be hidden by a round value. */
+const struct Slope slopes[] = {
+   {BJT_FIXED_BIAS},
+   {BJT_EMITTER_BIAS},
+   {BJT_VOLTAGE_DIVIDER},
+   {BJT_VOLTAGE_DIVIDER},
+   {BJT_COLLECTOR_FEEDBACK},
+   {BJT_EMITTER_FOLLOWER},
+   {BJT_COMMON_BASE},
+   {7, {16, 2, 1e+6, 2000, 0.01, -7.7, 25000}},
+   {7, {20, 1e+6, 3300, 1000, 0.008, -5.7, 50000}},
+   {8, {20, 82e+6, 11e+6, 2000, 610, 0.012, -3.3, 5e+5}},
+   {JFET_COMMON_GATE},
+   {7, {12, 1e+7, 2000, 0.006, 8, 2.7, 5e+4}},
+   {9, {24, 1e+7, 6.8e+6, 2200, 750, 0.005, 6, 2.7, 1e+6}}
+};
+
+const size_t num_slopes = sizeof(slopes) / sizeof(slopes[0]);
+
+/* Find one unit in the last printed digit of a value. */
+double _last_digit_(const char *printed) {
+   // Count the digits after the point and read the exponent.
+   const char *point = strchr(printed, '.');
+   const char *exponent = strpbrk(printed, "eE");
+   int digits = 0, power = (exponent != NULL) ? atoi(exponent + 1) : 0;
+   if (point != NULL)
+      digits = ((exponent != NULL) ? exponent :
+                printed + strlen(printed)) - point - 1;
+   return pow(10, power - digits);
+}
+
+/* Find the distance of two values in ULPs of double or float. */
+uint64_t _ulps_(double x, double y, int single) {
+   // NANs are equal only to NANs.
+   if (isnan(x) || isnan(y)) return (isnan(x) && isnan(y)) ? 0 :
+                                     UINT64_MAX;
+   int64_t a, b;
+   if (single) {
+      // Map the float bits to ordered integers.
+      float fx = x, fy = y;
+      int32_t ix, iy;
+      memcpy(&ix, &fx, sizeof(ix)); memcpy(&iy, &fy, sizeof(iy));
+      a = (ix < 0) ? (int64_t) INT32_MIN - ix : ix;
+      b = (iy < 0) ? (int64_t) INT32_MIN - iy : iy;
+   }
+   else {
+      memcpy(&a, &x, sizeof(a)); memcpy(&b, &y, sizeof(b));
+      a = (a < 0) ? INT64_MIN - a : a;
+      b = (b < 0) ? INT64_MIN - b : b;
+   }
+   return (a > b) ? (uint64_t) a - (uint64_t) b :
+                    (uint64_t) b - (uint64_t) a;
+}
+
+/* Find the relative error of two values. */
+double _relative_(double x, double y) {
+   double scale = fmax(fabs(x), fabs(y));
+   if (isnan(x) || isnan(y))
+      return (isnan(x) && isnan(y)) ? 0 : INFINITY;
+   return (scale == 0) ? 0 : fabs(x - y) / scale;
+}
+
+/* Get the next random number in [0, 1) (splitmix64 generator). */
+double _random_(uint64_t *state) {
+   // Mix the incremented state.
+   uint64_t z = (*state += 0x9E3779B97F4A7C15);
+   z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+   z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+   z ^= z >> 31;
+   return (z >> 11) * 0x1p-53;
+}
+
+/* Get the monotonic time in seconds. */
+double _now_(void) {
+   struct timespec time;
+   clock_gettime(CLOCK_MONOTONIC, &time);
+   return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+/* Run a path and return its throughput (points per second). */
+double _throughput_(Columns run, size_t num,
+                    const double *const *params,
+                    double *const *results) {
+   // Run once to warm up the caches, then keep the fastest run.
+   run(num, params, results);
+   double fastest = INFINITY;
+   for (int k=0; k<3; k++) {
+      double start = _now_();
+      run(num, params, results);
+      fastest = fmin(fastest, _now_() - start);
+   }
+   return num / fastest;
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Compare the documented examples. The count of failures is
+returned. */
+size_t check_goldens(int verbose) {
+   size_t failures = 0, values = 0;
+   double columns[MAX_PARAMS + MAX_RESULTS];
+   double *params[MAX_PARAMS], *results[MAX_RESULTS];
+   for (size_t p=0; p<MAX_PARAMS; p++) params[p] = &columns[p];
+   for (size_t r=0; r<MAX_RESULTS; r++)
+      results[r] = &columns[MAX_PARAMS + r];
+
+   for (size_t g=0; g<num_goldens; g++) {
+      const struct Golden *golden = &goldens[g];
+      // Analyze the example as a batch of one design.
+      for (size_t p=0; p<MAX_PARAMS; p++)
+         *params[p] = golden->params[p];
+      golden->run(1, (const double *const *) params, results);
+      for (size_t r=0; r<MAX_RESULTS; r++) {
+         if (golden->expected[r] == NULL) continue;
+         double expected = strtod(golden->expected[r], NULL);
+         double got = *results[r], unit = _last_digit_(
+               golden->expected[r]);
+         int pass = isnan(expected) ? isnan(got) :
+                    fabs(got - expected) <= unit * (1 + 1e-9);
+         values++;
+         if (!pass || verbose > 1)
+            printf("%s %s result %zu: %.9g (documented %s)\n",
+                   pass ? "PASS" : "FAIL", golden->name, r, got,
+                   golden->expected[r]);
+         failures += !pass;
+      }
+   }
+   printf("golden: %zu examples, %zu values, %zu failures\n",
+          num_goldens, values, failures);
+   return failures;
+}
+
+/* Compare the fast paths with their references on 'points' random
+designs. The count of failed checks is returned. */
+size_t check_paths(size_t points, int verbose) {
+   size_t failures = 0;
+   double *params[MAX_PARAMS], *fast[MAX_RESULTS];
+   double *reference[MAX_RESULTS];
+   // Columns are in one block and each one is shifted by a cache
+   // line, so they don't map to the same cache sets.
+   size_t stride = points + 8;
+   double *block = malloc((MAX_PARAMS + 2 * MAX_RESULTS) * stride *
+                          sizeof(double));
+   assert (block != NULL);
+   for (size_t p=0; p<MAX_PARAMS; p++) params[p] = block + p * stride;
+   for (size_t r=0; r<MAX_RESULTS; r++) {
+      fast[r] = block + (MAX_PARAMS + r) * stride;
+      reference[r] = block + (MAX_PARAMS + MAX_RESULTS + r) * stride;
+   }
+   golden_cache = create_result_cache(2 * points, 0);
+
+   printf("%-6s %-11s %-6s %-42s %10s %10s %9s %9s\n", "status", "path",
+          "type", "name", "max_ulp", "max_rel", "fast_Mps", "ref_Mps");
+   for (size_t c=0; c<num_checks; c++) {
+      const struct Check *check = &checks[c];
+      int single = strcmp(check->precision, "float") == 0;
+      // Randomize the inputs around the documented example.
+      uint64_t state = GOLDEN_SEED + c;
+      for (size_t p=0; p<check->nparams; p++)
+         for (size_t i=0; i<points; i++)
+            params[p][i] = check->nominal[p] * (1 + GOLDEN_SPREAD *
+                           (2 * _random_(&state) - 1));
+      double fast_rate = _throughput_(check->fast, points,
+            (const double *const *) params, fast);
+      double reference_rate = _throughput_(check->reference, points,
+            (const double *const *) params, reference);
+      // Find the worst field and count the values out of budgets.
+      uint64_t worst_ulp = 0;
+      double worst_rel = 0;
+      size_t worst_field = 0, bad = 0;
+      for (size_t r=0; r<check->nresults; r++) {
+         if (!(check->mask >> r & 1)) continue;
+         struct Budget budget = check->budgets[r];
+         for (size_t i=0; i<points; i++) {
+            uint64_t ulp = _ulps_(fast[r][i], reference[r][i], single);
+            double rel = _relative_(fast[r][i], reference[r][i]);
+            double error = fabs(fast[r][i] - reference[r][i]);
+            if (ulp > budget.ulp && rel > budget.rel &&
+                !(error <= budget.abs)) {
+               if (bad++ < 4)
+                  printf("  %s result %zu: %.17g != %.17g "
+                         "(%llu ulp, %.3g rel)\n", check->name, r,
+                         fast[r][i], reference[r][i],
+                         (unsigned long long) ulp, rel);
+            }
+            if (ulp > worst_ulp) { worst_ulp = ulp; worst_field = r; }
+            if (rel > worst_rel) worst_rel = rel;
+         }
+      }
+      printf("%-6s %-11s %-6s %-42s %10llu %10.3g %9.1f %9.1f\n",
+             bad ? "FAIL" : "PASS", check->path, check->precision,
+             check->name, (unsigned long long) worst_ulp, worst_rel,
+             fast_rate * 1e-6, reference_rate * 1e-6);
+      if (verbose && worst_ulp > 0)
+         printf("  worst field: result %zu\n", worst_field);
+      failures += (bad > 0);
+   }
+
+   free(block);
+   destroy_result_cache(golden_cache);
+   printf("paths: %zu checks, %zu failures\n", num_checks, failures);
+   return failures;
+}
+
+/* Compare the Jacobians of 'sensitivities[]' with the central
+differences of uniform evaluations. The count of failed partials is
+returned. */
+size_t check_sensitivities(int verbose) {
+   size_t failures = 0, partials = 0;
+   double columns[MAX_PARAMS + MAX_RESULTS * (MAX_PARAMS + 3)];
+   double *params[MAX_PARAMS], *results[MAX_RESULTS];
+   double *upper[MAX_RESULTS], *lower[MAX_RESULTS];
+   double *jacobian[MAX_RESULTS * MAX_PARAMS];
+   for (size_t p=0; p<MAX_PARAMS; p++) params[p] = &columns[p];
+   for (size_t r=0; r<MAX_RESULTS; r++) {
+      results[r] = &columns[MAX_PARAMS + r];
+      upper[r] = &columns[MAX_PARAMS + MAX_RESULTS + r];
+      lower[r] = &columns[MAX_PARAMS + 2 * MAX_RESULTS + r];
+   }
+   for (size_t k=0; k<MAX_RESULTS * MAX_PARAMS; k++)
+      jacobian[k] = &columns[MAX_PARAMS + 3 * MAX_RESULTS + k];
+
+   assert (num_slopes == num_sensitivities);
+   for (size_t s=0; s<num_sensitivities; s++) {
+      const struct Configuration *config = sensitivities[s].config;
+      const struct Slope *slope = &slopes[s];
+      assert (slope->nparams == config->nparams);
+      for (size_t p=0; p<config->nparams; p++)
+         *params[p] = slope->params[p];
+      sensitivities[s].jacobian(1, (const double *const *) params,
+                                results, jacobian);
+      // Step each parameter up and down (a zero one absolutely).
+      for (size_t p=0; p<config->nparams; p++) {
+         double nominal = slope->params[p];
+         double step = GOLDEN_STEP * (nominal ? fabs(nominal) : 1);
+         *params[p] = nominal + step;
+         config->evaluate(1, (const double *const *) params, upper);
+         *params[p] = nominal - step;
+         config->evaluate(1, (const double *const *) params, lower);
+         *params[p] = nominal;
+         for (size_t r=0; r<config->nresults; r++) {
+            double partial = *jacobian[r * config->nparams + p];
+            double central = (*upper[r] - *lower[r]) / (2 * step);
+            // Rounding of the results is amplified by the step, so
+            // it is also a budget of near-zero partials.
+            double noise = 1e3 * DBL_EPSILON * fmax(fabs(*upper[r]),
+                           fabs(*lower[r])) / step;
+            double error = fabs(partial - central);
+            int pass = error <= GOLDEN_SLOPE * fabs(partial) + noise;
+            partials++;
+            if (!pass || verbose > 1)
+               printf("%s %s d%s/d%s: %.9g (central %.9g)\n",
+                      pass ? "PASS" : "FAIL", config->name,
+                      config->results[r], config->params[p], partial,
+                      central);
+            failures += !pass;
+         }
+      }
+   }
+   printf("sensitivities: %zu configurations, %zu partials, "
+          "%zu failures\n", num_sensitivities, partials, failures);
+   return failures;
+}
+
+int main(int argc, char **argv) {
+   size_t points = GOLDEN_POINTS;
+   int verbose = 0;
+   // Read the options.
+   for (int i=1; i<argc; i++) {
+      if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+         points = strtoul(argv[++i], NULL, 10);
+      else if (strcmp(argv[i], "-v") == 0) verbose++;
+      else {
+         fprintf(stderr, "usage: %s [-n points] [-v]\n", argv[0]);
+         return 2;
+      }
+   }
+   if (points == 0) {
+      fprintf(stderr, "points must be positive\n");
+      return 2;
+   }
+   size_t failures = check_goldens(verbose);
+   failures += check_paths(points, verbose);
+   failures += check_sensitivities(verbose);
+   return failures ? 1 : 0;
+}
@@ -1,31 +1,635 @@
-/* TransCal - Transistor Calculator 
- 
-TransCal project was developed to make transistors analyzes 
+/* TransCal - Transistor Calculator
+
+TransCal project was developed to make transistors analyzes
 automatically. This project contains mostly used configurations.
 I've seperated it in three part. First part named 'BJT' contain
-BJT configurations like voltage-divider or common-base. Second 
+BJT configurations like voltage-divider or common-base. Second
 part named 'JFET' contain JFET configurations. Third and last
 part named 'MOSFET' contain basics E-MOSFET configuration. There
 is no part related D-MOSFET. Because JFET and D-MOSFET analyzes
-are same things. 
+are same things.
 
-Of course, I may have made mistake in some methods. Please, 
+Of course, I may have made mistake in some methods. Please,
 contact the with me over my e-mail address.
 */
 
+/* Streaming Job Driver
+
+This program analyzes a file of jobs, one job per line, and writes
+one result row per job in the same order. A line is either CSV or
+JSON (JSONL files), both can be mixed in a file:
+
+bjt,fixed_bias,12,240000,2200,50,40000
+{"device": "jfet", "config": "self_bias", "params": [20, 1e+6,
+3300, 1000, 0.008, -6, 50000]}
+
+Parameters are in the same order as 'config->params' (see the
+uniform tables of BJT.h, JFET.h and MOSFET.h). Results are written
+as CSV (device, configuration and result fields) or JSONL.
+
+cc -O3 -DNDEBUG -fno-math-errno -o transcal main.c TransCal.c \
+   -lm -pthread
+./transcal [-t threads] [-f csv|jsonl] [-o output] jobs.csv
+
+IMPORTANT NOTES:
+----------------
+
+1. The job file is memory-mapped and split into batches of about
+STREAM_BATCH bytes. Threads parse, analyze and format whole batches
+and one thread at a time writes the finished batches in order. So,
+reading, computing and writing overlap.
+2. Only a window of batches exists at any time and the pages of
+written batches are released. So, memory usage doesn't depend on
+the size of job file.
+3. The parser doesn't allocate any memory. JSON strings can't have
+escapes, and unknown keys can only have strings, numbers or flat
+arrays.
+4. Empty lines and lines beginning with '#' are skipped. Invalid
+lines are reported to stderr with their line numbers and skipped;
+then the exit status is 1.
+5. Faulty designs (see 'validate_results()'), like a zero resistance,
+are reported to stderr too and their rows have the fault name (see
+'fault_names') instead of the results, like 'bjt,fixed_bias,parameter'
+or '{..., "fault": "parameter"}'. Then the exit status is 1.
+*/
+
 #define AUTHOR   "Ahmet Can Gulmez"
 #define EMAIL    "ahmetcangulmez02gmail.com"
 #define VERSION  "2.0.0"
 #define RESOURCE "Electronic Devices and Circuit Theory by \
 Robert L. Boylestad and Louis Nashelsky"
 
-// #include "BJT.h"
-// #include "JFET.h"
-// #include "MOSFET.h"
+// Libraries:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include "Parallel.h"
+#include "TransCal.h"
+#include "Format.h"
+
+// General constants:
+#define STREAM_BATCH (1 << 18) // bytes of job file in a batch
+#define STREAM_ROW 1024 // bytes reserved for a result row
+#define MAX_NUMBER 64 // characters of a number
+
+// Output formats:
+enum Format {
+   FORMAT_CSV, // device,config,result,...
+   FORMAT_JSONL // {"device": ..., "config": ..., "field": result}
+};
+
+// Part of the job file (not terminated by NUL):
+struct Slice {
+   const char *begin; // first character
+   size_t length; // count of characters
+};
+
+// Invalid line of a batch:
+struct LineError {
+   size_t line; // line number in the batch
+   string message; // reason
+};
+
+// A batch of the job file:
+struct Batch {
+   struct Job *jobs; // parsed jobs
+   unsigned char *devices; // family of each job
+   size_t *numbers; // line number of each job in the batch
+   size_t njobs; // count of jobs
+   size_t capacity; // capacity of jobs
+   size_t lines; // count of lines
+   struct LineError *errors; // invalid lines
+   size_t nerrors; // count of invalid lines
+   size_t error_capacity; // capacity of errors
+   size_t nfaults; // count of faulty jobs
+   char *output; // formatted rows
+   size_t length; // bytes of rows
+   size_t size; // capacity of rows
+};
+
+// Common state of a stream:
+struct Stream {
+   const char *data; // mapped job file
+   size_t bytes; // size of job file
+   size_t batches; // count of batches
+   size_t window; // batches that may exist at once
+   struct Batch *slots; // batches of the window
+   unsigned char *done; // finished batches of the window
+   size_t next; // next batch to analyze
+   size_t emitted; // batches written
+   int emitting; // a thread is writing
+   enum Format format; // output format
+   int fd; // output file
+   int failed; // output couldn't be written
+   size_t lines; // lines written
+   size_t jobs; // jobs written
+   size_t errors; // invalid lines
+   size_t faults; // faulty jobs
+   size_t released; // bytes of job file released (page multiple)
+   pthread_mutex_t lock; // guards the window
+   pthread_cond_t advanced; // window moved forward
+};
+
+/* --------------------------------------------------------------- */
+/* ---------------------- Helper Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Check if the slice is equal to the string. */
+static int _equal_(struct Slice slice, const char *string) {
+   return strlen(string) == slice.length &&
+          memcmp(slice.begin, string, slice.length) == 0;
+}
+
+/* Skip the spaces and tabs. */
+static const char *_skip_(const char *at, const char *end) {
+   while (at < end && (*at == ' ' || *at == '\t')) at++;
+   return at;
+}
+
+/* Parse a number slice. If it isn't a whole number, 0 is returned. */
+static int _number_(struct Slice slice, double *value) {
+   // Copy the number to terminate it, the file isn't terminated.
+   char text[MAX_NUMBER];
+   if (slice.length == 0 || slice.length >= MAX_NUMBER) return 0;
+   memcpy(text, slice.begin, slice.length);
+   text[slice.length] = '\0';
+   char *stop;
+   *value = strtod(text, &stop);
+   return stop == text + slice.length;
+}
+
+/* Find the configuration of a family and configuration name. */
+static const struct Configuration *_find_job_(struct Slice device,
+      struct Slice name, unsigned char *family) {
+   for (int d=0; d<NUM_DEVICES; d++) {
+      if (!_equal_(device, device_names[d])) continue;
+      size_t num;
+      const struct Configuration *table = device_configurations(d,
+                                                                &num);
+      for (size_t c=0; c<num; c++)
+         if (_equal_(name, table[c].name)) {
+            *family = d;
+            return &table[c];
+         }
+      return NULL;
+   }
+   return NULL;
+}
+
+/* Parse a CSV job line. If it is invalid, the reason is returned. */
+static string _parse_csv_(const char *at, const char *end,
+                          struct Job *job, unsigned char *family) {
+   struct Slice fields[2 + MAX_PARAMS];
+   size_t nfields = 0;
+   // Split the fields and trim their spaces.
+   while (1) {
+      const char *comma = memchr(at, ',', end - at);
+      const char *stop = (comma != NULL) ? comma : end;
+      const char *last = stop;
+      at = _skip_(at, stop);
+      while (last > at && (last[-1] == ' ' || last[-1] == '\t'))
+         last--;
+      if (nfields == 2 + MAX_PARAMS) return "too many fields";
+      fields[nfields++] = (struct Slice) {at, last - at};
+      if (comma == NULL) break;
+      at = comma + 1;
+   }
+   if (nfields < 2) return "missing configuration";
+   job->config = _find_job_(fields[0], fields[1], family);
+   if (job->config == NULL) return "unknown configuration";
+   if (nfields - 2 != job->config->nparams)
+      return "wrong count of parameters";
+   for (size_t p=0; p<job->config->nparams; p++)
+      if (!_number_(fields[2 + p], &job->params[p]))
+         return "invalid number";
+   return NULL;
+}
+
+/* Parse a JSON string (without escapes) at 'at'. */
+static const char *_json_string_(const char *at, const char *end,
+                                 struct Slice *slice) {
+   if (at >= end || *at != '"') return NULL;
+   at++;
+   const char *close = memchr(at, '"', end - at);
+   if (close == NULL || memchr(at, '\\', close - at) != NULL)
+      return NULL;
+   *slice = (struct Slice) {at, close - at};
+   return close + 1;
+}
+
+/* Parse a JSON number (or literal) at 'at'. */
+static const char *_json_token_(const char *at, const char *end,
+                                struct Slice *slice) {
+   const char *stop = at;
+   while (stop < end && *stop != ',' && *stop != '}' &&
+          *stop != ']' && *stop != ' ' && *stop != '\t') stop++;
+   *slice = (struct Slice) {at, stop - at};
+   return (stop > at) ? stop : NULL;
+}
+
+/* Parse a JSON job line. If it is invalid, the reason is returned. */
+static string _parse_json_(const char *at, const char *end,
+                           struct Job *job, unsigned char *family) {
+   struct Slice device = {NULL, 0}, name = {NULL, 0}, key, value;
+   size_t nparams = 0;
+   int closed = 0;
+   at = _skip_(at + 1, end);
+   // Read the members of object.
+   while (at < end && !closed) {
+      if (*at == '}') { closed = 1; break; }
+      if ((at = _json_string_(at, end, &key)) == NULL)
+         return "invalid key";
+      at = _skip_(at, end);
+      if (at >= end || *at != ':') return "missing ':'";
+      at = _skip_(at + 1, end);
+      if (_equal_(key, "device") || _equal_(key, "config")) {
+         if ((at = _json_string_(at, end, &value)) == NULL)
+            return "invalid name";
+         *(_equal_(key, "device") ? &device : &name) = value;
+      }
+      else if (at < end && *at == '[') {
+         // Read the parameters (or skip the unknown arrays).
+         int params = _equal_(key, "params");
+         at = _skip_(at + 1, end);
+         while (at < end && *at != ']') {
+            if (*at == '"') at = _json_string_(at, end, &value);
+            else at = _json_token_(at, end, &value);
+            if (at == NULL) return "invalid array";
+            if (params) {
+               if (nparams == MAX_PARAMS) return "too many parameters";
+               if (!_number_(value, &job->params[nparams++]))
+                  return "invalid number";
+            }
+            at = _skip_(at, end);
+            if (at < end && *at == ',') at = _skip_(at + 1, end);
+         }
+         if (at >= end) return "missing ']'";
+         at++;
+      }
+      else if (at < end && *at == '"') {
+         if ((at = _json_string_(at, end, &value)) == NULL)
+            return "invalid string";
+      }
+      else if ((at = _json_token_(at, end, &value)) == NULL)
+         return "invalid value";
+      at = _skip_(at, end);
+      if (at < end && *at == ',') at = _skip_(at + 1, end);
+      else if (at < end && *at == '}') closed = 1;
+      else return "missing ',' or '}'";
+   }
+   if (!closed) return "missing '}'";
+   if (device.begin == NULL || name.begin == NULL)
+      return "missing device or config";
+   job->config = _find_job_(device, name, family);
+   if (job->config == NULL) return "unknown configuration";
+   if (nparams != job->config->nparams)
+      return "wrong count of parameters";
+   return NULL;
+}
+
+/* Make room for one more job or error in a batch. */
+static void _reserve_(struct Batch *batch) {
+   if (batch->njobs == batch->capacity) {
+      batch->capacity = batch->capacity ? 2 * batch->capacity : 1024;
+      batch->jobs = realloc(batch->jobs,
+                            batch->capacity * sizeof(struct Job));
+      batch->devices = realloc(batch->devices, batch->capacity);
+      batch->numbers = realloc(batch->numbers,
+                               batch->capacity * sizeof(size_t));
+      assert (batch->jobs != NULL && batch->devices != NULL &&
+              batch->numbers != NULL);
+   }
+   if (batch->nerrors == batch->error_capacity) {
+      batch->error_capacity = batch->error_capacity ?
+                              2 * batch->error_capacity : 16;
+      batch->errors = realloc(batch->errors, batch->error_capacity *
+                              sizeof(struct LineError));
+      assert (batch->errors != NULL);
+   }
+}
+
+/* Find the beginning of the first line which begins at or after
+'offset'. */
+static size_t _line_start_(const struct Stream *stream, size_t offset) {
+   if (offset == 0) return 0;
+   if (offset >= stream->bytes) return stream->bytes;
+   // A line begins after the newline before it.
+   const char *newline = memchr(stream->data + offset - 1, '\n',
+                                stream->bytes - offset + 1);
+   return (newline != NULL) ? (size_t) (newline - stream->data) + 1 :
+                              stream->bytes;
+}
+
+/* Parse the lines of the k'th batch. */
+static void _parse_batch_(const struct Stream *stream, size_t k,
+                          struct Batch *batch) {
+   size_t begin = _line_start_(stream, k * STREAM_BATCH);
+   size_t end = _line_start_(stream, (k + 1) * STREAM_BATCH);
+   const char *at = stream->data + begin, *stop = stream->data + end;
+   batch->njobs = batch->nerrors = batch->lines = 0;
+
+   while (at < stop) {
+      const char *newline = memchr(at, '\n', stop - at);
+      const char *last = (newline != NULL) ? newline : stop;
+      const char *next = (newline != NULL) ? newline + 1 : stop;
+      // Trim the line, then skip the empty and comment lines.
+      while (last > at && (last[-1] == '\r' || last[-1] == ' ' ||
+             last[-1] == '\t')) last--;
+      at = _skip_(at, last);
+      batch->lines++;
+      if (at == last || *at == '#') { at = next; continue; }
+      _reserve_(batch);
+      struct Job *job = &batch->jobs[batch->njobs];
+      unsigned char *family = &batch->devices[batch->njobs];
+      string error = (*at == '{') ?
+                     _parse_json_(at, last, job, family) :
+                     _parse_csv_(at, last, job, family);
+      // Skip the CSV header line silently.
+      if (error != NULL && batch->lines == 1 && k == 0 &&
+          strncmp(at, "device,", 7) == 0) error = NULL;
+      else if (error != NULL)
+         batch->errors[batch->nerrors++] = (struct LineError) {
+            batch->lines, error};
+      else batch->numbers[batch->njobs++] = batch->lines;
+      at = next;
+   }
+}
+
+/* Copy a string to the output and get the end of it. */
+static char *_append_(char *out, const char *text) {
+   size_t length = strlen(text);
+   memcpy(out, text, length);
+   return out + length;
+}
+
+/* Find the name of a job fault (only its lowest bit is set). */
+static string _fault_name_(unsigned char status) {
+   int f = 0;
+   while (f < NUM_FAULTS - 1 && !((status >> f) & 1)) f++;
+   return fault_names[f];
+}
+
+/* Write a result row of a job to the batch output. */
+static void _format_job_(struct Batch *batch, const struct Job *job,
+                         unsigned char family, enum Format format) {
+   const struct Configuration *config = job->config;
+   // Each row fits the reserved bytes (names and 17 digits).
+   if (batch->size - batch->length < STREAM_ROW) {
+      batch->size = batch->size ? 2 * batch->size : 1 << 20;
+      batch->output = realloc(batch->output, batch->size);
+      assert (batch->output != NULL);
+   }
+   // Numbers are written by Format.h, printf is much slower.
+   char *out = batch->output + batch->length;
+   if (format == FORMAT_CSV) {
+      out = _append_(out, device_names[family]);
+      *out++ = ',';
+      out = _append_(out, config->name);
+      // Faulty jobs have their fault instead of meaningless results.
+      if (job->status != 0) {
+         *out++ = ',';
+         out = _append_(out, _fault_name_(job->status));
+      }
+      else for (size_t r=0; r<config->nresults; r++) {
+         *out++ = ',';
+         out += format_double(out, job->results[r]);
+      }
+   }
+   else {
+      out = _append_(out, "{\"device\": \"");
+      out = _append_(out, device_names[family]);
+      out = _append_(out, "\", \"config\": \"");
+      out = _append_(out, config->name);
+      *out++ = '"';
+      if (job->status != 0) {
+         out = _append_(out, ", \"fault\": \"");
+         out = _append_(out, _fault_name_(job->status));
+         *out++ = '"';
+      }
+      // JSON hasn't any NAN or infinity, they are written as null.
+      else for (size_t r=0; r<config->nresults; r++) {
+         out = _append_(out, ", \"");
+         out = _append_(out, config->results[r]);
+         out = _append_(out, "\": ");
+         if (isfinite(job->results[r]))
+            out += format_double(out, job->results[r]);
+         else out = _append_(out, "null");
+      }
+      *out++ = '}';
+   }
+   *out++ = '\n';
+   batch->length = out - batch->output;
+}
+
+/* Write all bytes to the file. If it fails, 0 is returned. */
+static int _write_all_(int fd, const char *data, size_t length) {
+   while (length > 0) {
+      ssize_t written = write(fd, data, length);
+      if (written < 0 && errno == EINTR) continue;
+      if (written <= 0) return 0;
+      data += written;
+      length -= written;
+   }
+   return 1;
+}
+
+/* Write a finished batch and release its part of the job file. */
+static void _emit_batch_(struct Stream *stream, size_t k,
+                         struct Batch *batch) {
+   if (!stream->failed &&
+       !_write_all_(stream->fd, batch->output, batch->length)) {
+      perror("transcal: write");
+      stream->failed = 1;
+   }
+   // Report the invalid lines and faulty jobs in line order.
+   size_t e = 0;
+   for (size_t j=0; j<batch->njobs || e<batch->nerrors;) {
+      if (j == batch->njobs || (e < batch->nerrors &&
+          batch->errors[e].line < batch->numbers[j])) {
+         fprintf(stderr, "transcal: line %zu: %s\n",
+                 stream->lines + batch->errors[e].line,
+                 batch->errors[e].message);
+         e++;
+         continue;
+      }
+      if (batch->jobs[j].status != 0)
+         fprintf(stderr, "transcal: line %zu: faulty design (%s)\n",
+                 stream->lines + batch->numbers[j],
+                 _fault_name_(batch->jobs[j].status));
+      j++;
+   }
+   stream->lines += batch->lines;
+   stream->jobs += batch->njobs;
+   stream->errors += batch->nerrors;
+   stream->faults += batch->nfaults;
+   // The next batch reads from one byte before its boundary. Only
+   // the pages after the released ones are released, so the cost
+   // doesn't grow with the offset.
+   size_t page = sysconf(_SC_PAGESIZE);
+   size_t used = ((k + 1) * STREAM_BATCH - 1) / page * page;
+   if (used > stream->bytes) used = stream->bytes / page * page;
+   if (used > stream->released) {
+      madvise((void *) (stream->data + stream->released),
+              used - stream->released, MADV_DONTNEED);
+      stream->released = used;
+   }
+}
+
+/* Analyze the batches and write them in order. */
+static void _stream_worker_(void *args, size_t index) {
+   struct Stream *stream = args;
+   (void) index;
+   pthread_mutex_lock(&stream->lock);
+   while (1) {
+      // Take the next batch when the window reaches it.
+      while (stream->next < stream->batches &&
+             stream->next >= stream->emitted + stream->window)
+         pthread_cond_wait(&stream->advanced, &stream->lock);
+      if (stream->next >= stream->batches) break;
+      size_t k = stream->next++;
+      pthread_mutex_unlock(&stream->lock);
+
+      // Read the following batches ahead while this one is analyzed.
+      size_t ahead = (k + stream->window) * STREAM_BATCH;
+      if (ahead < stream->bytes) {
+         size_t page = sysconf(_SC_PAGESIZE);
+         size_t length = (stream->bytes - ahead < STREAM_BATCH) ?
+                         stream->bytes - ahead : STREAM_BATCH;
+         madvise((void *) (stream->data + ahead / page * page),
+                 length + ahead % page, MADV_WILLNEED);
+      }
+      struct Batch *batch = &stream->slots[k % stream->window];
+      _parse_batch_(stream, k, batch);
+      batch->nfaults = run_jobs(batch->jobs, batch->njobs, 1);
+      batch->length = 0;
+      for (size_t j=0; j<batch->njobs; j++)
+         _format_job_(batch, &batch->jobs[j], batch->devices[j],
+                      stream->format);
+
+      pthread_mutex_lock(&stream->lock);
+      stream->done[k % stream->window] = 1;
+      // Only one thread writes, the others go on analyzing.
+      if (!stream->emitting) {
+         stream->emitting = 1;
+         while (stream->emitted < stream->batches &&
+                stream->done[stream->emitted % stream->window]) {
+            size_t e = stream->emitted;
+            pthread_mutex_unlock(&stream->lock);
+            _emit_batch_(stream, e, &stream->slots[e % stream->window]);
+            pthread_mutex_lock(&stream->lock);
+            stream->done[e % stream->window] = 0;
+            stream->emitted++;
+            pthread_cond_broadcast(&stream->advanced);
+         }
+         stream->emitting = 0;
+      }
+   }
+   pthread_mutex_unlock(&stream->lock);
+}
+
+/* --------------------------------------------------------------- */
+/* ------------------------ Main Definations --------------------- */
+/* --------------------------------------------------------------- */
+
+/* Analyze all jobs of the mapped file and write their rows to 'fd'.
+If any line is invalid, any design is faulty or the output couldn't
+be written, non-zero is returned. */
+int stream_jobs(const char *data, size_t bytes, int fd,
+                enum Format format, size_t threads) {
+   struct Stream stream = {
+      .data = data, .bytes = bytes,
+      .batches = (bytes + STREAM_BATCH - 1) / STREAM_BATCH,
+      .format = format, .fd = fd,
+   };
+   threads = _num_threads_(threads);
+   if (threads > stream.batches) threads = stream.batches;
+   if (threads == 0) return 0;
+   // Each thread has a batch in analysis and another one waiting.
+   stream.window = 2 * threads;
+   stream.slots = calloc(stream.window, sizeof(struct Batch));
+   stream.done = calloc(stream.window, 1);
+   assert (stream.slots != NULL && stream.done != NULL);
+   pthread_mutex_init(&stream.lock, NULL);
+   pthread_cond_init(&stream.advanced, NULL);
+   parallel_run(threads, _stream_worker_, &stream);
+
+   pthread_cond_destroy(&stream.advanced);
+   pthread_mutex_destroy(&stream.lock);
+   for (size_t s=0; s<stream.window; s++) {
+      free(stream.slots[s].jobs); free(stream.slots[s].devices);
+      free(stream.slots[s].numbers);
+      free(stream.slots[s].errors); free(stream.slots[s].output);
+   }
+   free(stream.slots); free(stream.done);
+   fprintf(stderr, "transcal: %zu jobs, %zu invalid lines, "
+           "%zu faulty designs\n", stream.jobs, stream.errors,
+           stream.faults);
+   return stream.failed ? 2 : (stream.errors + stream.faults > 0);
+}
 
-int main(void) {
+int main(int argc, char **argv) {
+   size_t threads = 0;
+   const char *input = NULL, *output = NULL, *format = NULL;
+   // Read the options.
+   for (int i=1; i<argc; i++) {
+      if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+         threads = strtoul(argv[++i], NULL, 10);
+      else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+         format = argv[++i];
+      else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+         output = argv[++i];
+      else if (argv[i][0] != '-' && input == NULL) input = argv[i];
+      else input = NULL, i = argc;
+   }
+   if (input == NULL || (format != NULL && strcmp(format, "csv") != 0
+       && strcmp(format, "jsonl") != 0)) {
+      fprintf(stderr, "usage: %s [-t threads] [-f csv|jsonl] "
+              "[-o output] jobs\n", argv[0]);
+      return 2;
+   }
+   // Write JSONL for JSONL job files if the format isn't given.
+   size_t length = strlen(input);
+   enum Format kind = (format != NULL) ?
+      ((strcmp(format, "jsonl") == 0) ? FORMAT_JSONL : FORMAT_CSV) :
+      ((length > 6 && strcmp(input + length - 6, ".jsonl") == 0) ?
+       FORMAT_JSONL : FORMAT_CSV);
 
-   
+   // Map the job file.
+   int in = open(input, O_RDONLY);
+   struct stat info;
+   if (in < 0 || fstat(in, &info) < 0) {
+      perror(input);
+      return 2;
+   }
+   const char *data = NULL;
+   if (info.st_size > 0) {
+      data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, in, 0);
+      if (data == MAP_FAILED) {
+         perror(input);
+         return 2;
+      }
+      madvise((void *) data, info.st_size, MADV_SEQUENTIAL);
+   }
+   int out = (output != NULL) ?
+             open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644) : 1;
+   if (out < 0) {
+      perror(output);
+      return 2;
+   }
+   int status = stream_jobs(data, info.st_size, out, kind, threads);
 
-   return 0;
-}
\ No newline at end of file
+   if (data != NULL) munmap((void *) data, info.st_size);
+   close(in);
+   if (out != 1 && close(out) < 0) {
+      perror(output);
+      status = 2;
+   }
+   return status;
+}